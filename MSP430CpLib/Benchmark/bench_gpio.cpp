@@ -0,0 +1,198 @@
+#include <msp430.h>
+#include "msp430cp_gpio.h"
+#include "msp430cp_pin.h"
+#include "msp430cp_gpio_handle.h"
+#include "msp430cp_pin_group.h"
+
+// GPIO microbenchmarks
+// Each Bench_* function calls one library API once. The cycles of each call are measured by Timer_A0
+// (SMCLK = MCLK, continuous mode), the cost of calling an empty benchmark is subtracted,
+// and the minimum of BENCH_REPEAT runs is stored in bench_cycles[] (same order as bench_table[]).
+// run_bench.py runs this program in the simulator, reads both tables and maps bench_table[] addresses to names.
+
+/// <summary>Runs of each benchmark (the minimum is reported)</summary>
+#define BENCH_REPEAT 8
+
+#define BENCH __attribute__((noinline, used))
+
+// Objects under test
+MSP430_GPIO gpio(MSP430_GPIO_Port::P1, 0, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Output);
+MSP430_GPIO_Bank bank(MSP430_GPIO_Port::P4, MSP430_GPIO_Direction::Output);
+MSP430_Pin<MSP430_GPIO_Port::P1, 1> pin;
+/// <summary>Runtime-chosen pins (flash-resident table of 1-byte handles), indexed by a volatile to defeat constant folding</summary>
+const MSP430_GPIO_Handle handles[] = { { MSP430_GPIO_Port::P1, 3 }, { MSP430_GPIO_Port::P4, 7 } };
+volatile unsigned char handleIndex = 1;
+/// <summary>Scattered compile-time pins (two on P1, one on P2 and P4), written from a volatile to defeat constant folding</summary>
+typedef MSP430_PinGroup<MSP430_Pins::P1_0, MSP430_Pins::P1_5, MSP430_Pins::P2_3, MSP430_Pins::P4_7> group;
+volatile unsigned int groupValue = 0x5;
+
+/// <summary>Sink for read results, prevents the calls from being optimized out</summary>
+volatile unsigned int bench_sink;
+
+// MSP430_GPIO
+BENCH void Bench_Empty(void) {}
+BENCH void Bench_GPIO_Construct(void) { MSP430_GPIO local(MSP430_GPIO_Port::P1, 2); }
+BENCH void Bench_GPIO_EnableInterrupt(void) { gpio.EnableInterrupt(MSP430_GPIO_InterruptTrig::Posedge); }
+BENCH void Bench_GPIO_DisableInterrupt(void) { gpio.DisableInterrupt(); }
+BENCH void Bench_GPIO_CheckInterruptFlag(void) { bench_sink = gpio.CheckInterruptFlag(); }
+BENCH void Bench_GPIO_ClearInterruptFlag(void) { gpio.ClearInterruptFlag(); }
+BENCH void Bench_GPIO_Initialize(void) { gpio.Initialize(); }
+BENCH void Bench_GPIO_Deinitialize(void) { gpio.Deinitialize(); }
+BENCH void Bench_GPIO_SetHigh(void) { gpio.SetHigh(); }
+BENCH void Bench_GPIO_SetLow(void) { gpio.SetLow(); }
+BENCH void Bench_GPIO_SetValue(void) { gpio.SetValue(1); }
+BENCH void Bench_GPIO_GetValue(void) { bench_sink = gpio.GetValue(); }
+BENCH void Bench_GPIO_CheckHigh(void) { bench_sink = gpio.CheckHigh(); }
+BENCH void Bench_GPIO_CheckLow(void) { bench_sink = gpio.CheckLow(); }
+BENCH void Bench_GPIO_ReverseValue(void) { gpio.ReverseValue(); }
+BENCH void Bench_GPIO_ReverseDirection(void) { gpio.ReverseDirection(); }
+BENCH void Bench_GPIO_SetDirection(void) { gpio.SetDirection(MSP430_GPIO_Direction::Output); }
+BENCH void Bench_GPIO_GetDirection(void) { bench_sink = static_cast<unsigned int> (gpio.GetDirection()); }
+BENCH void Bench_GPIO_SetFunction(void) { gpio.SetFunction(MSP430_GPIO_Function::Stardand); }
+BENCH void Bench_GPIO_SetPullResistor(void) { gpio.SetPullResistor(MSP430_GPIO_PullResistor::Off); }
+
+// MSP430_GPIO_Bank
+BENCH void Bench_Bank_Construct(void) { MSP430_GPIO_Bank local(MSP430_GPIO_Port::P6); }
+BENCH void Bench_Bank_SetAccessMask(void) { bank.SetAccessMask(0xFF); }
+BENCH void Bench_Bank_SetAccessMaskRange(void) { bank.SetAccessMask(1, 6); }
+BENCH void Bench_Bank_Initialize(void) { bank.Initialize(); }
+BENCH void Bench_Bank_Deinitialize(void) { bank.Deinitialize(); }
+BENCH void Bench_Bank_SetValue(void) { bank.SetValue(0x5A); }
+BENCH void Bench_Bank_GetValue(void) { bench_sink = bank.GetValue(); }
+BENCH void Bench_Bank_ReverseValue(void) { bank.ReverseValue(); }
+BENCH void Bench_Bank_ReverseDirection(void) { bank.ReverseDirection(); }
+BENCH void Bench_Bank_SetDirection(void) { bank.SetDirection(MSP430_GPIO_Direction::Output); }
+BENCH void Bench_Bank_GetDirection(void) { bench_sink = static_cast<unsigned int> (bank.GetDirection()); }
+BENCH void Bench_Bank_SetPullResistor(void) { bank.SetPullResistor(MSP430_GPIO_PullResistor::Off); }
+
+// MSP430_Pin (compile-time pin, for comparison with MSP430_GPIO)
+BENCH void Bench_Pin_SetHigh(void) { pin.SetHigh(); }
+BENCH void Bench_Pin_SetLow(void) { pin.SetLow(); }
+BENCH void Bench_Pin_SetValue(void) { pin.SetValue(1); }
+BENCH void Bench_Pin_GetValue(void) { bench_sink = pin.GetValue(); }
+BENCH void Bench_Pin_ReverseValue(void) { pin.ReverseValue(); }
+BENCH void Bench_Pin_Initialize(void) { pin.Initialize(); }
+
+// MSP430_GPIO_Handle (1-byte runtime pin, for comparison with MSP430_GPIO)
+BENCH void Bench_Handle_SetHigh(void) { handles[handleIndex].SetHigh(); }
+BENCH void Bench_Handle_SetLow(void) { handles[handleIndex].SetLow(); }
+BENCH void Bench_Handle_GetValue(void) { bench_sink = handles[handleIndex].GetValue(); }
+BENCH void Bench_Handle_ReverseValue(void) { handles[handleIndex].ReverseValue(); }
+BENCH void Bench_Handle_Initialize(void) { handles[handleIndex].Initialize(MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Output, MSP430_GPIO_PullResistor::Off); }
+
+// MSP430_PinGroup (4 pins on 3 ports, for comparison with 4 MSP430_Pin calls)
+BENCH void Bench_PinGroup_Set(void) { group::Set(); }
+BENCH void Bench_PinGroup_Toggle(void) { group::Toggle(); }
+BENCH void Bench_PinGroup_Write(void) { group::Write(groupValue); }
+BENCH void Bench_PinGroup_Read(void) { bench_sink = group::Read(); }
+BENCH void Bench_PinGroup_Initialize(void) { group::Initialize(MSP430_GPIO_Direction::Output); }
+
+/// <summary>Benchmark table (read by run_bench.py, the addresses are mapped to names by the symbol table)</summary>
+void (* const bench_table[])(void) =
+{
+	Bench_GPIO_Construct,
+	Bench_GPIO_EnableInterrupt,
+	Bench_GPIO_DisableInterrupt,
+	Bench_GPIO_CheckInterruptFlag,
+	Bench_GPIO_ClearInterruptFlag,
+	Bench_GPIO_Initialize,
+	Bench_GPIO_Deinitialize,
+	Bench_GPIO_SetHigh,
+	Bench_GPIO_SetLow,
+	Bench_GPIO_SetValue,
+	Bench_GPIO_GetValue,
+	Bench_GPIO_CheckHigh,
+	Bench_GPIO_CheckLow,
+	Bench_GPIO_ReverseValue,
+	Bench_GPIO_ReverseDirection,
+	Bench_GPIO_SetDirection,
+	Bench_GPIO_GetDirection,
+	Bench_GPIO_SetFunction,
+	Bench_GPIO_SetPullResistor,
+	Bench_Bank_Construct,
+	Bench_Bank_SetAccessMask,
+	Bench_Bank_SetAccessMaskRange,
+	Bench_Bank_Initialize,
+	Bench_Bank_Deinitialize,
+	Bench_Bank_SetValue,
+	Bench_Bank_GetValue,
+	Bench_Bank_ReverseValue,
+	Bench_Bank_ReverseDirection,
+	Bench_Bank_SetDirection,
+	Bench_Bank_GetDirection,
+	Bench_Bank_SetPullResistor,
+	Bench_Pin_SetHigh,
+	Bench_Pin_SetLow,
+	Bench_Pin_SetValue,
+	Bench_Pin_GetValue,
+	Bench_Pin_ReverseValue,
+	Bench_Pin_Initialize,
+	Bench_Handle_SetHigh,
+	Bench_Handle_SetLow,
+	Bench_Handle_GetValue,
+	Bench_Handle_ReverseValue,
+	Bench_Handle_Initialize,
+	Bench_PinGroup_Set,
+	Bench_PinGroup_Toggle,
+	Bench_PinGroup_Write,
+	Bench_PinGroup_Read,
+	Bench_PinGroup_Initialize
+};
+
+#define BENCH_COUNT (sizeof(bench_table) / sizeof(bench_table[0]))
+
+/// <summary>Measured cycles of each benchmark (read by run_bench.py)</summary>
+volatile unsigned int bench_cycles[BENCH_COUNT];
+/// <summary>Object sizes in RAM: MSP430_GPIO, MSP430_GPIO_Bank, MSP430_Pin, MSP430_GPIO_Handle (read by run_bench.py)</summary>
+volatile unsigned int bench_object_size[4];
+
+/// <summary>Measure the minimum cycles of a benchmark</summary>
+/// <param name="bench">Benchmark function</param>
+static unsigned int Measure(void (*bench)(void))
+{
+	unsigned int best = 0xFFFF;
+	for (int i = 0; i < BENCH_REPEAT; i++)
+	{
+		unsigned int start = TA0R;
+		bench();
+		unsigned int cycles = TA0R - start;
+		if (cycles < best)
+		{
+			best = cycles;
+		}
+	}
+	return best;
+}
+
+/// <summary>Breakpoint location for the runner: all results are ready</summary>
+BENCH void Bench_Done(void)
+{
+	for (;;)
+	{
+		__no_operation();
+	}
+}
+
+int main()
+{
+	WDTCTL = WDTPW | WDTHOLD;
+
+	// Timer_A0 counts MCLK cycles (SMCLK = MCLK after reset, divider /1, continuous mode)
+	TA0CTL = TASSEL_2 | ID_0 | MC_2 | TACLR;
+
+	gpio.Initialize();
+	bank.Initialize();
+
+	unsigned int overhead = Measure(Bench_Empty);
+	for (unsigned int i = 0; i < BENCH_COUNT; i++)
+	{
+		bench_cycles[i] = Measure(bench_table[i]) - overhead;
+	}
+
+	bench_object_size[0] = sizeof(MSP430_GPIO);
+	bench_object_size[1] = sizeof(MSP430_GPIO_Bank);
+	bench_object_size[2] = sizeof(MSP430_Pin<MSP430_GPIO_Port::P1, 1>);
+	bench_object_size[3] = sizeof(MSP430_GPIO_Handle);
+
+	Bench_Done();
+}
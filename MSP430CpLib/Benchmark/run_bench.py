@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""Run the MSP430CpLib benchmark program and report cycles, flash and RAM per API.
+
+The program (bench_gpio.cpp) is loaded into mspdebug (simulator by default), run until Bench_Done,
+then bench_table/bench_cycles/bench_object_size are read back from the target memory.
+Flash per API comes from the symbol sizes of the library functions, totals from the section sizes.
+The results are compared with a stored baseline (JSON) and optionally with the VisualGDB memory report:
+any number of cycles, flash or RAM bytes above the baseline is flagged and makes the script exit with 1.
+With --report-only the numbers are printed (against the baseline when there is one) and the exit code is 0.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import xml.etree.ElementTree as ElementTree
+
+LIBRARY_SYMBOL = re.compile(r"^(MSP430_GPIO|MSP430_GPIO_Bank|MSP430_Pin<.*>)::")
+MEMORY_LINE = re.compile(r"^\s*([0-9a-fA-F]+):\s+(.*)$")
+
+
+def run(command):
+    return subprocess.run(command, check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+
+
+def read_symbols(toolchain_prefix, elf):
+    """Return {name: (address, size)} of all sized symbols (demangled, without parameter list)."""
+    symbols = {}
+    output = run([toolchain_prefix + "nm", "-S", "-C", "--defined-only", elf])
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) != 4:
+            continue
+        address, size, _, name = fields
+        symbols[name] = (int(address, 16), int(size, 16))
+    return symbols
+
+
+def read_sections(toolchain_prefix, elf):
+    """Return the program totals: flash and RAM (Berkeley format: text + data, data + bss) and the .data/.bss section sizes."""
+    lines = run([toolchain_prefix + "size", "-B", elf]).splitlines()
+    text, data, bss = (int(value) for value in lines[1].split()[:3])
+    totals = {"flash": text + data, "ram": data + bss, ".data": 0, ".bss": 0}
+    # msp430-elf splits the sections into .data/.lower.data/.upper.data/.either.data (same for .bss)
+    for line in run([toolchain_prefix + "size", "-A", elf]).splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[1].isdigit():
+            for section in (".data", ".bss"):
+                if fields[0].endswith(section):
+                    totals[section] += int(fields[1])
+    return totals
+
+
+def read_target_memory(mspdebug, driver, elf, regions):
+    """Run the program until Bench_Done and read the memory regions [(address, size)]."""
+    commands = ["prog " + elf]
+    if driver == "sim":
+        # Timer_A0 of the 5xx family is at 0x0340 (mspdebug defaults to the 2xx address)
+        commands += ["simio add timer ta0", "simio config ta0 base 0x0340"]
+    commands += ["setbreak Bench_Done", "run"]
+    commands += ["md 0x%04x %d" % region for region in regions]
+    output = run([mspdebug, "-q", driver] + commands)
+
+    memory = {}
+    for line in output.splitlines():
+        match = MEMORY_LINE.match(line)
+        if not match:
+            continue
+        address = int(match.group(1), 16)
+        for index, byte in enumerate(match.group(2).split("|")[0].split()):
+            memory[address + index] = int(byte, 16)
+
+    def words(address, size, width=2):
+        return [sum(memory[address + offset + i] << (8 * i) for i in range(width))
+                for offset in range(0, size, width)]
+
+    return words
+
+
+def measure(args):
+    symbols = read_symbols(args.toolchain_prefix, args.elf)
+    by_address = {address: name.split("(")[0] for name, (address, _) in symbols.items()}
+
+    table = symbols["bench_table"]
+    cycles = symbols["bench_cycles"]
+    object_size = symbols["bench_object_size"]
+    count = cycles[1] // 2
+    pointer_width = table[1] // count
+
+    words = read_target_memory(args.mspdebug, args.driver, args.elf, [table, cycles, object_size])
+    entries = words(table[0], table[1], pointer_width)
+    results = {"cycles": {}, "flash": {}, "ram": {}, "total": {}}
+    for entry, value in zip(entries, words(cycles[0], cycles[1])):
+        results["cycles"][by_address[entry].replace("Bench_", "", 1)] = value
+
+    for name, (_, size) in symbols.items():
+        if LIBRARY_SYMBOL.match(name) and size:
+            results["flash"][name] = size
+
+    sizes = words(object_size[0], object_size[1])
+    results["ram"] = {"MSP430_GPIO": sizes[0], "MSP430_GPIO_Bank": sizes[1], "MSP430_Pin": sizes[2], "MSP430_GPIO_Handle": sizes[3]}
+    results["total"] = read_sections(args.toolchain_prefix, args.elf)
+    return results
+
+
+def print_group(title, unit, current, baseline, tolerance):
+    """Print the group and return the number of values that grew by more than tolerance."""
+    print("%s" % title)
+    regressions = 0
+    for name in sorted(current):
+        value = current[name]
+        if name in baseline:
+            delta = value - baseline[name]
+            regression = delta > tolerance
+            regressions += regression
+            print("  %-60s %6d %-6s (%+d)%s" % (name, value, unit, delta, "  REGRESSION" if regression else ""))
+        else:
+            print("  %-60s %6d %-6s (new)" % (name, value, unit))
+    for name in sorted(set(baseline) - set(current)):
+        print("  %-60s %6s %-6s (removed)" % (name, "-", unit))
+    print()
+    return regressions
+
+
+def print_memory_report(path):
+    if not path or not os.path.exists(path):
+        return
+    print("VisualGDB memory utilization report (%s)" % os.path.basename(path))
+    for memory in ElementTree.parse(path).getroot().iter("MemoryUtilization"):
+        print("  %-60s %6s of %s bytes" % (memory.findtext("MemoryName"), memory.findtext("Used"), memory.findtext("Total")))
+    print()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--elf", required=True, help="benchmark program")
+    parser.add_argument("--toolchain-prefix", default="msp430-elf-")
+    parser.add_argument("--mspdebug", default="mspdebug")
+    parser.add_argument("--driver", default="sim", help="mspdebug driver (sim, tilib, ...)")
+    parser.add_argument("--baseline", default="baseline.json")
+    parser.add_argument("--update-baseline", action="store_true", help="store the results as the baseline")
+    parser.add_argument("--cycle-tolerance", type=int, default=0, help="cycles a call may grow before it is a regression")
+    parser.add_argument("--size-tolerance", type=int, default=0, help="bytes a flash or RAM figure may grow before it is a regression")
+    parser.add_argument("--report-only", action="store_true", help="print regressions but exit with 0")
+    parser.add_argument("--memory-report", help="VisualGDB MemoryUtilizationReport.xml to print for reference")
+    args = parser.parse_args()
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as file:
+            baseline = json.load(file)
+    elif not args.update_baseline and not args.report_only:
+        print("%s not found: store one with 'make baseline' and commit it" % args.baseline, file=sys.stderr)
+        return 2
+
+    results = measure(args)
+    regressions = 0
+    regressions += print_group("Cycles per call", "cycles", results["cycles"], baseline.get("cycles", {}), args.cycle_tolerance)
+    regressions += print_group("Flash per API", "bytes", results["flash"], baseline.get("flash", {}), args.size_tolerance)
+    regressions += print_group("RAM per object", "bytes", results["ram"], baseline.get("ram", {}), args.size_tolerance)
+    regressions += print_group("Program total", "bytes", results["total"], baseline.get("total", {}), args.size_tolerance)
+    print_memory_report(args.memory_report)
+
+    if args.update_baseline:
+        with open(args.baseline, "w") as file:
+            json.dump(results, file, indent=2, sort_keys=True)
+            file.write("\n")
+        print("Baseline stored in %s" % args.baseline)
+    elif regressions:
+        print("%d regression(s) against %s" % (regressions, args.baseline))
+        if not args.report_only:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,558 @@
+#pragma once
+
+// Host-side replacement of TI <msp430.h>
+// Put this directory before the TI include directory to build the library on a PC (g++/clang, x86).
+// Every register name maps into a simulated register file that follows the MSP430F5529 memory map,
+// so 8-bit port registers (P1OUT) and 16-bit port-pair registers (PAOUT) alias like on the device.
+// See also msp430cp_host.h for the pin stimulus and edge simulation API.
+
+/// <summary>Defined when the library is built against the host-side register file</summary>
+#define MSP430CP_HOST
+
+// Simulated register file (peripheral address space 0x0000 - 0x0FFF)
+#define MSP430HOST_REGISTER_FILE_SIZE 0x1000
+extern volatile unsigned char MSP430Host_RegisterFile[MSP430HOST_REGISTER_FILE_SIZE];
+
+/// <summary>8-bit register at address ADDR of the simulated register file</summary>
+#define MSP430HOST_SFR8(ADDR) (MSP430Host_RegisterFile[(ADDR)])
+/// <summary>16-bit register at address ADDR of the simulated register file</summary>
+#define MSP430HOST_SFR16(ADDR) (*reinterpret_cast<volatile unsigned short*> (&MSP430Host_RegisterFile[(ADDR)]))
+
+// Registers with a side effect on access (interrupt vector reads, PMM writes, multiplier operands and results), the value stays in the register file
+/// <summary>Host side of an active register read (returns the value read, e.g. the IV of the highest pending flag)</summary>
+/// <param name="address">Register address</param>
+unsigned short MSP430Host_ReadRegister(unsigned int address);
+/// <summary>Host side of an active register write (called after the value is stored)</summary>
+/// <param name="address">Register address</param>
+void MSP430Host_WriteRegister(unsigned int address);
+
+/// <summary>
+/// Register with a side effect on access, reached through its register name only
+/// <para>Reads call MSP430Host_ReadRegister(), writes store the value and call MSP430Host_WriteRegister().</para>
+/// </summary>
+/// <typeparam name="T">Register element (unsigned char or unsigned short)</typeparam>
+/// <typeparam name="ADDR">Register address</typeparam>
+template <typename T, unsigned int ADDR>
+struct MSP430Host_ActiveRegister
+{
+	/// <summary>Register value in the register file</summary>
+	static volatile T& Value(void) { return *reinterpret_cast<volatile T*> (&MSP430Host_RegisterFile[ADDR]); }
+
+	operator T() const { return static_cast<T> (MSP430Host_ReadRegister(ADDR)); }
+	const MSP430Host_ActiveRegister& operator=(T value) const { Value() = value; MSP430Host_WriteRegister(ADDR); return *this; }
+	const MSP430Host_ActiveRegister& operator|=(T value) const { return *this = static_cast<T> (Value() | value); }
+	const MSP430Host_ActiveRegister& operator&=(T value) const { return *this = static_cast<T> (Value() & value); }
+	const MSP430Host_ActiveRegister& operator^=(T value) const { return *this = static_cast<T> (Value() ^ value); }
+};
+
+/// <summary>8-bit active register at address ADDR of the simulated register file</summary>
+#define MSP430HOST_ACTIVE8(ADDR) (MSP430Host_ActiveRegister<unsigned char, (ADDR)>())
+/// <summary>16-bit active register at address ADDR of the simulated register file</summary>
+#define MSP430HOST_ACTIVE16(ADDR) (MSP430Host_ActiveRegister<unsigned short, (ADDR)>())
+
+// Device modules (MSP430F5529, read by msp430cp_device_traits.h)
+#define __MSP430_HAS_PORT1_R__
+#define __MSP430_HAS_PORT2_R__
+#define __MSP430_HAS_PORT3_R__
+#define __MSP430_HAS_PORT4_R__
+#define __MSP430_HAS_PORT5_R__
+#define __MSP430_HAS_PORT6_R__
+#define __MSP430_HAS_PORT7_R__
+#define __MSP430_HAS_PORT8_R__
+#define __MSP430_HAS_PORTA_R__
+#define __MSP430_HAS_PORTB_R__
+#define __MSP430_HAS_PORTC_R__
+#define __MSP430_HAS_PORTD_R__
+#define __MSP430_HAS_PORT_MAPPING__
+#define __MSP430_HAS_MPY32__
+#define __MSP430_HAS_T0A5__
+#define __MSP430_HAS_T1A3__
+#define __MSP430_HAS_T2A3__
+#define __MSP430_HAS_T0B7__
+#define __MSP430_HAS_DMAX_3__
+#define __MSP430_HAS_USCI_A0__
+#define __MSP430_HAS_USCI_A1__
+
+// Bit definations
+#define BIT0 (0x0001)
+#define BIT1 (0x0002)
+#define BIT2 (0x0004)
+#define BIT3 (0x0008)
+#define BIT4 (0x0010)
+#define BIT5 (0x0020)
+#define BIT6 (0x0040)
+#define BIT7 (0x0080)
+#define BIT8 (0x0100)
+#define BIT9 (0x0200)
+#define BITA (0x0400)
+#define BITB (0x0800)
+#define BITC (0x1000)
+#define BITD (0x2000)
+#define BITE (0x4000)
+#define BITF (0x8000)
+
+// Status register bits
+#define GIE (0x0008)
+#define CPUOFF (0x0010)
+#define OSCOFF (0x0020)
+#define SCG0 (0x0040)
+#define SCG1 (0x0080)
+
+#define LPM0_bits (CPUOFF)
+#define LPM1_bits (SCG0 + CPUOFF)
+#define LPM2_bits (SCG1 + CPUOFF)
+#define LPM3_bits (SCG1 + SCG0 + CPUOFF)
+#define LPM4_bits (SCG1 + SCG0 + OSCOFF + CPUOFF)
+
+// Special function registers (0x0100)
+#define SFRIFG1 MSP430HOST_SFR16(0x0102)
+#define OFIFG (0x0002)
+
+// Power management module (0x0120, PMMCTL0_H takes the PMMPW_H password; PMMCTL0_L and SVSMLCTL writes raise the PMMIFG
+// delay and level flags at once, the core voltage settles immediately)
+#define PMMCTL0 MSP430HOST_SFR16(0x0120)
+#define PMMCTL0_L MSP430HOST_ACTIVE8(0x0120)
+#define PMMCTL0_H MSP430HOST_SFR8(0x0121)
+#define SVSMHCTL MSP430HOST_SFR16(0x0124)
+#define SVSMLCTL MSP430HOST_ACTIVE16(0x0126)
+#define PMMIFG MSP430HOST_SFR16(0x012C)
+#define PMMPW_H (0xA5)
+#define PMMCOREV0 (0x0001)
+#define PMMCOREV_3 (0x0003)
+#define SVSMHRRL0 (0x0001)
+#define SVSHRVL0 (0x0100)
+#define SVSHE (0x0400)
+#define SVMHE (0x4000)
+#define SVSMLRRL0 (0x0001)
+#define SVSMLRRL_7 (0x0007)
+#define SVSLRVL0 (0x0100)
+#define SVSLE (0x0400)
+#define SVMLE (0x4000)
+#define SVSMLDLYIFG (0x0001)
+#define SVMLIFG (0x0002)
+#define SVMLVLRIFG (0x0004)
+
+// Watchdog timer
+#define WDTCTL MSP430HOST_SFR16(0x015C)
+#define WDTPW (0x5A00)
+#define WDTHOLD (0x0080)
+
+// Unified clock system (0x0160, UCSCTLx at 0x0160 + 2 * x)
+#define UCSCTL0 MSP430HOST_SFR16(0x0160)
+#define UCSCTL1 MSP430HOST_SFR16(0x0162)
+#define UCSCTL2 MSP430HOST_SFR16(0x0164)
+#define UCSCTL3 MSP430HOST_SFR16(0x0166)
+#define UCSCTL4 MSP430HOST_SFR16(0x0168)
+#define UCSCTL5 MSP430HOST_SFR16(0x016A)
+#define UCSCTL6 MSP430HOST_SFR16(0x016C)
+#define UCSCTL7 MSP430HOST_SFR16(0x016E)
+#define UCSCTL8 MSP430HOST_SFR16(0x0170)
+#define FLLD_1 (0x1000)
+#define SELREF_2 (0x0020)
+#define SELA_2 (0x0200)
+#define SELS_4 (0x0040)
+#define SELM_4 (0x0004)
+#define DCOFFG (0x0001)
+#define XT1LFOFFG (0x0002)
+#define XT2OFFG (0x0008)
+
+// Digital I/O port pairs (PA = P1/P2, PB = P3/P4, PC = P5/P6, PD = P7/P8)
+#define PAIN MSP430HOST_SFR16(0x0200)
+#define P1IN MSP430HOST_SFR8(0x0200)
+#define P2IN MSP430HOST_SFR8(0x0201)
+#define PAOUT MSP430HOST_SFR16(0x0202)
+#define P1OUT MSP430HOST_SFR8(0x0202)
+#define P2OUT MSP430HOST_SFR8(0x0203)
+#define PADIR MSP430HOST_SFR16(0x0204)
+#define P1DIR MSP430HOST_SFR8(0x0204)
+#define P2DIR MSP430HOST_SFR8(0x0205)
+#define PAREN MSP430HOST_SFR16(0x0206)
+#define P1REN MSP430HOST_SFR8(0x0206)
+#define P2REN MSP430HOST_SFR8(0x0207)
+#define PADS MSP430HOST_SFR16(0x0208)
+#define P1DS MSP430HOST_SFR8(0x0208)
+#define P2DS MSP430HOST_SFR8(0x0209)
+#define PASEL MSP430HOST_SFR16(0x020A)
+#define P1SEL MSP430HOST_SFR8(0x020A)
+#define P2SEL MSP430HOST_SFR8(0x020B)
+#define PAIES MSP430HOST_SFR16(0x0218)
+#define P1IES MSP430HOST_SFR8(0x0218)
+#define P2IES MSP430HOST_SFR8(0x0219)
+#define PAIE MSP430HOST_SFR16(0x021A)
+#define P1IE MSP430HOST_SFR8(0x021A)
+#define P2IE MSP430HOST_SFR8(0x021B)
+#define PAIFG MSP430HOST_SFR16(0x021C)
+#define P1IFG MSP430HOST_SFR8(0x021C)
+#define P2IFG MSP430HOST_SFR8(0x021D)
+
+// Port interrupt vectors (reading PxIV returns the lowest pending and enabled pin and clears its PxIFG bit)
+#define P1IV MSP430HOST_ACTIVE16(0x020E)
+#define P2IV MSP430HOST_ACTIVE16(0x021E)
+#define P1IV_NONE (0x0000)
+#define P1IV_P1IFG0 (0x0002)
+#define P1IV_P1IFG1 (0x0004)
+#define P1IV_P1IFG2 (0x0006)
+#define P1IV_P1IFG3 (0x0008)
+#define P1IV_P1IFG4 (0x000A)
+#define P1IV_P1IFG5 (0x000C)
+#define P1IV_P1IFG6 (0x000E)
+#define P1IV_P1IFG7 (0x0010)
+#define P2IV_NONE (0x0000)
+#define P2IV_P2IFG0 (0x0002)
+#define P2IV_P2IFG1 (0x0004)
+#define P2IV_P2IFG2 (0x0006)
+#define P2IV_P2IFG3 (0x0008)
+#define P2IV_P2IFG4 (0x000A)
+#define P2IV_P2IFG5 (0x000C)
+#define P2IV_P2IFG6 (0x000E)
+#define P2IV_P2IFG7 (0x0010)
+
+#define PBIN MSP430HOST_SFR16(0x0220)
+#define P3IN MSP430HOST_SFR8(0x0220)
+#define P4IN MSP430HOST_SFR8(0x0221)
+#define PBOUT MSP430HOST_SFR16(0x0222)
+#define P3OUT MSP430HOST_SFR8(0x0222)
+#define P4OUT MSP430HOST_SFR8(0x0223)
+#define PBDIR MSP430HOST_SFR16(0x0224)
+#define P3DIR MSP430HOST_SFR8(0x0224)
+#define P4DIR MSP430HOST_SFR8(0x0225)
+#define PBREN MSP430HOST_SFR16(0x0226)
+#define P3REN MSP430HOST_SFR8(0x0226)
+#define P4REN MSP430HOST_SFR8(0x0227)
+#define PBDS MSP430HOST_SFR16(0x0228)
+#define P3DS MSP430HOST_SFR8(0x0228)
+#define P4DS MSP430HOST_SFR8(0x0229)
+#define PBSEL MSP430HOST_SFR16(0x022A)
+#define P3SEL MSP430HOST_SFR8(0x022A)
+#define P4SEL MSP430HOST_SFR8(0x022B)
+
+#define PCIN MSP430HOST_SFR16(0x0240)
+#define P5IN MSP430HOST_SFR8(0x0240)
+#define P6IN MSP430HOST_SFR8(0x0241)
+#define PCOUT MSP430HOST_SFR16(0x0242)
+#define P5OUT MSP430HOST_SFR8(0x0242)
+#define P6OUT MSP430HOST_SFR8(0x0243)
+#define PCDIR MSP430HOST_SFR16(0x0244)
+#define P5DIR MSP430HOST_SFR8(0x0244)
+#define P6DIR MSP430HOST_SFR8(0x0245)
+#define PCREN MSP430HOST_SFR16(0x0246)
+#define P5REN MSP430HOST_SFR8(0x0246)
+#define P6REN MSP430HOST_SFR8(0x0247)
+#define PCDS MSP430HOST_SFR16(0x0248)
+#define P5DS MSP430HOST_SFR8(0x0248)
+#define P6DS MSP430HOST_SFR8(0x0249)
+#define PCSEL MSP430HOST_SFR16(0x024A)
+#define P5SEL MSP430HOST_SFR8(0x024A)
+#define P6SEL MSP430HOST_SFR8(0x024B)
+
+#define PDIN MSP430HOST_SFR16(0x0260)
+#define P7IN MSP430HOST_SFR8(0x0260)
+#define P8IN MSP430HOST_SFR8(0x0261)
+#define PDOUT MSP430HOST_SFR16(0x0262)
+#define P7OUT MSP430HOST_SFR8(0x0262)
+#define P8OUT MSP430HOST_SFR8(0x0263)
+#define PDDIR MSP430HOST_SFR16(0x0264)
+#define P7DIR MSP430HOST_SFR8(0x0264)
+#define P8DIR MSP430HOST_SFR8(0x0265)
+#define PDREN MSP430HOST_SFR16(0x0266)
+#define P7REN MSP430HOST_SFR8(0x0266)
+#define P8REN MSP430HOST_SFR8(0x0267)
+#define PDDS MSP430HOST_SFR16(0x0268)
+#define P7DS MSP430HOST_SFR8(0x0268)
+#define P8DS MSP430HOST_SFR8(0x0269)
+#define PDSEL MSP430HOST_SFR16(0x026A)
+#define P7SEL MSP430HOST_SFR8(0x026A)
+#define P8SEL MSP430HOST_SFR8(0x026B)
+
+// Timer_A/Timer_B (TA0 = 0x0340, TA1 = 0x0380, TB0 = 0x03C0, TA2 = 0x0400)
+#define TA0CTL MSP430HOST_SFR16(0x0340)
+#define TA0CCTL0 MSP430HOST_SFR16(0x0342)
+#define TA0CCTL1 MSP430HOST_SFR16(0x0344)
+#define TA0CCTL2 MSP430HOST_SFR16(0x0346)
+#define TA0CCTL3 MSP430HOST_SFR16(0x0348)
+#define TA0CCTL4 MSP430HOST_SFR16(0x034A)
+#define TA0R MSP430HOST_SFR16(0x0350)
+#define TA0CCR0 MSP430HOST_SFR16(0x0352)
+#define TA0CCR1 MSP430HOST_SFR16(0x0354)
+#define TA0CCR2 MSP430HOST_SFR16(0x0356)
+#define TA0CCR3 MSP430HOST_SFR16(0x0358)
+#define TA0CCR4 MSP430HOST_SFR16(0x035A)
+#define TA0EX0 MSP430HOST_SFR16(0x0360)
+#define TA0IV MSP430HOST_SFR16(0x036E)
+
+#define TA1CTL MSP430HOST_SFR16(0x0380)
+#define TA1CCTL0 MSP430HOST_SFR16(0x0382)
+#define TA1CCTL1 MSP430HOST_SFR16(0x0384)
+#define TA1CCTL2 MSP430HOST_SFR16(0x0386)
+#define TA1R MSP430HOST_SFR16(0x0390)
+#define TA1CCR0 MSP430HOST_SFR16(0x0392)
+#define TA1CCR1 MSP430HOST_SFR16(0x0394)
+#define TA1CCR2 MSP430HOST_SFR16(0x0396)
+#define TA1EX0 MSP430HOST_SFR16(0x03A0)
+#define TA1IV MSP430HOST_SFR16(0x03AE)
+
+#define TB0CTL MSP430HOST_SFR16(0x03C0)
+#define TB0CCTL0 MSP430HOST_SFR16(0x03C2)
+#define TB0CCTL1 MSP430HOST_SFR16(0x03C4)
+#define TB0CCTL2 MSP430HOST_SFR16(0x03C6)
+#define TB0CCTL3 MSP430HOST_SFR16(0x03C8)
+#define TB0CCTL4 MSP430HOST_SFR16(0x03CA)
+#define TB0CCTL5 MSP430HOST_SFR16(0x03CC)
+#define TB0CCTL6 MSP430HOST_SFR16(0x03CE)
+#define TB0R MSP430HOST_SFR16(0x03D0)
+#define TB0CCR0 MSP430HOST_SFR16(0x03D2)
+#define TB0CCR1 MSP430HOST_SFR16(0x03D4)
+#define TB0CCR2 MSP430HOST_SFR16(0x03D6)
+#define TB0CCR3 MSP430HOST_SFR16(0x03D8)
+#define TB0CCR4 MSP430HOST_SFR16(0x03DA)
+#define TB0CCR5 MSP430HOST_SFR16(0x03DC)
+#define TB0CCR6 MSP430HOST_SFR16(0x03DE)
+#define TB0EX0 MSP430HOST_SFR16(0x03E0)
+#define TB0IV MSP430HOST_SFR16(0x03EE)
+
+#define TA2CTL MSP430HOST_SFR16(0x0400)
+#define TA2CCTL0 MSP430HOST_SFR16(0x0402)
+#define TA2CCTL1 MSP430HOST_SFR16(0x0404)
+#define TA2CCTL2 MSP430HOST_SFR16(0x0406)
+#define TA2R MSP430HOST_SFR16(0x0410)
+#define TA2CCR0 MSP430HOST_SFR16(0x0412)
+#define TA2CCR1 MSP430HOST_SFR16(0x0414)
+#define TA2CCR2 MSP430HOST_SFR16(0x0416)
+#define TA2EX0 MSP430HOST_SFR16(0x0420)
+#define TA2IV MSP430HOST_SFR16(0x042E)
+
+#define TASSEL_0 (0x0000)
+#define TASSEL_1 (0x0100)
+#define TASSEL_2 (0x0200)
+#define TASSEL_3 (0x0300)
+#define ID_0 (0x0000)
+#define ID_1 (0x0040)
+#define ID_2 (0x0080)
+#define ID_3 (0x00C0)
+#define MC_0 (0x0000)
+#define MC_1 (0x0010)
+#define MC_2 (0x0020)
+#define MC_3 (0x0030)
+#define TACLR (0x0004)
+#define TAIE (0x0002)
+#define TAIFG (0x0001)
+#define CM_0 (0x0000)
+#define CM_1 (0x4000)
+#define CM_2 (0x8000)
+#define CM_3 (0xC000)
+#define CCIS_0 (0x0000)
+#define CCIS_1 (0x1000)
+#define CCIS_2 (0x2000)
+#define CCIS_3 (0x3000)
+#define SCS (0x0800)
+#define SCCI (0x0400)
+#define CAP (0x0100)
+#define OUTMOD_0 (0x0000)
+#define OUTMOD_1 (0x0020)
+#define OUTMOD_2 (0x0040)
+#define OUTMOD_3 (0x0060)
+#define OUTMOD_4 (0x0080)
+#define OUTMOD_5 (0x00A0)
+#define OUTMOD_6 (0x00C0)
+#define OUTMOD_7 (0x00E0)
+#define CLLD_0 (0x0000)
+#define CLLD_1 (0x0200)
+#define CLLD_2 (0x0400)
+#define CLLD_3 (0x0600)
+#define CCIE (0x0010)
+#define CCI (0x0008)
+#define OUT (0x0004)
+#define COV (0x0002)
+#define CCIFG (0x0001)
+
+// 32-bit hardware multiplier (0x04C0; an OP2 write multiplies, RESx reads apply MPYFRAC/MPYSAT to the raw result)
+#define MPY MSP430HOST_ACTIVE16(0x04C0)
+#define MPYS MSP430HOST_ACTIVE16(0x04C2)
+#define MAC MSP430HOST_ACTIVE16(0x04C4)
+#define MACS MSP430HOST_ACTIVE16(0x04C6)
+#define OP2 MSP430HOST_ACTIVE16(0x04C8)
+#define RESLO MSP430HOST_ACTIVE16(0x04CA)
+#define RESHI MSP430HOST_ACTIVE16(0x04CC)
+#define SUMEXT MSP430HOST_SFR16(0x04CE)
+#define MPY32L MSP430HOST_ACTIVE16(0x04D0)
+#define MPY32H MSP430HOST_ACTIVE16(0x04D2)
+#define MPYS32L MSP430HOST_ACTIVE16(0x04D4)
+#define MPYS32H MSP430HOST_ACTIVE16(0x04D6)
+#define MAC32L MSP430HOST_ACTIVE16(0x04D8)
+#define MAC32H MSP430HOST_ACTIVE16(0x04DA)
+#define MACS32L MSP430HOST_ACTIVE16(0x04DC)
+#define MACS32H MSP430HOST_ACTIVE16(0x04DE)
+#define OP2L MSP430HOST_SFR16(0x04E0)
+#define OP2H MSP430HOST_SFR16(0x04E2)
+#define RES0 MSP430HOST_ACTIVE16(0x04E4)
+#define RES1 MSP430HOST_ACTIVE16(0x04E6)
+#define RES2 MSP430HOST_ACTIVE16(0x04E8)
+#define RES3 MSP430HOST_ACTIVE16(0x04EA)
+#define MPY32CTL0 MSP430HOST_SFR16(0x04EC)
+
+#define MPYC (0x0001)
+#define MPYFRAC (0x0004)
+#define MPYSAT (0x0008)
+#define MPYM0 (0x0010)
+#define MPYM1 (0x0020)
+#define OP1_32 (0x0040)
+#define OP2_32 (0x0080)
+#define MPYDLYWRTEN (0x0100)
+#define MPYDLY32 (0x0200)
+
+// DMA controller (0x0500, channel n at 0x0510 + 0x10 * n: CTL, SA (20-bit), DA (20-bit), SZ)
+#define DMACTL0 MSP430HOST_SFR16(0x0500)
+#define DMACTL1 MSP430HOST_SFR16(0x0502)
+#define DMACTL2 MSP430HOST_SFR16(0x0504)
+#define DMACTL3 MSP430HOST_SFR16(0x0506)
+#define DMACTL4 MSP430HOST_SFR16(0x0508)
+#define DMAIV MSP430HOST_SFR16(0x050E)
+
+#define DMA0CTL MSP430HOST_SFR16(0x0510)
+#define DMA0SAL MSP430HOST_SFR16(0x0512)
+#define DMA0DAL MSP430HOST_SFR16(0x0516)
+#define DMA0SZ MSP430HOST_SFR16(0x051A)
+#define DMA1CTL MSP430HOST_SFR16(0x0520)
+#define DMA1SAL MSP430HOST_SFR16(0x0522)
+#define DMA1DAL MSP430HOST_SFR16(0x0526)
+#define DMA1SZ MSP430HOST_SFR16(0x052A)
+#define DMA2CTL MSP430HOST_SFR16(0x0530)
+#define DMA2SAL MSP430HOST_SFR16(0x0532)
+#define DMA2DAL MSP430HOST_SFR16(0x0536)
+#define DMA2SZ MSP430HOST_SFR16(0x053A)
+
+#define DMARMWDIS (0x0004)
+#define DMADT_0 (0x0000)
+#define DMADT_1 (0x1000)
+#define DMADT_2 (0x2000)
+#define DMADT_4 (0x4000)
+#define DMADT_5 (0x5000)
+#define DMADT_6 (0x6000)
+#define DMADT_7 (0x7000)
+#define DMADSTINCR_0 (0x0000)
+#define DMADSTINCR_2 (0x0800)
+#define DMADSTINCR_3 (0x0C00)
+#define DMASRCINCR_0 (0x0000)
+#define DMASRCINCR_2 (0x0200)
+#define DMASRCINCR_3 (0x0300)
+#define DMADSTBYTE (0x0080)
+#define DMASRCBYTE (0x0040)
+#define DMALEVEL (0x0020)
+#define DMAEN (0x0010)
+#define DMAIFG (0x0008)
+#define DMAIE (0x0004)
+#define DMAABORT (0x0002)
+#define DMAREQ (0x0001)
+
+// USCI_A (UCA0 = 0x05C0, UCA1 = 0x0600; CTL1 is the low byte of CTLW0, IE the low byte of ICTL)
+#define UCA0CTLW0 MSP430HOST_SFR16(0x05C0)
+#define UCA0CTL1 MSP430HOST_SFR8(0x05C0)
+#define UCA0CTL0 MSP430HOST_SFR8(0x05C1)
+#define UCA0BRW MSP430HOST_SFR16(0x05C6)
+#define UCA0BR0 MSP430HOST_SFR8(0x05C6)
+#define UCA0BR1 MSP430HOST_SFR8(0x05C7)
+#define UCA0MCTL MSP430HOST_SFR8(0x05C8)
+#define UCA0STAT MSP430HOST_SFR8(0x05CA)
+#define UCA0RXBUF MSP430HOST_SFR8(0x05CC)
+#define UCA0TXBUF MSP430HOST_SFR8(0x05CE)
+#define UCA0IE MSP430HOST_SFR8(0x05DC)
+#define UCA0IFG MSP430HOST_SFR8(0x05DD)
+#define UCA0IV MSP430HOST_SFR16(0x05DE)
+
+#define UCA1CTLW0 MSP430HOST_SFR16(0x0600)
+#define UCA1CTL1 MSP430HOST_SFR8(0x0600)
+#define UCA1CTL0 MSP430HOST_SFR8(0x0601)
+#define UCA1BRW MSP430HOST_SFR16(0x0606)
+#define UCA1BR0 MSP430HOST_SFR8(0x0606)
+#define UCA1BR1 MSP430HOST_SFR8(0x0607)
+#define UCA1MCTL MSP430HOST_SFR8(0x0608)
+#define UCA1STAT MSP430HOST_SFR8(0x060A)
+#define UCA1RXBUF MSP430HOST_SFR8(0x060C)
+#define UCA1TXBUF MSP430HOST_SFR8(0x060E)
+#define UCA1IE MSP430HOST_SFR8(0x061C)
+#define UCA1IFG MSP430HOST_SFR8(0x061D)
+#define UCA1IV MSP430HOST_SFR16(0x061E)
+
+#define UCSSEL_0 (0x00)
+#define UCSSEL_1 (0x40)
+#define UCSSEL_2 (0x80)
+#define UCSSEL_3 (0xC0)
+#define UCRXEIE (0x20)
+#define UCBRKIE (0x10)
+#define UCSWRST (0x01)
+#define UCOS16 (0x01)
+#define UCFE (0x40)
+#define UCOE (0x20)
+#define UCPE (0x10)
+#define UCBRK (0x08)
+#define UCRXERR (0x04)
+#define UCBUSY (0x01)
+#define UCTXIE (0x02)
+#define UCRXIE (0x01)
+#define UCTXIFG (0x02)
+#define UCRXIFG (0x01)
+#define USCI_NONE (0x0000)
+#define USCI_UCRXIFG (0x0002)
+#define USCI_UCTXIFG (0x0004)
+
+// ADC12_A (0x0700; ADC12MCTLx bytes at 0x0710 + x, ADC12MEMx words at 0x0720 + 2 * x)
+#define ADC12CTL0 MSP430HOST_SFR16(0x0700)
+#define ADC12CTL1 MSP430HOST_SFR16(0x0702)
+#define ADC12CTL2 MSP430HOST_SFR16(0x0704)
+#define ADC12IFG MSP430HOST_SFR16(0x070A)
+#define ADC12IE MSP430HOST_SFR16(0x070C)
+#define ADC12IV MSP430HOST_SFR16(0x070E)
+#define ADC12MCTL0 MSP430HOST_SFR8(0x0710)
+#define ADC12MEM0 MSP430HOST_SFR16(0x0720)
+
+#define ADC12SHT0_0 (0x0000)
+#define ADC12SHT0_1 (0x0100)
+#define ADC12SHT0_2 (0x0200)
+#define ADC12SHT0_3 (0x0300)
+#define ADC12SHT1_0 (0x0000)
+#define ADC12SHT1_1 (0x1000)
+#define ADC12SHT1_2 (0x2000)
+#define ADC12SHT1_3 (0x3000)
+#define ADC12MSC (0x0080)
+#define ADC12REF2_5V (0x0040)
+#define ADC12REFON (0x0020)
+#define ADC12ON (0x0010)
+#define ADC12ENC (0x0002)
+#define ADC12SC (0x0001)
+#define ADC12SHS_0 (0x0000)
+#define ADC12SHS_1 (0x0400)
+#define ADC12SHS_2 (0x0800)
+#define ADC12SHS_3 (0x0C00)
+#define ADC12SHP (0x0200)
+#define ADC12SSEL_0 (0x0000)
+#define ADC12CONSEQ_0 (0x0000)
+#define ADC12CONSEQ_1 (0x0002)
+#define ADC12CONSEQ_2 (0x0004)
+#define ADC12CONSEQ_3 (0x0006)
+#define ADC12BUSY (0x0001)
+#define ADC12RES_2 (0x0020)
+#define ADC12EOS (0x80)
+
+// Intrinsic functions
+/// <summary>Simulated status register (GIE and low-power mode bits)</summary>
+extern volatile unsigned short MSP430Host_StatusRegister;
+/// <summary>Status register saved on interrupt entry (restored on interrupt exit)</summary>
+extern volatile unsigned short MSP430Host_InterruptedStatusRegister;
+/// <summary>Total cycles requested by __delay_cycles()</summary>
+extern volatile unsigned long long MSP430Host_DelayedCycles;
+/// <summary>Low-power mode entry (CPUOFF set, defined by msp430cp_host.cpp: interrupts raised during the sleep may exit it)</summary>
+void MSP430Host_Sleep(void);
+/// <summary>Cycle delay (defined by msp430cp_host.cpp: the external circuit may follow the outputs)</summary>
+void MSP430Host_Delay(void);
+
+inline void __no_operation(void) {}
+inline void __enable_interrupt(void) { MSP430Host_StatusRegister |= GIE; }
+inline void __disable_interrupt(void) { MSP430Host_StatusRegister &= ~GIE; }
+inline unsigned short __get_SR_register(void) { return MSP430Host_StatusRegister; }
+inline void __bis_SR_register(unsigned short bits) { MSP430Host_StatusRegister |= bits; if (bits & CPUOFF) { MSP430Host_Sleep(); } }
+inline void __bic_SR_register(unsigned short bits) { MSP430Host_StatusRegister &= ~bits; }
+inline void __bis_SR_register_on_exit(unsigned short bits) { MSP430Host_InterruptedStatusRegister |= bits; }
+inline void __bic_SR_register_on_exit(unsigned short bits) { MSP430Host_InterruptedStatusRegister &= ~bits; }
+inline void __delay_cycles(unsigned long cycles) { MSP430Host_DelayedCycles += cycles; MSP430Host_Delay(); }
+
+#define __even_in_range(VAL, RANGE) (VAL)
@@ -0,0 +1,342 @@
+#include <msp430.h>
+#include <stdint.h>
+#include "msp430cp_device.h"
+#include "msp430cp_host.h"
+#include "msp430cp_gpio_interrupt.h"
+
+// Simulated register file
+alignas(2) volatile unsigned char MSP430Host_RegisterFile[MSP430HOST_REGISTER_FILE_SIZE];
+volatile unsigned short MSP430Host_StatusRegister = 0;
+volatile unsigned short MSP430Host_InterruptedStatusRegister = 0;
+volatile unsigned long long MSP430Host_DelayedCycles = 0;
+
+// Hardware multiplier emulation state
+/// <summary>Operand 1 as written (low word, and high word of the 32-bit operand registers)</summary>
+static unsigned long multiplierOperand1 = 0;
+/// <summary>Operation of the last operand 1 write (bit 0: signed, bit 1: accumulate)</summary>
+static unsigned int multiplierOperation = 0;
+/// <summary>Operand 1 is 32-bit (its high word was written)</summary>
+static bool multiplierWide = false;
+/// <summary>The last multiplication was signed</summary>
+static bool multiplierSigned = false;
+/// <summary>Raw result RES3:RES2:RES1:RES0 (before the fractional shift and the saturation of the read-out)</summary>
+static unsigned long long multiplierResult = 0;
+/// <summary>Exact sum of the last 16 x 16 operation (before the 32-bit wrap, for the saturation of the read-out)</summary>
+static long long multiplierSum = 0;
+
+// GPIO registers
+extern REG_8b const PxIN[GPIO_PORT_COUNT];
+extern REG_8b const PxOUT[GPIO_PORT_COUNT];
+extern REG_8b const PxDIR[GPIO_PORT_COUNT];
+extern REG_8b const PxREN[GPIO_PORT_COUNT];
+extern REG_8b const PxIE[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIFG[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIES[GPIO_PORT_SUPPORT_INT_COUNT];
+
+#ifndef GPIO_PORT_USER_ISR
+void (*MSP430_Host::portVector[GPIO_PORT_SUPPORT_INT_COUNT])(void) = { MSP430_GPIO_Port1_ISR, MSP430_GPIO_Port2_ISR };
+#else
+void (*MSP430_Host::portVector[GPIO_PORT_SUPPORT_INT_COUNT])(void) = { };
+#endif
+void (*MSP430_Host::sleepHook)(void) = nullptr;
+unsigned int MSP430_Host::sleepCount = 0;
+unsigned int MSP430_Host::missedWakeCount = 0;
+void (*MSP430_Host::delayHook)(void) = nullptr;
+unsigned char MSP430_Host::drivenMask[GPIO_PORT_COUNT];
+unsigned char MSP430_Host::drivenLevel[GPIO_PORT_COUNT];
+
+/// <summary>Reset the whole register file to zero and release all external drivers</summary>
+void MSP430_Host::Reset(void)
+{
+	for (int i = 0; i < MSP430HOST_REGISTER_FILE_SIZE; i++)
+	{
+		MSP430Host_RegisterFile[i] = 0;
+	}
+
+	for (int i = 0; i < GPIO_PORT_COUNT; i++)
+	{
+		drivenMask[i] = 0;
+		drivenLevel[i] = 0;
+	}
+
+	MSP430Host_StatusRegister = 0;
+	MSP430Host_InterruptedStatusRegister = 0;
+	MSP430Host_DelayedCycles = 0;
+	MSP430_WakeRequest = false;
+	sleepHook = nullptr;
+	sleepCount = 0;
+	missedWakeCount = 0;
+	delayHook = nullptr;
+	multiplierOperand1 = 0;
+	multiplierOperation = 0;
+	multiplierWide = false;
+	multiplierSigned = false;
+	multiplierResult = 0;
+	multiplierSum = 0;
+}
+
+/// <summary>
+/// Propagate output, external and resistor levels into PxIN and latch the interrupt flags on edges,
+/// then call the port interrupt vectors with pending and enabled flags (when GIE is set)
+/// </summary>
+void MSP430_Host::Update(void)
+{
+	for (int i = 0; i < GPIO_PORT_COUNT; i++)
+	{
+		unsigned char previous = REG_R(PxIN[i]);
+		unsigned char output = REG_R(PxDIR[i]);
+		unsigned char input = ~output;
+		unsigned char driven = input & drivenMask[i];
+		unsigned char pulled = input & ~drivenMask[i] & REG_R(PxREN[i]);
+		unsigned char floating = input & ~drivenMask[i] & ~REG_R(PxREN[i]);
+
+		// Output pins read back PxOUT, pulled pins read the resistor direction (selected by PxOUT)
+		unsigned char level = (REG_R(PxOUT[i]) & (output | pulled)) | (drivenLevel[i] & driven) | (previous & floating);
+		REG_W(PxIN[i], level);
+
+		// Latch the interrupt flags on selected edges
+		if (i < GPIO_PORT_SUPPORT_INT_COUNT)
+		{
+			unsigned char posedge = ~previous & level;
+			unsigned char negedge = previous & ~level;
+			unsigned char ies = REG_R(PxIES[i]);
+			*PxIFG[i] |= (posedge & ~ies) | (negedge & ies);
+		}
+	}
+
+	// Enter the port interrupts (GIE is cleared during the service routine like on the device)
+	for (int i = 0; i < GPIO_PORT_SUPPORT_INT_COUNT; i++)
+	{
+		if ((MSP430Host_StatusRegister & GIE) && (REG_R(PxIFG[i]) & REG_R(PxIE[i])) && portVector[i])
+		{
+			Interrupt(portVector[i]);
+		}
+	}
+}
+
+/// <summary>
+/// Enter an interrupt service routine like the device: the status register is stacked, GIE and the low-power bits are cleared
+/// during the routine, and the stacked value (changed by __bic_SR_register_on_exit()) is restored on exit
+/// </summary>
+/// <param name="vector">Interrupt service routine</param>
+void MSP430_Host::Interrupt(void (*vector)(void))
+{
+	unsigned short interrupted = MSP430Host_InterruptedStatusRegister;
+	MSP430Host_InterruptedStatusRegister = MSP430Host_StatusRegister;
+	MSP430Host_StatusRegister &= ~(GIE | LPM4_bits);
+	vector();
+	MSP430Host_StatusRegister = MSP430Host_InterruptedStatusRegister;
+	MSP430Host_InterruptedStatusRegister = interrupted;
+}
+
+/// <summary>Low-power mode entry: run the sleep hook, then return to active mode (counted as missed when no interrupt exited the sleep)</summary>
+void MSP430Host_Sleep(void)
+{
+	MSP430_Host::sleepCount++;
+	if (MSP430_Host::sleepHook)
+	{
+		MSP430_Host::sleepHook();
+	}
+	if (MSP430Host_StatusRegister & CPUOFF)
+	{
+		MSP430_Host::missedWakeCount++;
+		MSP430Host_StatusRegister &= ~LPM4_bits;
+	}
+}
+
+/// <summary>Cycle delay: run the delay hook (the external circuit follows the outputs)</summary>
+void MSP430Host_Delay(void)
+{
+	if (MSP430_Host::delayHook)
+	{
+		MSP430_Host::delayHook();
+	}
+}
+
+/// <summary>Drive a pin from outside of the device, then update the register file</summary>
+/// <param name="port">GPIO port</param>
+/// <param name="pin">GPIO pin</param>
+/// <param name="value">Driven level (0 for low, other for high)</param>
+void MSP430_Host::DriveInput(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin, MSP430_GPIO_Value value)
+{
+	unsigned char mask = 1 << pin;
+	DrivePort(port, drivenMask[static_cast<int> (port)] | mask, value ? (drivenLevel[static_cast<int> (port)] | mask) : (drivenLevel[static_cast<int> (port)] & ~mask));
+}
+
+/// <summary>Drive a whole port from outside of the device, then update the register file</summary>
+/// <param name="port">GPIO port</param>
+/// <param name="mask">Driven pins mask (1 bit means driven, 0 bit means released)</param>
+/// <param name="value">Driven level of the pins</param>
+void MSP430_Host::DrivePort(MSP430_GPIO_Port port, unsigned char mask, unsigned char value)
+{
+	drivenMask[static_cast<int> (port)] = mask;
+	drivenLevel[static_cast<int> (port)] = value & mask;
+	Update();
+}
+
+/// <summary>Release the external driver of a pin, then update the register file</summary>
+/// <param name="port">GPIO port</param>
+/// <param name="pin">GPIO pin</param>
+void MSP430_Host::ReleaseInput(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin)
+{
+	unsigned char mask = 1 << pin;
+	DrivePort(port, drivenMask[static_cast<int> (port)] & ~mask, drivenLevel[static_cast<int> (port)]);
+}
+
+/// <summary>Run the multiplication started by an OP2 write (16-bit operand 2 only)</summary>
+static void Multiply(void)
+{
+	bool isSigned = (multiplierOperation & 1) != 0;
+	bool accumulate = (multiplierOperation & 2) != 0;
+
+	long long a;
+	if (multiplierWide)
+	{
+		a = isSigned ? static_cast<long long> (static_cast<int32_t> (multiplierOperand1)) : static_cast<long long> (multiplierOperand1);
+	}
+	else
+	{
+		uint16_t low = static_cast<uint16_t> (multiplierOperand1);
+		a = isSigned ? static_cast<long long> (static_cast<int16_t> (low)) : static_cast<long long> (low);
+	}
+	uint16_t op2 = MSP430HOST_SFR16(0x04C8);
+	long long b = isSigned ? static_cast<long long> (static_cast<int16_t> (op2)) : static_cast<long long> (op2);
+	long long product = a * b;
+	multiplierSigned = isSigned;
+
+	if (multiplierWide)
+	{
+		// 64-bit accumulator, SUMEXT holds the sign (signed) or the carry (unsigned)
+		unsigned long long previous = accumulate ? multiplierResult : 0;
+		unsigned long long result = previous + static_cast<unsigned long long> (product);
+		SUMEXT = isSigned ? ((static_cast<long long> (result) < 0) ? 0xFFFF : 0) : ((result < previous) ? 1 : 0);
+		multiplierResult = result;
+		multiplierSum = static_cast<long long> (result);
+		return;
+	}
+
+	// 32-bit accumulator (RES3:RES2 unchanged)
+	long long sum;
+	if (isSigned)
+	{
+		sum = (accumulate ? static_cast<long long> (static_cast<int32_t> (multiplierResult)) : 0) + product;
+		SUMEXT = (sum < 0) ? 0xFFFF : 0;
+	}
+	else
+	{
+		sum = (accumulate ? static_cast<long long> (multiplierResult & 0xFFFFFFFFULL) : 0) + product;
+		SUMEXT = (sum > 0xFFFFFFFFLL) ? 1 : 0;
+	}
+	multiplierResult = (multiplierResult & 0xFFFFFFFF00000000ULL) | (static_cast<unsigned long long> (sum) & 0xFFFFFFFFULL);
+	multiplierSum = sum;
+}
+
+/// <summary>RES3:RES2:RES1:RES0 as read: the raw result shifted left by one in fractional mode, then saturated (signed results)</summary>
+static unsigned long long MultiplierReadout(void)
+{
+	bool fractional = (MPY32CTL0 & MPYFRAC) != 0;
+	bool saturate = multiplierSigned && (MPY32CTL0 & MPYSAT);
+
+	if (multiplierWide)
+	{
+		unsigned long long readout = fractional ? (multiplierResult << 1) : multiplierResult;
+		if (saturate && fractional && ((multiplierResult ^ readout) & 0x8000000000000000ULL))
+		{
+			readout = (multiplierResult & 0x8000000000000000ULL) ? 0x8000000000000000ULL : 0x7FFFFFFFFFFFFFFFULL;
+		}
+		return readout;
+	}
+
+	long long readout = fractional ? (multiplierSum * 2) : multiplierSum;
+	if (saturate)
+	{
+		readout = (readout > INT32_MAX) ? INT32_MAX : (readout < INT32_MIN) ? INT32_MIN : readout;
+	}
+	return (multiplierResult & 0xFFFFFFFF00000000ULL) | (static_cast<unsigned long long> (readout) & 0xFFFFFFFFULL);
+}
+
+/// <summary>Host side of an active register read (returns the value read, e.g. the IV of the highest pending flag)</summary>
+/// <param name="address">Register address</param>
+unsigned short MSP430Host_ReadRegister(unsigned int address)
+{
+	// PxIV: the lowest pending and enabled pin (highest priority) as 2 * (pin + 1), its flag is cleared by the read
+	for (int i = 0; i < GPIO_PORT_SUPPORT_INT_COUNT; i++)
+	{
+		if (address == 0x020E + 0x10 * static_cast<unsigned int> (i))
+		{
+			unsigned char pending = REG_R(PxIFG[i]) & REG_R(PxIE[i]);
+			if (pending == 0)
+			{
+				return 0;
+			}
+			unsigned char bit = pending & (~pending + 1);
+			*PxIFG[i] &= ~bit;
+			return static_cast<unsigned short> ((MSP430_GPIO_Interrupt::LowestPin(bit) + 1) << 1);
+		}
+	}
+
+	// RESLO/RESHI are the 16-bit names of RES0/RES1
+	switch (address)
+	{
+	case 0x04CA: case 0x04E4: return static_cast<unsigned short> (MultiplierReadout());
+	case 0x04CC: case 0x04E6: return static_cast<unsigned short> (MultiplierReadout() >> 16);
+	case 0x04E8: return static_cast<unsigned short> (MultiplierReadout() >> 32);
+	case 0x04EA: return static_cast<unsigned short> (MultiplierReadout() >> 48);
+	}
+	return MSP430HOST_SFR16(address);
+}
+
+/// <summary>Host side of an active register write (called after the value is stored)</summary>
+/// <param name="address">Register address</param>
+void MSP430Host_WriteRegister(unsigned int address)
+{
+	unsigned short value = MSP430HOST_SFR16(address);
+
+	if (address == 0x0126)
+	{
+		// SVSMLCTL: the supervisor delay elapses at once, the monitor flags a core voltage below its new level
+		PMMIFG |= SVSMLDLYIFG;
+		if ((value & SVSMLRRL_7) > (PMMCTL0 & PMMCOREV_3))
+		{
+			PMMIFG |= SVMLIFG;
+		}
+	}
+	else if (address == 0x0120)
+	{
+		// PMMCTL0_L: the core voltage reaches the new level at once
+		PMMIFG |= SVMLIFG | SVMLVLRIFG;
+	}
+	else if (address >= 0x04C0 && address <= 0x04C6)
+	{
+		// MPY, MPYS, MAC, MACS: 16-bit operand 1
+		multiplierOperation = (address - 0x04C0) >> 1;
+		multiplierOperand1 = value;
+		multiplierWide = false;
+	}
+	else if (address >= 0x04D0 && address <= 0x04DE)
+	{
+		// MPY32L/H, MPYS32L/H, MAC32L/H, MACS32L/H: 32-bit operand 1 once its high word is written
+		multiplierOperation = (address - 0x04D0) >> 2;
+		if ((address & 2) == 0)
+		{
+			multiplierOperand1 = value;
+			multiplierWide = false;
+		}
+		else
+		{
+			multiplierOperand1 = (multiplierOperand1 & 0xFFFFUL) | (static_cast<unsigned long> (value) << 16);
+			multiplierWide = true;
+		}
+	}
+	else if (address == 0x04C8)
+	{
+		Multiply();
+	}
+	else if (address == 0x04CA || address == 0x04CC || (address >= 0x04E4 && address <= 0x04EA))
+	{
+		// RESx writes preset the raw result (the fractional shift only applies to reads)
+		unsigned int word = (address < 0x04E4) ? ((address - 0x04CA) >> 1) : ((address - 0x04E4) >> 1);
+		multiplierResult = (multiplierResult & ~(0xFFFFULL << (16 * word))) | (static_cast<unsigned long long> (value) << (16 * word));
+		multiplierSum = multiplierWide ? static_cast<long long> (multiplierResult) : static_cast<long long> (static_cast<int32_t> (multiplierResult));
+	}
+}
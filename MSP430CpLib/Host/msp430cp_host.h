@@ -0,0 +1,80 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_gpio.h"
+
+#ifndef MSP430CP_HOST
+#error "msp430cp_host.h is only available when building against the host-side register file (Host/msp430.h)"
+#endif
+
+/// <summary>
+/// Host-side simulation of the MSP430 device
+/// <para>Holds the external pin stimulus and propagates it into the simulated register file:
+/// PxIN follows PxOUT on output pins, the external level on driven input pins and the pullup/pulldown
+/// (selected by PxOUT) on undriven input pins with PxREN set. Undriven input pins without resistor keep their last level.</para>
+/// <para>On ports with interrupt capability, PxIFG latches on every PxIN edge selected by PxIES, regardless of PxIE.</para>
+/// <para>Reading PxIV returns the lowest pending and enabled pin (2 * (pin + 1), 0 for none) and clears its PxIFG bit.</para>
+/// <para>The PMM settles at once: SVSMLCTL writes raise SVSMLDLYIFG (and SVMLIFG on a monitor level above the core voltage),
+/// PMMCTL0_L writes raise SVMLIFG and SVMLVLRIFG.</para>
+/// <para>An OP2 write runs the multiplication selected by the last operand 1 write (16-bit operand 2 only). RESx hold the raw result,
+/// reads return it shifted left by one in fractional mode (MPYFRAC) and saturated (MPYSAT) like on the device.</para>
+/// <para>When GIE is set (__enable_interrupt()), Update() calls the port interrupt vector of every port with a pending and enabled flag.
+/// The status register is saved and restored around the call, __bic_SR_register_on_exit() changes the restored value.</para>
+/// <para>Entering a low-power mode (__bis_SR_register() with CPUOFF) calls sleepHook, then returns to active mode.
+/// A sleep that no interrupt routine exited is counted in missedWakeCount.</para>
+/// <para>__delay_cycles() calls delayHook: the external circuit follows the outputs (e.g. a keypad matrix with DrivePort()).</para>
+/// <para>NOTE: Register writes made by the library do not propagate by themselves, call Update() before checking PxIN/PxIFG.</para>
+/// </summary>
+class MSP430_Host
+{
+public:
+	/// <summary>Port interrupt vectors (P1/P2), the library dispatcher by default</summary>
+	static void (*portVector[GPIO_PORT_SUPPORT_INT_COUNT])(void);
+	/// <summary>Called when the CPU enters a low-power mode, raises the interrupts of the sleep (e.g. DriveInput())</summary>
+	static void (*sleepHook)(void);
+	/// <summary>Number of low-power mode entries</summary>
+	static unsigned int sleepCount;
+	/// <summary>Number of low-power mode entries no interrupt exited (the device would sleep on, the host returns to active mode)</summary>
+	static unsigned int missedWakeCount;
+	/// <summary>Called by __delay_cycles(), changes the external pin stimulus after the outputs settled (e.g. DrivePort())</summary>
+	static void (*delayHook)(void);
+
+private:
+	/// <summary>External driven pins mask of each port</summary>
+	static unsigned char drivenMask[GPIO_PORT_COUNT];
+	/// <summary>External driven level of each port</summary>
+	static unsigned char drivenLevel[GPIO_PORT_COUNT];
+
+public:
+	// Simulation control
+	/// <summary>Reset the whole register file to zero and release all external drivers</summary>
+	static void Reset(void);
+	/// <summary>
+	/// Propagate output, external and resistor levels into PxIN and latch the interrupt flags on edges,
+	/// then call the port interrupt vectors with pending and enabled flags (when GIE is set)
+	/// </summary>
+	static void Update(void);
+	/// <summary>
+	/// Enter an interrupt service routine like the device: the status register is stacked, GIE and the low-power bits are cleared
+	/// during the routine, and the stacked value (changed by __bic_SR_register_on_exit()) is restored on exit
+	/// </summary>
+	/// <param name="vector">Interrupt service routine</param>
+	static void Interrupt(void (*vector)(void));
+
+	// External pin stimulus
+	/// <summary>Drive a pin from outside of the device, then update the register file</summary>
+	/// <param name="port">GPIO port</param>
+	/// <param name="pin">GPIO pin</param>
+	/// <param name="value">Driven level (0 for low, other for high)</param>
+	static void DriveInput(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin, MSP430_GPIO_Value value);
+	/// <summary>Drive a whole port from outside of the device, then update the register file</summary>
+	/// <param name="port">GPIO port</param>
+	/// <param name="mask">Driven pins mask (1 bit means driven, 0 bit means released)</param>
+	/// <param name="value">Driven level of the pins</param>
+	static void DrivePort(MSP430_GPIO_Port port, unsigned char mask, unsigned char value);
+	/// <summary>Release the external driver of a pin, then update the register file</summary>
+	/// <param name="port">GPIO port</param>
+	/// <param name="pin">GPIO pin</param>
+	static void ReleaseInput(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin);
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdio.h>
+
+// Host test programs
+// Each program links against libmsp430cp_host.a and checks the simulated register file after driver calls.
+// A failed check prints its location, the program returns the number of failed checks (0: passed).
+//
+//     MSP430_Host::Reset();
+//     led.SetHigh();
+//     HOST_CHECK(P1OUT == BIT0);
+//     return HOST_TEST_RESULT();
+
+/// <summary>Number of failed checks of the program</summary>
+static int hostTestFailures = 0;
+
+/// <summary>Check a condition, print its location when it does not hold</summary>
+/// <param name="CONDITION">Condition</param>
+#define HOST_CHECK(CONDITION) \
+	do \
+	{ \
+		if (!(CONDITION)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #CONDITION); \
+			hostTestFailures++; \
+		} \
+	} while (0)
+
+/// <summary>Print the result line and return the number of failed checks</summary>
+#define HOST_TEST_RESULT() (printf("%s: %s\n", __FILE__, hostTestFailures ? "FAILED" : "passed"), hostTestFailures)
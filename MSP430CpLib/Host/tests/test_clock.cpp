@@ -0,0 +1,58 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_delay.h"
+#include "host_test.h"
+
+// The FLL multiplier rounds down: 25 MHz requested gives 762 x 32768 Hz, never above the request
+static_assert(MSP430_Clock::Multiplier == CLOCK_MCLK_FREQUENCY / MSP430_Clock::ReferenceFrequency, "FLL multiplier rounds down");
+static_assert(MSP430_Clock::MCLKFrequency <= CLOCK_MCLK_FREQUENCY, "MCLK is at most the request");
+static_assert(MSP430_Clock::MCLKFrequency + MSP430_Clock::ReferenceFrequency > CLOCK_MCLK_FREQUENCY, "MCLK is within one FLL step");
+
+// Delay cycle counts round up and do not wrap at 32 bits (200 s at MCLK)
+static_assert(MSP430_Delay::CyclesOf(1) == (MSP430_Clock::MCLKFrequency + 999999UL) / 1000000UL, "Cycles round up");
+static_assert(MSP430_Delay::CyclesOf(200000000UL) == MSP430_Clock::MCLKFrequency * 200ULL, "Cycles are 64-bit");
+
+// The PMM steps wait on PMMIFG, raised by the host register file on SVSMLCTL and PMMCTL0_L writes
+int main()
+{
+	MSP430_Host::Reset();
+
+	HOST_CHECK(MSP430_Clock::Initialize());
+	HOST_CHECK(MSP430_Clock::GetCoreVoltage() == MSP430_Clock::CoreVoltage);
+	HOST_CHECK(static_cast<unsigned short> (SVSMLCTL) == (SVSLE | (SVSLRVL0 * MSP430_Clock::CoreVoltage) | SVMLE | (SVSMLRRL0 * MSP430_Clock::CoreVoltage)));
+	HOST_CHECK((PMMIFG & SVSMLDLYIFG) != 0);
+	HOST_CHECK(PMMCTL0_H == 0x00);
+	HOST_CHECK(UCSCTL2 == (FLLD_1 | (MSP430_Clock::Multiplier - 1)));
+	HOST_CHECK(UCSCTL3 == SELREF_2);
+	HOST_CHECK(UCSCTL4 == (SELA_2 | SELS_4 | SELM_4));
+	HOST_CHECK(MSP430Host_DelayedCycles >= MSP430_Clock::SettleCycles);
+
+	MSP430_Clock::SetCoreVoltage(1);
+	HOST_CHECK(MSP430_Clock::GetCoreVoltage() == 1);
+	HOST_CHECK(static_cast<unsigned short> (SVSMLCTL) == (SVSLE | SVSLRVL0 | SVMLE | SVSMLRRL0));
+	MSP430_Clock::SetCoreVoltage(3);
+	HOST_CHECK(MSP430_Clock::GetCoreVoltage() == 3);
+
+	MSP430Host_DelayedCycles = 0;
+	MSP430_Delay::Microseconds<100>();
+	HOST_CHECK(MSP430Host_DelayedCycles == MSP430_Delay::CyclesOf(100));
+
+	// SMCLK is held until every holder released it, a driver hold counts once
+	HOST_CHECK(!MSP430_Clock::IsSMCLKHeld());
+	MSP430_Clock::HoldSMCLK();
+	MSP430_Clock_SMCLKHold hold;
+	hold.Take();
+	hold.Take();
+	MSP430_Clock::ReleaseSMCLK();
+	HOST_CHECK(MSP430_Clock::IsSMCLKHeld());
+	hold.Release();
+	HOST_CHECK(!MSP430_Clock::IsSMCLKHeld());
+	hold.Release();
+	MSP430_Clock::ReleaseSMCLK();
+	MSP430_Clock::HoldSMCLK();
+	HOST_CHECK(MSP430_Clock::IsSMCLKHeld());
+	MSP430_Clock::ReleaseSMCLK();
+	HOST_CHECK(!MSP430_Clock::IsSMCLKHeld());
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,118 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_debounce.h"
+#include "host_test.h"
+
+/// <summary>Take a number of samples</summary>
+/// <return>The last Sample() result</return>
+template <typename Bank>
+static bool SampleTimes(MSP430_GPIO_Debouncer<Bank>& debouncer, unsigned int times)
+{
+	bool sampling = true;
+	for (unsigned int i = 0; i < times; i++)
+	{
+		sampling = debouncer.Sample();
+	}
+	return sampling;
+}
+
+/// <summary>MSP430_GPIO_Debouncer: 4-sample toggle, restart on a bounce, pressed/released masks, interrupt gating</summary>
+static void TestVerticalCounter(void)
+{
+	MSP430_Host::Reset();
+
+	// P1.0-P1.3 with pullups, switches to ground
+	MSP430_GPIO_Bank keys(MSP430_GPIO_Port::P1, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+	keys.SetAccessMask(0, 3);
+	keys.Initialize();
+	keys.SetValue(0x0F);
+	MSP430_Host::Update();
+	MSP430_GPIO_Debouncer<MSP430_GPIO_Bank> debouncer(keys, MSP430_GPIO_ActiveLevel::Low);
+	debouncer.Initialize();
+	HOST_CHECK(debouncer.GetState() == 0x0F);
+	HOST_CHECK(debouncer.GetActive() == 0);
+	HOST_CHECK(P1IE == 0x0F && P1IES == 0x0F);
+
+	// Press P1.1: the handler stops the interrupts, the 4th sample at the new level toggles the pin
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 0);
+	HOST_CHECK(P1IFG == BIT1);
+	debouncer.Wake();
+	HOST_CHECK(P1IE == 0 && P1IFG == 0);
+	HOST_CHECK(SampleTimes(debouncer, 3));
+	HOST_CHECK(debouncer.GetState() == 0x0F);
+	HOST_CHECK(debouncer.TakePressed() == 0);
+	HOST_CHECK(!debouncer.Sample());
+	HOST_CHECK(debouncer.GetState() == 0x0D);
+	HOST_CHECK(debouncer.GetActive() == BIT1);
+	HOST_CHECK(debouncer.TakePressed() == BIT1);
+	HOST_CHECK(debouncer.TakePressed() == 0);
+	HOST_CHECK(debouncer.TakeReleased() == 0);
+	// Re-armed: rising edge for the pressed pin
+	HOST_CHECK(P1IE == 0x0F && P1IES == 0x0D);
+
+	// Release with a bounce: a sample at the old level clears the count (all pins stable, the interrupts are re-armed)
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 1);
+	debouncer.Wake();
+	HOST_CHECK(SampleTimes(debouncer, 3));
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 0);
+	HOST_CHECK(!debouncer.Sample());
+	HOST_CHECK(P1IE == 0x0F && P1IES == 0x0D);
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 1);
+	HOST_CHECK(P1IFG == BIT1);
+	debouncer.Wake();
+	HOST_CHECK(SampleTimes(debouncer, 3));
+	HOST_CHECK(debouncer.GetState() == 0x0D);
+	HOST_CHECK(!debouncer.Sample());
+	HOST_CHECK(debouncer.GetState() == 0x0F);
+	HOST_CHECK(debouncer.TakeReleased() == BIT1);
+	HOST_CHECK(debouncer.TakePressed() == 0);
+
+	// Pins count independently: P1.0 pressed one sample before P1.3 toggles one sample earlier
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 0, 0);
+	debouncer.Wake();
+	HOST_CHECK(debouncer.Sample());
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 3, 0);
+	HOST_CHECK(SampleTimes(debouncer, 3));
+	HOST_CHECK(debouncer.TakePressed() == BIT0);
+	HOST_CHECK(!debouncer.Sample());
+	HOST_CHECK(debouncer.TakePressed() == BIT3);
+	HOST_CHECK(debouncer.GetActive() == (BIT0 | BIT3));
+
+	// Both released at once: one released mask
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, BIT0 | BIT3, BIT0 | BIT3);
+	debouncer.Wake();
+	HOST_CHECK(!SampleTimes(debouncer, 4));
+	HOST_CHECK(debouncer.TakeReleased() == (BIT0 | BIT3));
+	HOST_CHECK(debouncer.GetActive() == 0);
+
+	debouncer.Deinitialize();
+	HOST_CHECK(P1IE == 0);
+}
+
+/// <summary>MSP430_GPIO_Debouncer: active-high pins on a port without interrupts keep sampling</summary>
+static void TestUngated(void)
+{
+	MSP430_Host::Reset();
+
+	MSP430_GPIO_Bank keys(MSP430_GPIO_Port::P3, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+	keys.Initialize();
+	MSP430_Host::Update();
+	MSP430_GPIO_Debouncer<MSP430_GPIO_Bank> debouncer(keys, MSP430_GPIO_ActiveLevel::High);
+	debouncer.Initialize();
+	HOST_CHECK(debouncer.GetState() == 0);
+
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P3, BIT7, BIT7);
+	HOST_CHECK(SampleTimes(debouncer, 4));
+	HOST_CHECK(debouncer.TakePressed() == BIT7);
+	HOST_CHECK(debouncer.Sample());
+	HOST_CHECK(debouncer.GetActive() == BIT7);
+}
+
+int main(void)
+{
+	TestVerticalCounter();
+	TestUngated();
+
+	return HOST_TEST_RESULT();
+}
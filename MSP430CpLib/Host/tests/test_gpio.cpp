@@ -0,0 +1,215 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_gpio_interrupt.h"
+#include "host_test.h"
+
+/// <summary>Pins of the handler calls, in call order</summary>
+static unsigned char calls[8];
+/// <summary>Number of handler calls</summary>
+static unsigned int callCount = 0;
+
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 1)
+{
+	calls[callCount++ & 7] = 0x11;
+}
+
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 5)
+{
+	calls[callCount++ & 7] = 0x15;
+}
+
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 7)
+{
+	calls[callCount++ & 7] = 0x27;
+}
+
+/// <summary>MSP430_GPIO: output, input with resistor, external levels</summary>
+static void TestPin(void)
+{
+	MSP430_Host::Reset();
+
+	MSP430_GPIO led(MSP430_GPIO_Port::P4, 7);
+	led.Initialize();
+	led.SetHigh();
+	MSP430_Host::Update();
+	HOST_CHECK(P4DIR == BIT7);
+	HOST_CHECK(P4OUT == BIT7);
+	HOST_CHECK(led.CheckHigh());
+	led.ReverseValue();
+	MSP430_Host::Update();
+	HOST_CHECK(led.CheckLow());
+
+	MSP430_GPIO button(MSP430_GPIO_Port::P2, 1, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+	button.Initialize();
+	button.SetHigh();
+	MSP430_Host::Update();
+	HOST_CHECK(P2REN == BIT1);
+	HOST_CHECK(button.GetValue() == 1);
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P2, 1, 0);
+	HOST_CHECK(button.GetValue() == 0);
+	MSP430_Host::ReleaseInput(MSP430_GPIO_Port::P2, 1);
+	HOST_CHECK(button.GetValue() == 1);
+
+	button.Deinitialize();
+	HOST_CHECK(P2REN == 0 && P2DIR == 0);
+
+	// No interrupt registers on P3 and above: the interrupt control has no effect
+	led.EnableInterrupt(MSP430_GPIO_InterruptTrig::Negedge);
+	led.ClearInterruptFlag();
+	HOST_CHECK(!led.CheckInterruptFlag());
+	led.DisableInterrupt();
+}
+
+/// <summary>MSP430_GPIO_Bank: masked writes and reads</summary>
+static void TestBank(void)
+{
+	MSP430_Host::Reset();
+
+	P3OUT = 0x81;
+	MSP430_GPIO_Bank bank(MSP430_GPIO_Port::P3, MSP430_GPIO_Direction::Output);
+	bank.SetAccessMask(2, 5);
+	HOST_CHECK(bank.GetAccessMask() == 0x3C);
+	bank.Initialize();
+	HOST_CHECK(P3DIR == 0x3C);
+	bank.SetValue(0xFF);
+	HOST_CHECK(P3OUT == 0xBD);
+	bank.SetValue(0x14);
+	HOST_CHECK(P3OUT == 0x95);
+	bank.ReverseValue();
+	HOST_CHECK(P3OUT == 0xA9);
+	MSP430_Host::Update();
+	HOST_CHECK(bank.GetValue() == 0x28);
+
+	bank.SetDirection(MSP430_GPIO_Direction::Input);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P3, 0xFF, 0x0F);
+	HOST_CHECK(bank.GetValue() == 0x0C);
+}
+
+/// <summary>MSP430_GPIO_WordBank: range masks across the PA byte boundary, one word access for both ports</summary>
+static void TestWordBank(void)
+{
+	MSP430_Host::Reset();
+
+	MSP430_GPIO_WordBank bank(MSP430_GPIO_PortPair::PA, MSP430_GPIO_Direction::Output);
+	bank.SetAccessMask(0, 15);
+	HOST_CHECK(bank.GetAccessMask() == 0xFFFF);
+	bank.SetAccessMask(8, 15);
+	HOST_CHECK(bank.GetAccessMask() == 0xFF00);
+	bank.SetAccessMask(0, 7);
+	HOST_CHECK(bank.GetAccessMask() == 0x00FF);
+	bank.SetAccessMask(15, 15);
+	HOST_CHECK(bank.GetAccessMask() == 0x8000);
+
+	// P1.4-P2.3: the high nibble of P1 and the low nibble of P2
+	bank.SetAccessMask(4, 11);
+	HOST_CHECK(bank.GetAccessMask() == 0x0FF0);
+	P1OUT = 0x0F;
+	P2OUT = 0xF0;
+	P1SEL = P2SEL = 0xFF;
+	P1IE = P2IE = 0xFF;
+	bank.Initialize();
+	HOST_CHECK(P1DIR == 0xF0 && P2DIR == 0x0F);
+	HOST_CHECK(P1SEL == 0x0F && P2SEL == 0xF0);
+	HOST_CHECK(P1IE == 0x0F && P2IE == 0xF0);
+
+	bank.SetValue(0xFFFF);
+	HOST_CHECK(P1OUT == 0xFF && P2OUT == 0xFF);
+	bank.SetValue(0x5A50);
+	HOST_CHECK(P1OUT == 0x5F && P2OUT == 0xFA);
+	HOST_CHECK(PAOUT == 0xFA5F);
+	bank.ClearBits(0x0180);
+	HOST_CHECK(P1OUT == 0x5F && P2OUT == 0xFA);
+	bank.SetBits(0x0180);
+	HOST_CHECK(P1OUT == 0xDF && P2OUT == 0xFB);
+	bank.ReverseValue();
+	HOST_CHECK(P1OUT == 0x2F && P2OUT == 0xF4);
+	MSP430_Host::Update();
+	HOST_CHECK(bank.GetValue() == 0x0420);
+
+	bank.SetDirection(MSP430_GPIO_Direction::Input);
+	HOST_CHECK(P1DIR == 0 && P2DIR == 0);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, 0xFF, 0x9C);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P2, 0xFF, 0x36);
+	HOST_CHECK(bank.GetValue() == 0x0690);
+
+	bank.Deinitialize();
+	HOST_CHECK(PADIR == 0 && PAREN == 0);
+}
+
+/// <summary>PxIFG latches the edges selected by PxIES, with or without PxIE</summary>
+static void TestEdgeLatch(void)
+{
+	MSP430_Host::Reset();
+
+	MSP430_GPIO rising(MSP430_GPIO_Port::P1, 1, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input);
+	MSP430_GPIO falling(MSP430_GPIO_Port::P1, 5, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input);
+	rising.Initialize();
+	falling.Initialize();
+	rising.EnableInterrupt(MSP430_GPIO_InterruptTrig::Posedge);
+	falling.EnableInterrupt(MSP430_GPIO_InterruptTrig::Negedge);
+	HOST_CHECK(P1IES == BIT5);
+	HOST_CHECK(P1IE == (BIT1 | BIT5));
+
+	// GIE clear: the flags stay pending
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, BIT1 | BIT5, BIT1 | BIT5);
+	HOST_CHECK(P1IFG == BIT1);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, BIT1 | BIT5, 0);
+	HOST_CHECK(P1IFG == (BIT1 | BIT5));
+	HOST_CHECK(rising.CheckInterruptFlag() && falling.CheckInterruptFlag());
+	rising.ClearInterruptFlag();
+	HOST_CHECK(P1IFG == BIT5);
+
+	// PxIE clear: still latched
+	falling.ClearInterruptFlag();
+	falling.DisableInterrupt();
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, BIT5, BIT5);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, BIT5, 0);
+	HOST_CHECK(P1IFG == BIT5);
+	HOST_CHECK(callCount == 0);
+}
+
+/// <summary>PxIV reads and the library port ISRs dispatch the pending pins, lowest pin first</summary>
+static void TestVectorDispatch(void)
+{
+	MSP430_Host::Reset();
+	callCount = 0;
+
+	// Reading PxIV returns the lowest pending and enabled pin and clears its flag
+	P1IE = BIT1 | BIT5;
+	P1IFG = BIT0 | BIT1 | BIT5;
+	HOST_CHECK(P1IV == P1IV_P1IFG1);
+	HOST_CHECK(P1IFG == (BIT0 | BIT5));
+	HOST_CHECK(P1IV == P1IV_P1IFG5);
+	HOST_CHECK(P1IV == P1IV_NONE);
+	HOST_CHECK(P1IFG == BIT0);
+
+	// Both P1 edges at once: one ISR entry, both handlers in priority order
+	P1IFG = 0;
+	P1IES = 0;
+	P2IES = BIT7;
+	P2IE = BIT7;
+	__enable_interrupt();
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, BIT1 | BIT5, BIT1 | BIT5);
+	HOST_CHECK(callCount == 2);
+	HOST_CHECK(calls[0] == 0x11 && calls[1] == 0x15);
+	HOST_CHECK(P1IFG == 0);
+	HOST_CHECK(__get_SR_register() & GIE);
+
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P2, 7, 1);
+	HOST_CHECK(callCount == 2);
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P2, 7, 0);
+	HOST_CHECK(callCount == 3 && calls[2] == 0x27);
+	HOST_CHECK(P2IFG == 0);
+	__disable_interrupt();
+}
+
+int main()
+{
+	TestPin();
+	TestBank();
+	TestWordBank();
+	TestEdgeLatch();
+	TestVectorDispatch();
+	return HOST_TEST_RESULT();
+}
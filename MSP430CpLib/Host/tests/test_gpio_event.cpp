@@ -0,0 +1,96 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio_event.h"
+#include "host_test.h"
+
+/// <summary>Event record of a timestamp (P1.0, rising edge)</summary>
+static MSP430_GPIO_Event EventOf(unsigned int timestamp)
+{
+	MSP430_GPIO_Event event;
+	event.source = 0;
+	event.timestamp = timestamp;
+	return event;
+}
+
+/// <summary>MSP430_GPIO_EventQueue: FIFO order across the wrap, overflow counter, both Drain() overloads</summary>
+static void TestRing(void)
+{
+	MSP430_GPIO_EventQueue<4> events;
+	MSP430_GPIO_Event event = { };
+	HOST_CHECK(events.IsEmpty());
+	HOST_CHECK(!events.Pop(event));
+
+	// Move the indexes near the end of the buffer, then fill it across the wrap
+	HOST_CHECK(events.Push(EventOf(1)) && events.Push(EventOf(2)) && events.Push(EventOf(3)));
+	HOST_CHECK(events.Pop(event) && event.timestamp == 1);
+	HOST_CHECK(events.Pop(event) && event.timestamp == 2);
+	HOST_CHECK(events.Push(EventOf(4)) && events.Push(EventOf(5)) && events.Push(EventOf(6)));
+	HOST_CHECK(events.GetCount() == 4);
+
+	// Full: the event is lost and counted, the queued ones are kept
+	HOST_CHECK(!events.Push(EventOf(7)));
+	HOST_CHECK(!events.Push(EventOf(8)));
+	HOST_CHECK(events.GetOverflowCount() == 2);
+	HOST_CHECK(events.GetCount() == 4);
+
+	// Drain into an array, limited by its size
+	MSP430_GPIO_Event taken[3];
+	HOST_CHECK(events.Drain(taken, 3) == 3);
+	HOST_CHECK(taken[0].timestamp == 3 && taken[1].timestamp == 4 && taken[2].timestamp == 5);
+	HOST_CHECK(events.GetCount() == 1);
+
+	// Drain with a handler: every queued event in order, the slots are free after the pass
+	HOST_CHECK(events.Push(EventOf(9)) && events.Push(EventOf(10)));
+	unsigned int order[4] = { };
+	unsigned int count = 0;
+	HOST_CHECK(events.Drain([&](const MSP430_GPIO_Event& e) { order[count++ & 3] = e.timestamp; }) == 3);
+	HOST_CHECK(count == 3 && order[0] == 6 && order[1] == 9 && order[2] == 10);
+	HOST_CHECK(events.IsEmpty());
+	HOST_CHECK(events.Drain(taken, 3) == 0);
+
+	// The indexes run freely past the capacity
+	for (unsigned int i = 0; i < 9; i++)
+	{
+		HOST_CHECK(events.Push(EventOf(100 + i)));
+		HOST_CHECK(events.Pop(event) && event.timestamp == 100 + i);
+	}
+	HOST_CHECK(events.GetOverflowCount() == 2);
+}
+
+/// <summary>MSP430_GPIO_EventQueue: Capture() records the PxIES edge, the port, the pin and the timestamp</summary>
+static void TestCapture(void)
+{
+	MSP430_Host::Reset();
+	MSP430_GPIO_EventQueue<4> events;
+	MSP430_GPIO_Event event = { };
+
+	TA0R = 1234;
+	P2IES = BIT5;
+	HOST_CHECK(events.Capture(MSP430_GPIO_Port::P2, 5, true));
+	HOST_CHECK(P2IES == 0);
+	TA0R = 1300;
+	HOST_CHECK(events.Capture(MSP430_GPIO_Port::P2, 5, true));
+	HOST_CHECK(P2IES == BIT5);
+	HOST_CHECK(events.Capture(MSP430_GPIO_Port::P1, 0));
+	HOST_CHECK(P1IES == 0);
+
+	HOST_CHECK(events.Pop(event));
+	HOST_CHECK(event.GetPort() == MSP430_GPIO_Port::P2 && event.GetPin() == 5);
+	HOST_CHECK(event.GetEdge() == MSP430_GPIO_InterruptTrig::Negedge && event.timestamp == 1234);
+	HOST_CHECK(events.Pop(event));
+	HOST_CHECK(event.GetEdge() == MSP430_GPIO_InterruptTrig::Posedge && event.timestamp == 1300);
+	HOST_CHECK(events.Pop(event));
+	HOST_CHECK(event.GetPort() == MSP430_GPIO_Port::P1 && event.GetPin() == 0);
+
+	// No PxIES on P3 and above: nothing is recorded
+	HOST_CHECK(!events.Capture(MSP430_GPIO_Port::P3, 1));
+	HOST_CHECK(events.IsEmpty() && events.GetOverflowCount() == 0);
+}
+
+int main(void)
+{
+	TestRing();
+	TestCapture();
+
+	return HOST_TEST_RESULT();
+}
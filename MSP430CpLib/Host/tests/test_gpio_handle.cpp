@@ -0,0 +1,92 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio_handle.h"
+#include "host_test.h"
+
+/// <summary>Named port registers of the device, P1 to P8</summary>
+static volatile unsigned char* const outRegisters[8] = { &P1OUT, &P2OUT, &P3OUT, &P4OUT, &P5OUT, &P6OUT, &P7OUT, &P8OUT };
+static volatile unsigned char* const dirRegisters[8] = { &P1DIR, &P2DIR, &P3DIR, &P4DIR, &P5DIR, &P6DIR, &P7DIR, &P8DIR };
+static volatile unsigned char* const renRegisters[8] = { &P1REN, &P2REN, &P3REN, &P4REN, &P5REN, &P6REN, &P7REN, &P8REN };
+static volatile unsigned char* const dsRegisters[8] = { &P1DS, &P2DS, &P3DS, &P4DS, &P5DS, &P6DS, &P7DS, &P8DS };
+static volatile unsigned char* const selRegisters[8] = { &P1SEL, &P2SEL, &P3SEL, &P4SEL, &P5SEL, &P6SEL, &P7SEL, &P8SEL };
+
+/// <summary>Check a register table holds the pin mask on one port and nothing on the others</summary>
+static bool HoldsOnly(volatile unsigned char* const (&registers)[8], unsigned char port, unsigned char mask)
+{
+	for (unsigned char i = 0; i < 8; i++)
+	{
+		if (*registers[i] != ((i == port) ? mask : 0))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/// <summary>MSP430_GPIO_Handle: pair base + odd port byte + register offset reaches the named register of every port</summary>
+static void TestRegisterAddress(void)
+{
+	for (unsigned char port = 0; port < 8; port++)
+	{
+		MSP430_Host::Reset();
+		const unsigned char pin = 7 - port;
+		const unsigned char mask = static_cast<unsigned char> (1 << pin);
+		MSP430_GPIO_Handle handle(static_cast<MSP430_GPIO_Port> (port), pin);
+		HOST_CHECK(handle.GetId() == ((port << 3) | pin));
+		HOST_CHECK(handle.GetMask() == mask);
+
+		handle.Initialize(MSP430_GPIO_Function::Primary, MSP430_GPIO_Direction::Output, MSP430_GPIO_PullResistor::On);
+		HOST_CHECK(HoldsOnly(dirRegisters, port, mask));
+		HOST_CHECK(HoldsOnly(renRegisters, port, mask));
+		HOST_CHECK(HoldsOnly(selRegisters, port, mask));
+		HOST_CHECK(handle.GetDirection() == MSP430_GPIO_Direction::Output);
+		handle.SetDriveStrength(MSP430_GPIO_DriveStrength::Full);
+		HOST_CHECK(HoldsOnly(dsRegisters, port, mask));
+		handle.SetHigh();
+		HOST_CHECK(HoldsOnly(outRegisters, port, mask));
+		handle.ReverseValue();
+		HOST_CHECK(HoldsOnly(outRegisters, port, 0));
+
+		// PxIN: the pin driven from outside, the other pins of the port at the opposite level
+		handle.SetDirection(MSP430_GPIO_Direction::Input);
+		MSP430_Host::DrivePort(static_cast<MSP430_GPIO_Port> (port), 0xFF, mask);
+		HOST_CHECK(handle.CheckHigh() && handle.GetValue() == 1);
+		MSP430_Host::DrivePort(static_cast<MSP430_GPIO_Port> (port), 0xFF, static_cast<unsigned char> (~mask));
+		HOST_CHECK(handle.CheckLow() && handle.GetValue() == 0);
+
+		handle.Deinitialize();
+		HOST_CHECK(HoldsOnly(dirRegisters, port, 0) && HoldsOnly(renRegisters, port, 0) && HoldsOnly(selRegisters, port, 0));
+	}
+}
+
+/// <summary>MSP430_GPIO_Handle: PxIES/PxIE/PxIFG offsets of the odd port of PA</summary>
+static void TestInterruptRegisters(void)
+{
+	MSP430_Host::Reset();
+
+	const MSP430_GPIO_Handle handle(0x13);
+	HOST_CHECK(handle.GetPort() == MSP430_GPIO_Port::P3 && handle.GetPin() == 3);
+
+	const MSP430_GPIO_Handle button(MSP430_GPIO_Port::P2, 6);
+	button.Initialize(MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::Off);
+	button.EnableInterrupt(MSP430_GPIO_InterruptTrig::Negedge);
+	HOST_CHECK(P2IES == BIT6 && P2IE == BIT6);
+	HOST_CHECK(P1IES == 0 && P1IE == 0);
+	HOST_CHECK(!button.CheckInterruptFlag());
+	P2IFG = BIT6;
+	HOST_CHECK(button.CheckInterruptFlag());
+	button.ClearInterruptFlag();
+	HOST_CHECK(P2IFG == 0);
+	button.EnableInterrupt(MSP430_GPIO_InterruptTrig::Posedge);
+	HOST_CHECK(P2IES == 0 && P2IE == BIT6);
+	button.DisableInterrupt();
+	HOST_CHECK(P2IE == 0);
+}
+
+int main(void)
+{
+	TestRegisterAddress();
+	TestInterruptRegisters();
+
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,163 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_keypad.h"
+#include "host_test.h"
+
+/// <summary>Pressed keys of the simulated matrix (bit column of each row, no diodes)</summary>
+static unsigned char matrix[3];
+/// <summary>Reported keys (key index, bit 7 for pressed), in report order</summary>
+static unsigned char reports[8];
+/// <summary>Number of reported keys</summary>
+static unsigned int reportCount = 0;
+
+static void KeyChanged(unsigned char key, bool pressed)
+{
+	reports[reportCount++ & 7] = key | (pressed ? 0x80 : 0);
+}
+
+/// <summary>Delay hook: the driven rows (P6.0-P6.2) pull the columns (P2.0-P2.2) through the pressed keys</summary>
+static void Settle(void)
+{
+	// Without diodes, a pressed key also joins a released row to the columns it touches
+	unsigned char rows = P6DIR & (BIT0 | BIT1 | BIT2);
+	unsigned char low = 0;
+	unsigned char previous;
+	do
+	{
+		previous = low;
+		for (unsigned char row = 0; row < 3; row++)
+		{
+			if ((rows & (1 << row)) || (matrix[row] & low))
+			{
+				rows |= 1 << row;
+				low |= matrix[row];
+			}
+		}
+	} while (low != previous);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P2, low, 0);
+}
+
+/// <summary>Scan until the keys are stable</summary>
+/// <return>Number of scans</return>
+static unsigned int ScanStable(MSP430_Keypad& keypad, MSP430_Keypad_Status& status)
+{
+	unsigned int scans = 0;
+	do
+	{
+		status = keypad.Scan();
+		scans++;
+	} while (status == MSP430_Keypad_Status::Scanning && scans < 10);
+	return scans;
+}
+
+/// <summary>MSP430_Keypad: debounce by identical scans, key reports, re-armed column interrupt</summary>
+static void TestScan(void)
+{
+	MSP430_Host::Reset();
+	MSP430_Host::delayHook = Settle;
+	matrix[0] = matrix[1] = matrix[2] = 0;
+	reportCount = 0;
+
+	MSP430_GPIO_Bank rows(MSP430_GPIO_Port::P6, MSP430_GPIO_Direction::Output);
+	MSP430_GPIO_Bank columns(MSP430_GPIO_Port::P2, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+	rows.SetAccessMask(0, 2);
+	columns.SetAccessMask(0, 2);
+	rows.Initialize();
+	columns.Initialize();
+	MSP430_Keypad keypad(rows, columns, KeyChanged);
+	keypad.Initialize();
+	HOST_CHECK(P6DIR == (BIT0 | BIT1 | BIT2) && (P6OUT & (BIT0 | BIT1 | BIT2)) == 0);
+	HOST_CHECK(P2IE == (BIT0 | BIT1 | BIT2));
+	HOST_CHECK(P2IES == (BIT0 | BIT1 | BIT2));
+
+	// Row 1, column 2: reported after StableScans identical scans
+	matrix[1] = BIT2;
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P2, BIT2, 0);
+	HOST_CHECK(P2IFG == BIT2);
+	keypad.Wake();
+	HOST_CHECK(P2IE == 0 && P2IFG == 0);
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Scanning);
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Scanning);
+	HOST_CHECK(reportCount == 0);
+	HOST_CHECK(P6DIR == (BIT0 | BIT1 | BIT2));
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Held);
+	HOST_CHECK(reportCount == 1 && reports[0] == (0x80 | 5));
+	HOST_CHECK(keypad.IsPressed(5) && !keypad.IsPressed(2));
+	// Held column: rising edge interrupt for its release
+	HOST_CHECK(P2IES == (BIT0 | BIT1));
+	HOST_CHECK(P2IE == (BIT0 | BIT1 | BIT2));
+
+	// A bounce restarts the count
+	matrix[1] = 0;
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Scanning);
+	matrix[1] = BIT2;
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Scanning);
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Scanning);
+	HOST_CHECK(keypad.Scan() == MSP430_Keypad_Status::Held);
+	HOST_CHECK(reportCount == 1);
+
+	// Release: reported, back to idle with the column interrupt armed
+	matrix[1] = 0;
+	MSP430_Keypad_Status status;
+	HOST_CHECK(ScanStable(keypad, status) == MSP430_Keypad::StableScans);
+	HOST_CHECK(status == MSP430_Keypad_Status::Idle);
+	HOST_CHECK(reportCount == 2 && reports[1] == 5);
+	HOST_CHECK(!keypad.IsPressed(5));
+	HOST_CHECK(P2IE == (BIT0 | BIT1 | BIT2) && P2IES == (BIT0 | BIT1 | BIT2));
+
+	keypad.Deinitialize();
+	HOST_CHECK(P2IE == 0);
+}
+
+/// <summary>MSP430_Keypad: three corners of a rectangle read the fourth as pressed, the ghosted scan keeps the previous keys</summary>
+static void TestGhost(void)
+{
+	MSP430_Host::Reset();
+	MSP430_Host::delayHook = Settle;
+	matrix[0] = matrix[1] = matrix[2] = 0;
+	reportCount = 0;
+
+	MSP430_GPIO_Bank rows(MSP430_GPIO_Port::P6, MSP430_GPIO_Direction::Output);
+	MSP430_GPIO_Bank columns(MSP430_GPIO_Port::P2, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+	rows.SetAccessMask(0, 2);
+	columns.SetAccessMask(0, 2);
+	rows.Initialize();
+	columns.Initialize();
+	MSP430_Keypad keypad(rows, columns, KeyChanged);
+	keypad.Initialize();
+
+	// Two keys in one row (n-key rollover)
+	matrix[0] = BIT0 | BIT1;
+	MSP430_Keypad_Status status;
+	ScanStable(keypad, status);
+	HOST_CHECK(status == MSP430_Keypad_Status::Held);
+	HOST_CHECK(reportCount == 2 && reports[0] == (0x80 | 0) && reports[1] == (0x80 | 1));
+	HOST_CHECK(!keypad.IsGhosted());
+
+	// Row 1, column 0: row 1 reads columns 0 and 1 through the keys of row 0
+	matrix[1] = BIT0;
+	ScanStable(keypad, status);
+	HOST_CHECK(status == MSP430_Keypad_Status::Held);
+	HOST_CHECK(keypad.IsGhosted());
+	HOST_CHECK(reportCount == 2);
+	HOST_CHECK(keypad.IsPressed(0) && keypad.IsPressed(1));
+	HOST_CHECK(!keypad.IsPressed(3) && !keypad.IsPressed(4));
+
+	// Release the second corner: the rectangle is gone, the new key is reported
+	matrix[0] = BIT0;
+	ScanStable(keypad, status);
+	HOST_CHECK(!keypad.IsGhosted());
+	HOST_CHECK(reportCount == 4 && reports[2] == 1 && reports[3] == (0x80 | 3));
+	HOST_CHECK(keypad.IsPressed(0) && keypad.IsPressed(3) && !keypad.IsPressed(1));
+
+	keypad.Deinitialize();
+}
+
+int main(void)
+{
+	TestScan();
+	TestGhost();
+
+	return HOST_TEST_RESULT();
+}
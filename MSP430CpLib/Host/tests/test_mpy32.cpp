@@ -0,0 +1,88 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_mpy32.h"
+#include "host_test.h"
+
+// Q15 kernels run in the fractional mode: the raw sum is read shifted left by one, so presets are written at half weight
+static void TestDotProduct(void)
+{
+	static const MSP430_Q15 a[3] = { MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(0.25), MSP430_MPY32::Q15(-0.5) };
+	static const MSP430_Q15 b[3] = { MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(0.25) };
+	static const MSP430_Q15 zero[3] = { 0, 0, 0 };
+	static const MSP430_Q15 almostOne[1] = { INT16_MAX };
+	static const MSP430_Q15 minusOne[1] = { INT16_MIN };
+
+	// 0.25 + 0.125 - 0.125
+	HOST_CHECK(MSP430_MPY32::DotQ15(a, b, 3) == MSP430_MPY32::Q15(0.25));
+	HOST_CHECK(MSP430_MPY32::DotQ31(a, b, 3) == 0x20000000L);
+	HOST_CHECK(MSP430_MPY32::DotQ15(zero, b, 3) == 0);
+	HOST_CHECK(MSP430_MPY32::DotQ15(a, b, 0) == 0);
+	// (1 - 2^-15) squared rounds to 1 - 2^-14, -1 x -1 saturates
+	HOST_CHECK(MSP430_MPY32::DotQ15(almostOne, almostOne, 1) == INT16_MAX - 1);
+	HOST_CHECK(MSP430_MPY32::DotQ15(minusOne, minusOne, 1) == INT16_MAX);
+	HOST_CHECK(MSP430_MPY32::DotQ31(minusOne, minusOne, 1) == INT32_MAX);
+}
+
+// The accumulator elements are preset as RESHI = acc >> 1, RESLO = (acc & 1) << 15 | 0x4000
+static void TestAccumulate(void)
+{
+	static const MSP430_Q15 input[4] = { MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(-0.5) };
+	MSP430_Q15 accumulator[4] = { 1000, -1001, INT16_MAX, INT16_MIN };
+
+	// Zero factor: odd and even elements come back unchanged
+	MSP430_MPY32::MultiplyAccumulateQ15(input, accumulator, 4, 0);
+	HOST_CHECK(accumulator[0] == 1000);
+	HOST_CHECK(accumulator[1] == -1001);
+	HOST_CHECK(accumulator[2] == INT16_MAX);
+	HOST_CHECK(accumulator[3] == INT16_MIN);
+
+	// + 0.5 x 0.5, saturated at both ends
+	MSP430_MPY32::MultiplyAccumulateQ15(input, accumulator, 4, MSP430_MPY32::Q15(0.5));
+	HOST_CHECK(accumulator[0] == 1000 + 8192);
+	HOST_CHECK(accumulator[1] == -1001 + 8192);
+	HOST_CHECK(accumulator[2] == INT16_MAX);
+	HOST_CHECK(accumulator[3] == INT16_MIN);
+
+	MSP430_Q15 scaled[2] = { MSP430_MPY32::Q15(0.5), MSP430_MPY32::Q15(-0.25) };
+	MSP430_MPY32::ScaleQ15(scaled, scaled, 2, MSP430_MPY32::Q15(0.5));
+	HOST_CHECK(scaled[0] == MSP430_MPY32::Q15(0.25));
+	HOST_CHECK(scaled[1] == MSP430_MPY32::Q15(-0.125));
+}
+
+// An impulse (1 - 2^-15) through the filter gives back the coefficients, split over blocks
+static void TestFIRImpulse(void)
+{
+	static const MSP430_Q15 taps[4] = { 1000, -2000, 3000, 4000 };
+	MSP430_BufferedFIR<4, 3> fir(taps);
+
+	MSP430_Q15 samples[8] = { INT16_MAX, 0, 0, 0, 0, 0, 0, 0 };
+	fir.Process(samples, samples, 8);
+	HOST_CHECK(samples[0] == 1000);
+	HOST_CHECK(samples[1] == -2000);
+	HOST_CHECK(samples[2] == 3000);
+	HOST_CHECK(samples[3] == 4000);
+	HOST_CHECK(samples[4] == 0);
+	HOST_CHECK(samples[7] == 0);
+
+	// Second impulse with history carried over from the previous call
+	MSP430_Q15 next[2] = { 0, INT16_MAX };
+	fir.Process(next, next, 2);
+	HOST_CHECK(next[0] == 0);
+	HOST_CHECK(next[1] == 1000);
+}
+
+int main()
+{
+	MSP430_Host::Reset();
+	__enable_interrupt();
+	MPY32CTL0 = MPYDLYWRTEN;
+
+	TestDotProduct();
+	TestAccumulate();
+	TestFIRImpulse();
+
+	// The kernels restore the multiplier mode and the interrupts
+	HOST_CHECK(MPY32CTL0 == MPYDLYWRTEN);
+	HOST_CHECK((__get_SR_register() & GIE) != 0);
+	return HOST_TEST_RESULT();
+}
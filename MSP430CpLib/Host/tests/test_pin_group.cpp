@@ -0,0 +1,80 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_pin_group.h"
+#include "host_test.h"
+
+using namespace MSP430_Pins;
+
+// Six pins over P1/P2/P4, one shift run each: P1.0-P1.1 (distance 0), P2.5 (3), P2.4 (1), P4.7 (3), P4.0 (-5)
+typedef MSP430_PinGroup<P1_0, P1_1, P2_5, P2_4, P4_7, P4_0> Group;
+typedef MSP430_PinGroup_Layout<P1_0, P1_1, P2_5, P2_4, P4_7, P4_0> Layout;
+
+static_assert(Layout::PortMask(0) == (BIT0 | BIT1) && Layout::PortMask(1) == (BIT4 | BIT5) && Layout::PortMask(3) == (BIT0 | BIT7), "Port masks");
+static_assert(Layout::ValueMask(0, 0) == 0x03 && Layout::ValueMask(1, 3) == 0x04 && Layout::ValueMask(1, 1) == 0x08, "P1/P2 runs");
+static_assert(Layout::ValueMask(3, 3) == 0x10 && Layout::ValueMask(3, -5) == 0x20 && Layout::ValueMask(2, 0) == 0, "P4 runs");
+
+/// <summary>MSP430_PinGroup: Write() scatters the value bits, the other port bits are kept</summary>
+static void TestScatter(void)
+{
+	MSP430_Host::Reset();
+	P1OUT = 0xF0;
+	P2OUT = 0x0F;
+	P4OUT = 0x7E;
+	P1SEL = P2SEL = P4SEL = 0xFF;
+
+	Group::Initialize(MSP430_GPIO_Direction::Output);
+	HOST_CHECK(P1DIR == (BIT0 | BIT1) && P2DIR == (BIT4 | BIT5) && P4DIR == (BIT0 | BIT7));
+	HOST_CHECK(P1SEL == 0xFC && P2SEL == 0xCF && P4SEL == 0x7E);
+
+	Group::Write(0x2D);
+	HOST_CHECK(P1OUT == (0xF0 | BIT0));
+	HOST_CHECK(P2OUT == (0x0F | BIT4 | BIT5));
+	HOST_CHECK(P4OUT == (0x7E | BIT0));
+	Group::Write(0x12);
+	HOST_CHECK(P1OUT == (0xF0 | BIT1));
+	HOST_CHECK(P2OUT == 0x0F);
+	HOST_CHECK(P4OUT == (0x7E | BIT7));
+
+	// Set/Clear/Toggle touch the group bits only
+	Group::Toggle();
+	HOST_CHECK(P1OUT == (0xF0 | BIT0) && P2OUT == (0x0F | BIT4 | BIT5) && P4OUT == (0x7E | BIT0));
+	Group::Set();
+	HOST_CHECK(P1OUT == 0xF3 && P2OUT == 0x3F && P4OUT == 0xFF);
+	Group::Clear();
+	HOST_CHECK(P1OUT == 0xF0 && P2OUT == 0x0F && P4OUT == 0x7E);
+}
+
+/// <summary>MSP430_PinGroup: Read() gathers the PxIN bits of each port into the value</summary>
+static void TestGather(void)
+{
+	MSP430_Host::Reset();
+	Group::Initialize(MSP430_GPIO_Direction::Input);
+	HOST_CHECK(P1DIR == 0 && P2DIR == 0 && P4DIR == 0);
+
+	// The other pins of the ports are driven to the opposite level
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, 0xFF, 0xFE);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P2, 0xFF, 0xDF);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P4, 0xFF, 0x01);
+	HOST_CHECK(Group::Read() == (0x02 | 0x08 | 0x20));
+
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P1, 0xFF, 0x01);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P2, 0xFF, 0x20);
+	MSP430_Host::DrivePort(MSP430_GPIO_Port::P4, 0xFF, 0x80);
+	HOST_CHECK(Group::Read() == (0x01 | 0x04 | 0x10));
+
+	// Pulled inputs read the resistor level (PxOUT), all pins high
+	MSP430_Host::Reset();
+	P1OUT = P2OUT = P4OUT = 0xFF;
+	Group::Initialize(MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+	HOST_CHECK(P1REN == (BIT0 | BIT1) && P2REN == (BIT4 | BIT5) && P4REN == (BIT0 | BIT7));
+	MSP430_Host::Update();
+	HOST_CHECK(Group::Read() == Group::Mask);
+}
+
+int main(void)
+{
+	TestScatter();
+	TestGather();
+
+	return HOST_TEST_RESULT();
+}
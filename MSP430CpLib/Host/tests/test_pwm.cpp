@@ -0,0 +1,48 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_pwm.h"
+#include "host_test.h"
+
+/// <summary>MSP430_PWM links with the timer driver and drives TA0.1 on P1.2</summary>
+static void TestPWM(void)
+{
+	MSP430_Host::Reset();
+
+	MSP430_GPIO fanPin(MSP430_GPIO_Port::P1, 2);
+	MSP430_PWM fan(MSP430_Timer_Instance::TA0, 1, fanPin, 25000, 50);
+	fan.Initialize();
+	HOST_CHECK(MSP430_Clock::IsSMCLKHeld());
+	HOST_CHECK(P1SEL == BIT2 && P1DIR == BIT2);
+	HOST_CHECK((TA0CTL & MC_3) == MC_1);
+	HOST_CHECK((TA0CCTL1 & OUTMOD_7) == OUTMOD_7);
+	unsigned int period = TA0CCR0 + 1u;
+	HOST_CHECK(period > 900 && period < 1100);
+	HOST_CHECK(TA0CCR1 == period / 2);
+
+	fan.SetDutyPercent(0);
+	HOST_CHECK((TA0CCTL1 & (OUTMOD_7 | OUT)) == 0);
+	fan.Deinitialize();
+	HOST_CHECK(!MSP430_Clock::IsSMCLKHeld());
+	HOST_CHECK(P1SEL == 0 && P1DIR == 0);
+
+	// Period boundary updates turn the CCR0 interrupt on, Deinitialize() turns it off again
+	MSP430_PWM boundary(MSP430_Timer_Instance::TA0, 1, fanPin, 25000, 50, MSP430_PWM_Update::PeriodBoundary);
+	boundary.Initialize();
+	HOST_CHECK(TA0CCTL0 & CCIE);
+	boundary.Deinitialize();
+	HOST_CHECK((TA0CCTL0 & CCIE) == 0);
+
+	// A CCR0 interrupt enabled before Initialize() is left on
+	TA0CCTL0 |= CCIE;
+	boundary.Initialize();
+	boundary.Deinitialize();
+	HOST_CHECK(TA0CCTL0 & CCIE);
+}
+
+int main(void)
+{
+	TestPWM();
+
+	return HOST_TEST_RESULT();
+}
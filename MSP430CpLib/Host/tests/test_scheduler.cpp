@@ -0,0 +1,183 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_gpio_interrupt.h"
+#include "msp430cp_timer.h"
+#include "msp430cp_scheduler.h"
+#include "host_test.h"
+
+void Button(void);
+void Later(void);
+typedef MSP430_Scheduler<Button, Later> Scheduler;
+
+/// <summary>Number of Button task runs</summary>
+static unsigned int buttonCount = 0;
+/// <summary>Number of Later task runs</summary>
+static unsigned int laterCount = 0;
+/// <summary>The P1.1 handler posts a deadline instead of a task</summary>
+static bool postDeadline = false;
+
+void Button(void)
+{
+	buttonCount++;
+}
+
+void Later(void)
+{
+	laterCount++;
+}
+
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 1)
+{
+	if (postDeadline)
+	{
+		Scheduler::PostAt(Scheduler::IdOf<Later>(), MSP430_SchedulerTimebase::Now() + 10);
+	}
+	else
+	{
+		Scheduler::Post<Button>();
+	}
+}
+
+/// <summary>Sleep hook: a rising edge on P1.1 during the sleep</summary>
+static void PressButton(void)
+{
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 1);
+}
+
+/// <summary>Low-power bits of the last sleep</summary>
+static unsigned int sleepBits = 0;
+
+/// <summary>Sleep hook: record the low-power mode, then press the button</summary>
+static void RecordSleep(void)
+{
+	sleepBits = __get_SR_register() & LPM4_bits;
+	PressButton();
+}
+
+/// <summary>Sleep hook: the alarm compare matches during the sleep</summary>
+static void RaiseAlarm(void)
+{
+	MSP430_Host::Interrupt(MSP430_Timer_TA2_CCR0_ISR);
+}
+
+/// <summary>Set up the P1.1 rising edge interrupt and the scheduler</summary>
+static void Setup(MSP430_GPIO& button)
+{
+	MSP430_Host::Reset();
+	buttonCount = 0;
+	laterCount = 0;
+	postDeadline = false;
+
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 0);
+	button.Initialize();
+	button.EnableInterrupt(MSP430_GPIO_InterruptTrig::Posedge);
+	__enable_interrupt();
+	Scheduler::Initialize();
+}
+
+/// <summary>Post() from a GPIO handler leaves the low-power mode of Sleep() through the port interrupt routine</summary>
+static void TestPostWake(void)
+{
+	MSP430_GPIO button(MSP430_GPIO_Port::P1, 1, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::Off);
+	Setup(button);
+
+	MSP430_Host::sleepHook = PressButton;
+	Scheduler::Idle();
+	HOST_CHECK(MSP430_Host::sleepCount == 1);
+	HOST_CHECK(MSP430_Host::missedWakeCount == 0);
+	HOST_CHECK(!MSP430_WakeRequest);
+	HOST_CHECK(__get_SR_register() & GIE);
+	HOST_CHECK(Scheduler::Dispatch() == 1);
+	HOST_CHECK(buttonCount == 1);
+
+	// Runnable task: no sleep
+	Scheduler::Post<Button>();
+	Scheduler::Idle();
+	HOST_CHECK(MSP430_Host::sleepCount == 1);
+	HOST_CHECK(Scheduler::Dispatch() == 1);
+
+	// LPM3, or LPM0 while a driver holds SMCLK
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 0);
+	MSP430_Host::sleepHook = RecordSleep;
+	Scheduler::Idle();
+	HOST_CHECK(sleepBits == LPM3_bits);
+	HOST_CHECK(Scheduler::Dispatch() == 1);
+	MSP430_Clock::HoldSMCLK();
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 0);
+	Scheduler::Idle();
+	HOST_CHECK(sleepBits == LPM0_bits);
+	MSP430_Clock::ReleaseSMCLK();
+	HOST_CHECK(Scheduler::Dispatch() == 1);
+
+	// No interrupt during the sleep: the device would sleep on
+	MSP430_Host::sleepHook = nullptr;
+	Scheduler::Idle();
+	HOST_CHECK(MSP430_Host::sleepCount == 4);
+	HOST_CHECK(MSP430_Host::missedWakeCount == 1);
+	HOST_CHECK(Scheduler::Dispatch() == 0);
+
+	// A stale request of the main context does not take the next interrupt out of the sleep
+	MSP430_Host::DriveInput(MSP430_GPIO_Port::P1, 1, 0);
+	MSP430_WAKE();
+	Scheduler::Idle();
+	HOST_CHECK(MSP430_Host::missedWakeCount == 2);
+
+	button.DisableInterrupt();
+	__disable_interrupt();
+}
+
+/// <summary>PostAt() from a GPIO handler wakes a sleep armed for a far deadline (the alarm is reprogrammed)</summary>
+static void TestPostAtWake(void)
+{
+	MSP430_GPIO button(MSP430_GPIO_Port::P1, 1, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::Off);
+	Setup(button);
+
+	// Far deadline: sleep with the alarm disarmed, the overflow would reprogram it
+	Scheduler::PostAfter<Later>(0x20000UL);
+	postDeadline = true;
+	MSP430_Host::sleepHook = PressButton;
+	Scheduler::Idle();
+	HOST_CHECK(MSP430_Host::sleepCount == 1);
+	HOST_CHECK(MSP430_Host::missedWakeCount == 0);
+	HOST_CHECK(Scheduler::Dispatch() == 0);
+
+	// The next idle arms the nearer deadline, the alarm interrupt wakes the loop
+	MSP430_Host::sleepHook = RaiseAlarm;
+	Scheduler::Idle();
+	HOST_CHECK(MSP430_Host::sleepCount == 2);
+	HOST_CHECK(MSP430_Host::missedWakeCount == 0);
+	HOST_CHECK(TA2CCR0 == 10);
+	HOST_CHECK(TA2CCTL0 == 0);
+
+	button.DisableInterrupt();
+	__disable_interrupt();
+}
+
+/// <summary>Service functions for SCHEDULER_USER_ISR handlers: same effects as the library handlers</summary>
+static void TestService(void)
+{
+	MSP430_Host::Reset();
+	Scheduler::Initialize();
+
+	TA2CCTL0 = CCIE | CCIFG;
+	MSP430_SchedulerTimebase::ServiceAlarm();
+	HOST_CHECK(TA2CCTL0 == 0);
+	HOST_CHECK(MSP430_WakeRequest);
+	MSP430_WakeRequest = false;
+
+	// The overflow extends the time, it wakes the CPU only for a far alarm
+	TA2CTL = TA2CTL & ~TAIFG;
+	MSP430_SchedulerTimebase::ServiceOverflow();
+	HOST_CHECK(MSP430_SchedulerTimebase::Now() == 0x10000UL + TA2R);
+	HOST_CHECK(!MSP430_WakeRequest);
+}
+
+int main(void)
+{
+	TestPostWake();
+	TestPostAtWake();
+	TestService();
+
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,112 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_timer.h"
+#include "msp430cp_delay.h"
+#include "msp430cp_clock.h"
+#include "host_test.h"
+
+// MSP430_Timer links against the register tables (TxCTL, TxCHANNEL_COUNT) and reaches TA0/TB0 through them
+int main()
+{
+	MSP430_Host::Reset();
+
+	MSP430_Timer ta0(MSP430_Timer_Instance::TA0, MSP430_Timer_ClockSource::ACLK, MSP430_Timer_Divider::Div4, MSP430_Timer_Mode::Up);
+	HOST_CHECK(ta0.GetChannelCount() == 5);
+	ta0.Initialize();
+	HOST_CHECK(TA0CTL == (TASSEL_1 | ID_2 | TACLR));
+	ta0.SetPeriod(1000);
+	ta0.SetCompare(2, 250);
+	ta0.SetOutputMode(2, MSP430_Timer_OutputMode::ResetSet);
+	ta0.EnableInterrupt(2);
+	HOST_CHECK(TA0CCR0 == 999);
+	HOST_CHECK(TA0CCR2 == 250);
+	HOST_CHECK(TA0CCTL2 == (OUTMOD_7 | CCIE));
+	ta0.Start();
+	HOST_CHECK((TA0CTL & MC_3) == MC_1);
+	ta0.Stop();
+	HOST_CHECK((TA0CTL & MC_3) == MC_0);
+	ta0.Deinitialize();
+	HOST_CHECK(TA0CCTL2 == 0);
+
+	MSP430_Timer tb0(MSP430_Timer_Instance::TB0);
+	HOST_CHECK(tb0.GetChannelCount() == 7);
+	tb0.SetCapture(6, MSP430_Timer_CaptureEdge::Both, MSP430_Timer_CaptureInput::CCIxB);
+	HOST_CHECK(TB0CCTL6 == (CM_3 | CCIS_1 | SCS | CAP));
+	TB0CCTL6 |= COV;
+	HOST_CHECK(tb0.CheckCaptureOverflow(6));
+	HOST_CHECK(!tb0.CheckCaptureOverflow(6));
+
+	// MSP430_StaticTimer reaches the same registers through the compile-time map
+	typedef MSP430_StaticTimer<MSP430_Timer_Instance::TA1, MSP430_Timer_ClockSource::SMCLK, MSP430_Timer_Divider::Div8,
+		MSP430_Timer_DividerEx::Div3, MSP430_Timer_Mode::UpDown> ta1;
+	HOST_CHECK(ta1::GetChannelCount() == 3);
+	ta1::Initialize();
+	HOST_CHECK(TA1CTL == (TASSEL_2 | ID_3 | TACLR));
+	HOST_CHECK(TA1EX0 == 2);
+	ta1::SetPeriod(500);
+	ta1::SetCompare(1, 100);
+	ta1::SetOutputMode(1, MSP430_Timer_OutputMode::ToggleReset);
+	ta1::EnableInterrupt(1);
+	ta1::EnableOverflowInterrupt();
+	HOST_CHECK(TA1CCR0 == 499);
+	HOST_CHECK(TA1CCR1 == 100);
+	HOST_CHECK(TA1CCTL1 == (OUTMOD_2 | CCIE));
+	ta1::Start();
+	HOST_CHECK((TA1CTL & (MC_3 | TAIE)) == (MC_3 | TAIE));
+	TA1R = 42;
+	HOST_CHECK(ta1::GetCounter() == 42);
+	TA1CTL |= TAIFG;
+	TA1CCTL1 |= CCIFG;
+	HOST_CHECK(ta1::CheckOverflowFlag());
+	HOST_CHECK(ta1::CheckInterruptFlag(1));
+	ta1::ClearOverflowFlag();
+	ta1::ClearInterruptFlag(1);
+	HOST_CHECK(!ta1::CheckOverflowFlag());
+	HOST_CHECK(!ta1::CheckInterruptFlag(1));
+	ta1::SetCapture(2, MSP430_Timer_CaptureEdge::Posedge, MSP430_Timer_CaptureInput::GND);
+	HOST_CHECK(TA1CCTL2 == (CM_1 | CCIS_2 | SCS | CAP));
+	ta1::Stop();
+	HOST_CHECK((TA1CTL & MC_3) == MC_0);
+	ta1::Deinitialize();
+	HOST_CHECK(TA1CTL == TACLR);
+	HOST_CHECK(TA1CCTL1 == 0);
+	HOST_CHECK(TA1EX0 == 0);
+
+	// Period on SMCLK: the smallest input divider that fits 16 bits, the mode and the interrupt enable are kept
+	TA1CTL = MC_1 | TAIE;
+	HOST_CHECK(MSP430_Timer::SetPeriodOnSMCLK(&TA1CTL, MSP430_Clock::SMCLKFrequency / 1000) == 1000);
+	HOST_CHECK(TA1CCR0 == 999);
+	HOST_CHECK(TA1CTL == (TASSEL_2 | ID_0 | MC_1 | TAIE));
+	const unsigned long slow = MSP430_Clock::SMCLKFrequency / 0x30000UL;
+	HOST_CHECK(MSP430_Timer::DividerOnSMCLK(slow) == MSP430_Timer_Divider::Div4);
+	HOST_CHECK(MSP430_Timer::SetPeriodOnSMCLK(&TA1CTL, slow) == (MSP430_Clock::SMCLKFrequency / slow) >> 2);
+	HOST_CHECK(TA1CTL == (TASSEL_2 | ID_2 | MC_1 | TAIE));
+	// Out of range: the longest period at /8, the shortest period of 2 clocks
+	HOST_CHECK(MSP430_Timer::SetPeriodOnSMCLK(&TA1CTL, 0) == 0x10000UL);
+	HOST_CHECK(TA1CCR0 == 0xFFFF && (TA1CTL & ID_3) == ID_3);
+	HOST_CHECK(MSP430_Timer::PeriodOnSMCLK(MSP430_Clock::SMCLKFrequency * 2) == 2);
+	HOST_CHECK(MSP430_Timer::DividerOnSMCLK(MSP430_Clock::SMCLKFrequency * 2) == MSP430_Timer_Divider::Div1);
+	TA1CTL = 0;
+
+	// Service function for DELAY_USER_ISR handlers: same register effects as the library handler
+	TA1CCTL0 = CCIE | CCIFG;
+	TA1CTL = TASSEL_1 | MC_2;
+	MSP430_Delay::Service();
+	HOST_CHECK(TA1CCTL0 == 0);
+	HOST_CHECK((TA1CTL & MC_3) == MC_0);
+	HOST_CHECK(MSP430_WakeRequest);
+	MSP430_WakeRequest = false;
+
+	// The delay CCR0 handler requests the wake-up, the timer interrupt routine leaves LPM3 on exit
+	MSP430Host_StatusRegister = LPM3_bits | GIE;
+	MSP430_Host::Interrupt(MSP430_Timer_TA1_CCR0_ISR);
+	HOST_CHECK(MSP430Host_StatusRegister == GIE);
+	HOST_CHECK(!MSP430_WakeRequest);
+	// Without a request the CPU stays asleep
+	MSP430Host_StatusRegister = LPM3_bits | GIE;
+	MSP430_Host::Interrupt(MSP430_Timer_TA0_CCR0_ISR);
+	HOST_CHECK(MSP430Host_StatusRegister == (LPM3_bits | GIE));
+	MSP430Host_StatusRegister = 0;
+
+	return HOST_TEST_RESULT();
+}
@@ -0,0 +1,140 @@
+#include <msp430.h>
+#include "msp430cp_host.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_uart.h"
+#include "host_test.h"
+
+typedef MSP430_BufferedUART<MSP430_UART_Instance::UCA1, 115200, 8, 8> TestUART;
+
+/// <summary>Receive a byte: UCA1IV reports RX, the USCI_A1 interrupt routine services it</summary>
+static void Receive(unsigned char value, unsigned char status = 0)
+{
+	UCA1STAT = status;
+	UCA1RXBUF = value;
+	UCA1IV = USCI_UCRXIFG;
+	MSP430_Host::Interrupt(MSP430_UART_A1_ISR);
+}
+
+/// <summary>Empty transmit buffer: UCA1IV reports TX, the USCI_A1 interrupt routine services it</summary>
+static void TransmitReady(void)
+{
+	UCA1IV = USCI_UCTXIFG;
+	MSP430_Host::Interrupt(MSP430_UART_A1_ISR);
+}
+
+/// <summary>MSP430_UART: configuration, partial writes, TX interrupt self-disable</summary>
+static void TestTransmit(void)
+{
+	MSP430_Host::Reset();
+	MSP430_GPIO txd(MSP430_GPIO_Port::P4, 4), rxd(MSP430_GPIO_Port::P4, 5);
+	TestUART uart(txd, rxd);
+
+	uart.Initialize();
+	HOST_CHECK(UCA1CTL1 == UCSSEL_2);
+	HOST_CHECK(UCA1BRW == TestUART::Divisor.prescaler && UCA1MCTL == TestUART::Divisor.modulation);
+	HOST_CHECK(UCA1IE == UCRXIE);
+	HOST_CHECK((P4SEL & (BIT4 | BIT5)) == (BIT4 | BIT5));
+	HOST_CHECK(MSP430_Clock::IsSMCLKHeld());
+
+	// Only the free space is queued, the TX interrupt starts the transmission
+	static const unsigned char text[10] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j' };
+	HOST_CHECK(uart.Write(text, 10) == 8);
+	HOST_CHECK(uart.GetWritable() == 0);
+	HOST_CHECK(!uart.Write('k'));
+	HOST_CHECK(UCA1IE == (UCRXIE | UCTXIE));
+	HOST_CHECK(uart.IsBusy());
+
+	TransmitReady();
+	HOST_CHECK(UCA1TXBUF == 'a');
+	HOST_CHECK(uart.GetWritable() == 1);
+	HOST_CHECK(uart.Write(text + 8, 2) == 1);
+	for (unsigned int i = 1; i < 9; i++)
+	{
+		TransmitReady();
+		HOST_CHECK(UCA1TXBUF == text[i]);
+	}
+	HOST_CHECK(UCA1IE == (UCRXIE | UCTXIE));
+
+	// Empty buffer: the interrupt disables itself, the next Write() enables it again
+	TransmitReady();
+	HOST_CHECK(UCA1IE == UCRXIE);
+	HOST_CHECK(UCA1TXBUF == 'i');
+	HOST_CHECK(!uart.IsBusy());
+	HOST_CHECK(uart.Write('k'));
+	HOST_CHECK(UCA1IE == (UCRXIE | UCTXIE));
+	TransmitReady();
+	HOST_CHECK(UCA1TXBUF == 'k');
+
+	uart.Deinitialize();
+	HOST_CHECK(UCA1CTL1 == UCSWRST && UCA1IE == 0);
+	HOST_CHECK((P4SEL & (BIT4 | BIT5)) == 0);
+	HOST_CHECK(!MSP430_Clock::IsSMCLKHeld());
+}
+
+/// <summary>MSP430_UART: Peek()/Consume() across the ring wrap, overflow and error counters</summary>
+static void TestReceive(void)
+{
+	MSP430_Host::Reset();
+	MSP430_GPIO txd(MSP430_GPIO_Port::P4, 4), rxd(MSP430_GPIO_Port::P4, 5);
+	TestUART uart(txd, rxd);
+	uart.Initialize();
+
+	for (unsigned char i = 0; i < 6; i++)
+	{
+		Receive('0' + i);
+	}
+	HOST_CHECK(uart.GetAvailable() == 6);
+	unsigned char data[8];
+	HOST_CHECK(uart.Read(data, 5) == 5);
+	HOST_CHECK(data[0] == '0' && data[4] == '4');
+
+	// Bytes 5 to 10 occupy ring slots 5-7, then 0-2
+	for (unsigned char i = 6; i < 11; i++)
+	{
+		Receive('0' + i);
+	}
+	const unsigned char* run;
+	HOST_CHECK(uart.Peek(run) == 3);
+	HOST_CHECK(run[0] == '5' && run[1] == '6' && run[2] == '7');
+	uart.Consume(3);
+	HOST_CHECK(uart.Peek(run) == 3);
+	HOST_CHECK(run[0] == '8' && run[2] == ':');
+	uart.Consume(2);
+	unsigned char value = 0;
+	HOST_CHECK(uart.Read(value) && value == ':');
+	HOST_CHECK(!uart.Read(value));
+	HOST_CHECK(uart.Peek(run) == 0);
+
+	// Full buffer: the byte is dropped and counted
+	for (unsigned char i = 0; i < 9; i++)
+	{
+		Receive('a' + i);
+	}
+	HOST_CHECK(uart.GetAvailable() == 8);
+	HOST_CHECK(uart.GetOverflowCount() == 1);
+	HOST_CHECK(uart.Read(data, 8) == 8);
+	HOST_CHECK(data[0] == 'a' && data[7] == 'h');
+
+	// Framing/overrun errors are counted, the byte is still queued
+	Receive('x', UCFE);
+	Receive('y', UCOE | UCRXERR);
+	Receive('z');
+	HOST_CHECK(uart.GetErrorCount() == 2);
+	HOST_CHECK(uart.GetOverflowCount() == 1);
+	HOST_CHECK(uart.Read(data, 8) == 3);
+
+	// No source pending: nothing happens
+	UCA1IV = 0;
+	MSP430_Host::Interrupt(MSP430_UART_A1_ISR);
+	HOST_CHECK(uart.GetAvailable() == 0);
+
+	uart.Deinitialize();
+}
+
+int main(void)
+{
+	TestTransmit();
+	TestReceive();
+
+	return HOST_TEST_RESULT();
+}
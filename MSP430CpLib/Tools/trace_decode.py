@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Decode an MSP430CpLib trace buffer (msp430cp_trace.h) into a timeline.
+
+The input is the msp430cp_trace memory layout: a raw binary (MSP430_Trace::Dump() captured from the UART, or a
+debugger memory dump of the symbol msp430cp_trace), an mspdebug "md" listing (--text), or a serial port read live
+(--serial, needs pyserial). The ring is put back in recording order and the 16-bit timestamps are unwrapped by
+their deltas, so gaps longer than one counter period (65536 counts) are shown shorter than they were.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x5254
+HEADER = struct.Struct("<HBBHHI")
+MEMORY_LINE = re.compile(r"^\s*([0-9a-fA-F]+):\s+(.*)$")
+
+# MSP430_Trace_Id (keep in sync with msp430cp_trace.h)
+EVENTS = {
+    0x01: "GPIOWrite",
+    0x02: "GPIOToggle",
+    0x10: "InterruptEnter",
+    0x11: "InterruptExit",
+    0x12: "InterruptDispatch",
+    0x20: "UARTReceive",
+    0x21: "UARTTransmit",
+    0x22: "UARTError",
+}
+
+# MSP430_Trace_Source
+SOURCES = {
+    1: "PORT1", 2: "PORT2",
+    3: "TA0 CCR0", 4: "TA0 IV", 5: "TA1 CCR0", 6: "TA1 IV", 7: "TA2 CCR0", 8: "TA2 IV", 9: "TB0 CCR0", 10: "TB0 IV",
+    11: "DMA", 12: "USCI_A0", 13: "USCI_A1",
+}
+
+
+def describe(event, argument):
+    """Return (name, detail) of an entry."""
+    if event >= 0x80:
+        return "User(%d)" % (event & 0x7F), "0x%02x" % argument
+    name = EVENTS.get(event, "0x%02x" % event)
+    pin = "P%d.%d" % (((argument >> 3) & 0x0F) + 1, argument & 0x07)
+    if event == 0x01:
+        return name, "%s = %d" % (pin, argument >> 7)
+    if event == 0x02:
+        return name, pin
+    if event in (0x10, 0x11):
+        return name, SOURCES.get(argument, "source %d" % argument)
+    if event == 0x12:
+        return name, "handler %d" % argument
+    if event in (0x20, 0x21):
+        return name, "0x%02x %r" % (argument, chr(argument) if 0x20 <= argument < 0x7F else "")
+    if event == 0x22:
+        return name, "overflow" if argument == 0 else "UCAxSTAT 0x%02x" % argument
+    return name, "0x%02x" % argument
+
+
+def parse_text(text):
+    """Return the bytes of an mspdebug "md" listing (address: bytes | ascii)."""
+    memory = bytearray()
+    for line in text.splitlines():
+        match = MEMORY_LINE.match(line)
+        if match:
+            memory += bytes(int(byte, 16) for byte in match.group(2).split("|")[0].split())
+    return bytes(memory)
+
+
+def read_serial(port, baud, timeout):
+    """Read one dump from a serial port (header first, then the entries it announces)."""
+    import serial
+    with serial.Serial(port, baud, timeout=timeout) as link:
+        data = b""
+        while True:
+            byte = link.read(1)
+            if not byte:
+                raise SystemExit("no trace header received")
+            data = (data + byte)[-2:]
+            if data == struct.pack("<H", MAGIC):
+                break
+        header = data + link.read(HEADER.size - 2)
+        _, entry_size, _, capacity, _, _ = HEADER.unpack(header)
+        return header + link.read(entry_size * capacity)
+
+
+def decode(data):
+    """Return (frequency, [(time in counts, delta in counts, event, argument)]) in recording order."""
+    offset = data.find(struct.pack("<H", MAGIC))
+    if offset < 0 or len(data) < offset + HEADER.size:
+        raise SystemExit("no trace header found")
+    magic, entry_size, version, capacity, head, frequency = HEADER.unpack_from(data, offset)
+    if version != 1 or entry_size != 4:
+        raise SystemExit("unsupported trace layout (version %d, %d bytes per entry)" % (version, entry_size))
+    entries = data[offset + HEADER.size:offset + HEADER.size + entry_size * capacity]
+    if len(entries) < entry_size * capacity:
+        raise SystemExit("trace truncated (%d of %d entries)" % (len(entries) // entry_size, capacity))
+
+    count = min(head, capacity)
+    first = (head - count) % capacity
+    timeline = []
+    time = 0
+    previous = None
+    for index in range(count):
+        event, argument, timestamp = struct.unpack_from("<BBH", entries, ((first + index) % capacity) * entry_size)
+        delta = 0 if previous is None else (timestamp - previous) & 0xFFFF
+        time += delta
+        previous = timestamp
+        timeline.append((time, delta, event, argument))
+    return frequency, timeline
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("input", nargs="?", help="binary dump (- for stdin)")
+    parser.add_argument("--text", action="store_true", help="input is an mspdebug \"md\" listing")
+    parser.add_argument("--serial", help="read a dump from this serial port instead (pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=5.0, help="serial read timeout (s)")
+    parser.add_argument("--frequency", type=int, help="timestamp frequency (Hz), overrides the header")
+    args = parser.parse_args()
+
+    if args.serial:
+        data = read_serial(args.serial, args.baud, args.timeout)
+    elif args.input is None:
+        parser.error("an input file or --serial is required")
+    else:
+        with (sys.stdin.buffer if args.input == "-" else open(args.input, "rb")) as file:
+            data = file.read()
+        if args.text:
+            data = parse_text(data.decode("ascii", "replace"))
+
+    frequency, timeline = decode(data)
+    frequency = args.frequency or frequency
+    scale = 1e6 / frequency if frequency else 1.0
+    unit = "us" if frequency else "counts"
+    print("%d entries, timestamps at %d Hz" % (len(timeline), frequency))
+    print("%12s %10s  %-18s %s" % ("time (%s)" % unit, "delta", "event", "detail"))
+    for time, delta, event, argument in timeline:
+        name, detail = describe(event, argument)
+        print("%12.2f %+10.2f  %-18s %s" % (time * scale, delta * scale, name, detail))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
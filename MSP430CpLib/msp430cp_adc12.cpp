@@ -0,0 +1,294 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_adc12.h"
+#include "msp430cp_clock.h"
+
+// GPIO registers
+extern REG_8b const PxSEL[GPIO_PORT_COUNT];
+// Timer registers
+extern REG_16b const TxCTL[TIMER_COUNT];
+
+// Converter registers (constant addresses, absolute addressing)
+/// <summary>Control register 0 (ADC12CTL0)</summary>
+static inline MSP430_FieldRegister<MSP430_ADC12_Control0> Control0(void)
+{
+	return &ADC12CTL0;
+}
+/// <summary>Control register 1 (ADC12CTL1)</summary>
+static inline MSP430_FieldRegister<MSP430_ADC12_Control1> Control1(void)
+{
+	return &ADC12CTL1;
+}
+/// <summary>Control register 2 (ADC12CTL2)</summary>
+static inline MSP430_FieldRegister<MSP430_ADC12_Control2> Control2(void)
+{
+	return &ADC12CTL2;
+}
+/// <summary>Conversion memory control register (ADC12MCTLx)</summary>
+/// <param name="memory">Conversion memory (0-15)</param>
+static inline MSP430_FieldRegister<MSP430_ADC12_MemoryControl> MemoryControl(unsigned char memory)
+{
+	return &ADC12MCTL0 + memory;
+}
+/// <summary>Interrupt flags of the conversion memories (ADC12IFG)</summary>
+static inline MSP430_Register16 InterruptFlags(void)
+{
+	return &ADC12IFG;
+}
+/// <summary>Interrupt enables of the conversion memories (ADC12IE)</summary>
+static inline MSP430_Register16 InterruptEnables(void)
+{
+	return &ADC12IE;
+}
+
+/// <summary>Analog pin function select of an input channel (A0-A7 = P6.0-P6.7, A12-A15 = P7.0-P7.3 on MSP430F5529)</summary>
+/// <param name="channel">Input channel</param>
+/// <param name="selected">Select the analog function (false: GPIO)</param>
+static void SelectAnalogPin(unsigned char channel, bool selected)
+{
+	MSP430_Register8 sel;
+	unsigned char pin = 0;
+	if (channel < 8 && GPIO_PORT_COUNT >= 6)
+	{
+		sel = PxSEL[5];
+		pin = channel;
+	}
+#if GPIO_PORT_COUNT >= 7
+	else if (channel >= 12 && channel < 16)
+	{
+		sel = PxSEL[6];
+		pin = channel - 12;
+	}
+#endif
+	if (sel.IsPresent())
+	{
+		sel.Assign(static_cast<unsigned char> (1 << pin), selected);
+	}
+}
+
+/// <summary>Create a new streaming converter object (No hardware operation)</summary>
+/// <param name="channels">Input channels (0-15, kept by reference)</param>
+/// <param name="channelCount">Number of input channels (1-16)</param>
+/// <param name="rounds">Times the channel list is repeated in one sequence (channel count x rounds up to 16)</param>
+/// <param name="trigger">Conversion trigger</param>
+/// <param name="sampleRate">Conversions per second (timer triggers, each input is sampled at sampleRate / channelCount)</param>
+/// <param name="channel">DMA channel</param>
+/// <param name="reference">Reference of all channels</param>
+MSP430_ADC12::MSP430_ADC12(const unsigned char* channels, unsigned char channelCount, unsigned char rounds, MSP430_ADC12_Trigger trigger, unsigned long sampleRate,
+	MSP430_DMA_Channel channel, MSP430_ADC12_Reference reference) :
+	dma(channel, MSP430_DMA_Trigger::ADC12_IFG, MSP430_DMA_Mode::RepeatBlock, MSP430_DMA_Step::Increment, MSP430_DMA_Step::Increment, MSP430_DMA_Unit::Word)
+{
+	if (channelCount == 0)
+	{
+		channelCount = 1;
+	}
+	if (channelCount > MemoryCount)
+	{
+		channelCount = MemoryCount;
+	}
+	if (rounds == 0 || channelCount * rounds > MemoryCount)
+	{
+		rounds = MemoryCount / channelCount;
+	}
+
+	this->channels = channels;
+	this->channelCount = channelCount;
+	this->sequenceLength = channelCount * rounds;
+	this->trigger = trigger;
+	this->reference = reference;
+	this->sampleRate = sampleRate;
+
+	if (trigger == MSP430_ADC12_Trigger::TA0_CCR1)
+	{
+		this->reg_TxCTL = TxCTL[static_cast<int> (MSP430_Timer_Instance::TA0)];
+	}
+	else if (trigger == MSP430_ADC12_Trigger::TB0_CCR1)
+	{
+		this->reg_TxCTL = TxCTL[static_cast<int> (MSP430_Timer_Instance::TB0)];
+	}
+}
+
+/// <summary>Delete this converter instance, stop it and release the DMA channel, the timer and the analog pins</summary>
+MSP430_ADC12::~MSP430_ADC12()
+{
+	Deinitialize();
+}
+
+/// <summary>Select the analog pins, turn the converter on, load the sequence, initialize the DMA channel and the conversion clock (halted)</summary>
+void MSP430_ADC12::Initialize(void)
+{
+	for (unsigned char i = 0; i < this->channelCount; i++)
+	{
+		SelectAnalogPin(this->channels[i], true);
+	}
+
+	// The configuration is written with ADC12ENC cleared; pulse sample mode, each SHI edge converts one memory
+	// (a timer edge per conversion), or all memories back-to-back after one ADC12SC (ADC12MSC)
+	bool continuous = (this->trigger == MSP430_ADC12_Trigger::Continuous);
+	Control0().Reset();
+	Control0().Write(MSP430_ADC12_Control0::SampleTime1::Of<1>() | MSP430_ADC12_Control0::SampleTime0::Of<1>() | MSP430_ADC12_Control0::On::On |
+		MSP430_ADC12_Control0::MultipleConversion::Of(continuous));
+	Control1().Write(MSP430_ADC12_Control1::Trigger::Of(this->trigger) | MSP430_ADC12_Control1::SamplePulse::On | MSP430_ADC12_Control1::ClockSource::Of<0>() |
+		MSP430_ADC12_Control1::Sequence::Of(MSP430_ADC12_Sequence::RepeatSequence));
+	Control2().Write(MSP430_ADC12_Control2::Resolution::Of<2>());
+	InterruptEnables().Write(0);
+	InterruptFlags().Write(0);
+
+	// Sequence: the channel list in rounds, ADC12EOS on the last memory (its flag triggers the DMA block)
+	for (unsigned char i = 0; i < this->sequenceLength; i++)
+	{
+		MemoryControl(i).Write(MSP430_ADC12_MemoryControl::Reference::Of(this->reference) | MSP430_ADC12_MemoryControl::Input::Of(this->channels[i % this->channelCount]) |
+			MSP430_ADC12_MemoryControl::EndOfSequence::Of(i == this->sequenceLength - 1));
+	}
+
+	this->dma.Initialize();
+	this->dma.SetSource(&ADC12MEM0);
+	this->dma.SetSize(this->sequenceLength);
+
+	// Reset/Set output: the channel 1 output rises at CCR0, once per period
+	if (this->reg_TxCTL.IsPresent())
+	{
+		this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+		MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 1).Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::ResetSet));
+		SetSampleRate(this->sampleRate);
+	}
+}
+
+/// <summary>Stop, turn the converter off, reset the DMA channel and the timer, give the analog pins back to GPIO</summary>
+void MSP430_ADC12::Deinitialize(void)
+{
+	Stop();
+	Control0().Reset();
+	this->dma.Deinitialize();
+	if (this->reg_TxCTL.IsPresent())
+	{
+		this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+		MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 1).Reset();
+	}
+
+	for (unsigned char i = 0; i < this->channelCount; i++)
+	{
+		SelectAnalogPin(this->channels[i], false);
+	}
+}
+
+/// <summary>Set the conversion rate (takes effect at once, timer triggers only)</summary>
+/// <param name="sampleRate">Conversions per second</param>
+void MSP430_ADC12::SetSampleRate(unsigned long sampleRate)
+{
+	this->sampleRate = sampleRate;
+	if (!this->reg_TxCTL.IsPresent())
+	{
+		return;
+	}
+
+	// SMCLK with the smallest input divider that fits the period into 16 bits, the trigger in the middle of the period
+	unsigned long period = MSP430_Timer::SetPeriodOnSMCLK(this->reg_TxCTL, sampleRate);
+	(this->reg_TxCTL + MSP430_Timer::OffsetCCR + 1).Write(static_cast<unsigned int> (period / 2));
+}
+
+/// <summary>Get the number of results per sequence (channel count x rounds)</summary>
+unsigned int MSP430_ADC12::GetSequenceLength(void) const
+{
+	return this->sequenceLength;
+}
+
+/// <summary>Start converting into the first half of a buffer</summary>
+/// <param name="buffer">Results (2 x length)</param>
+/// <param name="length">Results per half (a multiple of the sequence length)</param>
+void MSP430_ADC12::Start(unsigned int* buffer, unsigned int length)
+{
+	Stop();
+	unsigned int sequenceLength = this->sequenceLength;
+	length -= length % sequenceLength;
+	if (length == 0)
+	{
+		length = sequenceLength;
+	}
+	this->buffer = buffer;
+	this->end = buffer + 2 * length;
+	this->halfLength = length;
+	this->completed = buffer;
+
+	// The first sequence is loaded by Enable(), the second one when the first is copied (repeated block)
+	this->dma.SetDestination(buffer);
+	this->dma.ClearInterruptFlag();
+	this->dma.Enable();
+	this->queued = buffer + sequenceLength;
+	this->dma.SetDestination(this->queued);
+	this->dma.EnableInterrupt();
+
+	// Stop() cleared the sequence mode, the sequence starts from ADC12MEM0
+	InterruptFlags().Write(0);
+	Control1().Modify(MSP430_ADC12_Control1::Sequence::Of(MSP430_ADC12_Sequence::RepeatSequence));
+	Control0().Modify(MSP430_ADC12_Control0::Enable::On);
+	if (!this->reg_TxCTL.IsPresent())
+	{
+		Control0().Modify(MSP430_ADC12_Control0::Start::On);
+	}
+	else
+	{
+		// The trigger timer counts SMCLK, the low-power waits keep it running
+		this->smclk.Take();
+		MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0).Reset();
+		this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Up) | MSP430_Timer_Control::Clear::On);
+	}
+}
+
+/// <summary>Stop converting at once (the sequence in progress is dropped)</summary>
+void MSP430_ADC12::Stop(void)
+{
+	if (this->reg_TxCTL.IsPresent())
+	{
+		this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Stop));
+	}
+
+	// Single-channel mode with ADC12ENC cleared stops the sequence immediately
+	Control1().Modify(MSP430_ADC12_Control1::Sequence::Of(MSP430_ADC12_Sequence::Single));
+	Control0().Modify(MSP430_ADC12_Control0::Enable::Off);
+	this->dma.DisableInterrupt();
+	this->dma.Disable();
+	this->smclk.Release();
+}
+
+/// <summary>Check if the converter is streaming</summary>
+bool MSP430_ADC12::IsRunning(void)
+{
+	return Control0().Test(MSP430_ADC12_Control0::Enable::On) && this->dma.IsEnabled();
+}
+
+/// <summary>
+/// Account a copied sequence (Call it from the DMA channel's interrupt handler)
+/// <para>The DMA channel is already filling the next sequence. When a half is full it is returned,
+/// it can be read until the other half is returned (it is being filled meanwhile).</para>
+/// </summary>
+/// <return>First result of the full half, nullptr if no half was completed</return>
+unsigned int* MSP430_ADC12::Advance(void)
+{
+	// The destination after the sequence being copied now (loaded when it is done); pointer steps, no division in the interrupt
+	unsigned int sequenceLength = this->sequenceLength;
+	unsigned int* next = this->queued + sequenceLength;
+	if (next == this->end)
+	{
+		next = this->buffer;
+	}
+	this->dma.SetDestination(next);
+	this->queued = next;
+
+	unsigned int* completed = this->completed + sequenceLength;
+	if (completed == this->end)
+	{
+		completed = this->buffer;
+	}
+	this->completed = completed;
+
+	if (completed == this->buffer)
+	{
+		return this->buffer + this->halfLength;
+	}
+	if (completed == this->buffer + this->halfLength)
+	{
+		return this->buffer;
+	}
+	return nullptr;
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_timer.h"
+#include "msp430cp_dma.h"
+
+// ADC12_A sequence streaming
+// The converter runs a repeat sequence over a list of channels (repeated in rounds to fill up to 16 memories),
+// each conversion started by a rising edge of a timer output (or back-to-back at the converter speed). The end of
+// the sequence triggers a DMA block that copies all its memories into a ping-pong buffer, so the CPU only sees
+// one DMA interrupt per sequence and gets a finished half when one is full.
+//
+//     static const unsigned char inputs[] = { 0, 1, 2, 3 };              // A0-A3 (P6.0-P6.3)
+//     unsigned int samples[2 * 256];
+//     MSP430_ADC12 adc(inputs, 4, 4, MSP430_ADC12_Trigger::TB0_CCR1, 64000, 0);   // 16 kHz per input
+//
+//     adc.Initialize();
+//     adc.Start(samples, 256);
+//
+//     MSP430_DMA_INTERRUPT_HANDLER(0)
+//     {
+//         unsigned int* half = adc.Advance();                             // nullptr until a half is full
+//         if (half != nullptr)
+//         {
+//             Scheduler::Post<ProcessSamples>();                          // half[i] is input i % 4
+//         }
+//     }
+//
+// Post() requests the wake-up: the DMA interrupt routine leaves the low-power mode of the scheduler loop on exit.
+
+/// <summary>
+/// ADC12 conversion trigger (Results in ADC12SHSx bits)
+/// <para>NOTE: The trigger sources are device specific (MSP430F5529 here), see also the device's datasheet (ADC12_A trigger assignments).</para>
+/// </summary>
+enum class MSP430_ADC12_Trigger
+{
+	/// <summary>Conversions back-to-back at the converter speed (ADC12SC and ADC12MSC, no timer)</summary>
+	Continuous = 0,
+	/// <summary>Timer_A0 channel 1 output (TA0 in Up mode, owned by the converter while running)</summary>
+	TA0_CCR1 = 1,
+	/// <summary>Timer_B0 channel 1 output (TB0 in Up mode, owned by the converter while running)</summary>
+	TB0_CCR1 = 3
+};
+
+/// <summary>
+/// ADC12 reference (Results in ADC12SREFx bits)
+/// </summary>
+enum class MSP430_ADC12_Reference
+{
+	/// <summary>VR+ = AVCC, VR- = AVSS</summary>
+	AVcc = 0b000,
+	/// <summary>VR+ = VREF+ (the REF module must be enabled), VR- = AVSS</summary>
+	Internal = 0b001,
+	/// <summary>VR+ = VeREF+, VR- = AVSS</summary>
+	External = 0b010
+};
+
+/// <summary>
+/// ADC12 conversion sequence mode (Results in ADC12CONSEQx bits)
+/// </summary>
+enum class MSP430_ADC12_Sequence
+{
+	/// <summary>Single channel, single conversion</summary>
+	Single = 0b00,
+	/// <summary>Sequence of channels</summary>
+	Sequence = 0b01,
+	/// <summary>Repeated single channel</summary>
+	RepeatSingle = 0b10,
+	/// <summary>Repeated sequence of channels</summary>
+	RepeatSequence = 0b11
+};
+
+// Register fields
+/// <summary>
+/// ADC12 control register 0 fields (ADC12CTL0)
+/// </summary>
+struct MSP430_ADC12_Control0
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>Sample-and-hold time of ADC12MEM8-15 (ADC12SHT1x, 4 x 2^n clocks up to n = 5)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control0, 12, 4> SampleTime1;
+	/// <summary>Sample-and-hold time of ADC12MEM0-7 (ADC12SHT0x)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control0, 8, 4> SampleTime0;
+	/// <summary>Following conversions of a sequence start at once after the first trigger (ADC12MSC)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control0, 7, 1, bool> MultipleConversion;
+	/// <summary>Converter on (ADC12ON)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control0, 4, 1, bool> On;
+	/// <summary>Enable conversion (ADC12ENC, most settings only change while it is cleared)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control0, 1, 1, bool> Enable;
+	/// <summary>Start conversion (ADC12SC, software trigger)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control0, 0, 1, bool> Start;
+};
+
+/// <summary>
+/// ADC12 control register 1 fields (ADC12CTL1)
+/// </summary>
+struct MSP430_ADC12_Control1
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>First conversion memory (ADC12CSTARTADDx)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 12, 4> StartAddress;
+	/// <summary>Sample-and-hold source (ADC12SHSx)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 10, 2, MSP430_ADC12_Trigger> Trigger;
+	/// <summary>Pulse sample mode, the sample time comes from ADC12SHTx (ADC12SHP)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 9, 1, bool> SamplePulse;
+	/// <summary>Clock divider (ADC12DIVx, divide by n + 1)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 5, 3> ClockDivider;
+	/// <summary>Clock source (ADC12SSELx, 0: ADC12OSC)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 3, 2> ClockSource;
+	/// <summary>Conversion sequence mode (ADC12CONSEQx)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 1, 2, MSP430_ADC12_Sequence> Sequence;
+	/// <summary>Conversion in progress (ADC12BUSY, read only)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control1, 0, 1, bool> Busy;
+};
+
+/// <summary>
+/// ADC12 control register 2 fields (ADC12CTL2)
+/// </summary>
+struct MSP430_ADC12_Control2
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>Clock predivider by 4 (ADC12PDIV)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control2, 8, 1, bool> Predivide;
+	/// <summary>Resolution (ADC12RESx, 0: 8-bit, 1: 10-bit, 2: 12-bit)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control2, 4, 2> Resolution;
+	/// <summary>Signed (two's complement, left aligned) results (ADC12DF)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_Control2, 3, 1, bool> Signed;
+};
+
+/// <summary>
+/// ADC12 conversion memory control register fields (ADC12MCTLx)
+/// </summary>
+struct MSP430_ADC12_MemoryControl
+{
+	typedef unsigned char Type;
+	/// <summary>End of sequence (ADC12EOS)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_MemoryControl, 7, 1, bool> EndOfSequence;
+	/// <summary>Reference (ADC12SREFx)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_MemoryControl, 4, 3, MSP430_ADC12_Reference> Reference;
+	/// <summary>Input channel (ADC12INCHx)</summary>
+	typedef MSP430_RegisterField<MSP430_ADC12_MemoryControl, 0, 4> Input;
+};
+
+/// <summary>
+/// MSP430 ADC12_A streaming converter class (12-bit results, ADC12OSC clock, 8 clocks of sample time)
+/// <para>Uses the converter, one DMA channel (repeated block per sequence) and the trigger timer. The analog pins are
+/// selected by Initialize() (A0-A7 on P6, A12-A15 on P7, the other inputs are internal).</para>
+/// </summary>
+class MSP430_ADC12
+{
+private:
+	// Hardware for streaming
+	/// <summary>DMA channel (sequence memories to the buffer)</summary>
+	MSP430_DMA dma;
+	/// <summary>Timer control register (TxCTL) of the conversion clock (absent for continuous conversions)</summary>
+	MSP430_FieldRegister<MSP430_Timer_Control> reg_TxCTL;
+
+	// Corresponding converter configuration
+	/// <summary>Input channels (0-15)</summary>
+	const unsigned char* channels;
+	/// <summary>Number of input channels</summary>
+	unsigned char channelCount;
+	/// <summary>Memories of the sequence (channel count x rounds)</summary>
+	unsigned char sequenceLength;
+	/// <summary>Conversion trigger</summary>
+	MSP430_ADC12_Trigger trigger;
+	/// <summary>Reference of all channels</summary>
+	MSP430_ADC12_Reference reference;
+	/// <summary>Conversions per second (timer triggers)</summary>
+	unsigned long sampleRate;
+
+	// Streaming state
+	/// <summary>First result of the buffer</summary>
+	unsigned int* buffer = nullptr;
+	/// <summary>End of the buffer (after the second half)</summary>
+	unsigned int* end = nullptr;
+	/// <summary>Results per half (a multiple of the sequence length)</summary>
+	unsigned int halfLength = 0;
+	/// <summary>Destination loaded by the DMA channel after the sequence being copied</summary>
+	unsigned int* queued = nullptr;
+	/// <summary>End of the copied results</summary>
+	unsigned int* completed = nullptr;
+	/// <summary>SMCLK hold of the trigger timer from Start() to Stop()</summary>
+	MSP430_Clock_SMCLKHold smclk;
+
+public:
+	/// <summary>Number of conversion memories (ADC12MEM0-15)</summary>
+	static constexpr unsigned char MemoryCount = 16;
+
+	// Constructor
+	/// <summary>Create a new streaming converter object (No hardware operation)</summary>
+	/// <param name="channels">Input channels (0-15, kept by reference)</param>
+	/// <param name="channelCount">Number of input channels (1-16)</param>
+	/// <param name="rounds">Times the channel list is repeated in one sequence (channel count x rounds up to 16)</param>
+	/// <param name="trigger">Conversion trigger</param>
+	/// <param name="sampleRate">Conversions per second (timer triggers, each input is sampled at sampleRate / channelCount)</param>
+	/// <param name="channel">DMA channel</param>
+	/// <param name="reference">Reference of all channels</param>
+	MSP430_ADC12(const unsigned char* channels, unsigned char channelCount, unsigned char rounds, MSP430_ADC12_Trigger trigger, unsigned long sampleRate,
+		MSP430_DMA_Channel channel, MSP430_ADC12_Reference reference = MSP430_ADC12_Reference::AVcc);
+	/// <summary>Delete this converter instance, stop it and release the DMA channel, the timer and the analog pins</summary>
+	~MSP430_ADC12();
+
+	// Converter initialize or re-configuration
+	/// <summary>Select the analog pins, turn the converter on, load the sequence, initialize the DMA channel and the conversion clock (halted)</summary>
+	void Initialize(void);
+	/// <summary>Stop, turn the converter off, reset the DMA channel and the timer, give the analog pins back to GPIO</summary>
+	void Deinitialize(void);
+	/// <summary>Set the conversion rate (takes effect at once, timer triggers only)</summary>
+	/// <param name="sampleRate">Conversions per second</param>
+	void SetSampleRate(unsigned long sampleRate);
+	/// <summary>Get the number of results per sequence (channel count x rounds)</summary>
+	unsigned int GetSequenceLength(void) const;
+
+	// Streaming control
+	/// <summary>Start converting into the first half of a buffer</summary>
+	/// <param name="buffer">Results (2 x length)</param>
+	/// <param name="length">Results per half (a multiple of the sequence length)</param>
+	void Start(unsigned int* buffer, unsigned int length);
+	/// <summary>Stop converting at once (the sequence in progress is dropped)</summary>
+	void Stop(void);
+	/// <summary>Check if the converter is streaming</summary>
+	bool IsRunning(void);
+	/// <summary>
+	/// Account a copied sequence (Call it from the DMA channel's interrupt handler)
+	/// <para>The DMA channel is already filling the next sequence. When a half is full it is returned,
+	/// it can be read until the other half is returned (it is being filled meanwhile).</para>
+	/// </summary>
+	/// <return>First result of the full half, nullptr if no half was completed</return>
+	unsigned int* Advance(void);
+};
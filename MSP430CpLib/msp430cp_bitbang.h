@@ -0,0 +1,925 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_pin.h"
+#include "msp430cp_delay.h"
+
+// Bit-bang serial engines on compile-time pins
+// The bit loops of SPI, the parallel lanes and WS2812 are hand-scheduled inline assembly: every path of a bit
+// takes the same number of cycles, and the cycles left to the configured bit rate are padded with a DEC/JNZ
+// loop and NOPs counted at compile time from MSP430_Clock::MCLKFrequency. I2C and 1-Wire run microsecond timings,
+// so they use MSP430_Delay on the compile-time pins.
+//
+//     typedef MSP430_Pin<MSP430_GPIO_Port::P3, 0> SCK;
+//     typedef MSP430_Pin<MSP430_GPIO_Port::P3, 1> MOSI;
+//     typedef MSP430_Pin<MSP430_GPIO_Port::P3, 2, MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Input> MISO;
+//     typedef MSP430_BitBang_SPI<SCK, MOSI, MISO, 1000000> Flash;
+//
+//     Flash::Initialize();
+//     unsigned char id = Flash::Transfer(0x9F);
+//
+// Up to 8 streams on one port are shifted out in parallel, one MOV.B to PxOUT per bit slot; a slot byte holds
+// bit n of lane n (MSP430_BitBang::Transpose() turns 8 lane bytes into 8 slots):
+//
+//     typedef MSP430_BitBang_Lanes<MSP430_GPIO_Port::P6, 0x0F> Strips;   // 4 WS2812 strips on P6.0 - P6.3
+//     Strips::WriteWS2812(slots, 24 * pixels);
+//
+// NOTE: The cycle counts are the MSP430 CPU format I/II timings with indexed (x(Rn)) port addresses; the MSP430X
+// CPU executes some of these forms one cycle faster, which moves an edge by one MCLK cycle at most.
+
+/// <summary>Delay a compile-time number of cycles inside an assembly kernel (DEC/JNZ loop of 3 cycles per pass, then NOPs)</summary>
+/// <param name="LOOPS">Loop passes operand ("%c[...]", from MSP430_BitBang::PadLoops())</param>
+/// <param name="NOPS">NOP count operand ("%c[...]", from MSP430_BitBang::PadNops())</param>
+/// <param name="TMP">Scratch register operand</param>
+#define MSP430CP_BITBANG_PAD(LOOPS, NOPS, TMP) \
+	".if " LOOPS "\n\t" \
+	"mov #" LOOPS ", " TMP "\n" \
+	"9:\n\t" \
+	"dec " TMP "\n\t" \
+	"jnz 9b\n\t" \
+	".endif\n\t" \
+	".rept " NOPS "\n\t" \
+	"nop\n\t" \
+	".endr\n\t"
+
+/// <summary>
+/// Bit-bang timing helpers (all static)
+/// </summary>
+class MSP430_BitBang
+{
+public:
+	// Cycle conversion
+	/// <summary>MCLK cycles of one bit at a bit rate (rounded)</summary>
+	/// <param name="bitRate">Bit rate (bit/s)</param>
+	static constexpr unsigned long CyclesPerBit(unsigned long bitRate)
+	{
+		return (MSP430_Clock::MCLKFrequency + bitRate / 2) / bitRate;
+	}
+	/// <summary>MCLK cycles of a time in nanoseconds (rounded)</summary>
+	/// <param name="nanoseconds">Time (ns)</param>
+	static constexpr unsigned long CyclesOfNanoseconds(unsigned long nanoseconds)
+	{
+		return static_cast<unsigned long> ((static_cast<unsigned long long> (MSP430_Clock::MCLKFrequency) * nanoseconds + 500000000ULL) / 1000000000ULL);
+	}
+	/// <summary>Nanoseconds of a number of MCLK cycles (rounded down)</summary>
+	/// <param name="cycles">MCLK cycles</param>
+	static constexpr unsigned long NanosecondsOfCycles(unsigned long cycles)
+	{
+		return static_cast<unsigned long> (static_cast<unsigned long long> (cycles) * 1000000000ULL / MSP430_Clock::MCLKFrequency);
+	}
+
+	// Padding of the assembly kernels (MSP430CP_BITBANG_PAD)
+	/// <summary>Cycles of MOV #N, Rn (1 for the constant generator values)</summary>
+	/// <param name="value">Immediate value</param>
+	static constexpr unsigned long MoveCycles(unsigned long value)
+	{
+		return (value == 0 || value == 1 || value == 2 || value == 4 || value == 8) ? 1 : 2;
+	}
+	/// <summary>Loop passes of a pad (0: NOPs only)</summary>
+	/// <param name="cycles">Pad cycles</param>
+	static constexpr unsigned long PadLoops(unsigned long cycles)
+	{
+		return (cycles < 5) ? 0 : (cycles - 2) / 3;
+	}
+	/// <summary>NOPs of a pad after its loop</summary>
+	/// <param name="cycles">Pad cycles</param>
+	static constexpr unsigned long PadNops(unsigned long cycles)
+	{
+		return (PadLoops(cycles) == 0) ? cycles : cycles - MoveCycles(PadLoops(cycles)) - 3 * PadLoops(cycles);
+	}
+
+	// Interrupt-safe sections
+	/// <summary>Disable the interrupts</summary>
+	/// <return>GIE before the call (for RestoreInterrupts())</return>
+	static inline unsigned int DisableInterrupts(void)
+	{
+		unsigned int gie = __get_SR_register() & GIE;
+		__disable_interrupt();
+		__no_operation();
+		return gie;
+	}
+	/// <summary>Enable the interrupts again if they were enabled</summary>
+	/// <param name="gie">GIE returned by DisableInterrupts()</param>
+	static inline void RestoreInterrupts(unsigned int gie)
+	{
+		if (gie)
+		{
+			__enable_interrupt();
+		}
+	}
+
+	// Lane data
+	/// <summary>
+	/// Transpose 8 lane bytes into 8 bit slots (MSB first)
+	/// <para>Bit n of slots[k] is bit (7 - k) of bytes[n], so lane n goes out on port bit n.</para>
+	/// </summary>
+	/// <param name="bytes">One byte of each lane (lane n = port bit n)</param>
+	/// <param name="slots">Bit slots (8 bytes)</param>
+	static void Transpose(const unsigned char* bytes, unsigned char* slots)
+	{
+		for (unsigned char k = 0; k < 8; k++)
+		{
+			unsigned char slot = 0;
+			for (signed char n = 7; n >= 0; n--)
+			{
+				slot = static_cast<unsigned char> ((slot << 1) | ((bytes[n] >> (7 - k)) & 0x01));
+			}
+			slots[k] = slot;
+		}
+	}
+};
+
+/// <summary>
+/// WS2812 bit timing in MCLK cycles (800 kHz, T0H 0.4 us, T1H 0.8 us, +/-150 ns)
+/// <para>The kernels write HIGH at t = 0, the bit at t = High0 and LOW at t = High1: 8 cycles from HIGH to the bit
+/// (load and merge), 4 cycles from the bit to LOW, 7 cycles from LOW to the next HIGH.</para>
+/// </summary>
+struct MSP430_BitBang_WS2812Timing
+{
+	/// <summary>Cycles of a bit</summary>
+	static constexpr unsigned long Bit = MSP430_BitBang::CyclesOfNanoseconds(1250);
+	/// <summary>Cycles of the HIGH time of a 0 bit</summary>
+	static constexpr unsigned long High0 = (MSP430_BitBang::CyclesOfNanoseconds(400) < 8) ? 8 : MSP430_BitBang::CyclesOfNanoseconds(400);
+	/// <summary>Cycles of the HIGH time of a 1 bit</summary>
+	static constexpr unsigned long High1 = (MSP430_BitBang::CyclesOfNanoseconds(800) + 7 > Bit) ? Bit - 7 : MSP430_BitBang::CyclesOfNanoseconds(800);
+	/// <summary>The timing is within the tolerances at MSP430_Clock::MCLKFrequency (16 MHz or more)</summary>
+	static constexpr bool Valid = Bit >= 15 && MSP430_BitBang::NanosecondsOfCycles(High0) <= 550 &&
+		MSP430_BitBang::NanosecondsOfCycles(High1) >= 650 && High1 >= High0 + 4;
+
+	/// <summary>Cycles padded from HIGH to the bit</summary>
+	static constexpr unsigned long Pad0 = Valid ? High0 - 8 : 0;
+	/// <summary>Cycles padded from the bit to LOW</summary>
+	static constexpr unsigned long Pad1 = Valid ? High1 - High0 - 4 : 0;
+	/// <summary>Cycles padded from LOW to the next HIGH</summary>
+	static constexpr unsigned long Pad2 = Valid ? Bit - High1 - 7 : 0;
+};
+
+/// <summary>
+/// Absent pin of a bit-bang engine (e.g. MISO of a write-only SPI): reads as LOW(0), writes nothing
+/// </summary>
+struct MSP430_BitBang_NoPin
+{
+	/// <summary>Port (reads of the empty mask are harmless)</summary>
+	static constexpr MSP430_GPIO_Port Port = MSP430_GPIO_Port::P1;
+	/// <summary>Empty bit mask</summary>
+	static constexpr unsigned char Mask = 0;
+
+	static void Initialize(void)
+	{
+	}
+	static void Deinitialize(void)
+	{
+	}
+};
+
+/// <summary>
+/// SPI mode (clock polarity CPOL and clock phase CPHA)
+/// </summary>
+enum class MSP430_BitBang_SPIMode
+{
+	/// <summary>Clock idles LOW(0), data sampled on the rising edge</summary>
+	Mode0 = 0,
+	/// <summary>Clock idles LOW(0), data sampled on the falling edge</summary>
+	Mode1 = 1,
+	/// <summary>Clock idles HIGH(1), data sampled on the falling edge</summary>
+	Mode2 = 2,
+	/// <summary>Clock idles HIGH(1), data sampled on the rising edge</summary>
+	Mode3 = 3
+};
+
+/// <summary>
+/// MSP430 bit-bang SPI master (MSB first, all static)
+/// <para>Each bit takes exactly CyclesPerBit(bitRate) MCLK cycles: both data paths are one BIS.B/BIC.B and a jump,
+/// and the clock edges are XOR.B, so both polarities run the same code.</para>
+/// <para>NOTE: Bytes are separated by a few cycles of call overhead. The interrupts are not disabled (the bus is clocked).</para>
+/// </summary>
+/// <typeparam name="SCK">Clock pin (MSP430_Pin, output)</typeparam>
+/// <typeparam name="MOSI">Data output pin (MSP430_Pin, output)</typeparam>
+/// <typeparam name="MISO">Data input pin (MSP430_Pin, input) or MSP430_BitBang_NoPin</typeparam>
+/// <typeparam name="bitRate">Bit rate (Hz)</typeparam>
+/// <typeparam name="mode">SPI mode</typeparam>
+template <typename SCK, typename MOSI, typename MISO, unsigned long bitRate, MSP430_BitBang_SPIMode mode = MSP430_BitBang_SPIMode::Mode0>
+class MSP430_BitBang_SPI
+{
+private:
+	typedef MSP430_GPIO_PortRegisters<SCK::Port> SCKRegisters;
+	typedef MSP430_GPIO_PortRegisters<MOSI::Port> MOSIRegisters;
+	typedef MSP430_GPIO_PortRegisters<MISO::Port> MISORegisters;
+
+	static constexpr bool CPOL = (static_cast<unsigned char> (mode) & 0x02) != 0;
+	static constexpr bool CPHA = (static_cast<unsigned char> (mode) & 0x01) != 0;
+
+	/// <summary>Extra cycle of an immediate mask outside the constant generator</summary>
+	static constexpr unsigned long Immediate(unsigned char mask)
+	{
+		return (mask == 0 || mask == 1 || mask == 2 || mask == 4 || mask == 8) ? 0 : 1;
+	}
+
+	// Kernel cycles between the edges (without padding)
+	// CPHA = 0: [data out] pad A [leading edge] [sample] pad B [trailing edge]
+	// CPHA = 1: [leading edge] [data out] pad A [trailing edge] [sample] pad B
+	static constexpr unsigned long EdgeCycles = 4 + Immediate(SCK::Mask);
+	static constexpr unsigned long DataCycles = 9 + Immediate(MOSI::Mask);
+	static constexpr unsigned long SampleCycles = 5 + Immediate(MISO::Mask);
+	/// <summary>Cycles from the leading to the trailing edge without padding</summary>
+	static constexpr unsigned long LeadingMinimum = CPHA ? DataCycles + EdgeCycles : SampleCycles + EdgeCycles;
+	/// <summary>Cycles from the trailing to the next leading edge without padding (DEC/JNZ included)</summary>
+	static constexpr unsigned long TrailingMinimum = CPHA ? SampleCycles + 3 + EdgeCycles : 3 + DataCycles + EdgeCycles;
+
+	static constexpr unsigned long Bit = MSP430_BitBang::CyclesPerBit(bitRate);
+	static_assert(Bit >= LeadingMinimum + TrailingMinimum, "SPI bit rate is too high for CLOCK_MCLK_FREQUENCY");
+
+	/// <summary>Cycles from the leading to the trailing edge (half a bit, skewed when a half is below its minimum)</summary>
+	static constexpr unsigned long Leading = (Bit / 2 < LeadingMinimum) ? LeadingMinimum :
+		((Bit - Bit / 2 < TrailingMinimum) ? Bit - TrailingMinimum : Bit / 2);
+	static constexpr unsigned long Trailing = Bit - Leading;
+
+	static constexpr unsigned long PadA = CPHA ? Leading - LeadingMinimum : Trailing - TrailingMinimum;
+	static constexpr unsigned long PadB = CPHA ? Trailing - TrailingMinimum : Leading - LeadingMinimum;
+
+public:
+	// SPI initialize
+	/// <summary>Initialize the pins and set the clock to its idle level</summary>
+	static void Initialize(void)
+	{
+		SCK::Initialize();
+		MOSI::Initialize();
+		MISO::Initialize();
+		SCK::SetValue(CPOL ? 1 : 0);
+		MOSI::SetLow();
+	}
+	/// <summary>Deinitialize the pins</summary>
+	static void Deinitialize(void)
+	{
+		SCK::Deinitialize();
+		MOSI::Deinitialize();
+		MISO::Deinitialize();
+	}
+
+	// Transfer
+	/// <summary>Shift one byte out and one byte in</summary>
+	/// <param name="value">Byte to send</param>
+	/// <return>Byte received (0 without MISO)</return>
+	static unsigned char Transfer(unsigned char value)
+	{
+#ifdef MSP430CP_HOST
+		unsigned char rx = 0;
+		for (unsigned char bit = 0; bit < 8; bit++)
+		{
+			if (CPHA)
+			{
+				SCKRegisters::PxOUT().Toggle(SCK::Mask);
+			}
+			if (value & 0x80)
+			{
+				MOSIRegisters::PxOUT().Set(MOSI::Mask);
+			}
+			else
+			{
+				MOSIRegisters::PxOUT().Clear(MOSI::Mask);
+			}
+			value <<= 1;
+			__delay_cycles(PadA);
+			SCKRegisters::PxOUT().Toggle(SCK::Mask);
+			rx = static_cast<unsigned char> ((rx << 1) | (MISORegisters::PxIN().Test(MISO::Mask) ? 1 : 0));
+			__delay_cycles(PadB);
+			if (!CPHA)
+			{
+				SCKRegisters::PxOUT().Toggle(SCK::Mask);
+			}
+		}
+		return rx;
+#else
+		unsigned int tx = value;
+		unsigned int rx = 0;
+		unsigned int count = 8;
+		unsigned int tmp;
+		__asm__ __volatile__(
+			"1:\n\t"
+			".if %c[cpha]\n\t"
+			"xor.b %[sck], 0(%[sckOut])\n\t"
+			".endif\n\t"
+			"rla.b %[tx]\n\t"
+			"jc 2f\n\t"
+			"bic.b %[mosi], 0(%[mosiOut])\n\t"
+			"jmp 3f\n"
+			"2:\n\t"
+			"bis.b %[mosi], 0(%[mosiOut])\n\t"
+			"jmp 3f\n"
+			"3:\n\t"
+			MSP430CP_BITBANG_PAD("%c[padALoops]", "%c[padANops]", "%[tmp]")
+			"xor.b %[sck], 0(%[sckOut])\n\t"
+			"bit.b %[miso], 0(%[misoIn])\n\t"
+			"rlc.b %[rx]\n\t"
+			MSP430CP_BITBANG_PAD("%c[padBLoops]", "%c[padBNops]", "%[tmp]")
+			".if %c[cpha] == 0\n\t"
+			"xor.b %[sck], 0(%[sckOut])\n\t"
+			".endif\n\t"
+			"dec %[count]\n\t"
+			"jnz 1b\n\t"
+			: [tx] "+r" (tx), [rx] "+r" (rx), [count] "+r" (count), [tmp] "=&r" (tmp)
+			: [sckOut] "r" (SCKRegisters::PxOUT().Address()), [mosiOut] "r" (MOSIRegisters::PxOUT().Address()),
+			  [misoIn] "r" (MISORegisters::PxIN().Address()),
+			  [sck] "i" (SCK::Mask), [mosi] "i" (MOSI::Mask), [miso] "i" (MISO::Mask), [cpha] "i" (CPHA ? 1 : 0),
+			  [padALoops] "i" (MSP430_BitBang::PadLoops(PadA)), [padANops] "i" (MSP430_BitBang::PadNops(PadA)),
+			  [padBLoops] "i" (MSP430_BitBang::PadLoops(PadB)), [padBNops] "i" (MSP430_BitBang::PadNops(PadB))
+			: "memory");
+		return static_cast<unsigned char> (rx);
+#endif
+	}
+	/// <summary>Shift a buffer out and receive into another one</summary>
+	/// <param name="tx">Bytes to send</param>
+	/// <param name="rx">Received bytes (nullptr to drop them, may be the same as tx)</param>
+	/// <param name="length">Number of bytes</param>
+	static void Transfer(const unsigned char* tx, unsigned char* rx, unsigned int length)
+	{
+		for (unsigned int i = 0; i < length; i++)
+		{
+			unsigned char value = Transfer(tx[i]);
+			if (rx != nullptr)
+			{
+				rx[i] = value;
+			}
+		}
+	}
+	/// <summary>Shift a buffer out</summary>
+	/// <param name="data">Bytes to send</param>
+	/// <param name="length">Number of bytes</param>
+	static void Write(const unsigned char* data, unsigned int length)
+	{
+		Transfer(data, nullptr, length);
+	}
+};
+
+/// <summary>
+/// MSP430 bit-bang I2C master (open drain, all static)
+/// <para>A pin is pulled LOW(0) by switching it to output (PxOUT stays 0) and released to the external pullup by
+/// switching it to input. SCL is waited for after every release, so slaves may stretch the clock.</para>
+/// </summary>
+/// <typeparam name="SCL">Clock pin (MSP430_Pin, initialized as input)</typeparam>
+/// <typeparam name="SDA">Data pin (MSP430_Pin, initialized as input)</typeparam>
+/// <typeparam name="bitRate">Bit rate (Hz, 100000 or 400000)</typeparam>
+template <typename SCL, typename SDA, unsigned long bitRate = 100000>
+class MSP430_BitBang_I2C
+{
+private:
+	/// <summary>Cycles of the pin operations between two half-bit delays</summary>
+	static constexpr unsigned long Overhead = 10;
+	/// <summary>Cycles of a half bit minus the pin operations</summary>
+	static constexpr unsigned long Half = (MSP430_BitBang::CyclesPerBit(bitRate) / 2 > Overhead) ? MSP430_BitBang::CyclesPerBit(bitRate) / 2 - Overhead : 0;
+
+	static void Delay(void)
+	{
+		__delay_cycles(Half);
+	}
+	/// <summary>Release SCL and wait while a slave stretches it</summary>
+	/// <return>SCL is HIGH(1)</return>
+	static bool ReleaseClock(void)
+	{
+		SCL::SetDirection(MSP430_GPIO_Direction::Input);
+		for (unsigned int i = 0; i < StretchLimit; i++)
+		{
+			if (SCL::CheckHigh())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	/// <summary>Send one bit</summary>
+	/// <return>No clock stretching timeout</return>
+	static bool WriteBit(bool bit)
+	{
+		SDA::SetDirection(bit ? MSP430_GPIO_Direction::Input : MSP430_GPIO_Direction::Output);
+		Delay();
+		bool released = ReleaseClock();
+		Delay();
+		SCL::SetDirection(MSP430_GPIO_Direction::Output);
+		return released;
+	}
+	/// <summary>Receive one bit (a stretching timeout reads HIGH(1))</summary>
+	static bool ReadBit(void)
+	{
+		SDA::SetDirection(MSP430_GPIO_Direction::Input);
+		Delay();
+		bool released = ReleaseClock();
+		Delay();
+		bool bit = !released || SDA::CheckHigh();
+		SCL::SetDirection(MSP430_GPIO_Direction::Output);
+		return bit;
+	}
+
+public:
+	/// <summary>SCL polls before a clock stretching timeout</summary>
+	static constexpr unsigned int StretchLimit = 1000;
+
+	// I2C initialize
+	/// <summary>Initialize the pins and release the bus</summary>
+	static void Initialize(void)
+	{
+		SCL::Initialize();
+		SDA::Initialize();
+		SCL::SetLow();
+		SDA::SetLow();
+		SCL::SetDirection(MSP430_GPIO_Direction::Input);
+		SDA::SetDirection(MSP430_GPIO_Direction::Input);
+	}
+	/// <summary>Deinitialize the pins</summary>
+	static void Deinitialize(void)
+	{
+		SCL::Deinitialize();
+		SDA::Deinitialize();
+	}
+
+	// Bus conditions
+	/// <summary>Send a START condition (or a repeated START after a transfer)</summary>
+	static void Start(void)
+	{
+		SDA::SetDirection(MSP430_GPIO_Direction::Input);
+		ReleaseClock();
+		Delay();
+		SDA::SetDirection(MSP430_GPIO_Direction::Output);
+		Delay();
+		SCL::SetDirection(MSP430_GPIO_Direction::Output);
+	}
+	/// <summary>Send a STOP condition and release the bus</summary>
+	static void Stop(void)
+	{
+		SDA::SetDirection(MSP430_GPIO_Direction::Output);
+		Delay();
+		ReleaseClock();
+		Delay();
+		SDA::SetDirection(MSP430_GPIO_Direction::Input);
+		Delay();
+	}
+
+	// Byte transfer
+	/// <summary>Send one byte</summary>
+	/// <param name="value">Byte to send</param>
+	/// <return>The slave acknowledged it (false: NACK or clock stretching timeout)</return>
+	static bool Write(unsigned char value)
+	{
+		bool released = true;
+		for (unsigned char bit = 0x80; bit; bit >>= 1)
+		{
+			released = WriteBit((value & bit) != 0) && released;
+		}
+		return !ReadBit() && released;
+	}
+	/// <summary>Receive one byte</summary>
+	/// <param name="ack">Acknowledge it (false: NACK, the last byte of a read)</param>
+	/// <return>Byte received</return>
+	static unsigned char Read(bool ack)
+	{
+		unsigned char value = 0;
+		for (unsigned char bit = 0; bit < 8; bit++)
+		{
+			value = static_cast<unsigned char> ((value << 1) | (ReadBit() ? 1 : 0));
+		}
+		WriteBit(!ack);
+		return value;
+	}
+
+	// Transactions
+	/// <summary>Write a buffer to a slave (START, address, data, STOP)</summary>
+	/// <param name="address">7-bit slave address</param>
+	/// <param name="data">Bytes to send</param>
+	/// <param name="length">Number of bytes</param>
+	/// <return>Every byte was acknowledged</return>
+	static bool Write(unsigned char address, const unsigned char* data, unsigned int length)
+	{
+		Start();
+		bool ack = Write(static_cast<unsigned char> (address << 1));
+		for (unsigned int i = 0; ack && i < length; i++)
+		{
+			ack = Write(data[i]);
+		}
+		Stop();
+		return ack;
+	}
+	/// <summary>Read a buffer from a slave (START, address, data, STOP)</summary>
+	/// <param name="address">7-bit slave address</param>
+	/// <param name="data">Received bytes</param>
+	/// <param name="length">Number of bytes</param>
+	/// <return>The slave acknowledged its address</return>
+	static bool Read(unsigned char address, unsigned char* data, unsigned int length)
+	{
+		Start();
+		bool ack = Write(static_cast<unsigned char> ((address << 1) | 0x01));
+		for (unsigned int i = 0; ack && i < length; i++)
+		{
+			data[i] = Read(i + 1 < length);
+		}
+		Stop();
+		return ack;
+	}
+};
+
+/// <summary>
+/// MSP430 bit-bang 1-Wire master (standard speed, open drain, all static)
+/// <para>Each time slot runs with the interrupts disabled (up to 70 us, reset pulse 480 us with interrupts enabled).
+/// The bus needs an external pullup (4.7 kOhm).</para>
+/// </summary>
+/// <typeparam name="DQ">Data pin (MSP430_Pin, initialized as input)</typeparam>
+template <typename DQ>
+class MSP430_BitBang_OneWire
+{
+private:
+	static void Low(void)
+	{
+		DQ::SetDirection(MSP430_GPIO_Direction::Output);
+	}
+	static void Release(void)
+	{
+		DQ::SetDirection(MSP430_GPIO_Direction::Input);
+	}
+
+public:
+	// 1-Wire initialize
+	/// <summary>Initialize the pin and release the bus</summary>
+	static void Initialize(void)
+	{
+		DQ::Initialize();
+		DQ::SetLow();
+		Release();
+	}
+	/// <summary>Deinitialize the pin</summary>
+	static void Deinitialize(void)
+	{
+		DQ::Deinitialize();
+	}
+
+	// Bus operation
+	/// <summary>Send a reset pulse and detect a presence pulse</summary>
+	/// <return>A device answered</return>
+	static bool Reset(void)
+	{
+		Low();
+		MSP430_Delay::Microseconds<480>();
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		Release();
+		MSP430_Delay::Microseconds<70>();
+		bool present = DQ::CheckLow();
+		MSP430_BitBang::RestoreInterrupts(gie);
+		MSP430_Delay::Microseconds<410>();
+		return present;
+	}
+	/// <summary>Write one time slot</summary>
+	/// <param name="bit">Bit to send</param>
+	static void WriteBit(bool bit)
+	{
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		Low();
+		if (bit)
+		{
+			MSP430_Delay::Microseconds<6>();
+			Release();
+			MSP430_Delay::Microseconds<64>();
+		}
+		else
+		{
+			MSP430_Delay::Microseconds<60>();
+			Release();
+			MSP430_Delay::Microseconds<10>();
+		}
+		MSP430_BitBang::RestoreInterrupts(gie);
+	}
+	/// <summary>Read one time slot</summary>
+	static bool ReadBit(void)
+	{
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		Low();
+		MSP430_Delay::Microseconds<6>();
+		Release();
+		MSP430_Delay::Microseconds<9>();
+		bool bit = DQ::CheckHigh();
+		MSP430_Delay::Microseconds<55>();
+		MSP430_BitBang::RestoreInterrupts(gie);
+		return bit;
+	}
+	/// <summary>Write one byte (LSB first)</summary>
+	/// <param name="value">Byte to send</param>
+	static void Write(unsigned char value)
+	{
+		for (unsigned char bit = 0; bit < 8; bit++)
+		{
+			WriteBit((value & 0x01) != 0);
+			value >>= 1;
+		}
+	}
+	/// <summary>Read one byte (LSB first)</summary>
+	static unsigned char Read(void)
+	{
+		unsigned char value = 0;
+		for (unsigned char bit = 0; bit < 8; bit++)
+		{
+			value >>= 1;
+			if (ReadBit())
+			{
+				value |= 0x80;
+			}
+		}
+		return value;
+	}
+
+	/// <summary>Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1) of a buffer (0 over a ROM code or scratchpad including its CRC)</summary>
+	/// <param name="data">Bytes</param>
+	/// <param name="length">Number of bytes</param>
+	static unsigned char CRC8(const unsigned char* data, unsigned int length)
+	{
+		unsigned char crc = 0;
+		for (unsigned int i = 0; i < length; i++)
+		{
+			crc ^= data[i];
+			for (unsigned char bit = 0; bit < 8; bit++)
+			{
+				crc = (crc & 0x01) ? static_cast<unsigned char> ((crc >> 1) ^ 0x8C) : static_cast<unsigned char> (crc >> 1);
+			}
+		}
+		return crc;
+	}
+};
+
+/// <summary>
+/// MSP430 bit-bang WS2812 (NeoPixel) output on a single pin (all static)
+/// <para>The bytes go out MSB first as stored (GRB for WS2812B). The interrupts are disabled during Write()
+/// (30 us per LED); keep the pin LOW(0) for 50 us or more between frames.</para>
+/// <para>NOTE: Needs MCLK of 16 MHz or more (CLOCK_MCLK_FREQUENCY).</para>
+/// </summary>
+/// <typeparam name="DIN">Data pin (MSP430_Pin, output)</typeparam>
+template <typename DIN>
+class MSP430_BitBang_WS2812
+{
+private:
+	typedef MSP430_GPIO_PortRegisters<DIN::Port> Registers;
+	typedef MSP430_BitBang_WS2812Timing Timing;
+	static_assert(DIN::Mask != 0 && Timing::Valid, "WS2812 needs CLOCK_MCLK_FREQUENCY of 16 MHz or more");
+
+public:
+	/// <summary>Initialize the pin (LOW(0))</summary>
+	static void Initialize(void)
+	{
+		DIN::Initialize();
+		DIN::SetLow();
+	}
+	/// <summary>Deinitialize the pin</summary>
+	static void Deinitialize(void)
+	{
+		DIN::Deinitialize();
+	}
+
+	/// <summary>Send a frame (the extra cycles between bytes lengthen the LOW time of bit 0)</summary>
+	/// <param name="data">Bytes (3 per LED)</param>
+	/// <param name="length">Number of bytes</param>
+	static void Write(const unsigned char* data, unsigned int length)
+	{
+		if (length == 0)
+		{
+			return;
+		}
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		unsigned int low = Registers::PxOUT().Read(static_cast<unsigned char> (~DIN::Mask));
+		unsigned int high = low | DIN::Mask;
+#ifdef MSP430CP_HOST
+		for (unsigned int i = 0; i < length; i++)
+		{
+			for (unsigned char bit = 0x80; bit; bit >>= 1)
+			{
+				Registers::PxOUT().Write(static_cast<unsigned char> (high));
+				Registers::PxOUT().Write(static_cast<unsigned char> ((data[i] & bit) ? high : low));
+				Registers::PxOUT().Write(static_cast<unsigned char> (low));
+			}
+		}
+		__delay_cycles(Timing::Bit * 8 * length);
+#else
+		unsigned int pin = DIN::Mask;
+		unsigned int value;
+		unsigned int level;
+		unsigned int bits;
+		unsigned int tmp;
+		// The bit is HIGH ^ (pin if the bit is 0): SUBC.B of a register from itself gives 0x00 after a carry, 0xFF without
+		__asm__ __volatile__(
+			"1:\n\t"
+			"mov.b @%[data]+, %[value]\n\t"
+			"mov #8, %[bits]\n"
+			"2:\n\t"
+			"mov.b %[high], 0(%[out])\n\t"
+			"rla.b %[value]\n\t"
+			"subc.b %[level], %[level]\n\t"
+			"and.b %[pin], %[level]\n\t"
+			"xor.b %[high], %[level]\n\t"
+			MSP430CP_BITBANG_PAD("%c[pad0Loops]", "%c[pad0Nops]", "%[tmp]")
+			"mov.b %[level], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[pad1Loops]", "%c[pad1Nops]", "%[tmp]")
+			"mov.b %[low], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[pad2Loops]", "%c[pad2Nops]", "%[tmp]")
+			"dec %[bits]\n\t"
+			"jnz 2b\n\t"
+			"dec %[length]\n\t"
+			"jnz 1b\n\t"
+			: [data] "+r" (data), [length] "+r" (length), [value] "=&r" (value), [level] "=&r" (level), [bits] "=&r" (bits), [tmp] "=&r" (tmp)
+			: [out] "r" (Registers::PxOUT().Address()), [high] "r" (high), [low] "r" (low), [pin] "r" (pin),
+			  [pad0Loops] "i" (MSP430_BitBang::PadLoops(Timing::Pad0)), [pad0Nops] "i" (MSP430_BitBang::PadNops(Timing::Pad0)),
+			  [pad1Loops] "i" (MSP430_BitBang::PadLoops(Timing::Pad1)), [pad1Nops] "i" (MSP430_BitBang::PadNops(Timing::Pad1)),
+			  [pad2Loops] "i" (MSP430_BitBang::PadLoops(Timing::Pad2)), [pad2Nops] "i" (MSP430_BitBang::PadNops(Timing::Pad2))
+			: "memory");
+#endif
+		MSP430_BitBang::RestoreInterrupts(gie);
+	}
+};
+
+/// <summary>
+/// MSP430 parallel bit-bang lanes: up to 8 streams on the pins of one port (all static)
+/// <para>Each bit slot is one byte of the slot buffer (bit n = lane on port bit n) and reaches the pins with one
+/// MOV.B to PxOUT, merged with the other pins of the port sampled at the start of the transfer.</para>
+/// <para>NOTE: The interrupts are disabled during a transfer, so no handler changes the other pins of the port meanwhile.</para>
+/// </summary>
+/// <typeparam name="port">GPIO port</typeparam>
+/// <typeparam name="laneMask">Pins of the lanes</typeparam>
+template <MSP430_GPIO_Port port, unsigned char laneMask>
+class MSP430_BitBang_Lanes
+{
+	static_assert(MSP430_Device::HasPort(static_cast<unsigned char> (port)), "The device does not have this port");
+
+private:
+	typedef MSP430_GPIO_PortRegisters<port> Registers;
+	typedef MSP430_BitBang_WS2812Timing Timing;
+
+public:
+	/// <summary>Pins of the lanes</summary>
+	static constexpr unsigned char Mask = laneMask;
+
+	/// <summary>Initialize the lane pins as outputs at LOW(0)</summary>
+	static void Initialize(void)
+	{
+		Registers::PxOUT().Clear(laneMask);
+		Registers::PxSEL().Clear(laneMask);
+		Registers::PxDIR().Set(laneMask);
+	}
+	/// <summary>Release the lane pins (inputs)</summary>
+	static void Deinitialize(void)
+	{
+		Registers::PxDIR().Clear(laneMask);
+	}
+
+	/// <summary>
+	/// Write bit slots at a fixed slot rate (one MOV.B every CyclesPerBit(slotRate) MCLK cycles, 11 cycles or more)
+	/// <para>The lanes keep the level of the last slot.</para>
+	/// </summary>
+	/// <typeparam name="slotRate">Slot rate (Hz)</typeparam>
+	/// <param name="slots">Bit slots</param>
+	/// <param name="count">Number of slots</param>
+	template <unsigned long slotRate>
+	static void Write(const unsigned char* slots, unsigned int count)
+	{
+		constexpr unsigned long Slot = MSP430_BitBang::CyclesPerBit(slotRate);
+		static_assert(Slot >= 11, "Slot rate is too high for CLOCK_MCLK_FREQUENCY");
+
+		if (count == 0)
+		{
+			return;
+		}
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		unsigned int base = Registers::PxOUT().Read(static_cast<unsigned char> (~laneMask));
+#ifdef MSP430CP_HOST
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Registers::PxOUT().Write(static_cast<unsigned char> ((slots[i] & laneMask) | base));
+		}
+		__delay_cycles(Slot * count);
+#else
+		constexpr unsigned long Pad = Slot - 11;
+		unsigned int mask = laneMask;
+		unsigned int data;
+		unsigned int tmp;
+		__asm__ __volatile__(
+			"1:\n\t"
+			"mov.b @%[slots]+, %[data]\n\t"
+			"and.b %[mask], %[data]\n\t"
+			"bis.b %[base], %[data]\n\t"
+			"mov.b %[data], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[padLoops]", "%c[padNops]", "%[tmp]")
+			"dec %[count]\n\t"
+			"jnz 1b\n\t"
+			: [slots] "+r" (slots), [count] "+r" (count), [data] "=&r" (data), [tmp] "=&r" (tmp)
+			: [out] "r" (Registers::PxOUT().Address()), [base] "r" (base), [mask] "r" (mask),
+			  [padLoops] "i" (MSP430_BitBang::PadLoops(Pad)), [padNops] "i" (MSP430_BitBang::PadNops(Pad))
+			: "memory");
+#endif
+		MSP430_BitBang::RestoreInterrupts(gie);
+	}
+
+	/// <summary>
+	/// Write bit slots with a shared clock on the same port (SPI mode 0: data and falling clock in one MOV.B, rising clock by BIS.B)
+	/// <para>The clock idles LOW(0) and is LOW(0) again after the last slot.</para>
+	/// </summary>
+	/// <typeparam name="clockPin">Clock pin on the port (not a lane, initialized as output LOW(0))</typeparam>
+	/// <typeparam name="bitRate">Bit rate (Hz)</typeparam>
+	/// <param name="slots">Bit slots</param>
+	/// <param name="count">Number of slots</param>
+	template <MSP430_GPIO_Pin clockPin, unsigned long bitRate>
+	static void WriteClocked(const unsigned char* slots, unsigned int count)
+	{
+		static_assert(clockPin < 8 && (laneMask & (1 << clockPin)) == 0, "The clock pin must be on the port and not a lane");
+		constexpr unsigned long Bit = MSP430_BitBang::CyclesPerBit(bitRate);
+		// LOW phase: pad A + BIS.B (4), HIGH phase: pad B + DEC/JNZ (3) + load and merge (4) + MOV.B (4)
+		static_assert(Bit >= 15, "Bit rate is too high for CLOCK_MCLK_FREQUENCY");
+
+		if (count == 0)
+		{
+			return;
+		}
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		unsigned int base = Registers::PxOUT().Read(static_cast<unsigned char> (~(laneMask | (1 << clockPin))));
+#ifdef MSP430CP_HOST
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Registers::PxOUT().Write(static_cast<unsigned char> ((slots[i] & laneMask) | base));
+			Registers::PxOUT().Set(static_cast<unsigned char> (1 << clockPin));
+		}
+		Registers::PxOUT().Clear(static_cast<unsigned char> (1 << clockPin));
+		__delay_cycles(Bit * count);
+#else
+		constexpr unsigned long Low = (Bit / 2 < 4) ? 4 : ((Bit - Bit / 2 < 11) ? Bit - 11 : Bit / 2);
+		constexpr unsigned long PadA = Low - 4;
+		constexpr unsigned long PadB = (Bit - Low) - 11;
+		unsigned int mask = laneMask;
+		unsigned int data;
+		unsigned int tmp;
+		__asm__ __volatile__(
+			"1:\n\t"
+			"mov.b @%[slots]+, %[data]\n\t"
+			"and.b %[mask], %[data]\n\t"
+			"bis.b %[base], %[data]\n\t"
+			"mov.b %[data], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[padALoops]", "%c[padANops]", "%[tmp]")
+			"bis.b %[clock], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[padBLoops]", "%c[padBNops]", "%[tmp]")
+			"dec %[count]\n\t"
+			"jnz 1b\n\t"
+			"bic.b %[clock], 0(%[out])\n\t"
+			: [slots] "+r" (slots), [count] "+r" (count), [data] "=&r" (data), [tmp] "=&r" (tmp)
+			: [out] "r" (Registers::PxOUT().Address()), [base] "r" (base), [mask] "r" (mask), [clock] "r" (1u << clockPin),
+			  [padALoops] "i" (MSP430_BitBang::PadLoops(PadA)), [padANops] "i" (MSP430_BitBang::PadNops(PadA)),
+			  [padBLoops] "i" (MSP430_BitBang::PadLoops(PadB)), [padBNops] "i" (MSP430_BitBang::PadNops(PadB))
+			: "memory");
+#endif
+		MSP430_BitBang::RestoreInterrupts(gie);
+	}
+
+	/// <summary>
+	/// Write WS2812 bit slots to all lanes (HIGH for every lane, the slot, LOW: 3 MOV.B per bit, one of them the slot)
+	/// <para>24 slots per LED (MSP430_BitBang::Transpose() of the G, R, B bytes of the lanes).</para>
+	/// <para>NOTE: Needs MCLK of 16 MHz or more (CLOCK_MCLK_FREQUENCY).</para>
+	/// </summary>
+	/// <param name="slots">Bit slots</param>
+	/// <param name="count">Number of slots</param>
+	static void WriteWS2812(const unsigned char* slots, unsigned int count)
+	{
+		static_assert(laneMask != 0 && Timing::Valid, "WS2812 needs CLOCK_MCLK_FREQUENCY of 16 MHz or more");
+
+		if (count == 0)
+		{
+			return;
+		}
+		unsigned int gie = MSP430_BitBang::DisableInterrupts();
+		unsigned int low = Registers::PxOUT().Read(static_cast<unsigned char> (~laneMask));
+		unsigned int high = low | laneMask;
+#ifdef MSP430CP_HOST
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Registers::PxOUT().Write(static_cast<unsigned char> (high));
+			Registers::PxOUT().Write(static_cast<unsigned char> ((slots[i] & laneMask) | low));
+			Registers::PxOUT().Write(static_cast<unsigned char> (low));
+		}
+		__delay_cycles(Timing::Bit * count);
+#else
+		unsigned int mask = laneMask;
+		unsigned int data;
+		unsigned int tmp;
+		__asm__ __volatile__(
+			"1:\n\t"
+			"mov.b %[high], 0(%[out])\n\t"
+			"mov.b @%[slots]+, %[data]\n\t"
+			"and.b %[mask], %[data]\n\t"
+			"bis.b %[low], %[data]\n\t"
+			MSP430CP_BITBANG_PAD("%c[pad0Loops]", "%c[pad0Nops]", "%[tmp]")
+			"mov.b %[data], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[pad1Loops]", "%c[pad1Nops]", "%[tmp]")
+			"mov.b %[low], 0(%[out])\n\t"
+			MSP430CP_BITBANG_PAD("%c[pad2Loops]", "%c[pad2Nops]", "%[tmp]")
+			"dec %[count]\n\t"
+			"jnz 1b\n\t"
+			: [slots] "+r" (slots), [count] "+r" (count), [data] "=&r" (data), [tmp] "=&r" (tmp)
+			: [out] "r" (Registers::PxOUT().Address()), [high] "r" (high), [low] "r" (low), [mask] "r" (mask),
+			  [pad0Loops] "i" (MSP430_BitBang::PadLoops(Timing::Pad0)), [pad0Nops] "i" (MSP430_BitBang::PadNops(Timing::Pad0)),
+			  [pad1Loops] "i" (MSP430_BitBang::PadLoops(Timing::Pad1)), [pad1Nops] "i" (MSP430_BitBang::PadNops(Timing::Pad1)),
+			  [pad2Loops] "i" (MSP430_BitBang::PadLoops(Timing::Pad2)), [pad2Nops] "i" (MSP430_BitBang::PadNops(Timing::Pad2))
+			: "memory");
+#endif
+		MSP430_BitBang::RestoreInterrupts(gie);
+	}
+};
@@ -0,0 +1,215 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_clock.h"
+
+/// <summary>Tries of ClearFaults() before the DCO fault is reported</summary>
+static constexpr unsigned int FaultRetries = 64;
+
+/// <summary>Number of HoldSMCLK() requests</summary>
+static volatile unsigned char smclkHolders = 0;
+
+// UCS registers (constant addresses, absolute addressing)
+// The PMM registers stay on their names: the host register file raises the PMMIFG flags on named PMMCTL0_L/SVSMLCTL writes.
+/// <summary>UCS control register 0 (UCSCTL0)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control0> Control0(void)
+{
+	return &UCSCTL0;
+}
+/// <summary>UCS control register 1 (UCSCTL1)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control1> Control1(void)
+{
+	return &UCSCTL1;
+}
+/// <summary>UCS control register 2 (UCSCTL2)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control2> Control2(void)
+{
+	return &UCSCTL2;
+}
+/// <summary>UCS control register 3 (UCSCTL3)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control3> Control3(void)
+{
+	return &UCSCTL3;
+}
+/// <summary>UCS control register 4 (UCSCTL4)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control4> Control4(void)
+{
+	return &UCSCTL4;
+}
+/// <summary>UCS control register 5 (UCSCTL5)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control5> Control5(void)
+{
+	return &UCSCTL5;
+}
+/// <summary>UCS control register 7 (UCSCTL7)</summary>
+static inline MSP430_FieldRegister<MSP430_Clock_Control7> Control7(void)
+{
+	return &UCSCTL7;
+}
+/// <summary>Special function interrupt flags 1 (SFRIFG1)</summary>
+static inline MSP430_Register16 InterruptFlags1(void)
+{
+	return &SFRIFG1;
+}
+
+/// <summary>
+/// Apply the compile-time settings: raise the core voltage in steps (if needed), select the clock sources,
+/// lock the FLL, wait for it to settle, then lower the core voltage (if allowed)
+/// <para>Takes SettleCycles MCLK cycles (about 32 ms). Interrupts are untouched.</para>
+/// </summary>
+/// <return>The DCO fault flag is clear (false if the FLL did not lock in range)</return>
+bool MSP430_Clock::Initialize(void)
+{
+	// The core voltage goes up before MCLK does
+	if (GetCoreVoltage() < CoreVoltage)
+	{
+		SetCoreVoltage(CoreVoltage);
+	}
+
+	// FLL reference and ACLK from REFO, MCLK and SMCLK from DCOCLKDIV
+	Control3().Write(MSP430_Clock_Control3::Reference::Of(MSP430_Clock_Source::REFO));
+	Control4().Write(MSP430_Clock_Control4::ACLK::Of(MSP430_Clock_Source::REFO) | MSP430_Clock_Control4::SMCLK::Of(MSP430_Clock_Source::DCODIV) |
+		MSP430_Clock_Control4::MCLK::Of(MSP430_Clock_Source::DCODIV));
+	Control5().Write(MSP430_Clock_Control5::ACLKDivider::Of<ACLKDivider>() | MSP430_Clock_Control5::SMCLKDivider::Of<SMCLKDivider>());
+
+	// The FLL is disabled (SCG0) while the range and the multiplier change, the DCO taps start from the lowest
+	__bis_SR_register(SCG0);
+	Control0().Reset();
+	Control1().Write(MSP430_Clock_Control1::Range::Of<RangeSelect>());
+	Control2().Write(MSP430_Clock_Control2::LoopDivider::Of<1>() | MSP430_Clock_Control2::Multiplier::Of<Multiplier - 1>());
+	__bic_SR_register(SCG0);
+
+	// Worst case settling time of the FLL (32 x 32 reference periods)
+	__delay_cycles(SettleCycles);
+
+	// The core voltage goes down after MCLK did
+	if (GetCoreVoltage() > CoreVoltage)
+	{
+		SetCoreVoltage(CoreVoltage);
+	}
+	return ClearFaults();
+}
+
+/// <summary>
+/// Set the PMM core voltage one level at a time, waiting for the supervisors to settle at each level
+/// <para>Raise it before MCLK goes up, lower it after MCLK went down.</para>
+/// </summary>
+/// <param name="level">Core voltage level (0-3)</param>
+void MSP430_Clock::SetCoreVoltage(unsigned int level)
+{
+	if (level > 3)
+	{
+		level = 3;
+	}
+
+	unsigned int current = GetCoreVoltage();
+	while (current < level)
+	{
+		StepCoreVoltageUp(++current);
+	}
+	while (current > level)
+	{
+		StepCoreVoltageDown(--current);
+	}
+}
+
+/// <summary>Get the PMM core voltage level (0-3)</summary>
+unsigned int MSP430_Clock::GetCoreVoltage(void)
+{
+	return PMMCTL0 & PMMCOREV_3;
+}
+
+/// <summary>Clear the oscillator fault flags (UCSCTL7 and OFIFG) until the DCO fault stays clear</summary>
+/// <return>The DCO fault flag is clear</return>
+bool MSP430_Clock::ClearFaults(void)
+{
+	// XT1 and XT2 keep faulting without crystals, so only the DCO fault decides
+	for (unsigned int i = 0; i < FaultRetries; i++)
+	{
+		Control7().Modify(MSP430_Clock_Control7::XT2Fault::Off | MSP430_Clock_Control7::XT1LowFault::Off | MSP430_Clock_Control7::DCOFault::Off);
+		InterruptFlags1().Clear(OFIFG);
+		__delay_cycles(32);
+		if (!Control7().Test(MSP430_Clock_Control7::DCOFault::On))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/// <summary>Keep SMCLK running in the library's low-power waits (LPM0 instead of LPM3 until every holder releases it)</summary>
+void MSP430_Clock::HoldSMCLK(void)
+{
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	smclkHolders = smclkHolders + 1;
+	if (gie)
+	{
+		__enable_interrupt();
+	}
+}
+
+/// <summary>Release a HoldSMCLK() request</summary>
+void MSP430_Clock::ReleaseSMCLK(void)
+{
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	if (smclkHolders > 0)
+	{
+		smclkHolders = smclkHolders - 1;
+	}
+	if (gie)
+	{
+		__enable_interrupt();
+	}
+}
+
+/// <summary>Check if SMCLK is held (the library's low-power waits use LPM0)</summary>
+bool MSP430_Clock::IsSMCLKHeld(void)
+{
+	return smclkHolders != 0;
+}
+
+/// <summary>Step the core voltage one level up (PMM sequence of the User's Guide)</summary>
+/// <param name="level">New core voltage level</param>
+void MSP430_Clock::StepCoreVoltageUp(unsigned int level)
+{
+	PMMCTL0_H = PMMPW_H;
+
+	// Supervisors of both sides to the new level, the low side supervisor stays at the old one
+	SVSMHCTL = SVSHE | (SVSHRVL0 * level) | SVMHE | (SVSMHRRL0 * level);
+	SVSMLCTL = SVSLE | SVMLE | (SVSMLRRL0 * level);
+	while ((PMMIFG & SVSMLDLYIFG) == 0)
+	{
+	}
+	PMMIFG &= ~(SVMLVLRIFG | SVMLIFG);
+
+	// New core voltage, the monitor flags while it is below the new level
+	PMMCTL0_L = PMMCOREV0 * level;
+	if (PMMIFG & SVMLIFG)
+	{
+		while ((PMMIFG & SVMLVLRIFG) == 0)
+		{
+		}
+	}
+
+	// Low side supervisor to the new level, then lock the PMM registers
+	SVSMLCTL = SVSLE | (SVSLRVL0 * level) | SVMLE | (SVSMLRRL0 * level);
+	PMMCTL0_H = 0x00;
+}
+
+/// <summary>Step the core voltage one level down</summary>
+/// <param name="level">New core voltage level</param>
+void MSP430_Clock::StepCoreVoltageDown(unsigned int level)
+{
+	PMMCTL0_H = PMMPW_H;
+
+	// Low side supervisor first, then the core voltage
+	SVSMLCTL = SVSLE | (SVSLRVL0 * level) | SVMLE | (SVSMLRRL0 * level);
+	while ((PMMIFG & SVSMLDLYIFG) == 0)
+	{
+	}
+	PMMCTL0_L = PMMCOREV0 * level;
+	PMMCTL0_H = 0x00;
+}
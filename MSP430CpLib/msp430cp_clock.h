@@ -0,0 +1,265 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+
+// Unified clock system (UCS) configuration
+// The FLL settings are computed at compile time from the CLOCK_xxx_FREQUENCY requests of msp430cp_device.h:
+// the FLL locks DCOCLKDIV to a multiple of REFO (32768 Hz), MCLK runs from DCOCLKDIV, SMCLK from DCOCLKDIV
+// divided by a power of 2 and ACLK from REFO divided by a power of 2. The drivers take the resulting frequencies
+// (MCLKFrequency, SMCLKFrequency, ACLKFrequency), which can be below the requests by up to one FLL step.
+//
+//     WDTCTL = WDTPW | WDTHOLD;
+//     MSP430_Clock::Initialize();                                  // raises VCore, then locks the FLL
+//
+//     static_assert(MSP430_Clock::MCLKFrequency > 24000000UL, "Needs 25 MHz");
+//
+// NOTE: The 5xx/6xx UCS only (MSP430F5529 here), XT1 and XT2 stay as after reset.
+
+/// <summary>
+/// UCS clock source (Results in SELREFx, SELAx, SELSx and SELMx bits; the FLL reference takes XT1CLK, REFOCLK and XT2CLK only)
+/// </summary>
+enum class MSP430_Clock_Source
+{
+	/// <summary>XT1CLK</summary>
+	XT1 = 0b000,
+	/// <summary>VLOCLK (about 10 kHz)</summary>
+	VLO = 0b001,
+	/// <summary>REFOCLK (32768 Hz)</summary>
+	REFO = 0b010,
+	/// <summary>DCOCLK</summary>
+	DCO = 0b011,
+	/// <summary>DCOCLKDIV (DCOCLK / FLLD)</summary>
+	DCODIV = 0b100,
+	/// <summary>XT2CLK</summary>
+	XT2 = 0b101
+};
+
+// Register fields
+/// <summary>
+/// UCS control register 0 fields (UCSCTL0, DCO tap and modulation, adjusted by the FLL)
+/// </summary>
+struct MSP430_Clock_Control0
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>DCO tap (DCOx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control0, 8, 5> Tap;
+	/// <summary>Modulation counter (MODx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control0, 3, 5> Modulation;
+};
+
+/// <summary>
+/// UCS control register 1 fields (UCSCTL1)
+/// </summary>
+struct MSP430_Clock_Control1
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>DCO frequency range select (DCORSELx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control1, 4, 3> Range;
+	/// <summary>Modulation disable (DISMOD)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control1, 0, 1, bool> DisableModulation;
+};
+
+/// <summary>
+/// UCS control register 2 fields (UCSCTL2)
+/// </summary>
+struct MSP430_Clock_Control2
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>FLL loop divider (FLLDx, DCOCLK / 2^n = DCOCLKDIV)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control2, 12, 3> LoopDivider;
+	/// <summary>FLL multiplier (FLLNx, n + 1)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control2, 0, 10> Multiplier;
+};
+
+/// <summary>
+/// UCS control register 3 fields (UCSCTL3)
+/// </summary>
+struct MSP430_Clock_Control3
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>FLL reference source (SELREFx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control3, 4, 3, MSP430_Clock_Source> Reference;
+	/// <summary>FLL reference divider (FLLREFDIVx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control3, 0, 3> ReferenceDivider;
+};
+
+/// <summary>
+/// UCS control register 4 fields (UCSCTL4, clock sources)
+/// </summary>
+struct MSP430_Clock_Control4
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>ACLK source (SELAx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control4, 8, 3, MSP430_Clock_Source> ACLK;
+	/// <summary>SMCLK source (SELSx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control4, 4, 3, MSP430_Clock_Source> SMCLK;
+	/// <summary>MCLK source (SELMx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control4, 0, 3, MSP430_Clock_Source> MCLK;
+};
+
+/// <summary>
+/// UCS control register 5 fields (UCSCTL5, clock dividers as powers of 2)
+/// </summary>
+struct MSP430_Clock_Control5
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>ACLK external pin divider (DIVPAx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control5, 12, 3> ACLKPinDivider;
+	/// <summary>ACLK divider (DIVAx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control5, 8, 3> ACLKDivider;
+	/// <summary>SMCLK divider (DIVSx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control5, 4, 3> SMCLKDivider;
+	/// <summary>MCLK divider (DIVMx)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control5, 0, 3> MCLKDivider;
+};
+
+/// <summary>
+/// UCS control register 7 fields (UCSCTL7, oscillator fault flags)
+/// </summary>
+struct MSP430_Clock_Control7
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>XT2 fault (XT2OFFG)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control7, 3, 1, bool> XT2Fault;
+	/// <summary>XT1 high-frequency fault (XT1HFOFFG)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control7, 2, 1, bool> XT1HighFault;
+	/// <summary>XT1 low-frequency fault (XT1LFOFFG)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control7, 1, 1, bool> XT1LowFault;
+	/// <summary>DCO fault (DCOFFG, the DCO tap reached an end of the range)</summary>
+	typedef MSP430_RegisterField<MSP430_Clock_Control7, 0, 1, bool> DCOFault;
+};
+
+/// <summary>
+/// UCS setting calculations (all static, compile time)
+/// </summary>
+struct MSP430_Clock_Settings
+{
+	/// <summary>DCO range select of a DCO frequency (kHz)</summary>
+	/// <param name="kilohertz">DCO frequency (kHz)</param>
+	static constexpr unsigned int RangeOf(unsigned long kilohertz)
+	{
+		return (kilohertz <= 630) ? 0 : (kilohertz < 1250) ? 1 : (kilohertz < 2500) ? 2 : (kilohertz < 5000) ? 3
+			: (kilohertz < 10000) ? 4 : (kilohertz < 20000) ? 5 : (kilohertz < 40000) ? 6 : 7;
+	}
+	/// <summary>Smallest power of 2 divider (0-5) that brings a source down to a request</summary>
+	/// <param name="source">Source frequency (Hz)</param>
+	/// <param name="request">Requested frequency (Hz)</param>
+	static constexpr unsigned int DividerOf(unsigned long source, unsigned long request)
+	{
+		unsigned int divider = 0;
+		while (divider < 5 && (source >> divider) > request + request / 64)
+		{
+			divider++;
+		}
+		return divider;
+	}
+};
+
+/// <summary>
+/// MSP430 clock class (all static)
+/// <para>Initialize() must run once at startup before the clocked drivers (delay, timers, UART, ...) are used,
+/// the frequencies after reset are about 1 MHz for MCLK/SMCLK and 32768 Hz for ACLK.</para>
+/// </summary>
+class MSP430_Clock
+{
+public:
+	/// <summary>FLL reference frequency (REFO, Hz)</summary>
+	static constexpr unsigned long ReferenceFrequency = 32768UL;
+
+	// Compile-time FLL settings
+	/// <summary>FLL multiplier (FLLN + 1): DCOCLKDIV = Multiplier x ReferenceFrequency (the highest up to the request), FLLD = 2</summary>
+	static constexpr unsigned int Multiplier = static_cast<unsigned int> (CLOCK_MCLK_FREQUENCY / ReferenceFrequency);
+	static_assert(Multiplier >= 1 && Multiplier <= 1024, "CLOCK_MCLK_FREQUENCY is out of the FLL range (32768 Hz to 33.5 MHz)");
+	/// <summary>DCO frequency range select (DCORSELx): the range with the DCO frequency (2 x DCOCLKDIV) near its middle</summary>
+	static constexpr unsigned int RangeSelect = MSP430_Clock_Settings::RangeOf(2UL * Multiplier * ReferenceFrequency / 1000UL);
+	/// <summary>SMCLK divider (DIVSx): DCOCLKDIV / 2^SMCLKDivider is the highest frequency up to the request</summary>
+	static constexpr unsigned int SMCLKDivider = MSP430_Clock_Settings::DividerOf(Multiplier * ReferenceFrequency, CLOCK_SMCLK_FREQUENCY);
+	/// <summary>ACLK divider (DIVAx): REFO / 2^ACLKDivider is the highest frequency up to the request</summary>
+	static constexpr unsigned int ACLKDivider = MSP430_Clock_Settings::DividerOf(ReferenceFrequency, CLOCK_ACLK_FREQUENCY);
+	/// <summary>PMM core voltage level (PMMCOREVx) needed by MCLK (up to 8, 12, 20 and 25 MHz)</summary>
+	static constexpr unsigned int CoreVoltage = (CLOCK_MCLK_FREQUENCY <= 8000000UL) ? 0 : (CLOCK_MCLK_FREQUENCY <= 12000000UL) ? 1
+		: (CLOCK_MCLK_FREQUENCY <= 20000000UL) ? 2 : 3;
+	/// <summary>MCLK cycles for the FLL to settle after a change (32 x 32 reference periods, worst case)</summary>
+	static constexpr unsigned long SettleCycles = 32UL * 32UL * Multiplier;
+
+	// Resulting frequencies (Hz)
+	/// <summary>MCLK frequency after Initialize()</summary>
+	static constexpr unsigned long MCLKFrequency = Multiplier * ReferenceFrequency;
+	static_assert(MCLKFrequency <= 25000000UL, "CLOCK_MCLK_FREQUENCY is above the device maximum (25 MHz)");
+	/// <summary>SMCLK frequency after Initialize()</summary>
+	static constexpr unsigned long SMCLKFrequency = MCLKFrequency >> SMCLKDivider;
+	/// <summary>ACLK frequency after Initialize()</summary>
+	static constexpr unsigned long ACLKFrequency = ReferenceFrequency >> ACLKDivider;
+	static_assert(CLOCK_SMCLK_FREQUENCY <= MCLKFrequency + MCLKFrequency / 64, "CLOCK_SMCLK_FREQUENCY is above MCLK");
+	static_assert(CLOCK_ACLK_FREQUENCY <= ReferenceFrequency + ReferenceFrequency / 64, "CLOCK_ACLK_FREQUENCY is above REFO (32768 Hz)");
+
+	// Clock initialize
+	/// <summary>
+	/// Apply the compile-time settings: raise the core voltage in steps (if needed), select the clock sources,
+	/// lock the FLL, wait for it to settle, then lower the core voltage (if allowed)
+	/// <para>Takes SettleCycles MCLK cycles (about 32 ms). Interrupts are untouched.</para>
+	/// </summary>
+	/// <return>The DCO fault flag is clear (false if the FLL did not lock in range)</return>
+	static bool Initialize(void);
+	/// <summary>
+	/// Set the PMM core voltage one level at a time, waiting for the supervisors to settle at each level
+	/// <para>Raise it before MCLK goes up, lower it after MCLK went down.</para>
+	/// </summary>
+	/// <param name="level">Core voltage level (0-3)</param>
+	static void SetCoreVoltage(unsigned int level);
+	/// <summary>Get the PMM core voltage level (0-3)</summary>
+	static unsigned int GetCoreVoltage(void);
+	/// <summary>Clear the oscillator fault flags (UCSCTL7 and OFIFG) until the DCO fault stays clear</summary>
+	/// <return>The DCO fault flag is clear</return>
+	static bool ClearFaults(void);
+
+	// Low-power mode limit
+	/// <summary>Keep SMCLK running in the library's low-power waits (LPM0 instead of LPM3 until every holder releases it)</summary>
+	static void HoldSMCLK(void);
+	/// <summary>Release a HoldSMCLK() request</summary>
+	static void ReleaseSMCLK(void);
+	/// <summary>Check if SMCLK is held (the library's low-power waits use LPM0)</summary>
+	static bool IsSMCLKHeld(void);
+
+private:
+	// Private low-level PMM functions
+	/// <summary>Step the core voltage one level up (PMM sequence of the User's Guide)</summary>
+	/// <param name="level">New core voltage level</param>
+	static void StepCoreVoltageUp(unsigned int level);
+	/// <summary>Step the core voltage one level down</summary>
+	/// <param name="level">New core voltage level</param>
+	static void StepCoreVoltageDown(unsigned int level);
+};
+
+/// <summary>
+/// SMCLK hold of a driver (HoldSMCLK() once while the driver runs on SMCLK)
+/// <para>Take() and Release() are called from the main context, a repeated call has no effect.</para>
+/// </summary>
+class MSP430_Clock_SMCLKHold
+{
+private:
+	/// <summary>The hold is taken</summary>
+	bool held = false;
+
+public:
+	/// <summary>Take the hold (SMCLK keeps running in the low-power waits)</summary>
+	void Take(void)
+	{
+		if (!this->held)
+		{
+			this->held = true;
+			MSP430_Clock::HoldSMCLK();
+		}
+	}
+	/// <summary>Release the hold</summary>
+	void Release(void)
+	{
+		if (this->held)
+		{
+			this->held = false;
+			MSP430_Clock::ReleaseSMCLK();
+		}
+	}
+};
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+
+// Bit-parallel GPIO debouncer
+// All pins of a MSP430_GPIO_Bank (8 bits) or MSP430_GPIO_WordBank (16 bits) are debounced together by a vertical counter:
+// bit n of count0/count1 is the 2-bit counter of pin n, so one sample costs a few word operations for every pin.
+// A pin changes its debounced level after 4 consecutive samples at the new level, any sample at the old level restarts it.
+//
+// On an interrupt port (P1/P2, PA) the pins interrupt on a change of the debounced level, so the sample tick
+// only runs while inputs are changing: Wake() from the pin handlers stops the interrupts, Sample() returns false
+// and re-arms them when all pins are stable again.
+//
+//     MSP430_GPIO_Bank keys(MSP430_GPIO_Port::P1, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+//     MSP430_GPIO_Debouncer<MSP430_GPIO_Bank> debouncer(keys, MSP430_GPIO_ActiveLevel::Low);
+//
+//     void Debounce(void)
+//     {
+//         if (debouncer.Sample())
+//         {
+//             Scheduler::PostAfter<Debounce>(MSP430_SchedulerTimebase::TicksOf(5));
+//         }
+//         unsigned char pressed = debouncer.TakePressed();
+//     }
+//
+//     static void KeysChanged(void)                                   // called by the handler of every pin of the bank
+//     {
+//         debouncer.Wake();
+//         Scheduler::Post<Debounce>();
+//     }
+//
+// Post() requests the wake-up: the port interrupt routine leaves the low-power mode of the scheduler loop on exit.
+//
+//     keys.Initialize();
+//     debouncer.Initialize();
+
+// GPIO registers
+extern REG_8b const PxIE[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIFG[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIES[GPIO_PORT_SUPPORT_INT_COUNT];
+
+/// <summary>
+/// GPIO Active Level (the level of a pressed input)
+/// </summary>
+enum class MSP430_GPIO_ActiveLevel
+{
+	/// <summary>Pressed when HIGH(1) (pulldown resistor or active-high source)</summary>
+	High = 0,
+	/// <summary>Pressed when LOW(0) (pullup resistor, switch to ground)</summary>
+	Low = 1
+};
+
+/// <summary>
+/// Bank access for the debouncer: value width and interrupt registers of a bank type
+/// </summary>
+/// <typeparam name="Bank">MSP430_GPIO_Bank or MSP430_GPIO_WordBank</typeparam>
+template <typename Bank>
+struct MSP430_GPIO_DebounceBank;
+
+template <>
+struct MSP430_GPIO_DebounceBank<MSP430_GPIO_Bank>
+{
+	typedef unsigned char Value;
+	typedef MSP430_Register8 Register;
+
+	/// <summary>Check the bank is on a port with interrupt capability</summary>
+	static bool HasInterrupt(MSP430_GPIO_Bank& bank)
+	{
+		return MSP430_Device::HasPortInterrupt(static_cast<unsigned char> (bank.GetPort()));
+	}
+	/// <summary>Interrupt enable register (PxIE)</summary>
+	static Register IE(MSP430_GPIO_Bank& bank)
+	{
+		return PxIE[static_cast<int> (bank.GetPort())];
+	}
+	/// <summary>Interrupt edge select register (PxIES)</summary>
+	static Register IES(MSP430_GPIO_Bank& bank)
+	{
+		return PxIES[static_cast<int> (bank.GetPort())];
+	}
+	/// <summary>Interrupt flag register (PxIFG)</summary>
+	static Register IFG(MSP430_GPIO_Bank& bank)
+	{
+		return PxIFG[static_cast<int> (bank.GetPort())];
+	}
+};
+
+#if GPIO_PORT_PAIR_COUNT > 0
+template <>
+struct MSP430_GPIO_DebounceBank<MSP430_GPIO_WordBank>
+{
+	typedef unsigned int Value;
+	typedef MSP430_Register16 Register;
+
+	/// <summary>Check the bank is on a port pair with interrupt capability (PA = P1/P2)</summary>
+	static bool HasInterrupt(MSP430_GPIO_WordBank& bank)
+	{
+		return bank.GetPortPair() == MSP430_GPIO_PortPair::PA && MSP430_Device::InterruptPortCount >= 2;
+	}
+	/// <summary>Interrupt enable register (PAIE)</summary>
+	static Register IE(MSP430_GPIO_WordBank&)
+	{
+		return &PAIE;
+	}
+	/// <summary>Interrupt edge select register (PAIES)</summary>
+	static Register IES(MSP430_GPIO_WordBank&)
+	{
+		return &PAIES;
+	}
+	/// <summary>Interrupt flag register (PAIFG)</summary>
+	static Register IFG(MSP430_GPIO_WordBank&)
+	{
+		return &PAIFG;
+	}
+};
+#endif
+
+/// <summary>
+/// MSP430 GPIO bank debouncer (vertical counter, 4 samples)
+/// <para>Sample() is called from one context (a timer handler or a task), the edge masks may be taken from another.</para>
+/// <para>NOTE: On an interrupt port the debouncer owns the PxIE/PxIES bits of the bank's access mask.</para>
+/// </summary>
+/// <typeparam name="Bank">MSP430_GPIO_Bank or MSP430_GPIO_WordBank</typeparam>
+template <typename Bank>
+class MSP430_GPIO_Debouncer
+{
+public:
+	/// <summary>Bank value type (8 or 16 bits)</summary>
+	typedef typename MSP430_GPIO_DebounceBank<Bank>::Value Value;
+
+private:
+	typedef MSP430_GPIO_DebounceBank<Bank> Access;
+
+	/// <summary>Sampled bank</summary>
+	Bank& bank;
+	/// <summary>Pins which are pressed at LOW(0)</summary>
+	Value activeLow;
+	/// <summary>The bank is on an interrupt port (sampling is gated by the port interrupt)</summary>
+	bool gated;
+
+	// Vertical counter
+	/// <summary>Debounced levels</summary>
+	volatile Value state = 0;
+	/// <summary>Counter bit 0 of each pin</summary>
+	Value count0 = 0;
+	/// <summary>Counter bit 1 of each pin</summary>
+	Value count1 = 0;
+
+	// Edges not taken yet
+	/// <summary>Pins which became pressed</summary>
+	volatile Value pressed = 0;
+	/// <summary>Pins which became released</summary>
+	volatile Value released = 0;
+
+	/// <summary>Take an edge mask with interrupts disabled</summary>
+	/// <param name="edges">Edge mask</param>
+	static Value Take(volatile Value& edges)
+	{
+		unsigned int gie = __get_SR_register() & GIE;
+		__disable_interrupt();
+		__no_operation();
+		Value value = edges;
+		edges = 0;
+		if (gie)
+		{
+			__enable_interrupt();
+		}
+		return value;
+	}
+
+	/// <summary>Interrupt on a change of the debounced level, then check the input did not change meanwhile</summary>
+	/// <return>All pins are still at their debounced level</return>
+	bool Arm(void)
+	{
+		Value mask = this->bank.GetAccessMask();
+
+		// Falling edge for the pins at HIGH(1), rising edge for the pins at LOW(0); writing PxIES may set flags
+		Access::IES(this->bank).Modify(this->state, mask);
+		Access::IFG(this->bank).Clear(mask);
+		Access::IE(this->bank).Set(mask);
+
+		if (this->bank.GetValue() != this->state)
+		{
+			Wake();
+			return false;
+		}
+		return true;
+	}
+
+public:
+	// Constructor
+	/// <summary>Create a new debouncer on a bank (No hardware operation)</summary>
+	/// <param name="bank">Input bank (access mask selects the pins)</param>
+	/// <param name="activeLevel">Level of a pressed input</param>
+	MSP430_GPIO_Debouncer(Bank& bank, MSP430_GPIO_ActiveLevel activeLevel) : bank(bank)
+	{
+		this->activeLow = (activeLevel == MSP430_GPIO_ActiveLevel::Low) ? static_cast<Value> (~0u) : 0;
+		this->gated = Access::HasInterrupt(bank);
+	}
+	/// <summary>Delete this debouncer instance and disable the bank's interrupts</summary>
+	~MSP430_GPIO_Debouncer()
+	{
+		Deinitialize();
+	}
+
+	// Debouncer initialize
+	/// <summary>Take the current input as the debounced levels and arm the port interrupt (the bank must be initialized)</summary>
+	void Initialize(void)
+	{
+		this->state = this->bank.GetValue();
+		this->count0 = 0;
+		this->count1 = 0;
+		this->pressed = 0;
+		this->released = 0;
+		if (this->gated)
+		{
+			Arm();
+		}
+	}
+	/// <summary>Disable the bank's interrupts</summary>
+	void Deinitialize(void)
+	{
+		if (this->gated)
+		{
+			Wake();
+		}
+	}
+
+	// Sampling
+	/// <summary>
+	/// Start sampling: disable and clear the bank's interrupts (Call it from the pin interrupt handlers, then start the tick)
+	/// </summary>
+	void Wake(void)
+	{
+		Value mask = this->bank.GetAccessMask();
+		Access::IE(this->bank).Clear(mask);
+		Access::IFG(this->bank).Clear(mask);
+	}
+	/// <summary>
+	/// Take one sample of the bank (Call it every tick while it returns true)
+	/// <para>On an interrupt port the interrupts are re-armed when it returns false.</para>
+	/// </summary>
+	/// <return>Keep sampling (some pins are still changing, always true on a port without interrupts)</return>
+	bool Sample(void)
+	{
+		Value sample = this->bank.GetValue();
+		Value state = this->state;
+
+		// Count the pins which differ from their debounced level, clear the counters of the others
+		Value delta = sample ^ state;
+		this->count1 = (this->count1 ^ this->count0) & delta;
+		this->count0 = ~this->count0 & delta;
+
+		// The counters which rolled over (4 samples) toggle their pins
+		Value toggle = delta & ~(this->count0 | this->count1);
+		if (toggle)
+		{
+			state ^= toggle;
+			this->state = state;
+
+			Value active = state ^ this->activeLow;
+			this->pressed = this->pressed | (toggle & active);
+			this->released = this->released | (toggle & ~active);
+		}
+
+		// Stable when every pin is at its debounced level (all counters are zero)
+		if (!this->gated || sample != state)
+		{
+			return true;
+		}
+		return !Arm();
+	}
+
+	// Debounced state
+	/// <summary>Get the debounced levels of the bank</summary>
+	Value GetState(void)
+	{
+		return this->state;
+	}
+	/// <summary>Get the pins which are pressed now</summary>
+	Value GetActive(void)
+	{
+		return (this->state ^ this->activeLow) & this->bank.GetAccessMask();
+	}
+	/// <summary>Take the pins which became pressed since the last call</summary>
+	Value TakePressed(void)
+	{
+		return Take(this->pressed);
+	}
+	/// <summary>Take the pins which became released since the last call</summary>
+	Value TakeReleased(void)
+	{
+		return Take(this->released);
+	}
+};
@@ -0,0 +1,100 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_delay.h"
+#include "msp430cp_timer.h"
+
+#ifdef DELAY_TIMER
+// Wait timer registers
+typedef MSP430_Timer_Registers<MSP430_Timer_Instance::DELAY_TIMER> DelayRegisters;
+
+/// <summary>The current wait reached its compare value (written by the CCR0 handler)</summary>
+static volatile bool expired = false;
+
+/// <summary>Service the CCR0 interrupt of the wait timer: halt the timer, end the wait and request the wake-up (Called by the library handler, or by yours with DELAY_USER_ISR)</summary>
+void MSP430_Delay::Service(void)
+{
+	DelayRegisters::TxCCTL(0).Reset();
+	DelayRegisters::TxCTL().Write(MSP430_Timer_Control::Clear::On);
+	expired = true;
+	MSP430_WAKE();
+}
+
+#ifndef DELAY_USER_ISR
+/// <summary>Define the CCR0 handler of a timer given by a macro</summary>
+#define MSP430CP_DELAY_HANDLER(TIMER) MSP430_TIMER_INTERRUPT_HANDLER(TIMER, 0)
+
+/// <summary>Wait timer CCR0 handler: end the wait (the timer interrupt routine returns to active mode)</summary>
+MSP430CP_DELAY_HANDLER(DELAY_TIMER)
+{
+	MSP430_Delay::Service();
+}
+#endif
+
+/// <summary>
+/// Wait a number of milliseconds in a low-power mode
+/// <para>Other interrupts are served during the wait, the wait continues after them.</para>
+/// </summary>
+/// <param name="milliseconds">Time (ms)</param>
+/// <param name="lowPower">Low-power mode of the wait</param>
+void MSP430_Delay::Sleep(unsigned long milliseconds, MSP430_Delay_LowPower lowPower)
+{
+	unsigned long frequency = (lowPower == MSP430_Delay_LowPower::LPM3) ? MSP430_Clock::ACLKFrequency : MSP430_Clock::SMCLKFrequency;
+
+	// Whole seconds first, so the tick count of the rest can't overflow
+	while (milliseconds >= 1000)
+	{
+		SleepTicks(frequency, lowPower);
+		milliseconds -= 1000;
+	}
+	SleepTicks((frequency / 1000) * milliseconds + (frequency % 1000) * milliseconds / 1000, lowPower);
+}
+
+/// <summary>Wait a number of timer clocks in a low-power mode</summary>
+/// <param name="ticks">Timer clocks (ACLK for LPM3, SMCLK for LPM0)</param>
+/// <param name="lowPower">Low-power mode of the wait</param>
+void MSP430_Delay::SleepTicks(unsigned long ticks, MSP430_Delay_LowPower lowPower)
+{
+	bool lpm3 = (lowPower == MSP430_Delay_LowPower::LPM3);
+	MSP430_Timer_ClockSource clock = lpm3 ? MSP430_Timer_ClockSource::ACLK : MSP430_Timer_ClockSource::SMCLK;
+	// LPM3 stops SMCLK, held by a running driver: wait in LPM0 then (the timer still counts ACLK)
+	unsigned int bits = (lpm3 && !MSP430_Clock::IsSMCLKHeld()) ? LPM3_bits : LPM0_bits;
+	unsigned int gie = __get_SR_register() & GIE;
+
+	while (ticks > 0)
+	{
+		unsigned int count = (ticks > 0xFFFF) ? 0xFFFF : static_cast<unsigned int> (ticks);
+		ticks -= count;
+
+#ifdef MSP430CP_HOST
+		// Timers do not count on host, account the wait as MCLK cycles
+		(void) clock;
+		(void) bits;
+		MSP430Host_DelayedCycles += static_cast<unsigned long long> (count) * MSP430_Clock::MCLKFrequency / (lpm3 ? MSP430_Clock::ACLKFrequency : MSP430_Clock::SMCLKFrequency);
+#else
+		__disable_interrupt();
+		__no_operation();
+		expired = false;
+
+		// Continuous mode from zero, CCR0 matches after count clocks
+		DelayRegisters::TxCTL().Write(MSP430_Timer_Control::ClockSource::Of(clock) | MSP430_Timer_Control::Clear::On);
+		DelayRegisters::TxCCR(0).Write(count);
+		DelayRegisters::TxCCTL(0).Write(MSP430_Timer_CaptureControl::InterruptEnable::On);
+		DelayRegisters::TxCTL().Write(MSP430_Timer_Control::ClockSource::Of(clock) | MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Continuous));
+
+		// GIE and the low-power bits are set by one instruction, so the wake-up can't be lost between the check and the sleep
+		while (!expired)
+		{
+			__bis_SR_register(bits | GIE);
+			__no_operation();
+			__disable_interrupt();
+			__no_operation();
+		}
+#endif
+	}
+
+	if (gie)
+	{
+		__enable_interrupt();
+	}
+}
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+
+// Delay and low-power wait
+// Short delays are compile-time cycle counts for __delay_cycles (exact, independent of the optimization level):
+//
+//     MSP430_Delay::Microseconds<10>();
+//     MSP430_Delay::Milliseconds<2>();
+//
+// Long waits stop the CPU in LPM3 (ACLK) or LPM0 (SMCLK) until CCR0 of DELAY_TIMER wakes it up:
+//
+//     MSP430_Delay::Sleep(500);
+//
+// The library owns the CCR0 handler of DELAY_TIMER (define DELAY_USER_ISR in msp430cp_device.h to keep your own and
+// call Service() from it: it requests the wake-up, which the library timer interrupt routine takes on exit).
+
+/// <summary>
+/// Low-power mode of a wait (Results in the timer clock source and the SR bits)
+/// </summary>
+enum class MSP430_Delay_LowPower
+{
+	/// <summary>LPM0, the timer counts SMCLK (timer clock resolution)</summary>
+	LPM0,
+	/// <summary>LPM3, the timer counts ACLK (lowest power, 1 / ACLK resolution)</summary>
+	LPM3
+};
+
+/// <summary>
+/// MSP430 delay class (all static)
+/// <para>The cycle counts are computed from MSP430_Clock::MCLKFrequency, the wait ticks from MSP430_Clock::SMCLKFrequency/ACLKFrequency.</para>
+/// </summary>
+class MSP430_Delay
+{
+public:
+	// Cycle conversion
+	/// <summary>MCLK cycles of a time in microseconds (rounded up, 64-bit: above 171 s at 25 MHz the count exceeds 32 bits)</summary>
+	/// <param name="microseconds">Time (us)</param>
+	static constexpr unsigned long long CyclesOf(unsigned long microseconds)
+	{
+		return (static_cast<unsigned long long> (MSP430_Clock::MCLKFrequency) * microseconds + 999999ULL) / 1000000ULL;
+	}
+
+	// Busy delays (CPU active, interrupts untouched)
+	/// <summary>Delay a compile-time number of microseconds</summary>
+	/// <typeparam name="microseconds">Time (us)</typeparam>
+	template <unsigned long microseconds>
+	static inline void Microseconds(void)
+	{
+		constexpr unsigned long long cycles = CyclesOf(microseconds);
+		static_assert(cycles <= 0xFFFFFFFFULL, "Delay is too long for __delay_cycles, use Sleep()");
+		__delay_cycles(static_cast<unsigned long> (cycles));
+	}
+	/// <summary>Delay a compile-time number of milliseconds</summary>
+	/// <typeparam name="milliseconds">Time (ms)</typeparam>
+	template <unsigned long milliseconds>
+	static inline void Milliseconds(void)
+	{
+		constexpr unsigned long long cycles = static_cast<unsigned long long> (MSP430_Clock::MCLKFrequency) * milliseconds / 1000ULL;
+		static_assert(cycles <= 0xFFFFFFFFULL, "Delay is too long for __delay_cycles, use Sleep()");
+		__delay_cycles(static_cast<unsigned long> (cycles));
+	}
+
+#ifdef DELAY_TIMER
+	// Low-power waits (CPU stopped, GIE is set during the wait and restored after it)
+	/// <summary>
+	/// Wait a number of milliseconds in a low-power mode
+	/// <para>Other interrupts are served during the wait, the wait continues after them.</para>
+	/// </summary>
+	/// <param name="milliseconds">Time (ms)</param>
+	/// <param name="lowPower">Low-power mode of the wait</param>
+	static void Sleep(unsigned long milliseconds, MSP430_Delay_LowPower lowPower = MSP430_Delay_LowPower::LPM3);
+	/// <summary>Wait a number of timer clocks in a low-power mode</summary>
+	/// <param name="ticks">Timer clocks (ACLK for LPM3, SMCLK for LPM0)</param>
+	/// <param name="lowPower">Low-power mode of the wait</param>
+	static void SleepTicks(unsigned long ticks, MSP430_Delay_LowPower lowPower = MSP430_Delay_LowPower::LPM3);
+
+	// Interrupt service
+	/// <summary>Service the CCR0 interrupt of DELAY_TIMER and request the wake-up (Called by the library handler, or by yours with DELAY_USER_ISR)</summary>
+	static void Service(void);
+#endif
+};
@@ -1,5 +1,52 @@
 #pragma once
 
-// GPIO Settings
-#define GPIO_PORT_COUNT 8
-#define GPIO_PORT_SUPPORT_INT_COUNT 2
+// Device capabilities (GPIO ports, port pairs, PxSEL2/PxDS/PMAP, PxIV, timers, DMA channels, UARTs, hardware multiplier) follow the device header
+#include "msp430cp_device_traits.h"
+
+// GPIO interrupt dispatcher (Define to keep your own PORT1/PORT2 interrupt service routines, end them with REG_ISR_EXIT())
+// #define GPIO_PORT_USER_ISR
+
+// GPIO event timestamp source (16-bit free-running counter, e.g. Timer_A0 in continuous mode)
+#define GPIO_EVENT_TIMESTAMP TA0R
+
+// Timer interrupt dispatcher (Define to keep your own timer interrupt service routines, end them with REG_ISR_EXIT())
+// #define TIMER_USER_ISR
+
+// Clock Settings (Hz, requested frequencies applied by MSP430_Clock::Initialize(): MCLK up to 25 MHz from the FLL,
+// SMCLK = MCLK / 2^n, ACLK = REFO / 2^n; the drivers use the resulting MSP430_Clock::xxxFrequency values)
+#define CLOCK_MCLK_FREQUENCY 25000000UL
+#define CLOCK_SMCLK_FREQUENCY 25000000UL
+#define CLOCK_ACLK_FREQUENCY 32768UL
+
+// Delay Settings (Low-power waits count on CCR0 of this timer, the delay owns its CCR0 handler; comment out to release it)
+#define DELAY_TIMER TA1
+
+// Delay interrupt handler (Define to keep your own DELAY_TIMER CCR0 handler, call MSP430_Delay::Service() from it)
+// #define DELAY_USER_ISR
+
+// Scheduler Settings (ACLK timebase in continuous mode, the scheduler owns its CCR0 and overflow handlers; must differ from DELAY_TIMER)
+#define SCHEDULER_TIMER TA2
+
+// Scheduler interrupt handlers (Define to keep your own SCHEDULER_TIMER CCR0/overflow handlers,
+// call MSP430_SchedulerTimebase::ServiceAlarm()/ServiceOverflow() from them)
+// #define SCHEDULER_USER_ISR
+
+// DMA interrupt dispatcher (Define to keep your own DMA interrupt service routine, end it with REG_ISR_EXIT())
+// #define DMA_USER_ISR
+
+// UART interrupt dispatcher (Define to keep your own USCI_A0/USCI_A1 interrupt service routines, end them with REG_ISR_EXIT())
+// #define UART_USER_ISR
+
+// Trace Settings (Define TRACE_ENABLE to record GPIO writes, interrupts and driver events, see msp430cp_trace.h;
+// capacity in entries (power of 2, 4 bytes each), timestamp counter and its frequency in Hz)
+// #define TRACE_ENABLE
+#define TRACE_CAPACITY 64
+#define TRACE_TIMESTAMP TA0R
+#define TRACE_TIMESTAMP_FREQUENCY MSP430_Clock::SMCLKFrequency
+
+// Profiler Settings (Define PROFILE_ENABLE to measure MSP430_PROFILE() scopes, see msp430cp_profile.h;
+// number of regions, free-running 16-bit counter (on MCLK to count cycles) and its frequency in Hz)
+// #define PROFILE_ENABLE
+#define PROFILE_REGION_COUNT 8
+#define PROFILE_COUNTER TA0R
+#define PROFILE_COUNTER_FREQUENCY MSP430_Clock::SMCLKFrequency
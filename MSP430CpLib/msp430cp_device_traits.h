@@ -0,0 +1,241 @@
+#pragma once
+
+#include <msp430.h>
+
+// Device capabilities
+// Derived from the module macros of the TI device header (__MSP430_HAS_xxx__, register offsets and IV values),
+// so they follow the -mmcu device and need no editing. The preprocessor results remove the code of unavailable
+// features entirely (register names that do not exist on the device are never referenced), MSP430_Device holds
+// the same results as constexpr values for if constexpr/static_assert.
+// NOTE: The library supports up to P8, the port interrupt dispatcher P1/P2.
+
+// GPIO ports (P1 to P8)
+#if defined(__MSP430_HAS_PORT8_R__) || defined(__MSP430_HAS_PORT8__)
+#define GPIO_PORT_COUNT 8
+#elif defined(__MSP430_HAS_PORT7_R__) || defined(__MSP430_HAS_PORT7__)
+#define GPIO_PORT_COUNT 7
+#elif defined(__MSP430_HAS_PORT6_R__) || defined(__MSP430_HAS_PORT6__)
+#define GPIO_PORT_COUNT 6
+#elif defined(__MSP430_HAS_PORT5_R__) || defined(__MSP430_HAS_PORT5__)
+#define GPIO_PORT_COUNT 5
+#elif defined(__MSP430_HAS_PORT4_R__) || defined(__MSP430_HAS_PORT4__)
+#define GPIO_PORT_COUNT 4
+#elif defined(__MSP430_HAS_PORT3_R__) || defined(__MSP430_HAS_PORT3__)
+#define GPIO_PORT_COUNT 3
+#elif defined(__MSP430_HAS_PORT2_R__) || defined(__MSP430_HAS_PORT2__)
+#define GPIO_PORT_COUNT 2
+#else
+#define GPIO_PORT_COUNT 1
+#endif
+
+// GPIO ports with interrupt capability (P1, and P2 if the device has it)
+#if GPIO_PORT_COUNT >= 2
+#define GPIO_PORT_SUPPORT_INT_COUNT 2
+#else
+#define GPIO_PORT_SUPPORT_INT_COUNT 1
+#endif
+
+// GPIO interrupt vector registers (PxIV, 5xx/6xx and FRxx)
+#ifdef P1IV_NONE
+#define GPIO_PORT_HAS_IV
+#endif
+
+// GPIO port pairs (16-bit PA/PB/PC/PD registers, 5xx/6xx: a pair every 0x20 bytes from P1IN, odd ports at +1)
+#if defined(__MSP430_HAS_PORTD_R__) || defined(__MSP430_HAS_PORTD__)
+#define GPIO_PORT_PAIR_COUNT 4
+#elif defined(__MSP430_HAS_PORTC_R__) || defined(__MSP430_HAS_PORTC__)
+#define GPIO_PORT_PAIR_COUNT 3
+#elif defined(__MSP430_HAS_PORTB_R__) || defined(__MSP430_HAS_PORTB__)
+#define GPIO_PORT_PAIR_COUNT 2
+#elif defined(__MSP430_HAS_PORTA_R__) || defined(__MSP430_HAS_PORTA__)
+#define GPIO_PORT_PAIR_COUNT 1
+#else
+#define GPIO_PORT_PAIR_COUNT 0
+#endif
+#if GPIO_PORT_PAIR_COUNT > 0
+#define GPIO_PORT_REGISTER_STRIDE 0x20
+#endif
+
+// GPIO function select 2 (PxSEL2, 2xx value line devices)
+#if defined(P1SEL2_) || defined(P1SEL2)
+#define GPIO_PORT_HAS_FUNSEL2
+#endif
+
+// GPIO drive strength (PxDS, 5xx/6xx)
+#if defined(OFS_P1DS) || defined(P1DS)
+#define GPIO_PORT_HAS_DS
+#endif
+
+// GPIO port mapping controller (PMAP)
+#ifdef __MSP430_HAS_PORT_MAPPING__
+#define GPIO_PORT_HAS_PMAP
+#endif
+
+// Timers (capture/compare channels of TA0, TA1, TA2 and TB0, 0 if the device lacks the timer)
+#if defined(__MSP430_HAS_T0A5__)
+#define TIMER_TA0_CHANNEL_COUNT 5
+#elif defined(__MSP430_HAS_T0A3__)
+#define TIMER_TA0_CHANNEL_COUNT 3
+#else
+#define TIMER_TA0_CHANNEL_COUNT 0
+#endif
+#if defined(__MSP430_HAS_T1A3__)
+#define TIMER_TA1_CHANNEL_COUNT 3
+#elif defined(__MSP430_HAS_T1A2__)
+#define TIMER_TA1_CHANNEL_COUNT 2
+#else
+#define TIMER_TA1_CHANNEL_COUNT 0
+#endif
+#if defined(__MSP430_HAS_T2A3__)
+#define TIMER_TA2_CHANNEL_COUNT 3
+#else
+#define TIMER_TA2_CHANNEL_COUNT 0
+#endif
+#if defined(__MSP430_HAS_T0B7__)
+#define TIMER_TB0_CHANNEL_COUNT 7
+#elif defined(__MSP430_HAS_T0B3__)
+#define TIMER_TB0_CHANNEL_COUNT 3
+#else
+#define TIMER_TB0_CHANNEL_COUNT 0
+#endif
+
+// Timer table size (the timer tables are indexed by MSP430_Timer_Instance, so they run to the last available timer)
+#if TIMER_TB0_CHANNEL_COUNT > 0
+#define TIMER_COUNT 4
+#elif TIMER_TA2_CHANNEL_COUNT > 0
+#define TIMER_COUNT 3
+#elif TIMER_TA1_CHANNEL_COUNT > 0
+#define TIMER_COUNT 2
+#else
+#define TIMER_COUNT 1
+#endif
+
+// DMA channels
+#if defined(__MSP430_HAS_DMAX_6__)
+#define DMA_CHANNEL_COUNT 6
+#elif defined(__MSP430_HAS_DMAX_3__)
+#define DMA_CHANNEL_COUNT 3
+#else
+#define DMA_CHANNEL_COUNT 0
+#endif
+
+// UARTs (USCI_A modules)
+#if defined(__MSP430_HAS_USCI_A1__)
+#define UART_COUNT 2
+#elif defined(__MSP430_HAS_USCI_A0__)
+#define UART_COUNT 1
+#else
+#define UART_COUNT 0
+#endif
+
+// Hardware multiplier
+#if defined(__MSP430_HAS_MPY32__)
+#define MULTIPLIER_HAS_MPY32
+#elif defined(__MSP430_HAS_MPY__)
+#define MULTIPLIER_HAS_MPY
+#endif
+
+/// <summary>
+/// Hardware multiplier type
+/// </summary>
+enum class MSP430_Device_Multiplier
+{
+	/// <summary>No hardware multiplier (software multiplication)</summary>
+	None,
+	/// <summary>16 x 16 multiplier (MPY)</summary>
+	MPY16,
+	/// <summary>32 x 32 multiplier (MPY32)</summary>
+	MPY32
+};
+
+/// <summary>
+/// Device capability traits resolved at compile time
+/// <para>Ports and port pairs are the zero-based index of MSP430_GPIO_Port and MSP430_GPIO_PortPair.</para>
+/// </summary>
+struct MSP430_Device
+{
+	/// <summary>Number of GPIO ports (P1 to Pn)</summary>
+	static constexpr unsigned char PortCount = GPIO_PORT_COUNT;
+	/// <summary>Number of GPIO ports with interrupt capability (P1 to Pn)</summary>
+	static constexpr unsigned char InterruptPortCount = GPIO_PORT_SUPPORT_INT_COUNT;
+	/// <summary>Number of 16-bit GPIO port pairs (PA to Px)</summary>
+	static constexpr unsigned char PortPairCount = GPIO_PORT_PAIR_COUNT;
+	/// <summary>Number of timer table entries (TA0 to the last available MSP430_Timer_Instance)</summary>
+	static constexpr unsigned char TimerCount = TIMER_COUNT;
+	/// <summary>Number of DMA channels</summary>
+	static constexpr unsigned char DMAChannelCount = DMA_CHANNEL_COUNT;
+	/// <summary>Number of USCI_A UARTs (UCA0 to UCAn)</summary>
+	static constexpr unsigned char UARTCount = UART_COUNT;
+
+#ifdef GPIO_PORT_HAS_IV
+	/// <summary>The interrupt ports have PxIV registers</summary>
+	static constexpr bool HasPortInterruptVector = true;
+#else
+	/// <summary>The interrupt ports have PxIV registers</summary>
+	static constexpr bool HasPortInterruptVector = false;
+#endif
+#ifdef GPIO_PORT_HAS_FUNSEL2
+	/// <summary>The ports have PxSEL2 registers</summary>
+	static constexpr bool HasPortFunctionSelect2 = true;
+#else
+	/// <summary>The ports have PxSEL2 registers</summary>
+	static constexpr bool HasPortFunctionSelect2 = false;
+#endif
+#ifdef GPIO_PORT_HAS_DS
+	/// <summary>The ports have PxDS registers</summary>
+	static constexpr bool HasPortDriveStrength = true;
+#else
+	/// <summary>The ports have PxDS registers</summary>
+	static constexpr bool HasPortDriveStrength = false;
+#endif
+#ifdef GPIO_PORT_HAS_PMAP
+	/// <summary>The device has a port mapping controller</summary>
+	static constexpr bool HasPortMapping = true;
+#else
+	/// <summary>The device has a port mapping controller</summary>
+	static constexpr bool HasPortMapping = false;
+#endif
+
+#if defined(MULTIPLIER_HAS_MPY32)
+	/// <summary>Hardware multiplier type</summary>
+	static constexpr MSP430_Device_Multiplier Multiplier = MSP430_Device_Multiplier::MPY32;
+#elif defined(MULTIPLIER_HAS_MPY)
+	/// <summary>Hardware multiplier type</summary>
+	static constexpr MSP430_Device_Multiplier Multiplier = MSP430_Device_Multiplier::MPY16;
+#else
+	/// <summary>Hardware multiplier type</summary>
+	static constexpr MSP430_Device_Multiplier Multiplier = MSP430_Device_Multiplier::None;
+#endif
+
+	/// <summary>Check the device has a GPIO port</summary>
+	/// <param name="port">Port index (P1 = 0)</param>
+	static constexpr bool HasPort(unsigned char port)
+	{
+		return port < PortCount;
+	}
+	/// <summary>Check a GPIO port has interrupt capability</summary>
+	/// <param name="port">Port index (P1 = 0)</param>
+	static constexpr bool HasPortInterrupt(unsigned char port)
+	{
+		return port < InterruptPortCount;
+	}
+	/// <summary>Get the number of capture/compare channels of a timer (0 if the device lacks it)</summary>
+	/// <param name="timer">Timer index (MSP430_Timer_Instance: TA0 = 0, TA1, TA2, TB0)</param>
+	static constexpr unsigned char TimerChannelCount(unsigned char timer)
+	{
+		return timer == 0 ? TIMER_TA0_CHANNEL_COUNT : timer == 1 ? TIMER_TA1_CHANNEL_COUNT :
+			timer == 2 ? TIMER_TA2_CHANNEL_COUNT : timer == 3 ? TIMER_TB0_CHANNEL_COUNT : 0;
+	}
+	/// <summary>Check the device has a timer</summary>
+	/// <param name="timer">Timer index (MSP430_Timer_Instance: TA0 = 0, TA1, TA2, TB0)</param>
+	static constexpr bool HasTimer(unsigned char timer)
+	{
+		return TimerChannelCount(timer) > 0;
+	}
+	/// <summary>Check the device has a 16-bit GPIO port pair</summary>
+	/// <param name="pair">Port pair index (PA = 0)</param>
+	static constexpr bool HasPortPair(unsigned char pair)
+	{
+		return pair < PortPairCount;
+	}
+};
@@ -0,0 +1,216 @@
+#include <msp430.h>
+#include <stdint.h>
+#include "msp430cp_device.h"
+#include "msp430cp_dma.h"
+#include "msp430cp_trace.h"
+
+#if DMA_CHANNEL_COUNT > 0
+// DMA registers
+extern REG_16b const DMAxCTL[DMA_CHANNEL_COUNT];
+
+/// <summary>Device address of a pointer (16-bit, small memory model)</summary>
+static inline unsigned int AddressOf(const volatile void* pointer)
+{
+#ifdef MSP430CP_HOST
+	// Register file pointers are translated back to the device memory map (RAM buffers have no device address on host)
+	const volatile unsigned char* byte = static_cast<const volatile unsigned char*> (pointer);
+	if (byte >= MSP430Host_RegisterFile && byte < MSP430Host_RegisterFile + MSP430HOST_REGISTER_FILE_SIZE)
+	{
+		return static_cast<unsigned int> (byte - MSP430Host_RegisterFile);
+	}
+#endif
+	return static_cast<unsigned int> (reinterpret_cast<uintptr_t> (pointer));
+}
+
+/// <summary>Hardware link from program to registers</summary>
+void MSP430_DMA::HardLink(void)
+{
+	this->reg_DMAxCTL = DMAxCTL[this->channel];
+	// DMACTL0 holds the trigger bytes of channel 0 (low) and 1 (high), DMACTL1 of channel 2 and 3, ...
+	this->reg_DMAxTSEL = MSP430_Register8(reinterpret_cast<REG_8b> (&DMACTL0)) + this->channel;
+}
+
+/// <summary>Create a new DMA object, set the channel only and let other parameters to default (software trigger, single byte transfers)</summary>
+/// <param name="channel">DMA channel</param>
+MSP430_DMA::MSP430_DMA(MSP430_DMA_Channel channel)
+{
+	this->channel = channel;
+
+	// Link the hardware
+	HardLink();
+}
+
+/// <summary>Create a new DMA object, set the channel, trigger, transfer mode, address steps and unit</summary>
+/// <param name="channel">DMA channel</param>
+/// <param name="trigger">Trigger</param>
+/// <param name="mode">Transfer mode</param>
+/// <param name="sourceStep">Source address step</param>
+/// <param name="destinationStep">Destination address step</param>
+/// <param name="unit">Transfer unit</param>
+MSP430_DMA::MSP430_DMA(MSP430_DMA_Channel channel, MSP430_DMA_Trigger trigger, MSP430_DMA_Mode mode, MSP430_DMA_Step sourceStep, MSP430_DMA_Step destinationStep, MSP430_DMA_Unit unit) : MSP430_DMA::MSP430_DMA(channel)
+{
+	this->trigger = trigger;
+	this->mode = mode;
+	this->sourceStep = sourceStep;
+	this->destinationStep = destinationStep;
+	this->unit = unit;
+}
+
+/// <summary>Delete this DMA instance, disable the channel and reset the registers</summary>
+MSP430_DMA::~MSP430_DMA()
+{
+	Deinitialize();
+}
+
+/// <summary>Initialize the hardware channel by this DMA instance (trigger and transfer configured, channel disabled)</summary>
+void MSP430_DMA::Initialize(void)
+{
+	bool byteUnit = (this->unit == MSP430_DMA_Unit::Byte);
+
+	this->reg_DMAxCTL.Reset();
+	this->reg_DMAxTSEL.Write(static_cast<unsigned char> (this->trigger));
+	this->reg_DMAxCTL.Write(MSP430_DMA_Control::Mode::Of(this->mode) | MSP430_DMA_Control::DestinationStep::Of(this->destinationStep) |
+		MSP430_DMA_Control::SourceStep::Of(this->sourceStep) | MSP430_DMA_Control::DestinationByte::Of(byteUnit) | MSP430_DMA_Control::SourceByte::Of(byteUnit));
+}
+
+/// <summary>
+/// Deinitialize the hardware channel and set all registers to default.
+/// <para>(Default: Disabled, software trigger, interrupt disabled)</para>
+/// </summary>
+void MSP430_DMA::Deinitialize(void)
+{
+	this->reg_DMAxCTL.Reset();
+	this->reg_DMAxTSEL.Write(0);
+}
+
+/// <summary>Set the trigger (takes effect at once)</summary>
+/// <param name="trigger">Trigger</param>
+void MSP430_DMA::SetTrigger(MSP430_DMA_Trigger trigger)
+{
+	this->trigger = trigger;
+	this->reg_DMAxTSEL.Write(static_cast<unsigned char> (trigger));
+}
+
+/// <summary>Set the source address (while disabled it is loaded by Enable(), while enabled by the next repeat)</summary>
+/// <param name="source">Source address</param>
+void MSP430_DMA::SetSource(const volatile void* source)
+{
+	(this->reg_DMAxCTL + OffsetSA).Write(AddressOf(source));
+}
+
+/// <summary>Set the destination address (while disabled it is loaded by Enable(), while enabled by the next repeat)</summary>
+/// <param name="destination">Destination address</param>
+void MSP430_DMA::SetDestination(volatile void* destination)
+{
+	(this->reg_DMAxCTL + OffsetDA).Write(AddressOf(destination));
+}
+
+/// <summary>Set the number of units per transfer/block</summary>
+/// <param name="size">Number of units</param>
+void MSP430_DMA::SetSize(unsigned int size)
+{
+	(this->reg_DMAxCTL + OffsetSZ).Write(size);
+}
+
+/// <summary>Get the number of units left in the current transfer/block</summary>
+unsigned int MSP430_DMA::GetRemaining(void)
+{
+	return (this->reg_DMAxCTL + OffsetSZ).Read();
+}
+
+/// <summary>Enable the channel (the addresses and the size are loaded, transfers wait for the trigger)</summary>
+void MSP430_DMA::Enable(void)
+{
+	this->reg_DMAxCTL.Modify(MSP430_DMA_Control::Enable::On);
+}
+
+/// <summary>Disable the channel (a transfer in progress is completed first)</summary>
+void MSP430_DMA::Disable(void)
+{
+	this->reg_DMAxCTL.Modify(MSP430_DMA_Control::Enable::Off);
+}
+
+/// <summary>Check if the channel is enabled (false after a non-repeated transfer is completed)</summary>
+bool MSP430_DMA::IsEnabled(void)
+{
+	return this->reg_DMAxCTL.Test(MSP430_DMA_Control::Enable::On);
+}
+
+/// <summary>Start a transfer by software (software trigger)</summary>
+void MSP430_DMA::Request(void)
+{
+	this->reg_DMAxCTL.Modify(MSP430_DMA_Control::Request::On);
+}
+
+/// <summary>Enable the transfer complete interrupt (when the size counts down to zero)</summary>
+void MSP430_DMA::EnableInterrupt(void)
+{
+	this->reg_DMAxCTL.Modify(MSP430_DMA_Control::InterruptEnable::On);
+}
+
+/// <summary>Disable the transfer complete interrupt</summary>
+void MSP430_DMA::DisableInterrupt(void)
+{
+	this->reg_DMAxCTL.Modify(MSP430_DMA_Control::InterruptEnable::Off);
+}
+
+/// <summary>Check if the transfer complete flag was setted</summary>
+bool MSP430_DMA::CheckInterruptFlag(void)
+{
+	return this->reg_DMAxCTL.Test(MSP430_DMA_Control::InterruptFlag::On);
+}
+
+/// <summary>Clear the transfer complete flag</summary>
+void MSP430_DMA::ClearInterruptFlag(void)
+{
+	this->reg_DMAxCTL.Modify(MSP430_DMA_Control::InterruptFlag::Off);
+}
+
+/// <summary>Default handler for the DMA interrupts without a registered handler</summary>
+extern "C" void MSP430_DMA_DefaultInterruptHandler(void)
+{
+}
+
+// Weak handler entry points, aliased to the default handler until MSP430_DMA_INTERRUPT_HANDLER defines them
+#define MSP430CP_DMA_WEAK_HANDLER(CHANNEL) \
+	extern "C" void MSP430_DMA_##CHANNEL##_InterruptHandler(void) __attribute__((weak, alias("MSP430_DMA_DefaultInterruptHandler")));
+
+MSP430CP_DMA_WEAK_HANDLER(0)
+MSP430CP_DMA_WEAK_HANDLER(1)
+MSP430CP_DMA_WEAK_HANDLER(2)
+#if DMA_CHANNEL_COUNT > 3
+MSP430CP_DMA_WEAK_HANDLER(3)
+MSP430CP_DMA_WEAK_HANDLER(4)
+MSP430CP_DMA_WEAK_HANDLER(5)
+#endif
+
+/// <summary>
+/// DMAIV handler table (flash-resident)
+/// <para>DMAIV is 2 * (n + 1) for channel n, so DMAIV shifted right by 1 is the index directly.</para>
+/// </summary>
+static const MSP430_DMA_InterruptHandler handlers[DMA_CHANNEL_COUNT + 1] =
+{
+	MSP430_DMA_DefaultInterruptHandler,
+	MSP430_DMA_0_InterruptHandler, MSP430_DMA_1_InterruptHandler, MSP430_DMA_2_InterruptHandler,
+#if DMA_CHANNEL_COUNT > 3
+	MSP430_DMA_3_InterruptHandler, MSP430_DMA_4_InterruptHandler, MSP430_DMA_5_InterruptHandler
+#endif
+};
+
+#ifndef DMA_USER_ISR
+/// <summary>DMA interrupt service routine</summary>
+REG_ISR(DMA_VECTOR, MSP430_DMA_ISR)
+{
+	MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::DMA);
+	// Reading DMAIV returns the highest priority pending channel and clears its flag
+	unsigned int iv;
+	while ((iv = DMAIV) != 0)
+	{
+		MSP430_TRACE(MSP430_Trace_Id::InterruptDispatch, iv >> 1);
+		handlers[__even_in_range(iv, 2 * DMA_CHANNEL_COUNT) >> 1]();
+	}
+	MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::DMA);
+	REG_ISR_EXIT();
+}
+#endif
+#endif
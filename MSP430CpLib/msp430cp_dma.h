@@ -0,0 +1,248 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+
+// DMA location enumerations and definations
+/// <summary>
+/// DMA channel Id (0 to DMA_CHANNEL_COUNT - 1, a lower channel has a higher priority)
+/// </summary>
+typedef unsigned char MSP430_DMA_Channel;
+
+// DMA configurations enumerations
+/// <summary>
+/// DMA Trigger (Results in DMAxTSEL bits)
+/// <para>NOTE: The trigger numbers are device specific (MSP430F5529 here), see also the device's datasheet (DMA trigger assignments).</para>
+/// </summary>
+enum class MSP430_DMA_Trigger
+{
+	/// <summary>DMAREQ bit (software request)</summary>
+	Software = 0,
+	TA0_CCR0 = 1,
+	TA0_CCR2 = 2,
+	TA1_CCR0 = 3,
+	TA1_CCR2 = 4,
+	TA2_CCR0 = 5,
+	TA2_CCR2 = 6,
+	TB0_CCR0 = 7,
+	TB0_CCR2 = 8,
+	UCA0_RX = 16,
+	UCA0_TX = 17,
+	UCB0_RX = 18,
+	UCB0_TX = 19,
+	UCA1_RX = 20,
+	UCA1_TX = 21,
+	UCB1_RX = 22,
+	UCB1_TX = 23,
+	ADC12_IFG = 24,
+	/// <summary>Hardware multiplier ready</summary>
+	Multiplier = 29,
+	/// <summary>Interrupt flag of the previous channel (DMA2IFG for channel 0)</summary>
+	PreviousChannel = 30,
+	/// <summary>External DMAE0 pin</summary>
+	External = 31
+};
+
+/// <summary>
+/// DMA Transfer Mode (Results in DMADT bits)
+/// <para>Repeated modes reload the size and the addresses when the size counts down to zero, and stay enabled.</para>
+/// </summary>
+enum class MSP430_DMA_Mode
+{
+	/// <summary>One unit per trigger, disabled after the size</summary>
+	Single = 0b000,
+	/// <summary>The whole size per trigger (CPU halted), disabled after the block</summary>
+	Block = 0b001,
+	/// <summary>The whole size per trigger, interleaved with the CPU, disabled after the block</summary>
+	Burst = 0b010,
+	RepeatSingle = 0b100,
+	RepeatBlock = 0b101,
+	RepeatBurst = 0b110
+};
+
+/// <summary>
+/// DMA Address Step after each unit (Results in DMASRCINCR/DMADSTINCR bits)
+/// </summary>
+enum class MSP430_DMA_Step
+{
+	Fixed = 0b00,
+	Decrement = 0b10,
+	Increment = 0b11
+};
+
+/// <summary>
+/// DMA Transfer Unit (Results in DMASRCBYTE/DMADSTBYTE bits, both sides)
+/// </summary>
+enum class MSP430_DMA_Unit
+{
+	Word = 0,
+	Byte = 1
+};
+
+// Register fields
+/// <summary>
+/// DMA channel control register fields (DMAxCTL)
+/// </summary>
+struct MSP430_DMA_Control
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>Transfer mode (DMADT)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 12, 3, MSP430_DMA_Mode> Mode;
+	/// <summary>Destination address step (DMADSTINCR)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 10, 2, MSP430_DMA_Step> DestinationStep;
+	/// <summary>Source address step (DMASRCINCR)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 8, 2, MSP430_DMA_Step> SourceStep;
+	/// <summary>Destination is a byte (DMADSTBYTE)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 7, 1, bool> DestinationByte;
+	/// <summary>Source is a byte (DMASRCBYTE)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 6, 1, bool> SourceByte;
+	/// <summary>Level sensitive trigger (DMALEVEL)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 5, 1, bool> Level;
+	/// <summary>Channel enable (DMAEN)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 4, 1, bool> Enable;
+	/// <summary>Transfer complete interrupt flag (DMAIFG)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 3, 1, bool> InterruptFlag;
+	/// <summary>Transfer complete interrupt enable (DMAIE)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 2, 1, bool> InterruptEnable;
+	/// <summary>Transfer aborted by an NMI (DMAABORT)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 1, 1, bool> Abort;
+	/// <summary>Software request (DMAREQ, reads as 0)</summary>
+	typedef MSP430_RegisterField<MSP430_DMA_Control, 0, 1, bool> Request;
+};
+
+// Interrupt handlers
+/// <summary>DMA interrupt handler (called in interrupt context, the interrupt flag is already cleared)</summary>
+typedef void (*MSP430_DMA_InterruptHandler)(void);
+
+/// <summary>
+/// Define the transfer complete interrupt handler of a DMA channel
+/// <para>CHANNEL is the channel id. Follow the macro by the handler body.</para>
+/// <para>The handler is called by the library interrupt routine: use MSP430_WAKE() (or a scheduler Post()) to return to active mode.</para>
+/// </summary>
+#define MSP430_DMA_INTERRUPT_HANDLER(CHANNEL) extern "C" void MSP430_DMA_##CHANNEL##_InterruptHandler(void)
+
+/// <summary>Default handler for the DMA interrupts without a registered handler</summary>
+extern "C" void MSP430_DMA_DefaultInterruptHandler(void);
+
+// Handler entry points (weak, overridden by MSP430_DMA_INTERRUPT_HANDLER)
+#if DMA_CHANNEL_COUNT > 0
+MSP430_DMA_INTERRUPT_HANDLER(0);
+MSP430_DMA_INTERRUPT_HANDLER(1);
+MSP430_DMA_INTERRUPT_HANDLER(2);
+#endif
+#if DMA_CHANNEL_COUNT > 3
+MSP430_DMA_INTERRUPT_HANDLER(3);
+MSP430_DMA_INTERRUPT_HANDLER(4);
+MSP430_DMA_INTERRUPT_HANDLER(5);
+#endif
+
+/// <summary>
+/// MSP430 DMA channel class
+/// <para>The channel registers are reached from the channel control register (DMAxCTL, DMAxSA, DMAxDA, DMAxSZ),
+/// the addresses are written by word (the upper address bits are cleared, small memory model).</para>
+/// </summary>
+class MSP430_DMA
+{
+private:
+	// Register for hardware operation
+
+	/// <summary>Channel control register (DMAxCTL), the base of the other registers</summary>
+	MSP430_FieldRegister<MSP430_DMA_Control> reg_DMAxCTL;
+	/// <summary>Trigger select byte (DMAxTSEL in DMACTL0-3)</summary>
+	MSP430_Register8 reg_DMAxTSEL;
+
+	// Corresponding DMA location
+	/// <summary>DMA channel</summary>
+	MSP430_DMA_Channel channel;
+
+	// Corresponding DMA configuration
+	/// <summary>Trigger</summary>
+	MSP430_DMA_Trigger trigger = MSP430_DMA_Trigger::Software;
+	/// <summary>Transfer mode</summary>
+	MSP430_DMA_Mode mode = MSP430_DMA_Mode::Single;
+	/// <summary>Source address step</summary>
+	MSP430_DMA_Step sourceStep = MSP430_DMA_Step::Increment;
+	/// <summary>Destination address step</summary>
+	MSP430_DMA_Step destinationStep = MSP430_DMA_Step::Increment;
+	/// <summary>Transfer unit</summary>
+	MSP430_DMA_Unit unit = MSP430_DMA_Unit::Byte;
+
+	// Private low-level linking functions
+	/// <summary>Hardware link from program to registers</summary>
+	void HardLink(void);
+
+public:
+	// Register word offsets from DMAxCTL
+	/// <summary>DMAxSA offset (low word)</summary>
+	static constexpr int OffsetSA = 1;
+	/// <summary>DMAxDA offset (low word)</summary>
+	static constexpr int OffsetDA = 3;
+	/// <summary>DMAxSZ offset</summary>
+	static constexpr int OffsetSZ = 5;
+
+	// Constructor
+	/// <summary>Create a new DMA object, set the channel only and let other parameters to default (software trigger, single byte transfers)</summary>
+	/// <param name="channel">DMA channel</param>
+	MSP430_DMA(MSP430_DMA_Channel channel);
+	/// <summary>Create a new DMA object, set the channel, trigger, transfer mode, address steps and unit</summary>
+	/// <param name="channel">DMA channel</param>
+	/// <param name="trigger">Trigger</param>
+	/// <param name="mode">Transfer mode</param>
+	/// <param name="sourceStep">Source address step</param>
+	/// <param name="destinationStep">Destination address step</param>
+	/// <param name="unit">Transfer unit</param>
+	MSP430_DMA(MSP430_DMA_Channel channel, MSP430_DMA_Trigger trigger, MSP430_DMA_Mode mode, MSP430_DMA_Step sourceStep, MSP430_DMA_Step destinationStep, MSP430_DMA_Unit unit);
+	/// <summary>Delete this DMA instance, disable the channel and reset the registers</summary>
+	~MSP430_DMA();
+
+	// DMA initialize or re-configuration
+	/// <summary>Initialize the hardware channel by this DMA instance (trigger and transfer configured, channel disabled)</summary>
+	void Initialize(void);
+	/// <summary>
+	/// Deinitialize the hardware channel and set all registers to default.
+	/// <para>(Default: Disabled, software trigger, interrupt disabled)</para>
+	/// </summary>
+	void Deinitialize(void);
+	/// <summary>Set the trigger (takes effect at once)</summary>
+	/// <param name="trigger">Trigger</param>
+	void SetTrigger(MSP430_DMA_Trigger trigger);
+
+	// Transfer control
+	/// <summary>Set the source address (while disabled it is loaded by Enable(), while enabled by the next repeat)</summary>
+	/// <param name="source">Source address</param>
+	void SetSource(const volatile void* source);
+	/// <summary>Set the destination address (while disabled it is loaded by Enable(), while enabled by the next repeat)</summary>
+	/// <param name="destination">Destination address</param>
+	void SetDestination(volatile void* destination);
+	/// <summary>Set the number of units per transfer/block</summary>
+	/// <param name="size">Number of units</param>
+	void SetSize(unsigned int size);
+	/// <summary>Get the number of units left in the current transfer/block</summary>
+	unsigned int GetRemaining(void);
+	/// <summary>Enable the channel (the addresses and the size are loaded, transfers wait for the trigger)</summary>
+	void Enable(void);
+	/// <summary>Disable the channel (a transfer in progress is completed first)</summary>
+	void Disable(void);
+	/// <summary>Check if the channel is enabled (false after a non-repeated transfer is completed)</summary>
+	bool IsEnabled(void);
+	/// <summary>Start a transfer by software (software trigger)</summary>
+	void Request(void);
+
+	// Channel interrupt
+	/// <summary>Enable the transfer complete interrupt (when the size counts down to zero)</summary>
+	void EnableInterrupt(void);
+	/// <summary>Disable the transfer complete interrupt</summary>
+	void DisableInterrupt(void);
+	/// <summary>Check if the transfer complete flag was setted</summary>
+	bool CheckInterruptFlag(void);
+	/// <summary>Clear the transfer complete flag</summary>
+	void ClearInterruptFlag(void);
+};
+
+#ifdef MSP430CP_HOST
+#ifndef DMA_USER_ISR
+// Interrupt service routine (plain function on host)
+void MSP430_DMA_ISR(void);
+#endif
+#endif
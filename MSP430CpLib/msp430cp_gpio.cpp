@@ -1,22 +1,30 @@
 #include <msp430.h>
 #include "msp430cp_device.h"
 #include "msp430cp_gpio.h"
+#include "msp430cp_trace.h"
 
 // GPIO registers
-extern REG_8b PxIN[GPIO_PORT_COUNT];
-extern REG_8b PxOUT[GPIO_PORT_COUNT];
-extern REG_8b PxDIR[GPIO_PORT_COUNT];
-extern REG_8b PxREN[GPIO_PORT_COUNT];
-extern REG_8b PxSEL[GPIO_PORT_COUNT];
+extern REG_8b const PxIN[GPIO_PORT_COUNT];
+extern REG_8b const PxOUT[GPIO_PORT_COUNT];
+extern REG_8b const PxDIR[GPIO_PORT_COUNT];
+extern REG_8b const PxREN[GPIO_PORT_COUNT];
+extern REG_8b const PxSEL[GPIO_PORT_COUNT];
 #ifdef GPIO_PORT_HAS_FUNSEL2
-extern REG_8b PxSEL2[GPIO_PORT_COUNT];
+extern REG_8b const PxSEL2[GPIO_PORT_COUNT];
 #endif
 #ifdef GPIO_PORT_HAS_DS
-extern REG_8b PxDS[GPIO_PORT_COUNT];
+extern REG_8b const PxDS[GPIO_PORT_COUNT];
+#endif
+extern REG_8b const PxIE[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIFG[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIES[GPIO_PORT_SUPPORT_INT_COUNT];
+#if GPIO_PORT_PAIR_COUNT > 0
+extern REG_16b const PPxIN[GPIO_PORT_PAIR_COUNT];
+extern REG_16b const PPxOUT[GPIO_PORT_PAIR_COUNT];
+extern REG_16b const PPxDIR[GPIO_PORT_PAIR_COUNT];
+extern REG_16b const PPxREN[GPIO_PORT_PAIR_COUNT];
+extern REG_16b const PPxSEL[GPIO_PORT_PAIR_COUNT];
 #endif
-extern REG_8b PxIE[GPIO_PORT_SUPPORT_INT_COUNT];
-extern REG_8b PxIFG[GPIO_PORT_SUPPORT_INT_COUNT];
-extern REG_8b PxIES[GPIO_PORT_SUPPORT_INT_COUNT];
 
 /// <summary>Hardware link from program to registers</summary>
 void MSP430_GPIO::HardLink(void)
@@ -34,9 +42,14 @@ void MSP430_GPIO::HardLink(void)
 #ifdef GPIO_PORT_HAS_DS
 	this->reg_PxDS = PxDS[static_cast<int> (port)];
 #endif
-	this->reg_PxIE = PxIE[static_cast<int> (port)];
-	this->reg_PxIFG = PxIFG[static_cast<int> (port)];
-	this->reg_PxIES = PxIES[static_cast<int> (port)];
+
+	// Only the ports with interrupt capability have interrupt registers
+	if (static_cast<int> (port) < GPIO_PORT_SUPPORT_INT_COUNT)
+	{
+		this->reg_PxIE = PxIE[static_cast<int> (port)];
+		this->reg_PxIFG = PxIFG[static_cast<int> (port)];
+		this->reg_PxIES = PxIES[static_cast<int> (port)];
+	}
 }
 
 /// <summary>Create a new GPIO object, set the location only and let other parameters to default</summary>
@@ -46,6 +59,7 @@ MSP430_GPIO::MSP430_GPIO(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin)
 {
 	this->port = port;
 	this->pin = pin;
+	this->mask = static_cast<unsigned char> (1 << pin);
 
 	// Link the hardware
 	HardLink();
@@ -83,71 +97,86 @@ MSP430_GPIO::~MSP430_GPIO()
 /// <param name="interruptTrig">Trig edge for interrupt</param>
 void MSP430_GPIO::EnableInterrupt(MSP430_GPIO_InterruptTrig interruptTrig)
 {
+	// Only P1/P2 port have interrupt capability
+	if (!this->reg_PxIE.IsPresent())
+	{
+		return;
+	}
 	this->interruptSw = MSP430_GPIO_InterruptSwitch::On;
 	this->interruptTrig = interruptTrig;
 
 	// Set interrupt
-	REG_SBIT(reg_PxIE, pin, static_cast<int> (this->interruptSw));
-	REG_SBIT(reg_PxIES, pin, static_cast<int> (this->interruptTrig));
+	this->reg_PxIES.Assign(this->mask, interruptTrig == MSP430_GPIO_InterruptTrig::Negedge);
+	this->reg_PxIE.Set(this->mask);
 }
 
 /// <summary>Disable the corresponding pin's interrupt</summary>
 void MSP430_GPIO::DisableInterrupt(void)
 {
 	this->interruptSw = MSP430_GPIO_InterruptSwitch::Off;
-	
+	if (!this->reg_PxIE.IsPresent())
+	{
+		return;
+	}
+
 	// Set interrupt
-	REG_SBIT(reg_PxIE, pin, static_cast<int> (this->interruptSw));
+	this->reg_PxIE.Clear(this->mask);
 }
 
 /// <summary>Check if the interrupt flag on corresponding pin was setted</summary>
 bool MSP430_GPIO::CheckInterruptFlag(void)
 {
-	return REG_GBIT(reg_PxIFG, pin);
+	return this->reg_PxIFG.IsPresent() && this->reg_PxIFG.Test(this->mask);
 }
 
 /// <summary>Clear the interrupt flag then interrupt can be re-detected</summary>
 void MSP430_GPIO::ClearInterruptFlag(void)
 {
-	REG_SBIT0(reg_PxIFG, pin);
+	if (this->reg_PxIFG.IsPresent())
+	{
+		this->reg_PxIFG.Clear(this->mask);
+	}
 }
 
 /// <summary>Set the corresponding GPIO pin output to HIGH(1) (Only effect when using standard function)</summary>
 void MSP430_GPIO::SetHigh(void)
 {
-	REG_SBIT1(reg_PxOUT, pin);
+	this->reg_PxOUT.Set(this->mask);
+	MSP430_TRACE(MSP430_Trace_Id::GPIOWrite, MSP430_Trace::PinOf(static_cast<unsigned int> (this->port), this->pin, true));
 }
 
 /// <summary>Set the corresponding GPIO pin output to LOW(0) (Only effect when using standard function)</summary>
 void MSP430_GPIO::SetLow(void)
 {
-	REG_SBIT0(reg_PxOUT, pin);
+	this->reg_PxOUT.Clear(this->mask);
+	MSP430_TRACE(MSP430_Trace_Id::GPIOWrite, MSP430_Trace::PinOf(static_cast<unsigned int> (this->port), this->pin, false));
 }
 
 /// <summary>Set the corresponding GPIO pin output by a setting value (Only effect when using standard function)</summary>
 /// <param name="value">GPIO pin output value</param>
 void MSP430_GPIO::SetValue(MSP430_GPIO_Value value)
 {
-	REG_SBIT(reg_PxOUT, pin, value);
+	this->reg_PxOUT.Assign(this->mask, value != 0);
+	MSP430_TRACE(MSP430_Trace_Id::GPIOWrite, MSP430_Trace::PinOf(static_cast<unsigned int> (this->port), this->pin, value != 0));
 }
 
 /// <summary>Get the corresponding GPIO pin input</summary>
 /// <return>GPIO pin input value</return>
 MSP430_GPIO_Value MSP430_GPIO::GetValue(void)
 {
-	return REG_GBIT(reg_PxIN, pin);
+	return this->reg_PxIN.Test(this->mask) ? 1 : 0;
 }
 
 /// <summary>Check if the corresponding GPIO pin input is HIGH(1)</summary>
 bool MSP430_GPIO::CheckHigh(void)
 {
-	return (GetValue() == 1);
+	return this->reg_PxIN.Test(this->mask);
 }
 
 /// <summary>Check if the corresponding GPIO pin input is LOW(0)</summary>
 bool MSP430_GPIO::CheckLow(void)
 {
-	return (GetValue() == 0);
+	return !this->reg_PxIN.Test(this->mask);
 }
 
 /// <summary>
@@ -157,8 +186,9 @@ bool MSP430_GPIO::CheckLow(void)
 /// </summary>
 void MSP430_GPIO::ReverseValue(void)
 {
-	// Read and write
-	SetValue(~GetValue());
+	// Single XOR.B on the output
+	this->reg_PxOUT.Toggle(this->mask);
+	MSP430_TRACE(MSP430_Trace_Id::GPIOToggle, MSP430_Trace::PinOf(static_cast<unsigned int> (this->port), this->pin));
 }
 
 /// <summary>Reverse the corresponding GPIO's direction
@@ -177,7 +207,7 @@ void MSP430_GPIO::ReverseDirection(void)
 	}
 
 	// Set pin direction
-	REG_SBIT(this->reg_PxDIR, this->pin, static_cast<int> (this->direction));
+	this->reg_PxDIR.Assign(this->mask, this->direction == MSP430_GPIO_Direction::Output);
 }
 
 /// <summary>
@@ -188,7 +218,7 @@ void MSP430_GPIO::ReverseDirection(void)
 void MSP430_GPIO::SetDirection(MSP430_GPIO_Direction direction)
 {
 	this->direction = direction;
-	REG_SBIT(this->reg_PxDIR, this->pin, static_cast<int> (this->direction));
+	this->reg_PxDIR.Assign(this->mask, this->direction == MSP430_GPIO_Direction::Output);
 }
 
 /// <summary>
@@ -209,9 +239,9 @@ void MSP430_GPIO::SetFunction(MSP430_GPIO_Function function)
 	this->function = function;
 
 	unsigned char func = static_cast<unsigned char> (this->function);
-	REG_SBIT(this->reg_PxSEL, this->pin, func & 0x01);
+	this->reg_PxSEL.Assign(this->mask, (func & 0x01) != 0);
 #ifdef GPIO_PORT_HAS_FUNSEL2
-	REG_SBIT(gpio.reg_PxSEL2, this->pin, (func & 0x02) >> 1);
+	this->reg_PxSEL2.Assign(this->mask, (func & 0x02) != 0);
 #endif
 }
 
@@ -223,23 +253,47 @@ void MSP430_GPIO::SetFunction(MSP430_GPIO_Function function)
 void MSP430_GPIO::SetPullResistor(MSP430_GPIO_PullResistor sw)
 {
 	this->pullResistor = sw;
-	REG_SBIT(this->reg_PxREN, this->pin, static_cast<int> (this->pullResistor));
+	this->reg_PxREN.Assign(this->mask, this->pullResistor == MSP430_GPIO_PullResistor::On);
+}
+
+#ifdef GPIO_PORT_HAS_DS
+/// <summary>
+/// Dymanically set the corresponding pin's drive strength
+/// <para>NOTE: This function will effect on register directly.</para>
+/// </summary>
+/// <param name="strength">Drive strength</param>
+void MSP430_GPIO::SetDriveStrength(MSP430_GPIO_DriveStrength strength)
+{
+	this->reg_PxDS.Assign(this->mask, strength == MSP430_GPIO_DriveStrength::Full);
+}
+#endif
+
+/// <summary>Get the port of the GPIO</summary>
+MSP430_GPIO_Port MSP430_GPIO::GetPort(void)
+{
+	return this->port;
+}
+
+/// <summary>Get the pin Id of the GPIO</summary>
+MSP430_GPIO_Pin MSP430_GPIO::GetPin(void)
+{
+	return this->pin;
 }
 
 /// <summary>Initialize a hardware GPIO by this GPIO instance</summary>
 void MSP430_GPIO::Initialize(void)
 {
 	// Set pin direction
-	REG_SBIT(this->reg_PxDIR, this->pin, static_cast<int> (this->direction));
+	this->reg_PxDIR.Assign(this->mask, this->direction == MSP430_GPIO_Direction::Output);
 	
 	// Set pullup/pulldown resistor
-	REG_SBIT(this->reg_PxREN, this->pin, static_cast<int> (this->pullResistor));
+	this->reg_PxREN.Assign(this->mask, this->pullResistor == MSP430_GPIO_PullResistor::On);
 
 	// Set function
 	unsigned char func = static_cast<unsigned char> (this->function);
-	REG_SBIT(this->reg_PxSEL, this->pin, func & 0x01);
+	this->reg_PxSEL.Assign(this->mask, (func & 0x01) != 0);
 #ifdef GPIO_PORT_HAS_FUNSEL2
-	REG_SBIT(gpio.reg_PxSEL2, this->pin, (func & 0x02) >> 1);
+	this->reg_PxSEL2.Assign(this->mask, (func & 0x02) != 0);
 #endif
 }
 
@@ -249,19 +303,18 @@ void MSP430_GPIO::Initialize(void)
 /// </summary>
 void MSP430_GPIO::Deinitialize(void)
 {
-	MSP430_GPIO_Pin pin = this->pin;
+	unsigned char mask = this->mask;
 
 	// Set pin direction
-	REG_SBIT(this->reg_PxDIR, pin, static_cast<int> (MSP430_GPIO_Direction::Input));
+	this->reg_PxDIR.Clear(mask);
 
 	// Set pullup/pulldown resistor
-	REG_SBIT(this->reg_PxREN, pin, static_cast<int> (MSP430_GPIO_PullResistor::Off));
+	this->reg_PxREN.Clear(mask);
 
 	// Set function
-	unsigned char func = static_cast<unsigned char> (this->function);
-	REG_SBIT(this->reg_PxSEL, pin, 0);
+	this->reg_PxSEL.Clear(mask);
 #ifdef GPIO_PORT_HAS_FUNSEL2
-	REG_SBIT(gpio.reg_PxSEL2, pin, 0);
+	this->reg_PxSEL2.Clear(mask);
 #endif
 }
 
@@ -334,23 +387,38 @@ void MSP430_GPIO_Bank::SetAccessMask(unsigned char start, unsigned char end)
 	this->accessMask = mask;
 }
 
+/// <summary>Get the access mask of the GPIO bank</summary>
+unsigned char MSP430_GPIO_Bank::GetAccessMask(void)
+{
+	return this->accessMask;
+}
+
+/// <summary>Get the port of the GPIO bank</summary>
+MSP430_GPIO_Port MSP430_GPIO_Bank::GetPort(void)
+{
+	return this->port;
+}
+
 /// <summary>Initialize a hardware GPIO bank by this GPIO bank instance</summary>
 void MSP430_GPIO_Bank::Initialize(void)
 {
 	// Select the stardand I/O function
-	REG_WM(PxSEL[static_cast<int> (port)], 0x00, accessMask);
+	MSP430_Register8(PxSEL[static_cast<int> (port)]).Clear(accessMask);
 #ifdef GPIO_PORT_HAS_FUNSEL2
-	REG_WM(PxSEL2[static_cast<int> (port)], 0x00, accessMask);
+	MSP430_Register8(PxSEL2[static_cast<int> (port)]).Clear(accessMask);
 #endif
 	
-	// Close the interrupt
-	REG_WM(PxIE[static_cast<int> (port)], 0x00, accessMask);
+	// Close the interrupt (Only the ports with interrupt capability)
+	if (static_cast<int> (port) < GPIO_PORT_SUPPORT_INT_COUNT)
+	{
+		MSP430_Register8(PxIE[static_cast<int> (port)]).Clear(accessMask);
+	}
 
 	// Set pin direction
-	REG_WM(this->reg_PxDIR, static_cast<int> (this->direction) ? 0xFF : 0x00, accessMask);
+	this->reg_PxDIR.Assign(accessMask, this->direction == MSP430_GPIO_Direction::Output);
 
 	// Set pullup/pulldown resistor
-	REG_WM(this->reg_PxREN, static_cast<int> (this->pullResistor) ? 0xFF : 0x00, accessMask);
+	this->reg_PxREN.Assign(accessMask, this->pullResistor == MSP430_GPIO_PullResistor::On);
 }
 
 /// <summary>
@@ -360,10 +428,10 @@ void MSP430_GPIO_Bank::Initialize(void)
 void MSP430_GPIO_Bank::Deinitialize(void)
 {
 	// Set direction
-	REG_WM(this->reg_PxDIR, 0x00, accessMask);
+	this->reg_PxDIR.Clear(accessMask);
 
 	// Set pullup/pulldown resistor
-	REG_WM(this->reg_PxREN, 0x00, accessMask);
+	this->reg_PxREN.Clear(accessMask);
 }
 
 /// <summary>
@@ -373,7 +441,7 @@ void MSP430_GPIO_Bank::Deinitialize(void)
 /// <param name="value">GPIO bank output value</param>
 void MSP430_GPIO_Bank::SetValue(unsigned char value)
 {
-	REG_WM(this->reg_PxOUT, value, accessMask);
+	this->reg_PxOUT.Modify(value, accessMask);
 }
 
 /// <summary>
@@ -382,7 +450,7 @@ void MSP430_GPIO_Bank::SetValue(unsigned char value)
 /// </summary>
 unsigned char MSP430_GPIO_Bank::GetValue(void)
 {
-	return REG_RM(this->reg_PxIN, accessMask);
+	return this->reg_PxIN.Read(accessMask);
 }
 
 /// <summary>
@@ -391,7 +459,8 @@ unsigned char MSP430_GPIO_Bank::GetValue(void)
 /// </summary>
 void MSP430_GPIO_Bank::ReverseValue(void)
 {
-	SetValue(~GetValue());
+	// Single XOR.B on the output
+	this->reg_PxOUT.Toggle(accessMask);
 }
 
 /// <summary>Reverse the corresponding GPIO  bank's direction
@@ -410,7 +479,7 @@ void MSP430_GPIO_Bank::ReverseDirection(void)
 	}
 
 	// Set pin direction
-	REG_WM(this->reg_PxDIR, static_cast<int> (this->direction) ? 0xFF : 0x00, accessMask);
+	this->reg_PxDIR.Assign(accessMask, this->direction == MSP430_GPIO_Direction::Output);
 }
 
 /// <summary>
@@ -423,7 +492,7 @@ void MSP430_GPIO_Bank::SetDirection(MSP430_GPIO_Direction direction)
 	this->direction = direction;
 
 	// Set pin direction
-	REG_WM(this->reg_PxDIR, static_cast<int> (this->direction) ? 0xFF : 0x00, accessMask);
+	this->reg_PxDIR.Assign(accessMask, this->direction == MSP430_GPIO_Direction::Output);
 }
 
 /// <summary>
@@ -443,9 +512,228 @@ void MSP430_GPIO_Bank::SetPullResistor(MSP430_GPIO_PullResistor sw)
 	this->pullResistor = sw;
 
 	// Set pullup/pulldown resistor
-	REG_WM(this->reg_PxREN, static_cast<int> (this->pullResistor) ? 0xFF : 0x00, accessMask);
+	this->reg_PxREN.Assign(accessMask, this->pullResistor == MSP430_GPIO_PullResistor::On);
+}
+
+#if GPIO_PORT_PAIR_COUNT > 0
+/// <summary>Hardware link from program to registers</summary>
+void MSP430_GPIO_WordBank::HardLink(void)
+{
+	// Get the port pair register pointer, then link them
+	MSP430_GPIO_PortPair pair = this->pair;
+	this->reg_PxIN = PPxIN[static_cast<int> (pair)];
+	this->reg_PxOUT = PPxOUT[static_cast<int> (pair)];
+	this->reg_PxDIR = PPxDIR[static_cast<int> (pair)];
+	this->reg_PxREN = PPxREN[static_cast<int> (pair)];
 }
 
+/// <summary>Create a new GPIO word bank object, set the port pair</summary>
+/// <param name="pair">GPIO port pair</param>
+MSP430_GPIO_WordBank::MSP430_GPIO_WordBank(MSP430_GPIO_PortPair pair)
+{
+	this->pair = pair;
+
+	// Link the hardware
+	HardLink();
+}
+
+/// <summary>Create a new GPIO word bank object, set the port pair and direction</summary>
+/// <param name="pair">GPIO port pair</param>
+/// <param name="direction">GPIO direction</param>
+MSP430_GPIO_WordBank::MSP430_GPIO_WordBank(MSP430_GPIO_PortPair pair, MSP430_GPIO_Direction direction) : MSP430_GPIO_WordBank(pair)
+{
+	this->direction = direction;
+}
+
+/// <summary>Create a new GPIO word bank object, set the port pair, direction and pullup/pulldown resistor</summary>
+/// <param name="pair">GPIO port pair</param>
+/// <param name="direction">GPIO direction</param>
+/// <param name="pullResistor">GPIO pullup/pulldown resistor enable/disable</param>
+MSP430_GPIO_WordBank::MSP430_GPIO_WordBank(MSP430_GPIO_PortPair pair, MSP430_GPIO_Direction direction, MSP430_GPIO_PullResistor pullResistor) : MSP430_GPIO_WordBank(pair, direction)
+{
+	this->pullResistor = pullResistor;
+}
+
+/// <summary>Delete this GPIO word bank instance, reset the hardware registers, and free up all memory space</summary>
+MSP430_GPIO_WordBank::~MSP430_GPIO_WordBank()
+{
+	Deinitialize();
+}
+
+/// <summary>
+/// Directly set the access mask for GPIO word bank.
+/// <para>The data you read from or write to the GPIO word bank will be mask with your setting.
+/// The 1 bit means data allowed, 0 bit means data no effect</para>
+/// </summary>
+/// <param name="mask">Access mask</param>
+void MSP430_GPIO_WordBank::SetAccessMask(unsigned int mask)
+{
+	this->accessMask = mask;
+}
+
+/// <summary>
+/// Directly set the access mask for GPIO word bank.
+/// <para>The data you read from or write to the GPIO word bank will be mask with your setting.
+/// The significant bit is start from START and end to END (0 to 15, may span the port boundary)</para>
+/// </summary>
+/// <param name="start">Least significant bit (LSB)</param>
+/// <param name="end">Most significant bit (MSB)</param>
+void MSP430_GPIO_WordBank::SetAccessMask(unsigned char start, unsigned char end)
+{
+	// Shift in 32 bits, so END = 15 does not overflow
+	unsigned int mask = static_cast<unsigned int> ((1UL << (end + 1)) - 1);
+	mask &= ~((1u << start) - 1);
+	this->accessMask = mask;
+}
+
+/// <summary>Get the access mask of the GPIO word bank</summary>
+unsigned int MSP430_GPIO_WordBank::GetAccessMask(void)
+{
+	return this->accessMask;
+}
+
+/// <summary>Get the port pair of the GPIO word bank</summary>
+MSP430_GPIO_PortPair MSP430_GPIO_WordBank::GetPortPair(void)
+{
+	return this->pair;
+}
+
+/// <summary>Initialize a hardware GPIO word bank by this GPIO word bank instance</summary>
+void MSP430_GPIO_WordBank::Initialize(void)
+{
+	// Select the stardand I/O function
+	MSP430_Register16(PPxSEL[static_cast<int> (pair)]).Clear(accessMask);
+
+	// Close the interrupt (Only PA has interrupt capability, P1 is the low byte)
+	if (pair == MSP430_GPIO_PortPair::PA)
+	{
+		MSP430_Register8(PxIE[0]).Clear(accessMask & 0xFF);
+		MSP430_Register8(PxIE[1]).Clear(accessMask >> 8);
+	}
+
+	// Set pin direction
+	this->reg_PxDIR.Assign(accessMask, this->direction == MSP430_GPIO_Direction::Output);
+
+	// Set pullup/pulldown resistor
+	this->reg_PxREN.Assign(accessMask, this->pullResistor == MSP430_GPIO_PullResistor::On);
+}
+
+/// <summary>
+/// Deinitialize the corresponding hardware GPIO and set all registers to default.
+/// <para>(Default: Input, Resistor Off)</para>
+/// </summary>
+void MSP430_GPIO_WordBank::Deinitialize(void)
+{
+	// Set direction
+	this->reg_PxDIR.Clear(accessMask);
+
+	// Set pullup/pulldown resistor
+	this->reg_PxREN.Clear(accessMask);
+}
+
+/// <summary>
+/// Set the GPIO word bank output by a setting value (a full access mask is a single MOV.W)
+/// <para>NOTE:The value data is masked by access mask.</para>
+/// </summary>
+/// <param name="value">GPIO word bank output value</param>
+void MSP430_GPIO_WordBank::SetValue(unsigned int value)
+{
+	if (accessMask == 0xFFFF)
+	{
+		this->reg_PxOUT.Write(value);
+	}
+	else
+	{
+		this->reg_PxOUT.Modify(value, accessMask);
+	}
+}
+
+/// <summary>
+/// Get the GPIO word bank input
+/// <para>NOTE:The return data is masked by access mask.</para>
+/// </summary>
+unsigned int MSP430_GPIO_WordBank::GetValue(void)
+{
+	return this->reg_PxIN.Read(accessMask);
+}
+
+/// <summary>Set the output of the bank pins in a mask to HIGH(1) (single BIS.W)</summary>
+/// <param name="bits">Pins to set (masked by the access mask)</param>
+void MSP430_GPIO_WordBank::SetBits(unsigned int bits)
+{
+	this->reg_PxOUT.Set(bits & accessMask);
+}
+
+/// <summary>Set the output of the bank pins in a mask to LOW(0) (single BIC.W)</summary>
+/// <param name="bits">Pins to clear (masked by the access mask)</param>
+void MSP430_GPIO_WordBank::ClearBits(unsigned int bits)
+{
+	this->reg_PxOUT.Clear(bits & accessMask);
+}
+
+/// <summary>
+/// Dymanically reverse the corresponding GPIO word bank's output (single XOR.W)
+/// <para>NOTE: This function will read and effect on register directly.</para>
+/// </summary>
+void MSP430_GPIO_WordBank::ReverseValue(void)
+{
+	this->reg_PxOUT.Toggle(accessMask);
+}
+
+/// <summary>Reverse the corresponding GPIO word bank's direction
+/// <para>NOTE: This function will read and effect on register directly.</para>
+/// </summary>
+void MSP430_GPIO_WordBank::ReverseDirection(void)
+{
+	// Reverse the direction
+	if (this->direction == MSP430_GPIO_Direction::Input)
+	{
+		this->direction = MSP430_GPIO_Direction::Output;
+	}
+	else
+	{
+		this->direction = MSP430_GPIO_Direction::Input;
+	}
+
+	// Set pin direction
+	this->reg_PxDIR.Assign(accessMask, this->direction == MSP430_GPIO_Direction::Output);
+}
+
+/// <summary>
+/// Dymanically set the corresponding word bank's direction
+/// <para>NOTE: This function will effect on register directly.</para>
+/// </summary>
+/// <param name="direction">Setting direction</param>
+void MSP430_GPIO_WordBank::SetDirection(MSP430_GPIO_Direction direction)
+{
+	this->direction = direction;
+
+	// Set pin direction
+	this->reg_PxDIR.Assign(accessMask, this->direction == MSP430_GPIO_Direction::Output);
+}
+
+/// <summary>
+/// Get the corresponding word bank's direction
+/// </summary>
+MSP430_GPIO_Direction MSP430_GPIO_WordBank::GetDirection(void)
+{
+	return this->direction;
+}
+
+/// <summary>
+/// Dymanically set the corresponding word bank's pullup/pulldown resistor
+/// <para>NOTE: This function will effect on register directly.</para>
+/// </summary>
+/// <param name="sw">Switch of the pullup/pulldown resistor</param>
+void MSP430_GPIO_WordBank::SetPullResistor(MSP430_GPIO_PullResistor sw)
+{
+	this->pullResistor = sw;
+
+	// Set pullup/pulldown resistor
+	this->reg_PxREN.Assign(accessMask, this->pullResistor == MSP430_GPIO_PullResistor::On);
+}
+#endif
+
 
 
 
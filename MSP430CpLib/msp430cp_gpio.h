@@ -1,4 +1,7 @@
+#pragma once
+
 #include <msp430.h>
+#include "msp430cp_device.h"
 #include "msp430cp_registers.h"
 
 // GPIO location enumerations and definations
@@ -18,6 +21,18 @@ enum class MSP430_GPIO_Port
 	P8
 };
 
+/// <summary>
+/// GPIO Port Pair (16-bit access to two ports: PA = P1/P2, PB = P3/P4, PC = P5/P6, PD = P7/P8)
+/// <para>The lower port is the low byte. Only 5xx/6xx devices have port pair registers.</para>
+/// </summary>
+enum class MSP430_GPIO_PortPair
+{
+	PA,
+	PB,
+	PC,
+	PD
+};
+
 /// <summary>
 /// GPIO Pin Id
 /// </summary>
@@ -70,6 +85,18 @@ enum class MSP430_GPIO_PullResistor
 	On = 1
 };
 
+#ifdef GPIO_PORT_HAS_DS
+/// <summary>
+/// GPIO Drive Strength (Results in PxDS register, 5xx/6xx devices only)
+/// <para>Selects the output drive strength of the corresponding GPIO pin.</para>
+/// </summary>
+enum class MSP430_GPIO_DriveStrength
+{
+	Reduced = 0,
+	Full = 1
+};
+#endif
+
 // GPIO interrupt configuration enumerations
 /// <summary>
 /// GPIO Interrupt Enable/Disable Switch (Results in PxIE register)
@@ -103,26 +130,28 @@ class MSP430_GPIO
 private:
 	// Register for hardware operation
 
-	REG_8b reg_PxIN;
-	REG_8b reg_PxOUT;
-	REG_8b reg_PxDIR;
-	REG_8b reg_PxREN;
-	REG_8b reg_PxSEL;
+	MSP430_Register8 reg_PxIN;
+	MSP430_Register8 reg_PxOUT;
+	MSP430_Register8 reg_PxDIR;
+	MSP430_Register8 reg_PxREN;
+	MSP430_Register8 reg_PxSEL;
 #ifdef GPIO_PORT_HAS_FUNSEL2
-	REG_8b reg_PxSEL2;
+	MSP430_Register8 reg_PxSEL2;
 #endif
 #ifdef GPIO_PORT_HAS_DS
-	REG_8b reg_PxDS
+	MSP430_Register8 reg_PxDS;
 #endif
-	REG_8b reg_PxIE;
-	REG_8b reg_PxIFG;
-	REG_8b reg_PxIES;
+	MSP430_Register8 reg_PxIE = nullptr;
+	MSP430_Register8 reg_PxIFG = nullptr;
+	MSP430_Register8 reg_PxIES = nullptr;
 
 	// Corresponding GPIO location (Port and ID)
 	/// <summary>Port</summary>
 	MSP430_GPIO_Port port;
 	/// <summary>Pin Id</summary>
 	MSP430_GPIO_Pin pin;
+	/// <summary>Bit mask of the pin in the port registers (one BIS.B/BIC.B/XOR.B/BIT.B per operation)</summary>
+	unsigned char mask;
 	
 	// Corresponding GPIO function/mode configuration
 	/// <summary>Pin function</summary>
@@ -164,7 +193,7 @@ public:
 	/// <summary>Delete this GPIO instance, reset the hardware registers, and free up all memory space</summary>
 	~MSP430_GPIO();
 
-	// Interrupt control (Separate control)
+	// Interrupt control (Separate control, no effect on a port without interrupt capability: only P1/P2 port)
 	/// <summary>Enable the corresponding pin's interrupt and set its trig edge</summary>
 	/// <param name="interruptTrig">Trig edge for interrupt</param>
 	void EnableInterrupt(MSP430_GPIO_InterruptTrig interruptTrig);
@@ -233,6 +262,20 @@ public:
 	/// </summary>
 	/// <param name="direction">Switch of the pullup/pulldown resistor</param>
 	void SetPullResistor(MSP430_GPIO_PullResistor sw);
+#ifdef GPIO_PORT_HAS_DS
+	/// <summary>
+	/// Dymanically set the corresponding pin's drive strength
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="strength">Drive strength</param>
+	void SetDriveStrength(MSP430_GPIO_DriveStrength strength);
+#endif
+
+	// Location
+	/// <summary>Get the port of the GPIO</summary>
+	MSP430_GPIO_Port GetPort(void);
+	/// <summary>Get the pin Id of the GPIO</summary>
+	MSP430_GPIO_Pin GetPin(void);
 };
 
 /// <summary>
@@ -243,10 +286,10 @@ class MSP430_GPIO_Bank
 private:
 	// Register for hardware operation
 
-	REG_8b reg_PxIN;
-	REG_8b reg_PxOUT;
-	REG_8b reg_PxDIR;
-	REG_8b reg_PxREN;
+	MSP430_Register8 reg_PxIN;
+	MSP430_Register8 reg_PxOUT;
+	MSP430_Register8 reg_PxDIR;
+	MSP430_Register8 reg_PxREN;
 
 	// Corresponding GPIO location (Port and ID)
 	/// <summary>Port</summary>
@@ -298,6 +341,10 @@ public:
 	/// <param name="start">Least significant bit (LSB)</param>
 	/// <param name="end">Most significant bit (MSB)</param>
 	void SetAccessMask(unsigned char start, unsigned char end);
+	/// <summary>Get the access mask of the GPIO bank</summary>
+	unsigned char GetAccessMask(void);
+	/// <summary>Get the port of the GPIO bank</summary>
+	MSP430_GPIO_Port GetPort(void);
 
 	// GPIO initialize or re-configuration
 	/// <summary>Initialize a hardware GPIO bank by this GPIO bank instance</summary>
@@ -341,3 +388,124 @@ public:
 	/// <param name="direction">Switch of the pullup/pulldown resistor</param>
 	void SetPullResistor(MSP430_GPIO_PullResistor sw);
 };
+
+#if GPIO_PORT_PAIR_COUNT > 0
+/// <summary>
+/// MSP430 GPIO(General purpose I/O) word bank class (multi pin on a port pair, 16-bit access)
+/// <para>One word instruction updates both ports at once, so a bank spanning the port boundary changes atomically.</para>
+/// </summary>
+class MSP430_GPIO_WordBank
+{
+private:
+	// Register for hardware operation
+
+	MSP430_Register16 reg_PxIN;
+	MSP430_Register16 reg_PxOUT;
+	MSP430_Register16 reg_PxDIR;
+	MSP430_Register16 reg_PxREN;
+
+	// Corresponding GPIO location (Port pair)
+	/// <summary>Port pair</summary>
+	MSP430_GPIO_PortPair pair;
+
+	// Corresponding GPIO function/mode configuration
+	/// <summary>Pin direction</summary>
+	MSP430_GPIO_Direction direction = MSP430_GPIO_Direction::Output;
+	/// <summary>Pullup/pulldown resistor</summary>
+	MSP430_GPIO_PullResistor pullResistor = MSP430_GPIO_PullResistor::Off;
+
+	// Private low-level linking functions
+	/// <summary>Hardware link from program to registers</summary>
+	void HardLink(void);
+
+	// Access mask
+	/// <summary>The binary mask for access the port pair registers (bit 0-7 lower port, bit 8-15 upper port)</summary>
+	unsigned int accessMask = 0xFFFF;
+public:
+	// Constructor
+	/// <summary>Create a new GPIO word bank object, set the port pair</summary>
+	/// <param name="pair">GPIO port pair</param>
+	MSP430_GPIO_WordBank(MSP430_GPIO_PortPair pair);
+	/// <summary>Create a new GPIO word bank object, set the port pair and direction</summary>
+	/// <param name="pair">GPIO port pair</param>
+	/// <param name="direction">GPIO direction</param>
+	MSP430_GPIO_WordBank(MSP430_GPIO_PortPair pair, MSP430_GPIO_Direction direction);
+	/// <summary>Create a new GPIO word bank object, set the port pair, direction and pullup/pulldown resistor</summary>
+	/// <param name="pair">GPIO port pair</param>
+	/// <param name="direction">GPIO direction</param>
+	/// <param name="pullResistor">GPIO pullup/pulldown resistor enable/disable</param>
+	MSP430_GPIO_WordBank(MSP430_GPIO_PortPair pair, MSP430_GPIO_Direction direction, MSP430_GPIO_PullResistor pullResistor);
+	/// <summary>Delete this GPIO word bank instance, reset the hardware registers, and free up all memory space</summary>
+	~MSP430_GPIO_WordBank();
+
+	// Access Mask
+	/// <summary>
+	/// Directly set the access mask for GPIO word bank.
+	/// <para>The data you read from or write to the GPIO word bank will be mask with your setting.
+	/// The 1 bit means data allowed, 0 bit means data no effect</para>
+	/// </summary>
+	/// <param name="mask">Access mask</param>
+	void SetAccessMask(unsigned int mask);
+	/// <summary>
+	/// Directly set the access mask for GPIO word bank.
+	/// <para>The data you read from or write to the GPIO word bank will be mask with your setting.
+	/// The significant bit is start from START and end to END (0 to 15, may span the port boundary)</para>
+	/// </summary>
+	/// <param name="start">Least significant bit (LSB)</param>
+	/// <param name="end">Most significant bit (MSB)</param>
+	void SetAccessMask(unsigned char start, unsigned char end);
+	/// <summary>Get the access mask of the GPIO word bank</summary>
+	unsigned int GetAccessMask(void);
+	/// <summary>Get the port pair of the GPIO word bank</summary>
+	MSP430_GPIO_PortPair GetPortPair(void);
+
+	// GPIO initialize or re-configuration
+	/// <summary>Initialize a hardware GPIO word bank by this GPIO word bank instance</summary>
+	void Initialize(void);
+	/// <summary>
+	/// Deinitialize the corresponding hardware GPIO and set all registers to default.
+	/// <para>(Default: Input, Resistor Off)</para>
+	/// </summary>
+	void Deinitialize(void);
+
+	// Stardand GPIO operation
+	/// <summary>Set the GPIO word bank output by a setting value (a full access mask is a single MOV.W)</summary>
+	/// <param name="value">GPIO word bank output value</param>
+	void SetValue(unsigned int value);
+	/// <summary>Get the GPIO word bank input</summary>
+	unsigned int GetValue(void);
+	/// <summary>Set the output of the bank pins in a mask to HIGH(1) (single BIS.W)</summary>
+	/// <param name="bits">Pins to set (masked by the access mask)</param>
+	void SetBits(unsigned int bits);
+	/// <summary>Set the output of the bank pins in a mask to LOW(0) (single BIC.W)</summary>
+	/// <param name="bits">Pins to clear (masked by the access mask)</param>
+	void ClearBits(unsigned int bits);
+
+	// Dymanic GPIO operation
+	/// <summary>
+	/// Dymanically reverse the corresponding GPIO word bank's output (single XOR.W)
+	/// <para>NOTE: This function will read and effect on register directly.</para>
+	/// </summary>
+	void ReverseValue(void);
+	/// <summary>Reverse the corresponding GPIO word bank's direction
+	/// <para>NOTE: This function will read and effect on register directly.</para>
+	/// </summary>
+	void ReverseDirection(void);
+	/// <summary>
+	/// Dymanically set the corresponding word bank's direction
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="direction">Setting direction</param>
+	void SetDirection(MSP430_GPIO_Direction direction);
+	/// <summary>
+	/// Get the corresponding word bank's direction
+	/// </summary>
+	MSP430_GPIO_Direction GetDirection(void);
+	/// <summary>
+	/// Dymanically set the corresponding word bank's pullup/pulldown resistor
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="sw">Switch of the pullup/pulldown resistor</param>
+	void SetPullResistor(MSP430_GPIO_PullResistor sw);
+};
+#endif
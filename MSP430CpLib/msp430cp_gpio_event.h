@@ -0,0 +1,207 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+
+// GPIO edge event queue
+// A single-producer (interrupt) / single-consumer (main loop) ring buffer of timestamped edge records.
+// The producer only writes the head index, the consumer only writes the tail index, so neither side disables interrupts.
+// Every edge of a burst is kept (up to the capacity) instead of being merged into one PxIFG bit.
+//
+//     MSP430_GPIO_EventQueue<16> events;
+//
+//     MSP430_GPIO_INTERRUPT_HANDLER(P1, 3)
+//     {
+//         events.Capture(MSP430_GPIO_Port::P1, 3, true);
+//     }
+//
+//     events.Drain([](const MSP430_GPIO_Event& event) { ... });
+
+// GPIO registers
+extern REG_8b const PxIES[GPIO_PORT_SUPPORT_INT_COUNT];
+
+/// <summary>
+/// GPIO edge event record (4 bytes on MSP430)
+/// </summary>
+struct MSP430_GPIO_Event
+{
+	/// <summary>Source: bit 0-2 pin, bit 3-5 port, bit 7 edge (1 for negedge)</summary>
+	unsigned char source;
+	/// <summary>Timestamp (GPIO_EVENT_TIMESTAMP counter at the interrupt)</summary>
+	unsigned int timestamp;
+
+	/// <summary>Get the port of the event</summary>
+	MSP430_GPIO_Port GetPort(void) const
+	{
+		return static_cast<MSP430_GPIO_Port> ((source >> 3) & 0x07);
+	}
+	/// <summary>Get the pin of the event</summary>
+	MSP430_GPIO_Pin GetPin(void) const
+	{
+		return source & 0x07;
+	}
+	/// <summary>Get the edge of the event</summary>
+	MSP430_GPIO_InterruptTrig GetEdge(void) const
+	{
+		return (source & 0x80) ? MSP430_GPIO_InterruptTrig::Negedge : MSP430_GPIO_InterruptTrig::Posedge;
+	}
+};
+
+/// <summary>
+/// MSP430 GPIO edge event queue (lock-free, single producer in interrupt, single consumer in main loop)
+/// </summary>
+/// <typeparam name="capacity">Number of events (power of 2)</typeparam>
+template <unsigned int capacity>
+class MSP430_GPIO_EventQueue
+{
+	static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "Capacity must be a power of 2");
+
+private:
+	/// <summary>Event records</summary>
+	MSP430_GPIO_Event buffer[capacity];
+	/// <summary>Free-running write index (written by the producer only)</summary>
+	volatile unsigned int head = 0;
+	/// <summary>Free-running read index (written by the consumer only)</summary>
+	volatile unsigned int tail = 0;
+	/// <summary>Lost events because the queue was full (written by the producer only)</summary>
+	volatile unsigned int overflowCount = 0;
+
+public:
+	// Producer (interrupt context)
+	/// <summary>Put an event into the queue, count an overflow if the queue is full</summary>
+	/// <param name="event">Event record</param>
+	/// <return>The event was queued</return>
+	bool Push(const MSP430_GPIO_Event& event)
+	{
+		unsigned int index = head;
+		if (index - tail >= capacity)
+		{
+			overflowCount = overflowCount + 1;
+			return false;
+		}
+
+		buffer[index & (capacity - 1)] = event;
+		REG_BARRIER();
+		head = index + 1;
+		return true;
+	}
+	/// <summary>
+	/// Record an edge of a pin with the current timestamp (Call it from the pin's interrupt handler)
+	/// <para>The edge is the one selected by PxIES. With bothEdges, PxIES is reversed so the opposite edge is captured next.</para>
+	/// </summary>
+	/// <param name="port">GPIO port (P1 or P2)</param>
+	/// <param name="pin">GPIO pin</param>
+	/// <param name="bothEdges">Capture both edges of the pin</param>
+	/// <return>The event was queued (false on a port without interrupt capability)</return>
+	bool Capture(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin, bool bothEdges = false)
+	{
+		// Only P1/P2 port have PxIES
+		if (static_cast<int> (port) >= GPIO_PORT_SUPPORT_INT_COUNT)
+		{
+			return false;
+		}
+
+		MSP430_GPIO_Event event;
+		event.timestamp = GPIO_EVENT_TIMESTAMP;
+
+		MSP430_Register8 ies = PxIES[static_cast<int> (port)];
+		unsigned char mask = 1 << pin;
+		bool negedge = ies.Test(mask);
+		if (bothEdges)
+		{
+			ies.Toggle(mask);
+		}
+
+		event.source = (negedge ? 0x80 : 0x00) | (static_cast<unsigned char> (port) << 3) | pin;
+		return Push(event);
+	}
+
+	// Consumer (main loop)
+	/// <summary>Take the oldest event from the queue</summary>
+	/// <param name="event">Event record output</param>
+	/// <return>An event was taken (false if the queue is empty)</return>
+	bool Pop(MSP430_GPIO_Event& event)
+	{
+		unsigned int index = tail;
+		if (index == head)
+		{
+			return false;
+		}
+
+		REG_BARRIER();
+		event = buffer[index & (capacity - 1)];
+		REG_BARRIER();
+		tail = index + 1;
+		return true;
+	}
+	/// <summary>Take up to max events from the queue in one pass</summary>
+	/// <param name="events">Event records output</param>
+	/// <param name="max">Size of the output</param>
+	/// <return>Number of events taken</return>
+	unsigned int Drain(MSP430_GPIO_Event* events, unsigned int max)
+	{
+		unsigned int index = tail;
+		unsigned int count = head - index;
+		if (count > max)
+		{
+			count = max;
+		}
+
+		REG_BARRIER();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			events[i] = buffer[(index + i) & (capacity - 1)];
+		}
+		REG_BARRIER();
+		tail = index + count;
+		return count;
+	}
+	/// <summary>
+	/// Process all queued events in one pass
+	/// <para>The handler (function or lambda) is called with each event, the slots are released once after the pass.</para>
+	/// </summary>
+	/// <param name="handler">Event handler: void handler(const MSP430_GPIO_Event&amp; event)</param>
+	/// <return>Number of events processed</return>
+	template <typename Handler>
+	unsigned int Drain(Handler handler)
+	{
+		unsigned int index = tail;
+		unsigned int count = head - index;
+
+		REG_BARRIER();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			handler(buffer[(index + i) & (capacity - 1)]);
+		}
+		REG_BARRIER();
+		tail = index + count;
+		return count;
+	}
+
+	// Status
+	/// <summary>Get the number of queued events</summary>
+	unsigned int GetCount(void) const
+	{
+		return head - tail;
+	}
+	/// <summary>Check if the queue is empty</summary>
+	bool IsEmpty(void) const
+	{
+		return head == tail;
+	}
+	/// <summary>
+	/// Get the number of lost events since the queue was created
+	/// <para>NOTE: The counter is never cleared (only the producer writes it), compare with a previous reading to get new losses.</para>
+	/// </summary>
+	unsigned int GetOverflowCount(void) const
+	{
+		return overflowCount;
+	}
+	/// <summary>Get the capacity of the queue</summary>
+	static constexpr unsigned int GetCapacity(void)
+	{
+		return capacity;
+	}
+};
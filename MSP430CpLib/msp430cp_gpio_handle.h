@@ -0,0 +1,241 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+
+// Compact GPIO pin handle
+// A pin chosen at runtime (e.g. from a configuration table) packed into one byte: bits 5-3 port, bits 2-0 pin.
+// The register addresses are computed from the handle on each access (port pair base + odd port + register offset),
+// so a handle holds no register pointers and a table of handles can stay in flash.
+//
+//     static const MSP430_GPIO_Handle leds[] = { { MSP430_GPIO_Port::P1, 0 }, { MSP430_GPIO_Port::P4, 7 } };
+//     for (MSP430_GPIO_Handle led : leds)
+//     {
+//         led.Initialize(MSP430_GPIO_Function::Stardand, MSP430_GPIO_Direction::Output, MSP430_GPIO_PullResistor::Off);
+//     }
+//     leds[index].ReverseValue();
+
+static_assert(MSP430_Device::PortPairCount > 0, "MSP430_GPIO_Handle computes the addresses from the 5xx/6xx port pair layout");
+
+/// <summary>
+/// MSP430 GPIO pin handle class (1 byte)
+/// <para>The methods are the same as MSP430_GPIO, the configuration is passed to Initialize() instead of being stored.</para>
+/// <para>NOTE: The register layout is the 5xx/6xx one (GPIO_PORT_REGISTER_STRIDE in msp430cp_device_traits.h).
+/// The interrupt methods are only valid on P1/P2 port.</para>
+/// </summary>
+class MSP430_GPIO_Handle
+{
+private:
+	/// <summary>Packed location (port << 3 | pin)</summary>
+	unsigned char id;
+
+	/// <summary>Port register handle</summary>
+	/// <param name="offset">Register offset from PxIN</param>
+	MSP430_Register8 Register(unsigned char offset) const
+	{
+		unsigned char port = this->id >> 3;
+		return &P1IN + (port >> 1) * GPIO_PORT_REGISTER_STRIDE + (port & 1) + offset;
+	}
+
+public:
+	// Register byte offsets from PxIN (the odd port of a pair is 1 byte above the even one)
+	static constexpr unsigned char OffsetIN = 0x00;
+	static constexpr unsigned char OffsetOUT = 0x02;
+	static constexpr unsigned char OffsetDIR = 0x04;
+	static constexpr unsigned char OffsetREN = 0x06;
+	static constexpr unsigned char OffsetDS = 0x08;
+	static constexpr unsigned char OffsetSEL = 0x0A;
+	static constexpr unsigned char OffsetIES = 0x18;
+	static constexpr unsigned char OffsetIE = 0x1A;
+	static constexpr unsigned char OffsetIFG = 0x1C;
+
+	// Constructor
+	/// <summary>Create a new GPIO handle from a location (No hardware operation)</summary>
+	/// <param name="port">GPIO port</param>
+	/// <param name="pin">GPIO pin</param>
+	constexpr MSP430_GPIO_Handle(MSP430_GPIO_Port port, MSP430_GPIO_Pin pin) :
+		id(static_cast<unsigned char> ((static_cast<unsigned char> (port) << 3) | (pin & 0x07)))
+	{
+	}
+	/// <summary>Create a new GPIO handle from a packed location (e.g. a byte of a configuration table)</summary>
+	/// <param name="id">Packed location (port << 3 | pin)</param>
+	explicit constexpr MSP430_GPIO_Handle(unsigned char id) : id(id)
+	{
+	}
+
+	// Location
+	/// <summary>Get the packed location (port << 3 | pin)</summary>
+	constexpr unsigned char GetId(void) const
+	{
+		return this->id;
+	}
+	/// <summary>Get the port</summary>
+	constexpr MSP430_GPIO_Port GetPort(void) const
+	{
+		return static_cast<MSP430_GPIO_Port> (this->id >> 3);
+	}
+	/// <summary>Get the pin Id</summary>
+	constexpr MSP430_GPIO_Pin GetPin(void) const
+	{
+		return this->id & 0x07;
+	}
+	/// <summary>Get the bit mask of the pin in the port registers</summary>
+	constexpr unsigned char GetMask(void) const
+	{
+		return static_cast<unsigned char> (1 << (this->id & 0x07));
+	}
+
+	// Interrupt control (Separate control)
+	/// <summary>Enable the corresponding pin's interrupt and set its trig edge</summary>
+	/// <param name="interruptTrig">Trig edge for interrupt</param>
+	void EnableInterrupt(MSP430_GPIO_InterruptTrig interruptTrig) const
+	{
+		Register(OffsetIES).Assign(GetMask(), interruptTrig == MSP430_GPIO_InterruptTrig::Negedge);
+		Register(OffsetIE).Set(GetMask());
+	}
+	/// <summary>Disable the corresponding pin's interrupt</summary>
+	void DisableInterrupt(void) const
+	{
+		Register(OffsetIE).Clear(GetMask());
+	}
+	/// <summary>Check if the interrupt flag on corresponding pin was setted</summary>
+	bool CheckInterruptFlag(void) const
+	{
+		return Register(OffsetIFG).Test(GetMask());
+	}
+	/// <summary>Clear the interrupt flag then interrupt can be re-detected</summary>
+	void ClearInterruptFlag(void) const
+	{
+		Register(OffsetIFG).Clear(GetMask());
+	}
+
+	// GPIO initialize or re-configuration
+	/// <summary>Initialize a hardware GPIO by a configuration</summary>
+	/// <param name="function">GPIO function</param>
+	/// <param name="direction">GPIO direction</param>
+	/// <param name="pullResistor">GPIO pullup/pulldown resistor enable/disable</param>
+	void Initialize(MSP430_GPIO_Function function, MSP430_GPIO_Direction direction, MSP430_GPIO_PullResistor pullResistor) const
+	{
+		SetDirection(direction);
+		SetPullResistor(pullResistor);
+		SetFunction(function);
+	}
+	/// <summary>
+	/// Deinitialize the corresponding hardware GPIO and set all registers to default.
+	/// <para>(Default: Input, Standard Function, Resistor Off)</para>
+	/// </summary>
+	void Deinitialize(void) const
+	{
+		SetDirection(MSP430_GPIO_Direction::Input);
+		SetPullResistor(MSP430_GPIO_PullResistor::Off);
+		SetFunction(MSP430_GPIO_Function::Stardand);
+	}
+
+	// Stardand GPIO operation
+	/// <summary>Set the corresponding GPIO pin output to HIGH(1) (Only effect when using standard function)</summary>
+	void SetHigh(void) const
+	{
+		Register(OffsetOUT).Set(GetMask());
+	}
+	/// <summary>Set the corresponding GPIO pin output to LOW(0) (Only effect when using standard function)</summary>
+	void SetLow(void) const
+	{
+		Register(OffsetOUT).Clear(GetMask());
+	}
+	/// <summary>Set the corresponding GPIO pin output by a setting value (Only effect when using standard function)</summary>
+	/// <param name="value">GPIO pin output value</param>
+	void SetValue(MSP430_GPIO_Value value) const
+	{
+		if (value)
+		{
+			SetHigh();
+		}
+		else
+		{
+			SetLow();
+		}
+	}
+	/// <summary>Get the corresponding GPIO pin input</summary>
+	/// <return>GPIO pin input value</return>
+	MSP430_GPIO_Value GetValue(void) const
+	{
+		return Register(OffsetIN).Test(GetMask()) ? 1 : 0;
+	}
+	/// <summary>Check if the corresponding GPIO pin input is HIGH(1)</summary>
+	bool CheckHigh(void) const
+	{
+		return Register(OffsetIN).Test(GetMask());
+	}
+	/// <summary>Check if the corresponding GPIO pin input is LOW(0)</summary>
+	bool CheckLow(void) const
+	{
+		return !Register(OffsetIN).Test(GetMask());
+	}
+
+	// Dymanic GPIO operation
+	/// <summary>
+	/// Dymanically reverse the corresponding pin's output value
+	/// <para>NOTE: This function toggles PxOUT directly (XOR.B), it does not read the pin input.</para>
+	/// </summary>
+	void ReverseValue(void) const
+	{
+		Register(OffsetOUT).Toggle(GetMask());
+	}
+	/// <summary>Reverse the corresponding GPIO's direction
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	void ReverseDirection(void) const
+	{
+		Register(OffsetDIR).Toggle(GetMask());
+	}
+	/// <summary>
+	/// Dymanically set the corresponding pin's direction
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="direction">Setting direction</param>
+	void SetDirection(MSP430_GPIO_Direction direction) const
+	{
+		Register(OffsetDIR).Assign(GetMask(), direction == MSP430_GPIO_Direction::Output);
+	}
+	/// <summary>
+	/// Get the corresponding pin's direction
+	/// <para>NOTE: This function will read the register directly.</para>
+	/// </summary>
+	MSP430_GPIO_Direction GetDirection(void) const
+	{
+		return Register(OffsetDIR).Test(GetMask()) ? MSP430_GPIO_Direction::Output : MSP430_GPIO_Direction::Input;
+	}
+	/// <summary>
+	/// Dymanically set the corresponding pin's function (PxSEL only, the 5xx/6xx ports have no PxSEL2)
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="function">Setting function</param>
+	void SetFunction(MSP430_GPIO_Function function) const
+	{
+		Register(OffsetSEL).Assign(GetMask(), (static_cast<unsigned char> (function) & 0x01) != 0);
+	}
+	/// <summary>
+	/// Dymanically set the corresponding pin's pullup/pulldown resistor
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="sw">Switch of the pullup/pulldown resistor</param>
+	void SetPullResistor(MSP430_GPIO_PullResistor sw) const
+	{
+		Register(OffsetREN).Assign(GetMask(), sw == MSP430_GPIO_PullResistor::On);
+	}
+#ifdef GPIO_PORT_HAS_DS
+	/// <summary>
+	/// Dymanically set the corresponding pin's drive strength
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="strength">Drive strength</param>
+	void SetDriveStrength(MSP430_GPIO_DriveStrength strength) const
+	{
+		Register(OffsetDS).Assign(GetMask(), strength == MSP430_GPIO_DriveStrength::Full);
+	}
+#endif
+};
+
+static_assert(sizeof(MSP430_GPIO_Handle) == 1, "A GPIO handle is packed into one byte");
@@ -0,0 +1,144 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_gpio_interrupt.h"
+#include "msp430cp_trace.h"
+
+// GPIO registers
+extern REG_8b const PxIE[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIFG[GPIO_PORT_SUPPORT_INT_COUNT];
+
+/// <summary>Default handler for the pins without a registered handler</summary>
+extern "C" void MSP430_GPIO_DefaultInterruptHandler(void)
+{
+}
+
+// Weak handler entry points, aliased to the default handler until MSP430_GPIO_INTERRUPT_HANDLER defines them
+#define MSP430CP_GPIO_WEAK_HANDLER(PORT, PIN) \
+	extern "C" void MSP430_GPIO_##PORT##_##PIN##_InterruptHandler(void) __attribute__((weak, alias("MSP430_GPIO_DefaultInterruptHandler")));
+
+MSP430CP_GPIO_WEAK_HANDLER(P1, 0)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 1)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 2)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 3)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 4)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 5)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 6)
+MSP430CP_GPIO_WEAK_HANDLER(P1, 7)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 0)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 1)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 2)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 3)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 4)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 5)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 6)
+MSP430CP_GPIO_WEAK_HANDLER(P2, 7)
+
+/// <summary>
+/// Handler table (flash-resident)
+/// <para>Index 0 is the "no interrupt" entry, index N is pin N - 1, so a PxIV value shifted right by 1 is the index directly.</para>
+/// </summary>
+static const MSP430_GPIO_InterruptHandler handlers[GPIO_PORT_SUPPORT_INT_COUNT][9] =
+{
+	{
+		MSP430_GPIO_DefaultInterruptHandler,
+		MSP430_GPIO_P1_0_InterruptHandler, MSP430_GPIO_P1_1_InterruptHandler,
+		MSP430_GPIO_P1_2_InterruptHandler, MSP430_GPIO_P1_3_InterruptHandler,
+		MSP430_GPIO_P1_4_InterruptHandler, MSP430_GPIO_P1_5_InterruptHandler,
+		MSP430_GPIO_P1_6_InterruptHandler, MSP430_GPIO_P1_7_InterruptHandler
+	},
+#if GPIO_PORT_SUPPORT_INT_COUNT >= 2
+	{
+		MSP430_GPIO_DefaultInterruptHandler,
+		MSP430_GPIO_P2_0_InterruptHandler, MSP430_GPIO_P2_1_InterruptHandler,
+		MSP430_GPIO_P2_2_InterruptHandler, MSP430_GPIO_P2_3_InterruptHandler,
+		MSP430_GPIO_P2_4_InterruptHandler, MSP430_GPIO_P2_5_InterruptHandler,
+		MSP430_GPIO_P2_6_InterruptHandler, MSP430_GPIO_P2_7_InterruptHandler
+	}
+#endif
+};
+
+/// <summary>Lowest 1 bit position of a nibble (index 0 is unused)</summary>
+static const unsigned char lowestBit[16] = { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+
+/// <summary>Get the lowest pending pin of a flags byte</summary>
+/// <param name="flags">Interrupt flags (must not be zero)</param>
+/// <return>Pin id of the least significant 1 bit</return>
+MSP430_GPIO_Pin MSP430_GPIO_Interrupt::LowestPin(unsigned char flags)
+{
+	if (flags & 0x0F)
+	{
+		return lowestBit[flags & 0x0F];
+	}
+	return 4 + lowestBit[flags >> 4];
+}
+
+/// <summary>Dispatch the pending and enabled interrupts by the interrupt flags (trailing-zeros lookup)</summary>
+/// <param name="ifg">PxIFG register</param>
+/// <param name="ie">PxIE register</param>
+/// <param name="table">Handler table of the port</param>
+static inline void DispatchFlags(MSP430_Register8 ifg, MSP430_Register8 ie, const MSP430_GPIO_InterruptHandler* table)
+{
+	unsigned char flags;
+	while ((flags = ifg.Read(ie.Read())) != 0)
+	{
+		// Clear the flag before calling (BIC.B, an edge in the handler will be latched again)
+		unsigned char bit = flags & (~flags + 1);
+		ifg.Clear(bit);
+		unsigned char index = MSP430_GPIO_Interrupt::LowestPin(bit) + 1;
+		MSP430_TRACE(MSP430_Trace_Id::InterruptDispatch, index);
+		table[index]();
+	}
+}
+
+/// <summary>Dispatch all pending and enabled interrupts of a port to their handlers</summary>
+/// <param name="port">GPIO port (P1 or P2)</param>
+void MSP430_GPIO_Interrupt::Dispatch(MSP430_GPIO_Port port)
+{
+	int index = static_cast<int> (port);
+	if (index < GPIO_PORT_SUPPORT_INT_COUNT)
+	{
+		DispatchFlags(PxIFG[index], PxIE[index], handlers[index]);
+	}
+}
+
+#ifndef GPIO_PORT_USER_ISR
+/// <summary>PORT1 interrupt service routine</summary>
+REG_ISR(PORT1_VECTOR, MSP430_GPIO_Port1_ISR)
+{
+	MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::Port1);
+#ifdef GPIO_PORT_HAS_IV
+	// Reading P1IV returns the highest priority pending pin and clears its flag
+	unsigned int iv;
+	while ((iv = P1IV) != 0)
+	{
+		MSP430_TRACE(MSP430_Trace_Id::InterruptDispatch, iv >> 1);
+		handlers[0][__even_in_range(iv, P1IV_P1IFG7) >> 1]();
+	}
+#else
+	DispatchFlags(&P1IFG, &P1IE, handlers[0]);
+#endif
+	MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::Port1);
+	REG_ISR_EXIT();
+}
+
+#if GPIO_PORT_SUPPORT_INT_COUNT >= 2
+/// <summary>PORT2 interrupt service routine</summary>
+REG_ISR(PORT2_VECTOR, MSP430_GPIO_Port2_ISR)
+{
+	MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::Port2);
+#ifdef GPIO_PORT_HAS_IV
+	// Reading P2IV returns the highest priority pending pin and clears its flag
+	unsigned int iv;
+	while ((iv = P2IV) != 0)
+	{
+		MSP430_TRACE(MSP430_Trace_Id::InterruptDispatch, iv >> 1);
+		handlers[1][__even_in_range(iv, P2IV_P2IFG7) >> 1]();
+	}
+#else
+	DispatchFlags(&P2IFG, &P2IE, handlers[1]);
+#endif
+	MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::Port2);
+	REG_ISR_EXIT();
+}
+#endif
+#endif
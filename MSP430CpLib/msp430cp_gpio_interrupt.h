@@ -0,0 +1,79 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+
+// GPIO port interrupt dispatcher
+// The library owns the PORT1_VECTOR/PORT2_VECTOR interrupt service routines (define GPIO_PORT_USER_ISR in
+// msp430cp_device.h to keep your own). On entry, the pending pin is found by reading PxIV (devices which have it)
+// or by a trailing-zeros lookup on PxIFG & PxIE, its flag is cleared, then its handler is called
+// through a flash-resident (const) table. There is no linear poll over the pins, no heap and no std::function.
+// A handler returns to active mode with MSP430_WAKE() (e.g. through a scheduler Post()), the routine takes it on exit.
+//
+// Register a handler at file scope for the pin of a MSP430_GPIO/MSP430_Pin, then enable its interrupt:
+//
+//     MSP430_GPIO_INTERRUPT_HANDLER(P1, 3)
+//     {
+//         counter++;
+//     }
+//
+//     button.EnableInterrupt(MSP430_GPIO_InterruptTrig::Negedge);
+//
+// Pins without a registered handler use MSP430_GPIO_DefaultInterruptHandler (flag cleared, no operation).
+
+/// <summary>GPIO interrupt handler (called in interrupt context, the pin's interrupt flag is already cleared)</summary>
+typedef void (*MSP430_GPIO_InterruptHandler)(void);
+
+/// <summary>
+/// Define the interrupt handler of a GPIO pin
+/// <para>PORT is the port name (P1 or P2), PIN is the pin id (0 to 7). Follow the macro by the handler body.</para>
+/// </summary>
+#define MSP430_GPIO_INTERRUPT_HANDLER(PORT, PIN) extern "C" void MSP430_GPIO_##PORT##_##PIN##_InterruptHandler(void)
+
+/// <summary>Default handler for the pins without a registered handler</summary>
+extern "C" void MSP430_GPIO_DefaultInterruptHandler(void);
+
+// Handler entry points (weak, overridden by MSP430_GPIO_INTERRUPT_HANDLER)
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 0);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 1);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 2);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 3);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 4);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 5);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 6);
+MSP430_GPIO_INTERRUPT_HANDLER(P1, 7);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 0);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 1);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 2);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 3);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 4);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 5);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 6);
+MSP430_GPIO_INTERRUPT_HANDLER(P2, 7);
+
+/// <summary>
+/// MSP430 GPIO port interrupt dispatcher
+/// </summary>
+class MSP430_GPIO_Interrupt
+{
+public:
+	/// <summary>Dispatch all pending and enabled interrupts of a port to their handlers</summary>
+	/// <param name="port">GPIO port (P1 or P2)</param>
+	static void Dispatch(MSP430_GPIO_Port port);
+	/// <summary>Get the lowest pending pin of a flags byte</summary>
+	/// <param name="flags">Interrupt flags (must not be zero)</param>
+	/// <return>Pin id of the least significant 1 bit</return>
+	static MSP430_GPIO_Pin LowestPin(unsigned char flags);
+};
+
+#ifdef MSP430CP_HOST
+#ifndef GPIO_PORT_USER_ISR
+// Interrupt service routines (plain functions on host, called by MSP430_Host::Update())
+void MSP430_GPIO_Port1_ISR(void);
+#if GPIO_PORT_SUPPORT_INT_COUNT >= 2
+void MSP430_GPIO_Port2_ISR(void);
+#endif
+#endif
+#endif
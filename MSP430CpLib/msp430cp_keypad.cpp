@@ -0,0 +1,233 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_keypad.h"
+
+// GPIO registers
+extern REG_8b const PxIN[GPIO_PORT_COUNT];
+extern REG_8b const PxOUT[GPIO_PORT_COUNT];
+extern REG_8b const PxDIR[GPIO_PORT_COUNT];
+extern REG_8b const PxIE[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIFG[GPIO_PORT_SUPPORT_INT_COUNT];
+extern REG_8b const PxIES[GPIO_PORT_SUPPORT_INT_COUNT];
+
+/// <summary>Create a new keypad object on a rows bank and a columns bank (No hardware operation)</summary>
+/// <param name="rows">Rows bank (output)</param>
+/// <param name="columns">Columns bank (input, pullup resistors, P1/P2 for the wake-up interrupt)</param>
+/// <param name="handler">Key handler</param>
+MSP430_Keypad::MSP430_Keypad(MSP430_GPIO_Bank& rows, MSP430_GPIO_Bank& columns, MSP430_Keypad_KeyHandler handler)
+{
+	int rowPort = static_cast<int> (rows.GetPort());
+	int columnPort = static_cast<int> (columns.GetPort());
+
+	this->reg_RowOUT = PxOUT[rowPort];
+	this->reg_RowDIR = PxDIR[rowPort];
+	this->reg_ColumnIN = PxIN[columnPort];
+	this->reg_ColumnOUT = PxOUT[columnPort];
+	if (columnPort < GPIO_PORT_SUPPORT_INT_COUNT)
+	{
+		this->reg_ColumnIE = PxIE[columnPort];
+		this->reg_ColumnIES = PxIES[columnPort];
+		this->reg_ColumnIFG = PxIFG[columnPort];
+	}
+
+	this->rowMask = rows.GetAccessMask();
+	this->columnMask = columns.GetAccessMask();
+	this->columnCount = 0;
+	for (unsigned char bit = 1; bit; bit <<= 1)
+	{
+		if (this->columnMask & bit)
+		{
+			this->columnCount++;
+		}
+	}
+	this->handler = handler;
+}
+
+/// <summary>Delete this keypad instance and disable the column interrupts</summary>
+MSP430_Keypad::~MSP430_Keypad()
+{
+	Deinitialize();
+}
+
+/// <summary>Select the column pullups, clear the keys, drive all rows and arm the column interrupt</summary>
+void MSP430_Keypad::Initialize(void)
+{
+	// The rows drive LOW(0) when selected, PxOUT selects the pullup of an input pin with PxREN set
+	this->reg_RowOUT.Clear(this->rowMask);
+	this->reg_ColumnOUT.Set(this->columnMask);
+	for (unsigned char row = 0; row < 8; row++)
+	{
+		this->keys[row] = 0;
+		this->last[row] = 0;
+	}
+	this->stableScans = 0;
+	this->ghosted = false;
+
+	Arm();
+}
+
+/// <summary>Disable the column interrupts (the rows stay driven low)</summary>
+void MSP430_Keypad::Deinitialize(void)
+{
+	Wake();
+}
+
+/// <summary>Disable and clear the column interrupts (Call it from the column pin interrupt handlers, then start the scan tick)</summary>
+void MSP430_Keypad::Wake(void)
+{
+	if (this->reg_ColumnIE.IsPresent())
+	{
+		this->reg_ColumnIE.Clear(this->columnMask);
+		this->reg_ColumnIFG.Clear(this->columnMask);
+	}
+}
+
+/// <summary>Drive all rows low and interrupt on a change of the columns</summary>
+/// <return>The columns did not change while arming</return>
+bool MSP430_Keypad::Arm(void)
+{
+	this->reg_RowDIR.Set(this->rowMask);
+	if (!this->reg_ColumnIE.IsPresent())
+	{
+		return true;
+	}
+	__delay_cycles(SettleCycles);
+
+	// Falling edge for the columns at HIGH(1), rising edge for the columns held LOW(0) by a key; writing PxIES may set flags
+	unsigned char columns = this->reg_ColumnIN.Read(this->columnMask);
+	this->reg_ColumnIES.Modify(columns, this->columnMask);
+	this->reg_ColumnIFG.Clear(this->columnMask);
+	this->reg_ColumnIE.Set(this->columnMask);
+
+	if (this->reg_ColumnIN.Read(this->columnMask) != columns)
+	{
+		Wake();
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// Scan the matrix once, report the changed keys when the scan is stable
+/// <para>Without a column interrupt (columns not on P1/P2) it never returns Idle.</para>
+/// </summary>
+/// <return>Scanner status (when to call again)</return>
+MSP430_Keypad_Status MSP430_Keypad::Scan(void)
+{
+	// Driving single rows changes the columns, keep their interrupts off during the scan
+	Wake();
+
+	// Drive one row low at a time, the other rows are released (PxOUT stays low, so a released row is high impedance)
+	unsigned char scan[8];
+	unsigned char rows = 0;
+	bool changed = false;
+	for (unsigned char bit = 1; bit; bit <<= 1)
+	{
+		if (this->rowMask & bit)
+		{
+			this->reg_RowDIR.Modify(bit, this->rowMask);
+			__delay_cycles(SettleCycles);
+			scan[rows] = ~this->reg_ColumnIN.Read() & this->columnMask;
+			changed = changed || (scan[rows] != this->last[rows]);
+			this->last[rows] = scan[rows];
+			rows++;
+		}
+	}
+
+	// Wait for identical scans
+	if (changed)
+	{
+		this->stableScans = 1;
+	}
+	else if (this->stableScans < StableScans)
+	{
+		this->stableScans++;
+	}
+	if (this->stableScans < StableScans)
+	{
+		this->reg_RowDIR.Set(this->rowMask);
+		return MSP430_Keypad_Status::Scanning;
+	}
+
+	// Ghost: two rows sharing two or more columns (the fourth corner of a rectangle may not be pressed)
+	this->ghosted = false;
+	for (unsigned char i = 0; i < rows; i++)
+	{
+		for (unsigned char j = i + 1; j < rows; j++)
+		{
+			unsigned char common = scan[i] & scan[j];
+			if (common & (common - 1))
+			{
+				this->ghosted = true;
+			}
+		}
+	}
+
+	// Report the changed keys of a valid scan
+	bool held = false;
+	for (unsigned char row = 0; row < rows; row++)
+	{
+		held = held || (scan[row] != 0);
+		if (this->ghosted)
+		{
+			continue;
+		}
+
+		unsigned char diff = scan[row] ^ this->keys[row];
+		this->keys[row] = scan[row];
+		unsigned char column = 0;
+		for (unsigned char bit = 1; bit; bit <<= 1)
+		{
+			if (this->columnMask & bit)
+			{
+				if (diff & bit)
+				{
+					this->handler(row * this->columnCount + column, (scan[row] & bit) != 0);
+				}
+				column++;
+			}
+		}
+	}
+
+	// Sleep until a column changes (a new key in a column already held low is seen by the slow scans)
+	if (!Arm())
+	{
+		this->stableScans = 0;
+		return MSP430_Keypad_Status::Scanning;
+	}
+	if (held || !this->reg_ColumnIE.IsPresent())
+	{
+		return MSP430_Keypad_Status::Held;
+	}
+	return MSP430_Keypad_Status::Idle;
+}
+
+/// <summary>Check if a key is pressed (stable state)</summary>
+/// <param name="key">Key index</param>
+bool MSP430_Keypad::IsPressed(unsigned char key)
+{
+	if (this->columnCount == 0)
+	{
+		return false;
+	}
+	unsigned char row = key / this->columnCount;
+	unsigned char column = key % this->columnCount;
+	for (unsigned char bit = 1; bit; bit <<= 1)
+	{
+		if (this->columnMask & bit)
+		{
+			if (column == 0)
+			{
+				return row < 8 && (this->keys[row] & bit) != 0;
+			}
+			column--;
+		}
+	}
+	return false;
+}
+
+/// <summary>Check if the last stable scan was ghosted (the keys of the scan before are kept)</summary>
+bool MSP430_Keypad::IsGhosted(void)
+{
+	return this->ghosted;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+
+// Interrupt-driven keypad matrix
+// The rows are an output bank, the columns an input bank with pullup resistors on an interrupt port (P1/P2).
+// While no key is pressed all rows are driven low and the CPU sleeps: a key pulls its column low and the column
+// interrupt wakes the scanner. Scan() then drives one row at a time (the other rows are released to high impedance,
+// so two keys in one column never short two driven rows) and is called every tick until the keys are stable.
+//
+//     MSP430_GPIO_Bank rows(MSP430_GPIO_Port::P6, MSP430_GPIO_Direction::Output);
+//     MSP430_GPIO_Bank columns(MSP430_GPIO_Port::P2, MSP430_GPIO_Direction::Input, MSP430_GPIO_PullResistor::On);
+//     MSP430_Keypad keypad(rows, columns, KeyChanged);              // void KeyChanged(unsigned char key, bool pressed)
+//
+//     void ScanKeys(void)
+//     {
+//         MSP430_Keypad_Status status = keypad.Scan();
+//         if (status != MSP430_Keypad_Status::Idle)
+//         {
+//             Scheduler::PostAfter<ScanKeys>(MSP430_SchedulerTimebase::TicksOf(status == MSP430_Keypad_Status::Scanning ? 5 : 50));
+//         }
+//     }
+//
+//     static void ColumnChanged(void)                                // called by the handler of every column pin
+//     {
+//         keypad.Wake();
+//         Scheduler::Post<ScanKeys>();
+//     }
+//
+// Post() requests the wake-up: the port interrupt routine leaves the low-power mode of the scheduler loop on exit.
+//
+// Any number of keys is tracked (n-key rollover). Without diodes, three keys on the corners of a rectangle make
+// the fourth corner read as pressed: such a scan is reported as ghosted and the previous keys are kept.
+
+/// <summary>Keypad key handler (called from Scan() for each key whose stable state changed)</summary>
+/// <param name="key">Key index (row index * column count + column index, in bit order of the access masks)</param>
+/// <param name="pressed">The key is pressed (false: released)</param>
+typedef void (*MSP430_Keypad_KeyHandler)(unsigned char key, bool pressed);
+
+/// <summary>
+/// Keypad scanner status (returned by Scan())
+/// </summary>
+enum class MSP430_Keypad_Status
+{
+	/// <summary>No key is pressed, the column interrupt is armed: stop the scan tick</summary>
+	Idle,
+	/// <summary>Keys are changing: scan again at the next (debounce) tick</summary>
+	Scanning,
+	/// <summary>Keys are held and stable, the column interrupt is armed: scan again at a slow tick to see more keys</summary>
+	Held
+};
+
+/// <summary>
+/// MSP430 keypad matrix scanner class (up to 8 rows x 8 columns)
+/// <para>NOTE: The banks must be initialized first. The scanner owns the PxDIR bits of the rows and
+/// the PxOUT/PxIE/PxIES bits of the columns (pullup selected by Initialize()).</para>
+/// </summary>
+class MSP430_Keypad
+{
+private:
+	// Register for hardware operation
+	MSP430_Register8 reg_RowOUT;
+	MSP430_Register8 reg_RowDIR;
+	MSP430_Register8 reg_ColumnIN;
+	MSP430_Register8 reg_ColumnOUT;
+	MSP430_Register8 reg_ColumnIE = nullptr;
+	MSP430_Register8 reg_ColumnIES = nullptr;
+	MSP430_Register8 reg_ColumnIFG = nullptr;
+
+	// Corresponding keypad location
+	/// <summary>Row pins (rows bank access mask)</summary>
+	unsigned char rowMask;
+	/// <summary>Column pins (columns bank access mask)</summary>
+	unsigned char columnMask;
+	/// <summary>Number of columns</summary>
+	unsigned char columnCount;
+	/// <summary>Key handler</summary>
+	MSP430_Keypad_KeyHandler handler;
+
+	// Scan state
+	/// <summary>Stable pressed columns of each row (column pin bits)</summary>
+	unsigned char keys[8] = { };
+	/// <summary>Pressed columns of each row in the last scan</summary>
+	unsigned char last[8] = { };
+	/// <summary>Number of consecutive identical scans</summary>
+	unsigned char stableScans = 0;
+	/// <summary>The last stable scan was ghosted</summary>
+	bool ghosted = false;
+
+	// Private low-level functions
+	/// <summary>Drive all rows low and interrupt on a change of the columns</summary>
+	/// <return>The columns did not change while arming</return>
+	bool Arm(void);
+
+public:
+	/// <summary>Identical scans for a stable state</summary>
+	static constexpr unsigned char StableScans = 3;
+	/// <summary>MCLK cycles for a column to follow a row (pullup and pin capacitance)</summary>
+	static constexpr unsigned int SettleCycles = 10;
+
+	// Constructor
+	/// <summary>Create a new keypad object on a rows bank and a columns bank (No hardware operation)</summary>
+	/// <param name="rows">Rows bank (output)</param>
+	/// <param name="columns">Columns bank (input, pullup resistors, P1/P2 for the wake-up interrupt)</param>
+	/// <param name="handler">Key handler</param>
+	MSP430_Keypad(MSP430_GPIO_Bank& rows, MSP430_GPIO_Bank& columns, MSP430_Keypad_KeyHandler handler);
+	/// <summary>Delete this keypad instance and disable the column interrupts</summary>
+	~MSP430_Keypad();
+
+	// Keypad initialize
+	/// <summary>Select the column pullups, clear the keys, drive all rows and arm the column interrupt</summary>
+	void Initialize(void);
+	/// <summary>Disable the column interrupts (the rows stay driven low)</summary>
+	void Deinitialize(void);
+
+	// Scanning
+	/// <summary>Disable and clear the column interrupts (Call it from the column pin interrupt handlers, then start the scan tick)</summary>
+	void Wake(void);
+	/// <summary>
+	/// Scan the matrix once, report the changed keys when the scan is stable
+	/// <para>Without a column interrupt (columns not on P1/P2) it never returns Idle.</para>
+	/// </summary>
+	/// <return>Scanner status (when to call again)</return>
+	MSP430_Keypad_Status Scan(void);
+
+	// Key state
+	/// <summary>Check if a key is pressed (stable state)</summary>
+	/// <param name="key">Key index</param>
+	bool IsPressed(unsigned char key);
+	/// <summary>Check if the last stable scan was ghosted (the keys of the scan before are kept)</summary>
+	bool IsGhosted(void);
+};
@@ -0,0 +1,343 @@
+#include <msp430.h>
+#include <stdint.h>
+#include "msp430cp_device.h"
+#include "msp430cp_mpy32.h"
+
+#ifdef MULTIPLIER_HAS_MPY32
+/// <summary>Cycles from the last OP2 write of a 32 x 16 multiplication until RES0-RES3 hold the result (32 x 32 latency, an upper bound)</summary>
+static constexpr unsigned int WideResultCycles = 7;
+
+/// <summary>Interrupt and multiplier state saved by a kernel section</summary>
+struct MPY32_Section
+{
+	/// <summary>GIE before the section</summary>
+	unsigned int gie;
+	/// <summary>MPY32CTL0 before the section</summary>
+	unsigned int control;
+};
+
+/// <summary>Disable interrupts and select a multiplier mode (the running sum must not be disturbed by interrupt handlers)</summary>
+/// <param name="mode">MPY32CTL0 value (MPYFRAC, MPYSAT, MPYDLYWRTEN)</param>
+/// <return>State to restore</return>
+static inline __attribute__((always_inline)) MPY32_Section Enter(unsigned int mode)
+{
+	MPY32_Section section;
+	section.gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	section.control = MPY32CTL0;
+	MPY32CTL0 = mode;
+	return section;
+}
+
+/// <summary>Restore the multiplier mode (integer mode for the compiler's multiplications) and the interrupts</summary>
+/// <param name="section">State saved by Enter()</param>
+static inline __attribute__((always_inline)) void Leave(MPY32_Section section)
+{
+	MPY32CTL0 = section.control;
+	__bis_SR_register(section.gie);
+}
+
+/// <summary>Signed 32 x 16 multiply-accumulate into RES3:RES2:RES1:RES0</summary>
+/// <param name="a">32-bit operand</param>
+/// <param name="b">16-bit operand</param>
+static inline __attribute__((always_inline)) void MultiplyAccumulateWide(int32_t a, int16_t b)
+{
+	MACS32L = static_cast<uint16_t> (a);
+	MACS32H = static_cast<uint16_t> (static_cast<uint32_t> (a) >> 16);
+	OP2 = b;
+}
+
+/// <summary>Dot product of two Q15 vectors, rounded and saturated to Q15</summary>
+/// <param name="a">First vector</param>
+/// <param name="b">Second vector</param>
+/// <param name="length">Number of elements</param>
+MSP430_Q15 MSP430_MPY32::DotQ15(const MSP430_Q15* a, const MSP430_Q15* b, unsigned int length)
+{
+	MPY32_Section section = Enter(MPYFRAC | MPYSAT);
+
+	// Q31 sum in RESHI:RESLO, preset with half of the RESHI unit for rounding
+	// (the fractional mode shifts the read-out left by one, presets are written at half weight)
+	RESLO = 0x4000;
+	RESHI = 0;
+	for (unsigned int i = 0; i < length; i++)
+	{
+		MACS = a[i];
+		OP2 = b[i];
+	}
+	MSP430_Q15 result = static_cast<MSP430_Q15> (RESHI);
+
+	Leave(section);
+	return result;
+}
+
+/// <summary>Dot product of two Q15 vectors, saturated to Q31</summary>
+/// <param name="a">First vector</param>
+/// <param name="b">Second vector</param>
+/// <param name="length">Number of elements</param>
+MSP430_Q31 MSP430_MPY32::DotQ31(const MSP430_Q15* a, const MSP430_Q15* b, unsigned int length)
+{
+	MPY32_Section section = Enter(MPYFRAC | MPYSAT);
+
+	RESLO = 0;
+	RESHI = 0;
+	for (unsigned int i = 0; i < length; i++)
+	{
+		MACS = a[i];
+		OP2 = b[i];
+	}
+	MSP430_Q31 result = static_cast<MSP430_Q31> ((static_cast<uint32_t> (RESHI) << 16) | RESLO);
+
+	Leave(section);
+	return result;
+}
+
+/// <summary>Multiply a Q15 vector by a Q15 factor (truncated and saturated, input and output may be the same)</summary>
+/// <param name="input">Input vector</param>
+/// <param name="output">Output vector</param>
+/// <param name="length">Number of elements</param>
+/// <param name="scale">Factor</param>
+void MSP430_MPY32::ScaleQ15(const MSP430_Q15* input, MSP430_Q15* output, unsigned int length, MSP430_Q15 scale)
+{
+	for (unsigned int i = 0; i < length; i++)
+	{
+		MPY32_Section section = Enter(MPYFRAC | MPYSAT);
+		MPYS = scale;
+		OP2 = input[i];
+		output[i] = static_cast<MSP430_Q15> (RESHI);
+		Leave(section);
+	}
+}
+
+/// <summary>Add a Q15 vector multiplied by a Q15 factor to an accumulator vector (rounded and saturated)</summary>
+/// <param name="input">Input vector</param>
+/// <param name="accumulator">Accumulator vector (input and output)</param>
+/// <param name="length">Number of elements</param>
+/// <param name="scale">Factor</param>
+void MSP430_MPY32::MultiplyAccumulateQ15(const MSP430_Q15* input, MSP430_Q15* accumulator, unsigned int length, MSP430_Q15 scale)
+{
+	for (unsigned int i = 0; i < length; i++)
+	{
+		MPY32_Section section = Enter(MPYFRAC | MPYSAT);
+		// The accumulator element is the preset Q31 sum (plus half of the RESHI unit for rounding),
+		// written at half weight as the fractional mode shifts the read-out left by one
+		RESHI = static_cast<uint16_t> (accumulator[i] >> 1);
+		RESLO = static_cast<uint16_t> (((accumulator[i] & 1) << 15) | 0x4000);
+		MACS = scale;
+		OP2 = input[i];
+		accumulator[i] = static_cast<MSP430_Q15> (RESHI);
+		Leave(section);
+	}
+}
+
+/// <summary>Convert 12-bit ADC12 results (0-4095, mid-scale 2048) into Q15 samples (input and output may be the same)</summary>
+/// <param name="input">ADC12 results</param>
+/// <param name="output">Q15 samples</param>
+/// <param name="length">Number of samples</param>
+void MSP430_MPY32::FromADC12(const unsigned int* input, MSP430_Q15* output, unsigned int length)
+{
+	// Left-aligned with the sign bit inverted: 0 -> -1, 2048 -> 0, 4095 -> 1 - 2^-11
+	for (unsigned int i = 0; i < length; i++)
+	{
+		output[i] = static_cast<MSP430_Q15> (static_cast<uint16_t> ((input[i] << 4) ^ 0x8000));
+	}
+}
+
+/// <summary>Create a new FIR filter object (history cleared)</summary>
+/// <param name="coefficients">Coefficients (Q15, kept by reference)</param>
+/// <param name="taps">Number of coefficients (1 or more)</param>
+/// <param name="state">State buffer (taps - 1 + blockSize samples)</param>
+/// <param name="blockSize">Samples filtered per block (1 or more, longer inputs are split)</param>
+MSP430_FIR::MSP430_FIR(const MSP430_Q15* coefficients, unsigned int taps, MSP430_Q15* state, unsigned int blockSize)
+{
+	this->coefficients = coefficients;
+	this->taps = (taps == 0) ? 1 : taps;
+	this->state = state;
+	this->blockSize = (blockSize == 0) ? 1 : blockSize;
+	Reset();
+}
+
+/// <summary>Clear the history (all past samples 0)</summary>
+void MSP430_FIR::Reset(void)
+{
+	for (unsigned int i = 0; i < this->taps - 1; i++)
+	{
+		this->state[i] = 0;
+	}
+}
+
+/// <summary>Filter samples (input and output may be the same)</summary>
+/// <param name="input">Input samples</param>
+/// <param name="output">Output samples</param>
+/// <param name="length">Number of samples</param>
+void MSP430_FIR::Process(const MSP430_Q15* input, MSP430_Q15* output, unsigned int length)
+{
+	unsigned int history = this->taps - 1;
+	MSP430_Q15* samples = this->state + history;
+	while (length > 0)
+	{
+		// The block goes after the history, so each output is one run over contiguous samples
+		unsigned int count = (length < this->blockSize) ? length : this->blockSize;
+		for (unsigned int i = 0; i < count; i++)
+		{
+			samples[i] = input[i];
+		}
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			const MSP430_Q15* coefficient = this->coefficients;
+			const MSP430_Q15* sample = samples + i;
+			MPY32_Section section = Enter(MPYFRAC | MPYSAT);
+
+			// Q31 sum in RESHI:RESLO, preset with half of the RESHI unit for rounding (at half weight, see DotQ15)
+			RESLO = 0x4000;
+			RESHI = 0;
+			for (unsigned int k = 0; k < this->taps; k++)
+			{
+				MACS = *coefficient++;
+				OP2 = *sample--;
+			}
+			output[i] = static_cast<MSP430_Q15> (RESHI);
+
+			Leave(section);
+		}
+
+		// The last taps - 1 samples are the history of the next block
+		for (unsigned int i = 0; i < history; i++)
+		{
+			this->state[i] = this->state[count + i];
+		}
+		input += count;
+		output += count;
+		length -= count;
+	}
+}
+
+/// <summary>Create a new biquad cascade object (state cleared)</summary>
+/// <param name="coefficients">Coefficients of each section (kept by reference)</param>
+/// <param name="state">State of each section</param>
+/// <param name="stages">Number of sections (1 or more)</param>
+MSP430_Biquad::MSP430_Biquad(const MSP430_Biquad_Coefficients* coefficients, MSP430_Biquad_State* state, unsigned int stages)
+{
+	this->coefficients = coefficients;
+	this->state = state;
+	this->stages = (stages == 0) ? 1 : stages;
+	Reset();
+}
+
+/// <summary>Clear the state of all sections</summary>
+void MSP430_Biquad::Reset(void)
+{
+	for (unsigned int i = 0; i < this->stages; i++)
+	{
+		this->state[i] = { 0, 0, 0, 0 };
+	}
+}
+
+/// <summary>Filter samples (input and output may be the same)</summary>
+/// <param name="input">Input samples</param>
+/// <param name="output">Output samples</param>
+/// <param name="length">Number of samples</param>
+void MSP430_Biquad::Process(const MSP430_Q15* input, MSP430_Q15* output, unsigned int length)
+{
+	for (unsigned int i = 0; i < length; i++)
+	{
+		MSP430_Q15 x = input[i];
+		for (unsigned int s = 0; s < this->stages; s++)
+		{
+			const MSP430_Biquad_Coefficients& c = this->coefficients[s];
+			MSP430_Biquad_State& state = this->state[s];
+			MPY32_Section section = Enter(MPYDLYWRTEN);
+
+			// Q2.30 x Q15 products summed in 64 bits (Q45), preset with half of the Q15 unit (bit 29) for rounding
+			RES3 = 0;
+			RES2 = 0;
+			RES1 = 0x2000;
+			RES0 = 0;
+			MultiplyAccumulateWide(c.b0, x);
+			MultiplyAccumulateWide(c.b1, state.x1);
+			MultiplyAccumulateWide(c.b2, state.x2);
+			MultiplyAccumulateWide(c.minusA1, state.y1);
+			MultiplyAccumulateWide(c.minusA2, state.y2);
+			__delay_cycles(WideResultCycles);
+
+			// The Q15 result is bits 30-45: in range when bits 29-63 are all copies of the sign
+			unsigned int high = RES3;
+			unsigned int upper = RES2;
+			unsigned int middle = RES1;
+			Leave(section);
+
+			int32_t word = static_cast<int32_t> ((static_cast<uint32_t> (upper) << 16) | middle);
+			MSP430_Q15 y;
+			if (high == ((word < 0) ? 0xFFFFU : 0U) && word >= -0x20000000L && word < 0x20000000L)
+			{
+				y = static_cast<MSP430_Q15> (static_cast<uint16_t> ((upper << 2) | (middle >> 14)));
+			}
+			else
+			{
+				y = (high & 0x8000) ? INT16_MIN : INT16_MAX;
+			}
+
+			state.x2 = state.x1;
+			state.x1 = x;
+			state.y2 = state.y1;
+			state.y1 = y;
+			x = y;
+		}
+		output[i] = x;
+	}
+}
+
+/// <summary>Create a new moving average object (window cleared)</summary>
+/// <param name="window">Window buffer (length samples)</param>
+/// <param name="length">Number of samples averaged (2 or more)</param>
+MSP430_MovingAverage::MSP430_MovingAverage(MSP430_Q15* window, unsigned int length)
+{
+	this->window = window;
+	this->length = (length < 2) ? 2 : length;
+	this->reciprocal = 32768U / this->length;
+	Reset();
+}
+
+/// <summary>Fill the window with a value</summary>
+/// <param name="value">Value of all past samples</param>
+void MSP430_MovingAverage::Reset(MSP430_Q15 value)
+{
+	this->sum = 0;
+	for (unsigned int i = 0; i < this->length; i++)
+	{
+		this->window[i] = value;
+		this->sum += value;
+	}
+	this->index = 0;
+}
+
+/// <summary>Average samples (input and output may be the same)</summary>
+/// <param name="input">Input samples</param>
+/// <param name="output">Averages (rounded)</param>
+/// <param name="count">Number of samples</param>
+void MSP430_MovingAverage::Process(const MSP430_Q15* input, MSP430_Q15* output, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		MSP430_Q15 x = input[i];
+		this->sum += static_cast<int32_t> (x) - this->window[this->index];
+		this->window[this->index] = x;
+		if (++this->index == this->length)
+		{
+			this->index = 0;
+		}
+
+		MPY32_Section section = Enter(MPYDLYWRTEN);
+		// Sum x reciprocal is the average in Q30 (bits 15-30 are the Q15 average), preset with half of its unit for rounding
+		RES3 = 0;
+		RES2 = 0;
+		RES1 = 0;
+		RES0 = 0x4000;
+		MultiplyAccumulateWide(this->sum, static_cast<int16_t> (this->reciprocal));
+		__delay_cycles(WideResultCycles);
+		output[i] = static_cast<MSP430_Q15> (static_cast<uint16_t> ((RES1 << 1) | (RES0 >> 15)));
+		Leave(section);
+	}
+}
+#endif
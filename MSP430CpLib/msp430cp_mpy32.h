@@ -0,0 +1,286 @@
+#pragma once
+
+#include <stdint.h>
+#include <msp430.h>
+#include "msp430cp_device.h"
+
+// Fixed-point DSP kernels on the 32-bit hardware multiplier (MPY32)
+// The kernels write the multiplier registers directly: the samples and coefficients go to the operand registers,
+// sums build up in the RES registers (multiply-accumulate), no libgcc multiply is called. Q15 kernels run in the
+// fractional mode with saturation (a Q15 x Q15 sum is read as a saturated Q15 from RESHI), the biquad and the
+// moving average use 32 x 16 multiplications accumulated into 64 bits.
+// All kernels take sample blocks and may work in place, e.g. on the halves handed over by MSP430_ADC12::Advance():
+//
+//     static const MSP430_Q15 taps[16] = { MSP430_MPY32::Q15(0.0625), ... };
+//     MSP430_BufferedFIR<16, 64> lowpass(taps);
+//
+//     unsigned int* half = adc.Advance();
+//     if (half != nullptr)
+//     {
+//         MSP430_MPY32::FromADC12(half, samples, 64);
+//         lowpass.Process(samples, samples, 64);
+//     }
+//
+// Interrupts are disabled while the multiplier holds a running sum: per output sample in the filters and the
+// element-wise kernels, for the whole vector in the dot products. The multiplier mode is restored afterwards for the
+// compiler's own multiplications.
+
+#ifdef MULTIPLIER_HAS_MPY32
+/// <summary>
+/// Q15 fixed-point number (-1 to 1 - 2^-15)
+/// </summary>
+typedef int16_t MSP430_Q15;
+
+/// <summary>
+/// Q31 fixed-point number (-1 to 1 - 2^-31)
+/// </summary>
+typedef int32_t MSP430_Q31;
+
+/// <summary>
+/// Q2.30 fixed-point number (-2 to 2 - 2^-30, filter coefficients)
+/// </summary>
+typedef int32_t MSP430_Q30;
+
+/// <summary>
+/// MSP430 hardware multiplier kernels (all static)
+/// </summary>
+class MSP430_MPY32
+{
+public:
+	// Compile-time conversions
+	/// <summary>Q15 value of a real number (saturated)</summary>
+	/// <param name="value">Real number</param>
+	static constexpr MSP430_Q15 Q15(double value)
+	{
+		return (value >= 32767.0 / 32768.0) ? 32767 : (value <= -1.0) ? -32768
+			: static_cast<MSP430_Q15> ((value < 0) ? (value * 32768.0 - 0.5) : (value * 32768.0 + 0.5));
+	}
+	/// <summary>Q2.30 value of a real number (saturated)</summary>
+	/// <param name="value">Real number</param>
+	static constexpr MSP430_Q30 Q30(double value)
+	{
+		return (value >= 2147483647.0 / 1073741824.0) ? INT32_MAX : (value <= -2.0) ? INT32_MIN
+			: static_cast<MSP430_Q30> ((value < 0) ? (value * 1073741824.0 - 0.5) : (value * 1073741824.0 + 0.5));
+	}
+
+	// Vector kernels
+	/// <summary>Dot product of two Q15 vectors, rounded and saturated to Q15</summary>
+	/// <param name="a">First vector</param>
+	/// <param name="b">Second vector</param>
+	/// <param name="length">Number of elements</param>
+	static MSP430_Q15 DotQ15(const MSP430_Q15* a, const MSP430_Q15* b, unsigned int length);
+	/// <summary>Dot product of two Q15 vectors, saturated to Q31</summary>
+	/// <param name="a">First vector</param>
+	/// <param name="b">Second vector</param>
+	/// <param name="length">Number of elements</param>
+	static MSP430_Q31 DotQ31(const MSP430_Q15* a, const MSP430_Q15* b, unsigned int length);
+	/// <summary>Multiply a Q15 vector by a Q15 factor (truncated and saturated, input and output may be the same)</summary>
+	/// <param name="input">Input vector</param>
+	/// <param name="output">Output vector</param>
+	/// <param name="length">Number of elements</param>
+	/// <param name="scale">Factor</param>
+	static void ScaleQ15(const MSP430_Q15* input, MSP430_Q15* output, unsigned int length, MSP430_Q15 scale);
+	/// <summary>Add a Q15 vector multiplied by a Q15 factor to an accumulator vector (rounded and saturated)</summary>
+	/// <param name="input">Input vector</param>
+	/// <param name="accumulator">Accumulator vector (input and output)</param>
+	/// <param name="length">Number of elements</param>
+	/// <param name="scale">Factor</param>
+	static void MultiplyAccumulateQ15(const MSP430_Q15* input, MSP430_Q15* accumulator, unsigned int length, MSP430_Q15 scale);
+	/// <summary>Convert 12-bit ADC12 results (0-4095, mid-scale 2048) into Q15 samples (input and output may be the same)</summary>
+	/// <param name="input">ADC12 results</param>
+	/// <param name="output">Q15 samples</param>
+	/// <param name="length">Number of samples</param>
+	static void FromADC12(const unsigned int* input, MSP430_Q15* output, unsigned int length);
+};
+
+/// <summary>
+/// Q15 FIR filter (Block processing on the multiplier's multiply-accumulate, fractional mode with saturation)
+/// <para>y[n] = sum of coefficients[k] x x[n - k], rounded to Q15. The sum is kept in 32 bits (Q31): the sum of
+/// the absolute coefficients must stay below 1 to rule out wrap-around, the final result is saturated.</para>
+/// </summary>
+class MSP430_FIR
+{
+private:
+	/// <summary>Coefficients (Q15, coefficients[0] applies to the newest sample)</summary>
+	const MSP430_Q15* coefficients;
+	/// <summary>Number of coefficients</summary>
+	unsigned int taps;
+	/// <summary>History of taps - 1 samples followed by the block being filtered</summary>
+	MSP430_Q15* state;
+	/// <summary>Samples filtered per block</summary>
+	unsigned int blockSize;
+
+public:
+	// Constructor
+	/// <summary>Create a new FIR filter object (history cleared)</summary>
+	/// <param name="coefficients">Coefficients (Q15, kept by reference)</param>
+	/// <param name="taps">Number of coefficients (1 or more)</param>
+	/// <param name="state">State buffer (taps - 1 + blockSize samples)</param>
+	/// <param name="blockSize">Samples filtered per block (1 or more, longer inputs are split)</param>
+	MSP430_FIR(const MSP430_Q15* coefficients, unsigned int taps, MSP430_Q15* state, unsigned int blockSize);
+
+	/// <summary>Clear the history (all past samples 0)</summary>
+	void Reset(void);
+	/// <summary>Filter samples (input and output may be the same)</summary>
+	/// <param name="input">Input samples</param>
+	/// <param name="output">Output samples</param>
+	/// <param name="length">Number of samples</param>
+	void Process(const MSP430_Q15* input, MSP430_Q15* output, unsigned int length);
+};
+
+/// <summary>
+/// Q15 FIR filter with its state buffer
+/// </summary>
+/// <typeparam name="firTaps">Number of coefficients</typeparam>
+/// <typeparam name="firBlockSize">Samples filtered per block</typeparam>
+template <unsigned int firTaps, unsigned int firBlockSize>
+class MSP430_BufferedFIR : public MSP430_FIR
+{
+	static_assert(firTaps >= 1 && firBlockSize >= 1, "FIR filters need 1 tap and 1 sample per block or more");
+
+private:
+	MSP430_Q15 stateStorage[firTaps - 1 + firBlockSize];
+
+public:
+	// Constructor
+	/// <summary>Create a new FIR filter object (history cleared)</summary>
+	/// <param name="coefficients">Coefficients (Q15, firTaps values, kept by reference)</param>
+	MSP430_BufferedFIR(const MSP430_Q15* coefficients) :
+		MSP430_FIR(coefficients, firTaps, stateStorage, firBlockSize)
+	{
+	}
+};
+
+/// <summary>
+/// Biquad section coefficients (Q2.30): y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + minusA1 y[n-1] + minusA2 y[n-2]
+/// <para>The feedback coefficients are stored negated (minusA1 = -a1, minusA2 = -a2 of the usual a0 = 1 form).</para>
+/// </summary>
+struct MSP430_Biquad_Coefficients
+{
+	MSP430_Q30 b0;
+	MSP430_Q30 b1;
+	MSP430_Q30 b2;
+	MSP430_Q30 minusA1;
+	MSP430_Q30 minusA2;
+};
+
+/// <summary>
+/// Biquad section state (direct form I, Q15)
+/// </summary>
+struct MSP430_Biquad_State
+{
+	MSP430_Q15 x1;
+	MSP430_Q15 x2;
+	MSP430_Q15 y1;
+	MSP430_Q15 y2;
+};
+
+/// <summary>
+/// Cascade of biquad IIR sections (Direct form I, 32 x 16 multiply-accumulate into 64 bits)
+/// <para>Each section output is rounded and saturated to Q15 before the next section.</para>
+/// </summary>
+class MSP430_Biquad
+{
+private:
+	/// <summary>Coefficients of each section</summary>
+	const MSP430_Biquad_Coefficients* coefficients;
+	/// <summary>State of each section</summary>
+	MSP430_Biquad_State* state;
+	/// <summary>Number of sections</summary>
+	unsigned int stages;
+
+public:
+	// Constructor
+	/// <summary>Create a new biquad cascade object (state cleared)</summary>
+	/// <param name="coefficients">Coefficients of each section (kept by reference)</param>
+	/// <param name="state">State of each section</param>
+	/// <param name="stages">Number of sections (1 or more)</param>
+	MSP430_Biquad(const MSP430_Biquad_Coefficients* coefficients, MSP430_Biquad_State* state, unsigned int stages);
+
+	/// <summary>Clear the state of all sections</summary>
+	void Reset(void);
+	/// <summary>Filter samples (input and output may be the same)</summary>
+	/// <param name="input">Input samples</param>
+	/// <param name="output">Output samples</param>
+	/// <param name="length">Number of samples</param>
+	void Process(const MSP430_Q15* input, MSP430_Q15* output, unsigned int length);
+};
+
+/// <summary>
+/// Cascade of biquad IIR sections with its state
+/// </summary>
+/// <typeparam name="biquadStages">Number of sections</typeparam>
+template <unsigned int biquadStages>
+class MSP430_BufferedBiquad : public MSP430_Biquad
+{
+	static_assert(biquadStages >= 1, "Biquad cascades need 1 section or more");
+
+private:
+	MSP430_Biquad_State stateStorage[biquadStages];
+
+public:
+	// Constructor
+	/// <summary>Create a new biquad cascade object (state cleared)</summary>
+	/// <param name="coefficients">Coefficients of each section (biquadStages values, kept by reference)</param>
+	MSP430_BufferedBiquad(const MSP430_Biquad_Coefficients* coefficients) :
+		MSP430_Biquad(coefficients, stateStorage, biquadStages)
+	{
+	}
+};
+
+/// <summary>
+/// Q15 moving average (Running 32-bit sum, one 32 x 16 multiplication by the reciprocal of the window per sample)
+/// <para>The reciprocal is rounded down to Q15, the average is exact for power of 2 windows.</para>
+/// </summary>
+class MSP430_MovingAverage
+{
+private:
+	/// <summary>Last samples (circular)</summary>
+	MSP430_Q15* window;
+	/// <summary>Number of samples averaged</summary>
+	unsigned int length;
+	/// <summary>Position of the oldest sample</summary>
+	unsigned int index;
+	/// <summary>Sum of the window</summary>
+	int32_t sum;
+	/// <summary>32768 / length</summary>
+	unsigned int reciprocal;
+
+public:
+	// Constructor
+	/// <summary>Create a new moving average object (window cleared)</summary>
+	/// <param name="window">Window buffer (length samples)</param>
+	/// <param name="length">Number of samples averaged (2 or more)</param>
+	MSP430_MovingAverage(MSP430_Q15* window, unsigned int length);
+
+	/// <summary>Fill the window with a value</summary>
+	/// <param name="value">Value of all past samples</param>
+	void Reset(MSP430_Q15 value = 0);
+	/// <summary>Average samples (input and output may be the same)</summary>
+	/// <param name="input">Input samples</param>
+	/// <param name="output">Averages (rounded)</param>
+	/// <param name="count">Number of samples</param>
+	void Process(const MSP430_Q15* input, MSP430_Q15* output, unsigned int count);
+};
+
+/// <summary>
+/// Q15 moving average with its window buffer
+/// </summary>
+/// <typeparam name="averageLength">Number of samples averaged</typeparam>
+template <unsigned int averageLength>
+class MSP430_BufferedMovingAverage : public MSP430_MovingAverage
+{
+	static_assert(averageLength >= 2, "Moving averages need a window of 2 samples or more");
+
+private:
+	MSP430_Q15 windowStorage[averageLength];
+
+public:
+	// Constructor
+	/// <summary>Create a new moving average object (window cleared)</summary>
+	MSP430_BufferedMovingAverage(void) :
+		MSP430_MovingAverage(windowStorage, averageLength)
+	{
+	}
+};
+#endif
@@ -0,0 +1,405 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_parallel.h"
+#include "msp430cp_clock.h"
+
+// GPIO registers
+extern REG_8b const PxIN[GPIO_PORT_COUNT];
+extern REG_8b const PxOUT[GPIO_PORT_COUNT];
+extern REG_8b const PxDIR[GPIO_PORT_COUNT];
+extern REG_8b const PxSEL[GPIO_PORT_COUNT];
+// Timer registers
+extern REG_16b const TxCTL[TIMER_COUNT];
+
+/// <summary>Register of an absent strobe pin (its mask is 0, the XOR.B leave it unchanged)</summary>
+static volatile unsigned char absentPin[2];
+
+/// <summary>DMA trigger of a timer's CCR0 (TA0_CCR0, TA1_CCR0, TA2_CCR0, TB0_CCR0 follow the timer instance order)</summary>
+static inline MSP430_DMA_Trigger TriggerOf(MSP430_Timer_Instance timer)
+{
+	return static_cast<MSP430_DMA_Trigger> (static_cast<int> (MSP430_DMA_Trigger::TA0_CCR0) + 2 * static_cast<int> (timer));
+}
+
+/// <summary>Create a new parallel bus object on a data bank and the strobe pins (No hardware operation)</summary>
+/// <param name="data">Data bank (output)</param>
+/// <param name="wr">Write strobe pin</param>
+/// <param name="dc">Data/command select pin (D/CX, RS)</param>
+/// <param name="cs">Chip select pin (nullptr when CS is tied LOW)</param>
+/// <param name="rd">Read strobe pin (nullptr when RD is tied HIGH, Read() returns 0)</param>
+MSP430_ParallelBus::MSP430_ParallelBus(MSP430_GPIO_Bank& data, MSP430_GPIO& wr, MSP430_GPIO& dc, MSP430_GPIO* cs, MSP430_GPIO* rd)
+{
+	int dataPort = static_cast<int> (data.GetPort());
+	int wrPort = static_cast<int> (wr.GetPort());
+	int dcPort = static_cast<int> (dc.GetPort());
+
+	this->reg_DataIN = PxIN[dataPort];
+	this->reg_DataOUT = PxOUT[dataPort];
+	this->reg_DataDIR = PxDIR[dataPort];
+	this->dataMask = data.GetAccessMask();
+
+	this->reg_WROUT = PxOUT[wrPort];
+	this->reg_WRDIR = PxDIR[wrPort];
+	this->reg_WRSEL = PxSEL[wrPort];
+	this->wrMask = static_cast<unsigned char> (1 << wr.GetPin());
+	this->reg_DCOUT = PxOUT[dcPort];
+	this->reg_DCDIR = PxDIR[dcPort];
+	this->dcMask = static_cast<unsigned char> (1 << dc.GetPin());
+
+	this->reg_CSOUT = this->reg_CSDIR = MSP430_Register8(&absentPin[0]);
+	if (cs != nullptr)
+	{
+		this->reg_CSOUT = PxOUT[static_cast<int> (cs->GetPort())];
+		this->reg_CSDIR = PxDIR[static_cast<int> (cs->GetPort())];
+		this->csMask = static_cast<unsigned char> (1 << cs->GetPin());
+	}
+	this->reg_RDOUT = this->reg_RDDIR = MSP430_Register8(&absentPin[1]);
+	if (rd != nullptr)
+	{
+		this->reg_RDOUT = PxOUT[static_cast<int> (rd->GetPort())];
+		this->reg_RDDIR = PxDIR[static_cast<int> (rd->GetPort())];
+		this->rdMask = static_cast<unsigned char> (1 << rd->GetPin());
+	}
+}
+
+/// <summary>Delete this parallel bus instance and release the data port</summary>
+MSP430_ParallelBus::~MSP430_ParallelBus()
+{
+	Deinitialize();
+}
+
+/// <summary>Set the strobes to their idle levels and drive the data port</summary>
+void MSP430_ParallelBus::Initialize(void)
+{
+	// Idle levels before the pins become outputs, so no strobe glitches
+	this->reg_WROUT.Set(this->wrMask);
+	this->reg_RDOUT.Set(this->rdMask);
+	this->reg_CSOUT.Set(this->csMask);
+	this->reg_DCOUT.Set(this->dcMask);
+	this->reg_WRDIR.Set(this->wrMask);
+	this->reg_RDDIR.Set(this->rdMask);
+	this->reg_CSDIR.Set(this->csMask);
+	this->reg_DCDIR.Set(this->dcMask);
+
+	this->reg_DataDIR.Set(this->dataMask);
+}
+
+/// <summary>Deselect the device and release the data port (inputs)</summary>
+void MSP430_ParallelBus::Deinitialize(void)
+{
+	this->reg_CSOUT.Set(this->csMask);
+	this->reg_DataDIR.Clear(this->dataMask);
+}
+
+/// <summary>Select the device (CS LOW(0))</summary>
+void MSP430_ParallelBus::Select(void)
+{
+	this->reg_CSOUT.Clear(this->csMask);
+}
+
+/// <summary>Deselect the device (CS HIGH(1))</summary>
+void MSP430_ParallelBus::Deselect(void)
+{
+	this->reg_CSOUT.Set(this->csMask);
+}
+
+/// <summary>Write a command byte (DC LOW(0) during the strobe)</summary>
+/// <param name="command">Command byte</param>
+void MSP430_ParallelBus::WriteCommand(unsigned char command)
+{
+	this->reg_DCOUT.Clear(this->dcMask);
+	Write(command);
+	this->reg_DCOUT.Set(this->dcMask);
+}
+
+/// <summary>Write a data byte</summary>
+/// <param name="value">Data byte</param>
+void MSP430_ParallelBus::Write(unsigned char value)
+{
+	this->reg_DataOUT.Modify(value, this->dataMask);
+	this->reg_WROUT.Toggle(this->wrMask);
+	this->reg_WROUT.Toggle(this->wrMask);
+}
+
+/// <summary>Write a buffer through a data bank smaller than the port</summary>
+void MSP430_ParallelBus::WriteMasked(const unsigned char* data, unsigned int length)
+{
+	MSP430_Register8 out = this->reg_DataOUT;
+	MSP430_Register8 wr = this->reg_WROUT;
+	unsigned char strobe = this->wrMask;
+	unsigned char mask = this->dataMask;
+	unsigned char others = out.Read() & ~mask;
+
+	for (; length > 0; length--)
+	{
+		out.Write((*data++ & mask) | others);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+}
+
+/// <summary>Write a buffer of data bytes (burst)</summary>
+/// <param name="data">Data bytes</param>
+/// <param name="length">Number of bytes</param>
+void MSP430_ParallelBus::Write(const unsigned char* data, unsigned int length)
+{
+	if (this->dataMask != 0xFF)
+	{
+		WriteMasked(data, length);
+		return;
+	}
+
+	// Locals: the volatile writes could alias the members, which would be reloaded for every byte
+	MSP430_Register8 out = this->reg_DataOUT;
+	MSP430_Register8 wr = this->reg_WROUT;
+	unsigned char strobe = this->wrMask;
+
+	// MOV.B @Rn+, 0(Rm) and two XOR.B per byte, unrolled by 2
+	for (; length >= 2; length -= 2)
+	{
+		out.Write(*data++);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		out.Write(*data++);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+	if (length)
+	{
+		out.Write(*data);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+}
+
+/// <summary>Write 16-bit words high byte first (e.g. RGB565 pixels)</summary>
+/// <param name="data">Words</param>
+/// <param name="count">Number of words</param>
+void MSP430_ParallelBus::Write16(const unsigned int* data, unsigned int count)
+{
+	MSP430_Register8 out = this->reg_DataOUT;
+	MSP430_Register8 wr = this->reg_WROUT;
+	unsigned char strobe = this->wrMask;
+	unsigned char mask = this->dataMask;
+	unsigned char others = out.Read() & ~mask;
+
+	for (; count > 0; count--)
+	{
+		unsigned int value = *data++;
+		out.Write((static_cast<unsigned char> (value >> 8) & mask) | others);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		out.Write((static_cast<unsigned char> (value) & mask) | others);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+}
+
+/// <summary>Write the same data byte a number of times (the data port is written once, then only WR toggles)</summary>
+/// <param name="value">Data byte</param>
+/// <param name="count">Number of bytes</param>
+void MSP430_ParallelBus::Fill(unsigned char value, unsigned long count)
+{
+	MSP430_Register8 wr = this->reg_WROUT;
+	unsigned char strobe = this->wrMask;
+
+	this->reg_DataOUT.Modify(value, this->dataMask);
+
+	// The 32-bit count is only touched every 8 bytes
+	for (; count >= 8; count -= 8)
+	{
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+	for (unsigned char rest = static_cast<unsigned char> (count); rest > 0; rest--)
+	{
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+}
+
+/// <summary>Write the same 16-bit word a number of times, high byte first (Fill() when both bytes are equal)</summary>
+/// <param name="value">Word (e.g. an RGB565 pixel)</param>
+/// <param name="count">Number of words</param>
+void MSP430_ParallelBus::Fill16(unsigned int value, unsigned long count)
+{
+	unsigned char mask = this->dataMask;
+	unsigned char high = static_cast<unsigned char> (value >> 8);
+	unsigned char low = static_cast<unsigned char> (value);
+	if (((high ^ low) & mask) == 0)
+	{
+		Fill(high, count * 2);
+		return;
+	}
+
+	MSP430_Register8 out = this->reg_DataOUT;
+	MSP430_Register8 wr = this->reg_WROUT;
+	unsigned char strobe = this->wrMask;
+	unsigned char others = out.Read() & ~mask;
+	high = (high & mask) | others;
+	low = (low & mask) | others;
+
+	for (; count > 0; count--)
+	{
+		out.Write(high);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+		out.Write(low);
+		wr.Toggle(strobe);
+		wr.Toggle(strobe);
+	}
+}
+
+/// <summary>Read a data byte (the data port is an input during the RD strobe)</summary>
+unsigned char MSP430_ParallelBus::Read(void)
+{
+	unsigned char value;
+	Read(&value, 1);
+	return value;
+}
+
+/// <summary>Read a buffer of data bytes</summary>
+/// <param name="data">Data bytes</param>
+/// <param name="length">Number of bytes</param>
+void MSP430_ParallelBus::Read(unsigned char* data, unsigned int length)
+{
+	MSP430_Register8 in = this->reg_DataIN;
+	MSP430_Register8 rd = this->reg_RDOUT;
+	unsigned char strobe = this->rdMask;
+	unsigned char mask = this->dataMask;
+
+	this->reg_DataDIR.Clear(mask);
+	for (; length > 0; length--)
+	{
+		rd.Toggle(strobe);
+		__delay_cycles(ReadCycles);
+		*data++ = (strobe != 0) ? in.Read(mask) : 0;
+		rd.Toggle(strobe);
+	}
+	this->reg_DataDIR.Set(mask);
+}
+
+/// <summary>Create a new DMA writer on a bus, two DMA channels and a timer channel (No hardware operation)</summary>
+/// <param name="bus">Parallel bus (WR on the timer channel's output pin)</param>
+/// <param name="channel">Data DMA channel (the next channel finishes the transfer)</param>
+/// <param name="timer">Timer of the byte clock (Up mode, CCR0 triggers the DMA)</param>
+/// <param name="wrChannel">Capture/compare channel whose output is WR (1 to 6)</param>
+/// <param name="byteRate">Bytes per second</param>
+MSP430_ParallelBus_DMA::MSP430_ParallelBus_DMA(MSP430_ParallelBus& bus, MSP430_DMA_Channel channel, MSP430_Timer_Instance timer, MSP430_Timer_Channel wrChannel, unsigned long byteRate) :
+	bus(bus),
+	data(channel, TriggerOf(timer), MSP430_DMA_Mode::Single, MSP430_DMA_Step::Increment, MSP430_DMA_Step::Fixed, MSP430_DMA_Unit::Byte),
+	finish((channel + 1) % DMA_CHANNEL_COUNT, MSP430_DMA_Trigger::PreviousChannel, MSP430_DMA_Mode::Single, MSP430_DMA_Step::Fixed, MSP430_DMA_Step::Fixed, MSP430_DMA_Unit::Word)
+{
+	this->reg_TxCTL = TxCTL[static_cast<int> (timer)];
+	this->reg_TxCCTLn = MSP430_Timer::CaptureControlOf(this->reg_TxCTL, wrChannel);
+	this->reg_TxCCRn = this->reg_TxCTL + MSP430_Timer::OffsetCCR + wrChannel;
+	this->byteRate = byteRate;
+}
+
+/// <summary>Delete this DMA writer instance, stop it and release the DMA channels and the timer</summary>
+MSP430_ParallelBus_DMA::~MSP430_ParallelBus_DMA()
+{
+	Deinitialize();
+}
+
+/// <summary>Initialize the DMA channels and the byte clock (halted)</summary>
+void MSP430_ParallelBus_DMA::Initialize(void)
+{
+	this->data.Initialize();
+	this->data.SetDestination(this->bus.reg_DataOUT.Address());
+	this->finish.Initialize();
+	this->finish.SetSource(&this->finishControl);
+	this->finish.SetDestination(this->reg_TxCCTLn.Address());
+	this->finish.SetSize(1);
+
+	// Byte clock on SMCLK: the smallest input divider that fits the period into 16 bits, WR rises in the middle
+	this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+	unsigned long period = MSP430_Timer::SetPeriodOnSMCLK(this->reg_TxCTL, this->byteRate);
+	this->reg_TxCCRn.Write(static_cast<unsigned int> (period / 2));
+	this->reg_TxCCTLn.Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output) | MSP430_Timer_CaptureControl::Output::On);
+}
+
+/// <summary>Stop writing, reset the DMA channels and the timer</summary>
+void MSP430_ParallelBus_DMA::Deinitialize(void)
+{
+	Finish();
+	this->data.Deinitialize();
+	this->finish.Deinitialize();
+	this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+	MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0).Reset();
+	this->reg_TxCCTLn.Reset();
+}
+
+/// <summary>
+/// Start writing a buffer of data bytes (returns at once, the buffer must stay valid until IsBusy() is false)
+/// <para>Falls back to MSP430_ParallelBus::Write() when the data bank does not cover the whole port.</para>
+/// </summary>
+/// <param name="data">Data bytes</param>
+/// <param name="length">Number of bytes</param>
+void MSP430_ParallelBus_DMA::Write(const unsigned char* data, unsigned int length)
+{
+	if (this->bus.dataMask != 0xFF || length == 0)
+	{
+		this->bus.Write(data, length);
+		return;
+	}
+
+	// WR HIGH(1) from the timer output before the pin is handed over
+	this->reg_TxCCTLn.Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output) | MSP430_Timer_CaptureControl::Output::On);
+	this->bus.reg_WRSEL.Set(this->bus.wrMask);
+
+	this->data.SetSource(data);
+	this->data.SetSize(length);
+	this->data.ClearInterruptFlag();
+	this->data.Enable();
+	this->finish.ClearInterruptFlag();
+	this->finish.Enable();
+
+	// Set/Reset: WR falls at CCR0 (with the DMA byte), rises at CCRn; the output keeps its level until the next match
+	// (the byte clock counts SMCLK, the low-power waits keep it running)
+	this->smclk.Take();
+	this->reg_TxCCTLn.Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::SetReset));
+	MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0).Reset();
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Up) | MSP430_Timer_Control::Clear::On);
+}
+
+/// <summary>Check if the last byte is not latched yet</summary>
+bool MSP430_ParallelBus_DMA::IsBusy(void)
+{
+	return this->finish.IsEnabled();
+}
+
+/// <summary>Wait for the last byte, then Finish()</summary>
+void MSP430_ParallelBus_DMA::Wait(void)
+{
+	while (IsBusy())
+	{
+	}
+	Finish();
+}
+
+/// <summary>Stop the byte clock and give WR back to the bus (Call it when IsBusy() is false, before the next bus operation)</summary>
+void MSP430_ParallelBus_DMA::Finish(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Stop));
+	this->data.Disable();
+	this->finish.Disable();
+	this->smclk.Release();
+
+	// The GPIO output of WR is HIGH(1) like the timer output, no edge when the pin is given back
+	this->bus.reg_WRSEL.Clear(this->bus.wrMask);
+	this->reg_TxCCTLn.Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output) | MSP430_Timer_CaptureControl::Output::On);
+}
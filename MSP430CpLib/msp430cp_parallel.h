@@ -0,0 +1,196 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_timer.h"
+#include "msp430cp_dma.h"
+
+// Parallel bus master (8080-style LCD interface)
+// The data lines are an output bank, WR/DC (and optionally CS/RD) are single pins. A write puts the byte on the data
+// port and pulses WR LOW(0) with two XOR.B on PxOUT, the display latches the byte on the rising edge. The register
+// pointers and masks are loaded into locals once per call, so a burst costs one MOV.B and two XOR.B per byte.
+//
+//     MSP430_GPIO_Bank data(MSP430_GPIO_Port::P6, MSP430_GPIO_Direction::Output);
+//     MSP430_GPIO wr(MSP430_GPIO_Port::P1, 2), dc(MSP430_GPIO_Port::P1, 3), cs(MSP430_GPIO_Port::P1, 4);
+//     MSP430_ParallelBus lcd(data, wr, dc, &cs, nullptr);
+//
+//     lcd.Initialize();
+//     lcd.Select();
+//     lcd.WriteCommand(0x2C);                                    // memory write
+//     lcd.Fill16(0xF800, 320UL * 240);                           // red screen, the data port is written once
+//     lcd.Deselect();
+//
+// With MSP430_ParallelBus_DMA a DMA channel writes the bytes at the CCR0 rate of a timer and the WR strobe is that
+// timer's channel output (WR must be a TAx.y/TBx.y pin), so a frame is sent without CPU.
+
+/// <summary>
+/// MSP430 parallel bus master class (8080 interface, 8 data bits)
+/// <para>Idle levels: WR, RD and CS HIGH(1), DC HIGH(1) (data). DC is LOW(0) only during WriteCommand().</para>
+/// <para>NOTE: The fast path needs a data bank covering the whole port (access mask 0xFF). With a smaller mask the
+/// other pins of the data port are sampled once per call and must not be changed meanwhile.</para>
+/// </summary>
+class MSP430_ParallelBus
+{
+	friend class MSP430_ParallelBus_DMA;
+
+private:
+	// Register for hardware operation
+	MSP430_Register8 reg_DataIN;
+	MSP430_Register8 reg_DataOUT;
+	MSP430_Register8 reg_DataDIR;
+	MSP430_Register8 reg_WROUT;
+	MSP430_Register8 reg_WRDIR;
+	MSP430_Register8 reg_WRSEL;
+	MSP430_Register8 reg_DCOUT;
+	MSP430_Register8 reg_DCDIR;
+	/// <summary>CS output register (a dummy byte without CS)</summary>
+	MSP430_Register8 reg_CSOUT;
+	MSP430_Register8 reg_CSDIR;
+	/// <summary>RD output register (a dummy byte without RD)</summary>
+	MSP430_Register8 reg_RDOUT;
+	MSP430_Register8 reg_RDDIR;
+
+	// Corresponding bus location
+	/// <summary>Data pins (data bank access mask)</summary>
+	unsigned char dataMask;
+	unsigned char wrMask;
+	unsigned char dcMask;
+	/// <summary>CS pin (0 without CS)</summary>
+	unsigned char csMask = 0;
+	/// <summary>RD pin (0 without RD)</summary>
+	unsigned char rdMask = 0;
+
+	// Private low-level functions
+	/// <summary>Write a buffer through a data bank smaller than the port</summary>
+	void WriteMasked(const unsigned char* data, unsigned int length);
+
+public:
+	/// <summary>MCLK cycles from RD LOW(0) to the data read (display read access time)</summary>
+	static constexpr unsigned int ReadCycles = 8;
+
+	// Constructor
+	/// <summary>Create a new parallel bus object on a data bank and the strobe pins (No hardware operation)</summary>
+	/// <param name="data">Data bank (output)</param>
+	/// <param name="wr">Write strobe pin</param>
+	/// <param name="dc">Data/command select pin (D/CX, RS)</param>
+	/// <param name="cs">Chip select pin (nullptr when CS is tied LOW)</param>
+	/// <param name="rd">Read strobe pin (nullptr when RD is tied HIGH, Read() returns 0)</param>
+	MSP430_ParallelBus(MSP430_GPIO_Bank& data, MSP430_GPIO& wr, MSP430_GPIO& dc, MSP430_GPIO* cs, MSP430_GPIO* rd);
+	/// <summary>Delete this parallel bus instance and release the data port</summary>
+	~MSP430_ParallelBus();
+
+	// Bus initialize
+	/// <summary>Set the strobes to their idle levels and drive the data port</summary>
+	void Initialize(void);
+	/// <summary>Deselect the device and release the data port (inputs)</summary>
+	void Deinitialize(void);
+
+	// Bus control
+	/// <summary>Select the device (CS LOW(0))</summary>
+	void Select(void);
+	/// <summary>Deselect the device (CS HIGH(1))</summary>
+	void Deselect(void);
+
+	// Write
+	/// <summary>Write a command byte (DC LOW(0) during the strobe)</summary>
+	/// <param name="command">Command byte</param>
+	void WriteCommand(unsigned char command);
+	/// <summary>Write a data byte</summary>
+	/// <param name="value">Data byte</param>
+	void Write(unsigned char value);
+	/// <summary>Write a buffer of data bytes (burst)</summary>
+	/// <param name="data">Data bytes</param>
+	/// <param name="length">Number of bytes</param>
+	void Write(const unsigned char* data, unsigned int length);
+	/// <summary>Write 16-bit words high byte first (e.g. RGB565 pixels)</summary>
+	/// <param name="data">Words</param>
+	/// <param name="count">Number of words</param>
+	void Write16(const unsigned int* data, unsigned int count);
+	/// <summary>Write the same data byte a number of times (the data port is written once, then only WR toggles)</summary>
+	/// <param name="value">Data byte</param>
+	/// <param name="count">Number of bytes</param>
+	void Fill(unsigned char value, unsigned long count);
+	/// <summary>Write the same 16-bit word a number of times, high byte first (Fill() when both bytes are equal)</summary>
+	/// <param name="value">Word (e.g. an RGB565 pixel)</param>
+	/// <param name="count">Number of words</param>
+	void Fill16(unsigned int value, unsigned long count);
+
+	// Read
+	/// <summary>Read a data byte (the data port is an input during the RD strobe)</summary>
+	unsigned char Read(void);
+	/// <summary>Read a buffer of data bytes</summary>
+	/// <param name="data">Data bytes</param>
+	/// <param name="length">Number of bytes</param>
+	void Read(unsigned char* data, unsigned int length);
+};
+
+/// <summary>
+/// MSP430 DMA-paced parallel bus writer
+/// <para>A DMA channel writes one byte to the data port at each CCR0 match of a timer in Up mode. The timer channel
+/// output drives WR in Set/Reset mode: LOW(0) at CCR0 (with the new byte), HIGH(1) at CCRn (the display latches).
+/// The next DMA channel (triggered by the end of the first one) writes the channel control register to hold WR HIGH(1),
+/// which latches the last byte and stops the strobes.</para>
+/// <para>NOTE: WR must be the timer channel's output pin and the data bank must cover the whole port.
+/// Uses DMA channels n and n + 1 (mod DMA_CHANNEL_COUNT), the timer clock is SMCLK.</para>
+/// </summary>
+class MSP430_ParallelBus_DMA
+{
+private:
+	/// <summary>Bus (data port and WR pin)</summary>
+	MSP430_ParallelBus& bus;
+	/// <summary>DMA channel: buffer to the data port at each CCR0 match</summary>
+	MSP430_DMA data;
+	/// <summary>DMA channel: WR held HIGH(1) when the data channel is finished</summary>
+	MSP430_DMA finish;
+
+	// Register for hardware operation
+	/// <summary>Timer control register (TxCTL)</summary>
+	MSP430_FieldRegister<MSP430_Timer_Control> reg_TxCTL;
+	/// <summary>WR channel control register (TxCCTLn)</summary>
+	MSP430_FieldRegister<MSP430_Timer_CaptureControl> reg_TxCCTLn;
+	/// <summary>WR channel compare register (TxCCRn)</summary>
+	MSP430_Register16 reg_TxCCRn;
+
+	/// <summary>Bytes per second</summary>
+	unsigned long byteRate;
+	/// <summary>TxCCTLn value written by the finish channel (output mode 0, OUT HIGH(1))</summary>
+	unsigned int finishControl = OUTMOD_0 | OUT;
+	/// <summary>SMCLK hold of the byte clock from Write() to Finish()</summary>
+	MSP430_Clock_SMCLKHold smclk;
+
+public:
+	// Constructor
+	/// <summary>Create a new DMA writer on a bus, two DMA channels and a timer channel (No hardware operation)</summary>
+	/// <param name="bus">Parallel bus (WR on the timer channel's output pin)</param>
+	/// <param name="channel">Data DMA channel (the next channel finishes the transfer)</param>
+	/// <param name="timer">Timer of the byte clock (Up mode, CCR0 triggers the DMA)</param>
+	/// <param name="wrChannel">Capture/compare channel whose output is WR (1 to 6)</param>
+	/// <param name="byteRate">Bytes per second</param>
+	MSP430_ParallelBus_DMA(MSP430_ParallelBus& bus, MSP430_DMA_Channel channel, MSP430_Timer_Instance timer, MSP430_Timer_Channel wrChannel, unsigned long byteRate);
+	/// <summary>Delete this DMA writer instance, stop it and release the DMA channels and the timer</summary>
+	~MSP430_ParallelBus_DMA();
+
+	// Writer initialize
+	/// <summary>Initialize the DMA channels and the byte clock (halted)</summary>
+	void Initialize(void);
+	/// <summary>Stop writing, reset the DMA channels and the timer</summary>
+	void Deinitialize(void);
+
+	// Write
+	/// <summary>
+	/// Start writing a buffer of data bytes (returns at once, the buffer must stay valid until IsBusy() is false)
+	/// <para>Falls back to MSP430_ParallelBus::Write() when the data bank does not cover the whole port.</para>
+	/// </summary>
+	/// <param name="data">Data bytes</param>
+	/// <param name="length">Number of bytes</param>
+	void Write(const unsigned char* data, unsigned int length);
+	/// <summary>Check if the last byte is not latched yet</summary>
+	bool IsBusy(void);
+	/// <summary>Wait for the last byte, then Finish()</summary>
+	void Wait(void);
+	/// <summary>Stop the byte clock and give WR back to the bus (Call it when IsBusy() is false, before the next bus operation)</summary>
+	void Finish(void);
+};
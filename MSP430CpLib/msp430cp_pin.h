@@ -0,0 +1,300 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_trace.h"
+
+// Compile-time GPIO port register map
+/// <summary>
+/// GPIO port register map resolved at compile time
+/// <para>Each specialization returns handles of the port registers built from constant addresses, so the compiler can use
+/// absolute addressing instead of loading a register pointer from RAM.</para>
+/// </summary>
+template <MSP430_GPIO_Port port>
+struct MSP430_GPIO_PortRegisters;
+
+/// <summary>
+/// GPIO port interrupt register map resolved at compile time (Only P1/P2 port have interrupt capability)
+/// </summary>
+template <MSP430_GPIO_Port port>
+struct MSP430_GPIO_PortInterruptRegisters;
+
+#ifdef GPIO_PORT_HAS_FUNSEL2
+#define MSP430CP_PORT_REGISTERS_FUNSEL2(N) static MSP430_Register8 PxSEL2(void) { return &P##N##SEL2; }
+#else
+#define MSP430CP_PORT_REGISTERS_FUNSEL2(N)
+#endif
+#ifdef GPIO_PORT_HAS_DS
+#define MSP430CP_PORT_REGISTERS_DS(N) static MSP430_Register8 PxDS(void) { return &P##N##DS; }
+#else
+#define MSP430CP_PORT_REGISTERS_DS(N)
+#endif
+
+/// <summary>Define the compile-time register map of GPIO port N</summary>
+#define MSP430CP_PORT_REGISTERS(N) \
+	template <> \
+	struct MSP430_GPIO_PortRegisters<MSP430_GPIO_Port::P##N> \
+	{ \
+		static MSP430_Register8 PxIN(void) { return &P##N##IN; } \
+		static MSP430_Register8 PxOUT(void) { return &P##N##OUT; } \
+		static MSP430_Register8 PxDIR(void) { return &P##N##DIR; } \
+		static MSP430_Register8 PxREN(void) { return &P##N##REN; } \
+		static MSP430_Register8 PxSEL(void) { return &P##N##SEL; } \
+		MSP430CP_PORT_REGISTERS_FUNSEL2(N) \
+		MSP430CP_PORT_REGISTERS_DS(N) \
+	};
+
+/// <summary>Define the compile-time interrupt register map of GPIO port N</summary>
+#define MSP430CP_PORT_INTERRUPT_REGISTERS(N) \
+	template <> \
+	struct MSP430_GPIO_PortInterruptRegisters<MSP430_GPIO_Port::P##N> \
+	{ \
+		static MSP430_Register8 PxIE(void) { return &P##N##IE; } \
+		static MSP430_Register8 PxIFG(void) { return &P##N##IFG; } \
+		static MSP430_Register8 PxIES(void) { return &P##N##IES; } \
+	};
+
+// Only the ports of the device are defined, an absent port fails at compile time (incomplete type)
+MSP430CP_PORT_REGISTERS(1)
+#if GPIO_PORT_COUNT >= 2
+MSP430CP_PORT_REGISTERS(2)
+#endif
+#if GPIO_PORT_COUNT >= 3
+MSP430CP_PORT_REGISTERS(3)
+#endif
+#if GPIO_PORT_COUNT >= 4
+MSP430CP_PORT_REGISTERS(4)
+#endif
+#if GPIO_PORT_COUNT >= 5
+MSP430CP_PORT_REGISTERS(5)
+#endif
+#if GPIO_PORT_COUNT >= 6
+MSP430CP_PORT_REGISTERS(6)
+#endif
+#if GPIO_PORT_COUNT >= 7
+MSP430CP_PORT_REGISTERS(7)
+#endif
+#if GPIO_PORT_COUNT >= 8
+MSP430CP_PORT_REGISTERS(8)
+#endif
+
+MSP430CP_PORT_INTERRUPT_REGISTERS(1)
+#if GPIO_PORT_SUPPORT_INT_COUNT >= 2
+MSP430CP_PORT_INTERRUPT_REGISTERS(2)
+#endif
+
+/// <summary>
+/// MSP430 GPIO(General purpose I/O) pin class resolved at compile time
+/// <para>The port, pin and configuration are template parameters, so the instance holds no register pointers
+/// and every operation compiles to a single BIS.B/BIC.B/XOR.B/BIT.B on an absolute register address.</para>
+/// <para>The methods are the same as MSP430_GPIO, existing code can switch over by changing the declaration only.</para>
+/// <para>NOTE: The configuration is not stored in RAM. GetDirection() reads the PxDIR register directly.</para>
+/// </summary>
+/// <typeparam name="port">GPIO port</typeparam>
+/// <typeparam name="pin">GPIO pin</typeparam>
+/// <typeparam name="initFunction">GPIO function used by Initialize()</typeparam>
+/// <typeparam name="initDirection">GPIO direction used by Initialize()</typeparam>
+/// <typeparam name="initPullResistor">GPIO pullup/pulldown resistor used by Initialize()</typeparam>
+template <MSP430_GPIO_Port port, MSP430_GPIO_Pin pin,
+	MSP430_GPIO_Function initFunction = MSP430_GPIO_Function::Stardand,
+	MSP430_GPIO_Direction initDirection = MSP430_GPIO_Direction::Output,
+	MSP430_GPIO_PullResistor initPullResistor = MSP430_GPIO_PullResistor::Off>
+class MSP430_Pin
+{
+	static_assert(pin < 8, "Each port has up to 8 GPIO pins");
+	static_assert(MSP430_Device::HasPort(static_cast<unsigned char> (port)), "The device does not have this port");
+
+private:
+	// Register for hardware operation
+	typedef MSP430_GPIO_PortRegisters<port> Registers;
+	typedef MSP430_GPIO_PortInterruptRegisters<port> InterruptRegisters;
+
+	/// <summary>Check the port has interrupt capability (Only P1/P2 port)</summary>
+	static constexpr bool HasInterrupt(void)
+	{
+		return MSP430_Device::HasPortInterrupt(static_cast<unsigned char> (port));
+	}
+
+public:
+	// Location and bit mask
+	/// <summary>Port</summary>
+	static constexpr MSP430_GPIO_Port Port = port;
+	/// <summary>Pin Id</summary>
+	static constexpr MSP430_GPIO_Pin Pin = pin;
+	/// <summary>Bit mask of the pin in the port registers</summary>
+	static constexpr unsigned char Mask = static_cast<unsigned char> (1 << pin);
+
+	// Constructor
+	/// <summary>Create a new compile-time GPIO object (No hardware operation)</summary>
+	MSP430_Pin() = default;
+	/// <summary>Delete this GPIO instance and reset the hardware registers</summary>
+	~MSP430_Pin()
+	{
+		Deinitialize();
+	}
+
+	// Interrupt control (Separate control)
+	/// <summary>Enable the corresponding pin's interrupt and set its trig edge</summary>
+	/// <param name="interruptTrig">Trig edge for interrupt</param>
+	static void EnableInterrupt(MSP430_GPIO_InterruptTrig interruptTrig)
+	{
+		static_assert(HasInterrupt(), "Only P1/P2 port have interrupt capability");
+
+		InterruptRegisters::PxIES().Assign(Mask, interruptTrig == MSP430_GPIO_InterruptTrig::Negedge);
+		InterruptRegisters::PxIE().Set(Mask);
+	}
+	/// <summary>Disable the corresponding pin's interrupt</summary>
+	static void DisableInterrupt(void)
+	{
+		static_assert(HasInterrupt(), "Only P1/P2 port have interrupt capability");
+
+		InterruptRegisters::PxIE().Clear(Mask);
+	}
+	/// <summary>Check if the interrupt flag on corresponding pin was setted</summary>
+	static bool CheckInterruptFlag(void)
+	{
+		static_assert(HasInterrupt(), "Only P1/P2 port have interrupt capability");
+
+		return InterruptRegisters::PxIFG().Test(Mask);
+	}
+	/// <summary>Clear the interrupt flag then interrupt can be re-detected</summary>
+	static void ClearInterruptFlag(void)
+	{
+		static_assert(HasInterrupt(), "Only P1/P2 port have interrupt capability");
+
+		InterruptRegisters::PxIFG().Clear(Mask);
+	}
+
+	// GPIO initialize or re-configuration
+	/// <summary>Initialize a hardware GPIO by the template configuration</summary>
+	static void Initialize(void)
+	{
+		SetDirection(initDirection);
+		SetPullResistor(initPullResistor);
+		SetFunction(initFunction);
+	}
+	/// <summary>
+	/// Deinitialize the corresponding hardware GPIO and set all registers to default.
+	/// <para>(Default: Input, Standard Function, Resistor Off)</para>
+	/// </summary>
+	static void Deinitialize(void)
+	{
+		SetDirection(MSP430_GPIO_Direction::Input);
+		SetPullResistor(MSP430_GPIO_PullResistor::Off);
+		SetFunction(MSP430_GPIO_Function::Stardand);
+	}
+
+	// Stardand GPIO operation
+	/// <summary>Set the corresponding GPIO pin output to HIGH(1) (Only effect when using standard function)</summary>
+	static void SetHigh(void)
+	{
+		Registers::PxOUT().Set(Mask);
+		MSP430_TRACE(MSP430_Trace_Id::GPIOWrite, MSP430_Trace::PinOf(static_cast<unsigned int> (port), pin, true));
+	}
+	/// <summary>Set the corresponding GPIO pin output to LOW(0) (Only effect when using standard function)</summary>
+	static void SetLow(void)
+	{
+		Registers::PxOUT().Clear(Mask);
+		MSP430_TRACE(MSP430_Trace_Id::GPIOWrite, MSP430_Trace::PinOf(static_cast<unsigned int> (port), pin, false));
+	}
+	/// <summary>Set the corresponding GPIO pin output by a setting value (Only effect when using standard function)</summary>
+	/// <param name="value">GPIO pin output value</param>
+	static void SetValue(MSP430_GPIO_Value value)
+	{
+		if (value)
+		{
+			SetHigh();
+		}
+		else
+		{
+			SetLow();
+		}
+	}
+	/// <summary>Get the corresponding GPIO pin input</summary>
+	/// <return>GPIO pin input value</return>
+	static MSP430_GPIO_Value GetValue(void)
+	{
+		return Registers::PxIN().Test(Mask) ? 1 : 0;
+	}
+	/// <summary>Check if the corresponding GPIO pin input is HIGH(1)</summary>
+	static bool CheckHigh(void)
+	{
+		return Registers::PxIN().Test(Mask);
+	}
+	/// <summary>Check if the corresponding GPIO pin input is LOW(0)</summary>
+	static bool CheckLow(void)
+	{
+		return !Registers::PxIN().Test(Mask);
+	}
+
+	// Dymanic GPIO operation
+	/// <summary>
+	/// Dymanically reverse the corresponding pin's output value
+	/// <para>NOTE: This function toggles PxOUT directly (XOR.B), it does not read the pin input.</para>
+	/// <para>NOTE: This function is only effect when using standard function.</para>
+	/// </summary>
+	static void ReverseValue(void)
+	{
+		Registers::PxOUT().Toggle(Mask);
+		MSP430_TRACE(MSP430_Trace_Id::GPIOToggle, MSP430_Trace::PinOf(static_cast<unsigned int> (port), pin));
+	}
+	/// <summary>Reverse the corresponding GPIO's direction
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	static void ReverseDirection(void)
+	{
+		Registers::PxDIR().Toggle(Mask);
+	}
+	/// <summary>
+	/// Dymanically set the corresponding pin's direction
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="direction">Setting direction</param>
+	static void SetDirection(MSP430_GPIO_Direction direction)
+	{
+		Registers::PxDIR().Assign(Mask, direction == MSP430_GPIO_Direction::Output);
+	}
+	/// <summary>
+	/// Get the corresponding pin's direction
+	/// <para>NOTE: This function will read the register directly.</para>
+	/// </summary>
+	static MSP430_GPIO_Direction GetDirection(void)
+	{
+		return Registers::PxDIR().Test(Mask) ? MSP430_GPIO_Direction::Output : MSP430_GPIO_Direction::Input;
+	}
+	/// <summary>
+	/// Dymanically set the corresponding pin's function
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="function">Setting function</param>
+	static void SetFunction(MSP430_GPIO_Function function)
+	{
+		unsigned char func = static_cast<unsigned char> (function);
+		Registers::PxSEL().Assign(Mask, (func & 0x01) != 0);
+#ifdef GPIO_PORT_HAS_FUNSEL2
+		Registers::PxSEL2().Assign(Mask, (func & 0x02) != 0);
+#endif
+	}
+	/// <summary>
+	/// Dymanically set the corresponding pin's pullup/pulldown resistor
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="sw">Switch of the pullup/pulldown resistor</param>
+	static void SetPullResistor(MSP430_GPIO_PullResistor sw)
+	{
+		Registers::PxREN().Assign(Mask, sw == MSP430_GPIO_PullResistor::On);
+	}
+#ifdef GPIO_PORT_HAS_DS
+	/// <summary>
+	/// Dymanically set the corresponding pin's drive strength
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="strength">Drive strength</param>
+	static void SetDriveStrength(MSP430_GPIO_DriveStrength strength)
+	{
+		Registers::PxDS().Assign(Mask, strength == MSP430_GPIO_DriveStrength::Full);
+	}
+#endif
+};
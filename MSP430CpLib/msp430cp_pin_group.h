@@ -0,0 +1,404 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_pin.h"
+
+// Compile-time GPIO pin groups
+// Any set of compile-time pins, spread over any ports, driven as one value: bit i of the value is the i-th pin of
+// the group. The pins are grouped by port at compile time, and the pins of a port whose value bits are at the same
+// distance from their port bits are moved together by one shift. An operation is one register access per port
+// (BIS.B/BIC.B/XOR.B for Set/Clear/Toggle, one masked write for Write), no loop over the pins.
+//
+//     using namespace MSP430_Pins;
+//     typedef MSP430_PinGroup<P1_0, P1_5, P2_3, P4_7> Bus;
+//
+//     Bus::Initialize(MSP430_GPIO_Direction::Output);
+//     Bus::Write(0b1010);                          // P1.5 and P4.7 HIGH(1), P1.0 and P2.3 LOW(0)
+//     unsigned int state = Bus::Read();            // bit 0 is P1.0, bit 1 P1.5, bit 2 P2.3, bit 3 P4.7
+//
+// NOTE: Write() reads and writes PxOUT of each port in turn (not atomic against interrupts writing the same port),
+// Set/Clear/Toggle are single instructions per port.
+
+/// <summary>Pin aliases (Px_y is pin y of port x as MSP430_Pin), take them in with "using namespace MSP430_Pins"</summary>
+namespace MSP430_Pins
+{
+/// <summary>Define the pin aliases of GPIO port N</summary>
+#define MSP430CP_PIN_ALIASES(N) \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 0> P##N##_0; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 1> P##N##_1; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 2> P##N##_2; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 3> P##N##_3; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 4> P##N##_4; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 5> P##N##_5; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 6> P##N##_6; \
+	typedef MSP430_Pin<MSP430_GPIO_Port::P##N, 7> P##N##_7;
+
+	MSP430CP_PIN_ALIASES(1)
+#if GPIO_PORT_COUNT >= 2
+	MSP430CP_PIN_ALIASES(2)
+#endif
+#if GPIO_PORT_COUNT >= 3
+	MSP430CP_PIN_ALIASES(3)
+#endif
+#if GPIO_PORT_COUNT >= 4
+	MSP430CP_PIN_ALIASES(4)
+#endif
+#if GPIO_PORT_COUNT >= 5
+	MSP430CP_PIN_ALIASES(5)
+#endif
+#if GPIO_PORT_COUNT >= 6
+	MSP430CP_PIN_ALIASES(6)
+#endif
+#if GPIO_PORT_COUNT >= 7
+	MSP430CP_PIN_ALIASES(7)
+#endif
+#if GPIO_PORT_COUNT >= 8
+	MSP430CP_PIN_ALIASES(8)
+#endif
+}
+
+/// <summary>
+/// Pin group layout calculations (all static, compile time)
+/// <para>The distance of a pin is its port bit minus its value bit (-15 to 7): the value bits of a port at the same
+/// distance form a run that is moved into place by a single shift.</para>
+/// </summary>
+/// <typeparam name="Pins">Compile-time pins (MSP430_Pin or any type with Port and Pin)</typeparam>
+template <typename... Pins>
+struct MSP430_PinGroup_Layout
+{
+	/// <summary>Number of pins</summary>
+	static constexpr unsigned char Count = sizeof...(Pins);
+	/// <summary>Smallest distance (port bit 0, value bit 15)</summary>
+	static constexpr int MinDistance = -15;
+	/// <summary>Largest distance (port bit 7, value bit 0)</summary>
+	static constexpr int MaxDistance = 7;
+
+	/// <summary>Port of each value bit</summary>
+	static constexpr unsigned char PortOf[Count] = { static_cast<unsigned char> (Pins::Port)... };
+	/// <summary>Port bit of each value bit</summary>
+	static constexpr unsigned char PinOf[Count] = { static_cast<unsigned char> (Pins::Pin)... };
+
+	/// <summary>Bits of a port used by the group</summary>
+	/// <param name="port">Port index (0 for P1)</param>
+	static constexpr unsigned char PortMask(unsigned char port)
+	{
+		unsigned char mask = 0;
+		for (unsigned char i = 0; i < Count; i++)
+		{
+			if (PortOf[i] == port)
+			{
+				mask |= static_cast<unsigned char> (1 << PinOf[i]);
+			}
+		}
+		return mask;
+	}
+	/// <summary>Value bits of a port at a distance (one shift run)</summary>
+	/// <param name="port">Port index (0 for P1)</param>
+	/// <param name="distance">Port bit minus value bit</param>
+	static constexpr unsigned int ValueMask(unsigned char port, int distance)
+	{
+		unsigned int mask = 0;
+		for (unsigned char i = 0; i < Count; i++)
+		{
+			if (PortOf[i] == port && PinOf[i] - i == distance)
+			{
+				mask |= 1u << i;
+			}
+		}
+		return mask;
+	}
+	/// <summary>Check no pin is listed twice</summary>
+	static constexpr bool IsUnique(void)
+	{
+		for (unsigned char i = 0; i < Count; i++)
+		{
+			for (unsigned char j = i + 1; j < Count; j++)
+			{
+				if (PortOf[i] == PortOf[j] && PinOf[i] == PinOf[j])
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+	/// <summary>Check all pins are on ports of the device</summary>
+	static constexpr bool IsPresent(void)
+	{
+		for (unsigned char i = 0; i < Count; i++)
+		{
+			if (!MSP430_Device::HasPort(PortOf[i]) || PinOf[i] > 7)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/// <summary>
+/// MSP430 GPIO pin group class resolved at compile time (all static)
+/// <para>Bit i of a value is the i-th pin of the template list. Each operation touches every port of the group once:
+/// Set/Clear/Toggle are one BIS.B/BIC.B/XOR.B of the port's pin mask, Write() is one masked write of PxOUT (MOV.B when
+/// the group owns the whole port), Read() one read of PxIN per port. The value bits are scattered/gathered with one
+/// shift per run of pins at the same distance, e.g. P1.0-P1.3 as bits 0-3 is a single AND.</para>
+/// <para>NOTE: The pins must use the standard function (Initialize() selects it).</para>
+/// </summary>
+/// <typeparam name="Pins">Compile-time pins (1 to 16, MSP430_Pin or the MSP430_Pins aliases)</typeparam>
+template <typename... Pins>
+class MSP430_PinGroup
+{
+private:
+	typedef MSP430_PinGroup_Layout<Pins...> Layout;
+
+	static_assert(sizeof...(Pins) >= 1 && sizeof...(Pins) <= 16, "A pin group has 1 to 16 pins (one bit of an unsigned int each)");
+	static_assert(Layout::IsPresent(), "The device does not have a port of the group");
+	static_assert(Layout::IsUnique(), "A pin is listed twice in the group");
+
+	/// <summary>Number of port indexes scanned (P1 to P8)</summary>
+	static constexpr unsigned char PortLimit = 8;
+
+	/// <summary>Port bits of a port from a value (one shift per distance run)</summary>
+	template <unsigned char port, int distance = Layout::MinDistance>
+	__attribute__((always_inline)) static unsigned char Scatter(unsigned int value)
+	{
+		constexpr unsigned int mask = Layout::ValueMask(port, distance);
+		unsigned char bits = 0;
+		if constexpr (mask != 0 && distance >= 0)
+		{
+			bits = static_cast<unsigned char> ((value & mask) << distance);
+		}
+		else if constexpr (mask != 0)
+		{
+			bits = static_cast<unsigned char> ((value & mask) >> -distance);
+		}
+		if constexpr (distance < Layout::MaxDistance)
+		{
+			bits |= Scatter<port, distance + 1>(value);
+		}
+		return bits;
+	}
+	/// <summary>Value bits from the port bits of a port (one shift per distance run)</summary>
+	template <unsigned char port, int distance = Layout::MinDistance>
+	__attribute__((always_inline)) static unsigned int Gather(unsigned char bits)
+	{
+		constexpr unsigned int mask = Layout::ValueMask(port, distance);
+		unsigned int value = 0;
+		if constexpr (mask != 0 && distance >= 0)
+		{
+			value = static_cast<unsigned int> (bits & static_cast<unsigned char> (mask << distance)) >> distance;
+		}
+		else if constexpr (mask != 0)
+		{
+			value = static_cast<unsigned int> (bits & static_cast<unsigned char> (mask >> -distance)) << -distance;
+		}
+		if constexpr (distance < Layout::MaxDistance)
+		{
+			value |= Gather<port, distance + 1>(bits);
+		}
+		return value;
+	}
+
+	/// <summary>Apply an operation to one register of each port of the group</summary>
+	/// <typeparam name="Registers">Port register selector (Of&lt;port&gt;() returns the register)</typeparam>
+	/// <typeparam name="Operation">Register operation (Apply(reg, portMask, portBits))</typeparam>
+	/// <param name="value">Group value (scattered into the port bits)</param>
+	template <typename Registers, typename Operation, unsigned char port = 0>
+	__attribute__((always_inline)) static void ForEachPort(unsigned int value)
+	{
+		if constexpr (port < PortLimit)
+		{
+			constexpr unsigned char mask = Layout::PortMask(port);
+			if constexpr (mask != 0)
+			{
+				Operation::Apply(Registers::template Of<port>(), mask, Scatter<port>(value));
+			}
+			ForEachPort<Registers, Operation, port + 1>(value);
+		}
+	}
+	/// <summary>Gather the group value from the PxIN of each port</summary>
+	template <unsigned char port = 0>
+	__attribute__((always_inline)) static unsigned int ReadFrom(void)
+	{
+		if constexpr (port < PortLimit)
+		{
+			unsigned int value = 0;
+			if constexpr (Layout::PortMask(port) != 0)
+			{
+				value = Gather<port>(MSP430_GPIO_PortRegisters<static_cast<MSP430_GPIO_Port> (port)>::PxIN().Read());
+			}
+			return value | ReadFrom<port + 1>();
+		}
+		else
+		{
+			return 0;
+		}
+	}
+
+	// Register operations of a port (static and always inline, so the masks stay constants)
+	/// <summary>Set the group bits (BIS.B)</summary>
+	struct SetOperation
+	{
+		__attribute__((always_inline)) static void Apply(MSP430_Register8 reg, unsigned char mask, unsigned char)
+		{
+			reg.Set(mask);
+		}
+	};
+	/// <summary>Clear the group bits (BIC.B)</summary>
+	struct ClearOperation
+	{
+		__attribute__((always_inline)) static void Apply(MSP430_Register8 reg, unsigned char mask, unsigned char)
+		{
+			reg.Clear(mask);
+		}
+	};
+	/// <summary>Toggle the group bits (XOR.B)</summary>
+	struct ToggleOperation
+	{
+		__attribute__((always_inline)) static void Apply(MSP430_Register8 reg, unsigned char mask, unsigned char)
+		{
+			reg.Toggle(mask);
+		}
+	};
+	/// <summary>Write the group bits (masked write, MOV.B for a whole port)</summary>
+	struct WriteOperation
+	{
+		__attribute__((always_inline)) static void Apply(MSP430_Register8 reg, unsigned char mask, unsigned char bits)
+		{
+			reg.Modify(bits, mask);
+		}
+	};
+
+	// Port register selectors
+	/// <summary>PxOUT of a port</summary>
+	struct OUTRegister
+	{
+		template <unsigned char port>
+		static MSP430_Register8 Of(void)
+		{
+			return MSP430_GPIO_PortRegisters<static_cast<MSP430_GPIO_Port> (port)>::PxOUT();
+		}
+	};
+	/// <summary>PxDIR of a port</summary>
+	struct DIRRegister
+	{
+		template <unsigned char port>
+		static MSP430_Register8 Of(void)
+		{
+			return MSP430_GPIO_PortRegisters<static_cast<MSP430_GPIO_Port> (port)>::PxDIR();
+		}
+	};
+	/// <summary>PxREN of a port</summary>
+	struct RENRegister
+	{
+		template <unsigned char port>
+		static MSP430_Register8 Of(void)
+		{
+			return MSP430_GPIO_PortRegisters<static_cast<MSP430_GPIO_Port> (port)>::PxREN();
+		}
+	};
+	/// <summary>PxSEL of a port</summary>
+	struct SELRegister
+	{
+		template <unsigned char port>
+		static MSP430_Register8 Of(void)
+		{
+			return MSP430_GPIO_PortRegisters<static_cast<MSP430_GPIO_Port> (port)>::PxSEL();
+		}
+	};
+#ifdef GPIO_PORT_HAS_FUNSEL2
+	/// <summary>PxSEL2 of a port</summary>
+	struct SEL2Register
+	{
+		template <unsigned char port>
+		static MSP430_Register8 Of(void)
+		{
+			return MSP430_GPIO_PortRegisters<static_cast<MSP430_GPIO_Port> (port)>::PxSEL2();
+		}
+	};
+#endif
+
+public:
+	/// <summary>Number of pins</summary>
+	static constexpr unsigned char Count = sizeof...(Pins);
+	/// <summary>All value bits of the group</summary>
+	static constexpr unsigned int Mask = (Count == 16) ? 0xFFFFu : ((1u << Count) - 1);
+
+	// Group initialize or re-configuration
+	/// <summary>Select the standard function, the pullup/pulldown resistor and the direction of all pins</summary>
+	/// <param name="direction">Direction</param>
+	/// <param name="pullResistor">Pullup/pulldown resistor (input pins, PxOUT selects pullup or pulldown)</param>
+	static void Initialize(MSP430_GPIO_Direction direction, MSP430_GPIO_PullResistor pullResistor = MSP430_GPIO_PullResistor::Off)
+	{
+		ForEachPort<SELRegister, ClearOperation>(0);
+#ifdef GPIO_PORT_HAS_FUNSEL2
+		ForEachPort<SEL2Register, ClearOperation>(0);
+#endif
+		SetPullResistor(pullResistor);
+		SetDirection(direction);
+	}
+	/// <summary>
+	/// Set the direction of all pins
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="direction">Setting direction</param>
+	static void SetDirection(MSP430_GPIO_Direction direction)
+	{
+		if (direction == MSP430_GPIO_Direction::Output)
+		{
+			ForEachPort<DIRRegister, SetOperation>(0);
+		}
+		else
+		{
+			ForEachPort<DIRRegister, ClearOperation>(0);
+		}
+	}
+	/// <summary>
+	/// Set the pullup/pulldown resistor of all pins
+	/// <para>NOTE: This function will effect on register directly.</para>
+	/// </summary>
+	/// <param name="sw">Switch of the pullup/pulldown resistor</param>
+	static void SetPullResistor(MSP430_GPIO_PullResistor sw)
+	{
+		if (sw == MSP430_GPIO_PullResistor::On)
+		{
+			ForEachPort<RENRegister, SetOperation>(0);
+		}
+		else
+		{
+			ForEachPort<RENRegister, ClearOperation>(0);
+		}
+	}
+
+	// Group operation
+	/// <summary>Set all pins HIGH(1) (one BIS.B per port)</summary>
+	static void Set(void)
+	{
+		ForEachPort<OUTRegister, SetOperation>(0);
+	}
+	/// <summary>Set all pins LOW(0) (one BIC.B per port)</summary>
+	static void Clear(void)
+	{
+		ForEachPort<OUTRegister, ClearOperation>(0);
+	}
+	/// <summary>Toggle all pins (one XOR.B per port)</summary>
+	static void Toggle(void)
+	{
+		ForEachPort<OUTRegister, ToggleOperation>(0);
+	}
+	/// <summary>Write the pins from a value (bit i to the i-th pin, one masked write of PxOUT per port)</summary>
+	/// <param name="value">Group value</param>
+	static void Write(unsigned int value)
+	{
+		ForEachPort<OUTRegister, WriteOperation>(value);
+	}
+	/// <summary>Read the pin inputs into a value (the i-th pin to bit i, one read of PxIN per port)</summary>
+	/// <return>Group value</return>
+	static unsigned int Read(void)
+	{
+		return ReadFrom();
+	}
+};
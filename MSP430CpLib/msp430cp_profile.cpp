@@ -0,0 +1,173 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_profile.h"
+
+#ifdef PROFILE_ENABLE
+#include "msp430cp_clock.h"
+#include "msp430cp_uart.h"
+
+/// <summary>Runs of the empty scope measured by Calibrate()</summary>
+static constexpr unsigned int CalibrationRuns = 16;
+
+/// <summary>Region table (zero: never run)</summary>
+MSP430_Profile_Region msp430cp_profile[PROFILE_REGION_COUNT + 1];
+
+/// <summary>Counts subtracted from each run</summary>
+static unsigned int overhead = 0;
+
+/// <summary>Account a run to a region (called by the scope after its end read)</summary>
+/// <param name="index">Region index</param>
+/// <param name="counts">Counts between the start and the end read</param>
+void MSP430_Profiler::Account(unsigned int index, unsigned int counts)
+{
+	counts = (counts > overhead) ? counts - overhead : 0;
+
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	MSP430_Profile_Region& region = msp430cp_profile[index];
+	if (counts < region.min || region.count == 0)
+	{
+		region.min = counts;
+	}
+	if (counts > region.max)
+	{
+		region.max = counts;
+	}
+	region.count++;
+	region.total += counts;
+	__bis_SR_register(gie);
+}
+
+/// <summary>Measure the overhead of an empty scope (minimum of 16 runs), it is subtracted from then on</summary>
+void MSP430_Profiler::Calibrate(void)
+{
+	overhead = 0;
+	MSP430_Profile_Region& region = msp430cp_profile[CalibrationRegion];
+	region.min = 0;
+	region.max = 0;
+	region.count = 0;
+	region.total = 0;
+
+	// The same inline start/end reads as the measured scopes, an interrupt in between only raises the maximum
+	for (unsigned int i = 0; i < CalibrationRuns; i++)
+	{
+		MSP430_PROFILE(CalibrationRegion, "(overhead)");
+	}
+	overhead = region.min;
+}
+
+/// <summary>Get the overhead subtracted from each run (counts)</summary>
+unsigned int MSP430_Profiler::GetOverhead(void)
+{
+	return overhead;
+}
+
+/// <summary>Clear the statistics of all regions (names are kept)</summary>
+void MSP430_Profiler::Reset(void)
+{
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	for (unsigned int i = 0; i < RegionCount; i++)
+	{
+		MSP430_Profile_Region& region = msp430cp_profile[i];
+		region.min = 0;
+		region.max = 0;
+		region.count = 0;
+		region.total = 0;
+	}
+	__bis_SR_register(gie);
+}
+
+/// <summary>Get the statistics of a region (copied with interrupts disabled)</summary>
+/// <param name="index">Region index (up to CalibrationRegion)</param>
+MSP430_Profile_Region MSP430_Profiler::Get(unsigned int index)
+{
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	MSP430_Profile_Region region = msp430cp_profile[index];
+	__bis_SR_register(gie);
+	return region;
+}
+
+/// <summary>Get the mean run of a region (counts, 0 if never run)</summary>
+/// <param name="index">Region index (up to CalibrationRegion)</param>
+unsigned int MSP430_Profiler::GetMean(unsigned int index)
+{
+	MSP430_Profile_Region region = Get(index);
+	return (region.count == 0) ? 0 : static_cast<unsigned int> (region.total / region.count);
+}
+
+/// <summary>Queue bytes, waiting for space in the TX buffer</summary>
+/// <param name="uart">UART</param>
+/// <param name="data">Bytes</param>
+/// <param name="length">Number of bytes</param>
+static void WriteAll(MSP430_UART& uart, const char* data, unsigned int length)
+{
+	while (length > 0)
+	{
+		unsigned int written = uart.Write(reinterpret_cast<const unsigned char*> (data), length);
+		data += written;
+		length -= written;
+	}
+}
+
+/// <summary>Queue a text</summary>
+/// <param name="uart">UART</param>
+/// <param name="text">Zero-terminated text</param>
+static void WriteText(MSP430_UART& uart, const char* text)
+{
+	unsigned int length = 0;
+	while (text[length] != '\0')
+	{
+		length++;
+	}
+	WriteAll(uart, text, length);
+}
+
+/// <summary>Queue a number in decimal after a space</summary>
+/// <param name="uart">UART</param>
+/// <param name="value">Number</param>
+static void WriteNumber(MSP430_UART& uart, unsigned long value)
+{
+	char digits[11];
+	unsigned int index = sizeof(digits);
+	do
+	{
+		digits[--index] = static_cast<char> ('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	digits[--index] = ' ';
+	WriteAll(uart, digits + index, sizeof(digits) - index);
+}
+
+/// <summary>
+/// Send the regions that ran as text lines: name, count, min, max and mean (counts)
+/// <para>NOTE: Blocks until all lines are queued, the UART interrupt must be enabled.</para>
+/// </summary>
+/// <param name="uart">Initialized UART</param>
+void MSP430_Profiler::Print(MSP430_UART& uart)
+{
+	WriteText(uart, "profile: counts at");
+	WriteNumber(uart, PROFILE_COUNTER_FREQUENCY);
+	WriteText(uart, " Hz, overhead");
+	WriteNumber(uart, overhead);
+	WriteText(uart, "\r\nregion count min max mean\r\n");
+	for (unsigned int i = 0; i <= CalibrationRegion; i++)
+	{
+		MSP430_Profile_Region region = Get(i);
+		if (region.count == 0)
+		{
+			continue;
+		}
+		WriteText(uart, region.name);
+		WriteNumber(uart, region.count);
+		WriteNumber(uart, region.min);
+		WriteNumber(uart, region.max);
+		WriteNumber(uart, region.total / region.count);
+		WriteText(uart, "\r\n");
+	}
+}
+#endif
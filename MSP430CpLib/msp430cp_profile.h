@@ -0,0 +1,129 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+
+// Scoped cycle profiler
+// An MSP430_PROFILE() scope reads PROFILE_COUNTER at its start and at its end, the difference (minus the calibrated
+// overhead of an empty scope) is accounted to its region: count, minimum, maximum and total (mean = total / count).
+// Regions are slots of a static table (msp430cp_profile, readable by the debugger) picked by a constant index,
+// so a scope costs two counter reads and a call after the second read, the same every time.
+//
+//     // msp430cp_device.h: #define PROFILE_ENABLE (TA0 continuous on SMCLK = MCLK counts cycles)
+//     MSP430_Profiler::Calibrate();
+//
+//     MSP430_GPIO_INTERRUPT_HANDLER(P1, 3)
+//     {
+//         MSP430_PROFILE(0, "P1.3 handler");
+//         led.SetValue(sensor.GetValue());
+//     }
+//     ...
+// #ifdef PROFILE_ENABLE
+//     MSP430_Profiler::Print(log);                             // name, count, min, max, mean per region
+// #endif
+//
+// Interrupts taken inside a scope are part of its time (the maximum shows them). A region must end within one
+// counter period (65536 counts). Without PROFILE_ENABLE, MSP430_PROFILE() expands to nothing.
+
+#ifdef PROFILE_ENABLE
+/// <summary>
+/// Profiled region statistics (counter counts, overhead subtracted)
+/// </summary>
+struct MSP430_Profile_Region
+{
+	/// <summary>Region name (of the last scope that ran, nullptr if never run)</summary>
+	const char* name;
+	/// <summary>Shortest run</summary>
+	unsigned int min;
+	/// <summary>Longest run</summary>
+	unsigned int max;
+	/// <summary>Number of runs</summary>
+	unsigned long count;
+	/// <summary>Sum of all runs</summary>
+	unsigned long total;
+};
+
+/// <summary>Region table, PROFILE_REGION_COUNT regions and the calibration region (C name for the debugger: msp430cp_profile)</summary>
+extern "C" MSP430_Profile_Region msp430cp_profile[PROFILE_REGION_COUNT + 1];
+
+class MSP430_UART;
+
+/// <summary>
+/// MSP430 profiler class (all static, PROFILE_ENABLE only)
+/// </summary>
+class MSP430_Profiler
+{
+public:
+	/// <summary>Number of regions (index 0 to RegionCount - 1)</summary>
+	static constexpr unsigned int RegionCount = PROFILE_REGION_COUNT;
+	/// <summary>Region of the empty scopes measured by Calibrate()</summary>
+	static constexpr unsigned int CalibrationRegion = PROFILE_REGION_COUNT;
+
+	/// <summary>Measure the overhead of an empty scope (minimum of 16 runs), it is subtracted from then on</summary>
+	static void Calibrate(void);
+	/// <summary>Get the overhead subtracted from each run (counts)</summary>
+	static unsigned int GetOverhead(void);
+	/// <summary>Clear the statistics of all regions (names are kept)</summary>
+	static void Reset(void);
+	/// <summary>Get the statistics of a region (copied with interrupts disabled)</summary>
+	/// <param name="index">Region index (up to CalibrationRegion)</param>
+	static MSP430_Profile_Region Get(unsigned int index);
+	/// <summary>Get the mean run of a region (counts, 0 if never run)</summary>
+	/// <param name="index">Region index (up to CalibrationRegion)</param>
+	static unsigned int GetMean(unsigned int index);
+	/// <summary>
+	/// Send the regions that ran as text lines: name, count, min, max and mean (counts)
+	/// <para>NOTE: Blocks until all lines are queued, the UART interrupt must be enabled.</para>
+	/// </summary>
+	/// <param name="uart">Initialized UART</param>
+	static void Print(MSP430_UART& uart);
+
+	/// <summary>Account a run to a region (called by the scope after its end read)</summary>
+	/// <param name="index">Region index</param>
+	/// <param name="counts">Counts between the start and the end read</param>
+	static void Account(unsigned int index, unsigned int counts);
+};
+
+/// <summary>
+/// Profiling scope: the counter is read by the constructor and by the destructor (use MSP430_PROFILE())
+/// </summary>
+/// <typeparam name="index">Region index (absolute addressing of the region)</typeparam>
+template <unsigned int index>
+class MSP430_Profile_Scope
+{
+	static_assert(index <= PROFILE_REGION_COUNT, "Profile region index out of range (PROFILE_REGION_COUNT)");
+
+private:
+	/// <summary>Counter at the start</summary>
+	unsigned int start;
+
+public:
+	/// <summary>Name the region and start the run</summary>
+	/// <param name="name">Region name (kept by reference)</param>
+	__attribute__((always_inline)) MSP430_Profile_Scope(const char* name)
+	{
+		msp430cp_profile[index].name = name;
+		REG_BARRIER();
+		this->start = PROFILE_COUNTER;
+		REG_BARRIER();
+	}
+	/// <summary>End the run and account it</summary>
+	__attribute__((always_inline)) ~MSP430_Profile_Scope()
+	{
+		REG_BARRIER();
+		unsigned int end = PROFILE_COUNTER;
+		MSP430_Profiler::Account(index, end - this->start);
+	}
+
+	MSP430_Profile_Scope(const MSP430_Profile_Scope&) = delete;
+	MSP430_Profile_Scope& operator=(const MSP430_Profile_Scope&) = delete;
+};
+
+#define MSP430_PROFILE_SCOPE_NAME(LINE) msp430cp_profile_scope_##LINE
+#define MSP430_PROFILE_SCOPE(INDEX, NAME, LINE) MSP430_Profile_Scope<INDEX> MSP430_PROFILE_SCOPE_NAME(LINE) (NAME)
+/// <summary>Profile the rest of the enclosing block as region INDEX (a constant) named NAME</summary>
+#define MSP430_PROFILE(INDEX, NAME) MSP430_PROFILE_SCOPE(INDEX, NAME, __LINE__)
+#else
+#define MSP430_PROFILE(INDEX, NAME) ((void)0)
+#endif
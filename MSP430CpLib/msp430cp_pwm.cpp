@@ -0,0 +1,208 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_pwm.h"
+#include "msp430cp_clock.h"
+
+// Timer registers
+extern REG_16b const TxCTL[TIMER_COUNT];
+
+/// <summary>Hardware link from program to registers</summary>
+void MSP430_PWM::HardLink(void)
+{
+	this->reg_TxCTL = TxCTL[static_cast<int> (this->instance)];
+	this->reg_TxCCTLn = MSP430_Timer::CaptureControlOf(this->reg_TxCTL, this->channel);
+	this->reg_TxCCRn = this->reg_TxCTL + MSP430_Timer::OffsetCCR + this->channel;
+}
+
+/// <summary>Timer clocks of the high level for a duty in percent (100 % or more saturates to always high)</summary>
+static inline unsigned int DutyOf(unsigned long period, unsigned char percent)
+{
+	unsigned long duty = period * percent / 100;
+	return static_cast<unsigned int> ((duty > 0xFFFF) ? 0xFFFF : duty);
+}
+
+/// <summary>Create a new PWM object, set the location only and let other parameters to default (1 kHz, 0%)</summary>
+/// <param name="instance">Timer instance</param>
+/// <param name="channel">Capture/compare channel (1 to 6, CCR0 holds the period)</param>
+/// <param name="pin">Output pin (TAx.y/TBx.y)</param>
+MSP430_PWM::MSP430_PWM(MSP430_Timer_Instance instance, MSP430_Timer_Channel channel, MSP430_GPIO& pin)
+{
+	this->instance = instance;
+	this->channel = channel;
+	this->pin = &pin;
+	this->period = MSP430_Timer::PeriodOnSMCLK(this->frequency);
+
+	// Link the hardware
+	HardLink();
+}
+
+/// <summary>Create a new PWM object, set the location, frequency and duty</summary>
+/// <param name="instance">Timer instance</param>
+/// <param name="channel">Capture/compare channel (1 to 6, CCR0 holds the period)</param>
+/// <param name="pin">Output pin (TAx.y/TBx.y)</param>
+/// <param name="frequency">PWM frequency (Hz)</param>
+/// <param name="dutyPercent">Duty cycle (0 to 100 %)</param>
+MSP430_PWM::MSP430_PWM(MSP430_Timer_Instance instance, MSP430_Timer_Channel channel, MSP430_GPIO& pin, unsigned long frequency, unsigned char dutyPercent) : MSP430_PWM::MSP430_PWM(instance, channel, pin)
+{
+	this->frequency = frequency;
+	this->period = MSP430_Timer::PeriodOnSMCLK(frequency);
+	this->duty = this->pendingDuty = DutyOf(this->period, dutyPercent);
+}
+
+/// <summary>Create a new PWM object, set the location, frequency, duty and duty update timing</summary>
+/// <param name="instance">Timer instance</param>
+/// <param name="channel">Capture/compare channel (1 to 6, CCR0 holds the period)</param>
+/// <param name="pin">Output pin (TAx.y/TBx.y)</param>
+/// <param name="frequency">PWM frequency (Hz)</param>
+/// <param name="dutyPercent">Duty cycle (0 to 100 %)</param>
+/// <param name="update">Duty update timing</param>
+MSP430_PWM::MSP430_PWM(MSP430_Timer_Instance instance, MSP430_Timer_Channel channel, MSP430_GPIO& pin, unsigned long frequency, unsigned char dutyPercent, MSP430_PWM_Update update) : MSP430_PWM::MSP430_PWM(instance, channel, pin, frequency, dutyPercent)
+{
+	this->update = update;
+}
+
+/// <summary>Delete this PWM instance, stop the channel output and release the pin</summary>
+MSP430_PWM::~MSP430_PWM()
+{
+	Deinitialize();
+}
+
+/// <summary>Write a duty to the compare register (0 holds the output low)</summary>
+void MSP430_PWM::WriteDuty(unsigned int duty)
+{
+	if (duty == 0)
+	{
+		// Reset/Set mode still sets the output for one clock at CCRn = 0, use the OUT bit instead
+		this->reg_TxCCTLn.Modify(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output) | MSP430_Timer_CaptureControl::Output::Off);
+		return;
+	}
+
+	// CCRn above CCR0 never resets the output (always high)
+	this->reg_TxCCRn.Write(duty);
+	this->reg_TxCCTLn.Modify(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::ResetSet));
+}
+
+/// <summary>Initialize the pin (output, primary function), the timer period (Up mode) and the channel output</summary>
+void MSP430_PWM::Initialize(void)
+{
+	// Hand the pin over to the timer output
+	this->pin->SetDirection(MSP430_GPIO_Direction::Output);
+	this->pin->SetFunction(MSP430_GPIO_Function::Primary);
+
+	// The timer counts SMCLK, the low-power waits keep it running
+	this->smclk.Take();
+
+	// Compare mode, the period and the duty are loaded by SetFrequency()
+	this->reg_TxCCTLn.Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output));
+	SetFrequency(this->frequency);
+
+	// Period boundary updates on Timer_A are written by Apply() from the CCR0 handler
+	if (this->update == MSP430_PWM_Update::PeriodBoundary && this->instance != MSP430_Timer_Instance::TB0)
+	{
+		MSP430_FieldRegister<MSP430_Timer_CaptureControl> control0 = MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0);
+		this->periodInterrupt = !control0.Test(MSP430_Timer_CaptureControl::InterruptEnable::On);
+		control0.Modify(MSP430_Timer_CaptureControl::InterruptEnable::On);
+	}
+}
+
+/// <summary>
+/// Deinitialize the channel and set the pin to default.
+/// <para>(Default: Channel output low, pin input with standard function; the timer keeps running for the other channels)</para>
+/// </summary>
+void MSP430_PWM::Deinitialize(void)
+{
+	this->reg_TxCCTLn.Write(MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output));
+	if (this->periodInterrupt)
+	{
+		// Only the CCR0 interrupt this object turned on, a user handler enabled before Initialize() keeps it
+		MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0).Modify(MSP430_Timer_CaptureControl::InterruptEnable::Off);
+		this->periodInterrupt = false;
+	}
+	this->pending = false;
+	this->smclk.Release();
+	this->pin->Deinitialize();
+}
+
+/// <summary>
+/// Set the PWM frequency, the duty ratio is kept
+/// <para>NOTE: The period is shared by all channels of the timer, the counter restarts from zero.</para>
+/// </summary>
+/// <param name="frequency">PWM frequency (Hz)</param>
+void MSP430_PWM::SetFrequency(unsigned long frequency)
+{
+	// Halt, load the period on SMCLK, then restart in Up mode from zero (the overflow interrupt enable is kept)
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Stop));
+	unsigned long period = MSP430_Timer::SetPeriodOnSMCLK(this->reg_TxCTL, frequency);
+	unsigned long duty = GetDuty();
+	duty = (duty >= this->period) ? period : (duty * period / this->period);
+	this->duty = static_cast<unsigned int> ((duty > 0xFFFF) ? 0xFFFF : duty);
+	this->pendingDuty = this->duty;
+	this->pending = false;
+	this->frequency = frequency;
+	this->period = period;
+
+	// TBxCLn loads at once while CLLD is 0, then at each period start
+	this->reg_TxCCTLn.Modify(MSP430_Timer_CaptureControl::CompareLoad::Of<0>());
+	WriteDuty(this->duty);
+	if (this->instance == MSP430_Timer_Instance::TB0)
+	{
+		this->reg_TxCCTLn.Modify(MSP430_Timer_CaptureControl::CompareLoad::Of<1>());
+	}
+
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Up) | MSP430_Timer_Control::Clear::On | MSP430_Timer_Control::InterruptFlag::Off);
+}
+
+/// <summary>Get the PWM frequency (Hz)</summary>
+unsigned long MSP430_PWM::GetFrequency(void)
+{
+	return this->frequency;
+}
+
+/// <summary>Get the timer clocks per period (the full scale of SetDuty())</summary>
+unsigned long MSP430_PWM::GetPeriod(void)
+{
+	return this->period;
+}
+
+/// <summary>Set the duty in timer clocks (0 for always low, GetPeriod() or more for always high)</summary>
+/// <param name="duty">Timer clocks of the high level per period</param>
+void MSP430_PWM::SetDuty(unsigned int duty)
+{
+	if (this->update == MSP430_PWM_Update::PeriodBoundary && this->instance != MSP430_Timer_Instance::TB0)
+	{
+		// Apply() picks it up at the next CCR0 interrupt
+		this->pendingDuty = duty;
+		this->pending = true;
+		return;
+	}
+
+	this->duty = this->pendingDuty = duty;
+	WriteDuty(duty);
+}
+
+/// <summary>Set the duty in percent</summary>
+/// <param name="percent">Duty cycle (0 to 100 %)</param>
+void MSP430_PWM::SetDutyPercent(unsigned char percent)
+{
+	SetDuty(DutyOf(this->period, percent));
+}
+
+/// <summary>Get the duty in timer clocks (the pending one when waiting for the period boundary)</summary>
+unsigned int MSP430_PWM::GetDuty(void)
+{
+	return this->pendingDuty;
+}
+
+/// <summary>
+/// Write the pending duty (Call it from the timer's CCR0 interrupt handler, with MSP430_PWM_Update::PeriodBoundary on Timer_A)
+/// <para>The CCR0 interrupt is enabled by Initialize() in this case.</para>
+/// </summary>
+void MSP430_PWM::Apply(void)
+{
+	if (this->pending)
+	{
+		this->pending = false;
+		this->duty = this->pendingDuty;
+		WriteDuty(this->duty);
+	}
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_timer.h"
+
+// Hardware PWM channel
+// A capture/compare channel of a timer in Up mode drives its TAx.y/TBx.y pin in Reset/Set output mode:
+// the pin is set when the counter reaches CCR0 (period) and reset when it reaches CCRn (duty).
+// The waveform runs without CPU, the duty is only written when it changes.
+//
+//     MSP430_GPIO fanPin(MSP430_GPIO_Port::P1, 2);                // P1.2 = TA0.1
+//     MSP430_PWM fan(MSP430_Timer_Instance::TA0, 1, fanPin, 25000, 50);
+//     fan.Initialize();
+//     fan.SetDutyPercent(80);
+//
+// Duty updates on Timer_B are shadowed by TBxCLn (loaded when the counter returns to zero).
+// Timer_A has no shadow register, with MSP430_PWM_Update::PeriodBoundary the new duty is kept pending
+// and written by Apply() from the CCR0 interrupt handler:
+//
+//     MSP430_TIMER_INTERRUPT_HANDLER(TA0, 0)
+//     {
+//         fan.Apply();
+//     }
+
+/// <summary>
+/// PWM duty update timing
+/// </summary>
+enum class MSP430_PWM_Update
+{
+	/// <summary>Write CCRn at once (Timer_A: a period may be cut or stretched once, Timer_B: always shadowed)</summary>
+	Immediate,
+	/// <summary>Write CCRn at the period boundary (Timer_A: by Apply() in the CCR0 handler, Timer_B: shadowed)</summary>
+	PeriodBoundary
+};
+
+/// <summary>
+/// MSP430 hardware PWM channel class
+/// <para>All channels of a timer share the timer's period (CCR0), so they share one frequency.
+/// The timer is clocked by SMCLK (MSP430_Clock::SMCLKFrequency), the smallest input divider that fits the period into 16 bits is selected.</para>
+/// <para>NOTE: The pin must be the timer channel's output pin, see also the device's datasheet (pin functions).</para>
+/// </summary>
+class MSP430_PWM
+{
+private:
+	// Register for hardware operation
+
+	/// <summary>Timer control register (TxCTL), the base of the other registers</summary>
+	MSP430_FieldRegister<MSP430_Timer_Control> reg_TxCTL;
+	/// <summary>Channel control register (TxCCTLn)</summary>
+	MSP430_FieldRegister<MSP430_Timer_CaptureControl> reg_TxCCTLn;
+	/// <summary>Channel compare register (TxCCRn)</summary>
+	MSP430_Register16 reg_TxCCRn;
+
+	// Corresponding PWM location
+	/// <summary>Timer instance</summary>
+	MSP430_Timer_Instance instance;
+	/// <summary>Capture/compare channel (1 to 6)</summary>
+	MSP430_Timer_Channel channel;
+	/// <summary>Output pin</summary>
+	MSP430_GPIO* pin;
+
+	// Corresponding PWM configuration
+	/// <summary>Duty update timing</summary>
+	MSP430_PWM_Update update = MSP430_PWM_Update::Immediate;
+	/// <summary>PWM frequency (Hz)</summary>
+	unsigned long frequency = 1000;
+	/// <summary>Timer clocks per period (CCR0 + 1)</summary>
+	unsigned long period = 0;
+	/// <summary>Timer clocks of the high level per period</summary>
+	unsigned int duty = 0;
+	/// <summary>Duty waiting for the period boundary (written by the main loop, read by Apply())</summary>
+	volatile unsigned int pendingDuty = 0;
+	/// <summary>A duty is waiting for the period boundary</summary>
+	volatile bool pending = false;
+	/// <summary>Initialize() turned on the CCR0 interrupt for the period boundary updates (Deinitialize() turns it off)</summary>
+	bool periodInterrupt = false;
+	/// <summary>SMCLK hold from Initialize() to Deinitialize()</summary>
+	MSP430_Clock_SMCLKHold smclk;
+
+	// Private low-level linking functions
+	/// <summary>Hardware link from program to registers</summary>
+	void HardLink(void);
+	/// <summary>Write a duty to the compare register (0 holds the output low)</summary>
+	void WriteDuty(unsigned int duty);
+
+public:
+	// Constructor
+	/// <summary>Create a new PWM object, set the location only and let other parameters to default (1 kHz, 0%)</summary>
+	/// <param name="instance">Timer instance</param>
+	/// <param name="channel">Capture/compare channel (1 to 6, CCR0 holds the period)</param>
+	/// <param name="pin">Output pin (TAx.y/TBx.y)</param>
+	MSP430_PWM(MSP430_Timer_Instance instance, MSP430_Timer_Channel channel, MSP430_GPIO& pin);
+	/// <summary>Create a new PWM object, set the location, frequency and duty</summary>
+	/// <param name="instance">Timer instance</param>
+	/// <param name="channel">Capture/compare channel (1 to 6, CCR0 holds the period)</param>
+	/// <param name="pin">Output pin (TAx.y/TBx.y)</param>
+	/// <param name="frequency">PWM frequency (Hz)</param>
+	/// <param name="dutyPercent">Duty cycle (0 to 100 %)</param>
+	MSP430_PWM(MSP430_Timer_Instance instance, MSP430_Timer_Channel channel, MSP430_GPIO& pin, unsigned long frequency, unsigned char dutyPercent);
+	/// <summary>Create a new PWM object, set the location, frequency, duty and duty update timing</summary>
+	/// <param name="instance">Timer instance</param>
+	/// <param name="channel">Capture/compare channel (1 to 6, CCR0 holds the period)</param>
+	/// <param name="pin">Output pin (TAx.y/TBx.y)</param>
+	/// <param name="frequency">PWM frequency (Hz)</param>
+	/// <param name="dutyPercent">Duty cycle (0 to 100 %)</param>
+	/// <param name="update">Duty update timing</param>
+	MSP430_PWM(MSP430_Timer_Instance instance, MSP430_Timer_Channel channel, MSP430_GPIO& pin, unsigned long frequency, unsigned char dutyPercent, MSP430_PWM_Update update);
+	/// <summary>Delete this PWM instance, stop the channel output and release the pin</summary>
+	~MSP430_PWM();
+
+	// PWM initialize or re-configuration
+	/// <summary>Initialize the pin (output, primary function), the timer period (Up mode) and the channel output</summary>
+	void Initialize(void);
+	/// <summary>
+	/// Deinitialize the channel and set the pin to default.
+	/// <para>(Default: Channel output low, pin input with standard function; the timer keeps running for the other channels)</para>
+	/// </summary>
+	void Deinitialize(void);
+
+	// Frequency control
+	/// <summary>
+	/// Set the PWM frequency, the duty ratio is kept
+	/// <para>NOTE: The period is shared by all channels of the timer, the counter restarts from zero.</para>
+	/// </summary>
+	/// <param name="frequency">PWM frequency (Hz)</param>
+	void SetFrequency(unsigned long frequency);
+	/// <summary>Get the PWM frequency (Hz)</summary>
+	unsigned long GetFrequency(void);
+	/// <summary>Get the timer clocks per period (the full scale of SetDuty())</summary>
+	unsigned long GetPeriod(void);
+
+	// Duty control
+	/// <summary>Set the duty in timer clocks (0 for always low, GetPeriod() or more for always high)</summary>
+	/// <param name="duty">Timer clocks of the high level per period</param>
+	void SetDuty(unsigned int duty);
+	/// <summary>Set the duty in percent</summary>
+	/// <param name="percent">Duty cycle (0 to 100 %)</param>
+	void SetDutyPercent(unsigned char percent);
+	/// <summary>Get the duty in timer clocks (the pending one when waiting for the period boundary)</summary>
+	unsigned int GetDuty(void);
+	/// <summary>
+	/// Write the pending duty (Call it from the timer's CCR0 interrupt handler, with MSP430_PWM_Update::PeriodBoundary on Timer_A)
+	/// <para>The CCR0 interrupt is enabled by Initialize() in this case.</para>
+	/// </summary>
+	void Apply(void);
+};
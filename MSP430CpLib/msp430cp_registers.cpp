@@ -2,18 +2,105 @@
 #include "msp430cp_device.h"
 #include "msp430cp_registers.h"
 
+// Register tables are const (flash-resident, nothing is copied into RAM at startup).
+// "extern" keeps the external linkage of the const definitions, the drivers declare them as "extern REG_xx const".
+
+// Low-power wake-up request (set by MSP430_WAKE(), taken by REG_ISR_EXIT())
+volatile bool MSP430_WakeRequest = false;
+
+// Table initializers of the available ports (P1 to P<N>) and port pairs (PA to P<N>)
+// The register name R is only pasted (never macro-expanded, e.g. OUT is also a CCTL bit), N is expanded by MSP430CP_SELECT.
+#define MSP430CP_PORTS_1(R) { &P1##R }
+#define MSP430CP_PORTS_2(R) { &P1##R, &P2##R }
+#define MSP430CP_PORTS_3(R) { &P1##R, &P2##R, &P3##R }
+#define MSP430CP_PORTS_4(R) { &P1##R, &P2##R, &P3##R, &P4##R }
+#define MSP430CP_PORTS_5(R) { &P1##R, &P2##R, &P3##R, &P4##R, &P5##R }
+#define MSP430CP_PORTS_6(R) { &P1##R, &P2##R, &P3##R, &P4##R, &P5##R, &P6##R }
+#define MSP430CP_PORTS_7(R) { &P1##R, &P2##R, &P3##R, &P4##R, &P5##R, &P6##R, &P7##R }
+#define MSP430CP_PORTS_8(R) { &P1##R, &P2##R, &P3##R, &P4##R, &P5##R, &P6##R, &P7##R, &P8##R }
+#define MSP430CP_PAIRS_1(R) { &PA##R }
+#define MSP430CP_PAIRS_2(R) { &PA##R, &PB##R }
+#define MSP430CP_PAIRS_3(R) { &PA##R, &PB##R, &PC##R }
+#define MSP430CP_PAIRS_4(R) { &PA##R, &PB##R, &PC##R, &PD##R }
+#define MSP430CP_SELECT_N(TABLE, N) TABLE##_##N
+#define MSP430CP_SELECT(TABLE, N) MSP430CP_SELECT_N(TABLE, N)
+
 // GPIO registers
-REG_8b PxIN[GPIO_PORT_COUNT] = { &P1IN, &P2IN, &P3IN, &P4IN, &P5IN, &P6IN, &P7IN, &P8IN };
-REG_8b PxOUT[GPIO_PORT_COUNT] = { &P1OUT, &P2OUT, &P3OUT, &P4OUT, &P5OUT, &P6OUT, &P7OUT, &P8OUT };
-REG_8b PxDIR[GPIO_PORT_COUNT] = { &P1DIR, &P2DIR, &P3DIR, &P4DIR, &P5DIR, &P6DIR, &P7DIR, &P8DIR };
-REG_8b PxREN[GPIO_PORT_COUNT] = { &P1REN, &P2REN, &P3REN, &P4REN, &P5REN, &P6REN, &P7REN, &P8REN };
-REG_8b PxSEL[GPIO_PORT_COUNT] = { &P1SEL, &P2SEL, &P3SEL, &P4SEL, &P5SEL, &P6SEL, &P7SEL, &P8SEL };
+extern REG_8b const PxIN[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(IN);
+extern REG_8b const PxOUT[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(OUT);
+extern REG_8b const PxDIR[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(DIR);
+extern REG_8b const PxREN[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(REN);
+extern REG_8b const PxSEL[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(SEL);
 #ifdef GPIO_PORT_HAS_FUNSEL2
-REG_8b PxSEL2[GPIO_PORT_COUNT] = { &P1SEL2, &P2SEL2, &P3SEL2, &P4SEL2, &P5SEL2, &P6SEL2, &P7SEL2, &P8SEL2 };
+extern REG_8b const PxSEL2[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(SEL2);
 #endif
 #ifdef GPIO_PORT_HAS_DS
-REG_8b PxDS[GPIO_PORT_COUNT] = { &P1DS, &P2DS, &P3DS, &P4DS, &P5DS, &P6DS, &P7DS, &P8DS };
+extern REG_8b const PxDS[GPIO_PORT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_COUNT)(DS);
+#endif
+extern REG_8b const PxIE[GPIO_PORT_SUPPORT_INT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_SUPPORT_INT_COUNT)(IE);
+extern REG_8b const PxIFG[GPIO_PORT_SUPPORT_INT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_SUPPORT_INT_COUNT)(IFG);
+extern REG_8b const PxIES[GPIO_PORT_SUPPORT_INT_COUNT] = MSP430CP_SELECT(MSP430CP_PORTS, GPIO_PORT_SUPPORT_INT_COUNT)(IES);
+
+#if GPIO_PORT_PAIR_COUNT > 0
+// GPIO port pair registers (PA = P1/P2, PB = P3/P4, PC = P5/P6, PD = P7/P8)
+extern REG_16b const PPxIN[GPIO_PORT_PAIR_COUNT] = MSP430CP_SELECT(MSP430CP_PAIRS, GPIO_PORT_PAIR_COUNT)(IN);
+extern REG_16b const PPxOUT[GPIO_PORT_PAIR_COUNT] = MSP430CP_SELECT(MSP430CP_PAIRS, GPIO_PORT_PAIR_COUNT)(OUT);
+extern REG_16b const PPxDIR[GPIO_PORT_PAIR_COUNT] = MSP430CP_SELECT(MSP430CP_PAIRS, GPIO_PORT_PAIR_COUNT)(DIR);
+extern REG_16b const PPxREN[GPIO_PORT_PAIR_COUNT] = MSP430CP_SELECT(MSP430CP_PAIRS, GPIO_PORT_PAIR_COUNT)(REN);
+extern REG_16b const PPxSEL[GPIO_PORT_PAIR_COUNT] = MSP430CP_SELECT(MSP430CP_PAIRS, GPIO_PORT_PAIR_COUNT)(SEL);
+#endif
+
+// Timer registers (control register of each timer, the other registers follow it)
+// The tables are indexed by MSP430_Timer_Instance: a timer the device lacks keeps its slot, with no register and 0 channels.
+extern REG_16b const TxCTL[TIMER_COUNT] =
+{
+	&TA0CTL,
+#if TIMER_TA1_CHANNEL_COUNT > 0
+	&TA1CTL,
+#elif TIMER_COUNT > 1
+	nullptr,
+#endif
+#if TIMER_TA2_CHANNEL_COUNT > 0
+	&TA2CTL,
+#elif TIMER_COUNT > 2
+	nullptr,
+#endif
+#if TIMER_TB0_CHANNEL_COUNT > 0
+	&TB0CTL
+#endif
+};
+extern const unsigned char TxCHANNEL_COUNT[TIMER_COUNT] =
+{
+	TIMER_TA0_CHANNEL_COUNT,
+#if TIMER_COUNT > 1
+	TIMER_TA1_CHANNEL_COUNT,
+#endif
+#if TIMER_COUNT > 2
+	TIMER_TA2_CHANNEL_COUNT,
+#endif
+#if TIMER_COUNT > 3
+	TIMER_TB0_CHANNEL_COUNT
+#endif
+};
+
+#if DMA_CHANNEL_COUNT > 0
+// DMA registers (control register of each channel, the address and size registers follow it)
+extern REG_16b const DMAxCTL[DMA_CHANNEL_COUNT] =
+{
+	&DMA0CTL, &DMA1CTL, &DMA2CTL,
+#if DMA_CHANNEL_COUNT > 3
+	&DMA3CTL, &DMA4CTL, &DMA5CTL
+#endif
+};
+#endif
+
+#if UART_COUNT > 0
+// UART registers (control register 1 of each USCI_A, the other registers follow it)
+extern REG_8b const UCAxCTL1[UART_COUNT] =
+{
+	&UCA0CTL1,
+#if UART_COUNT > 1
+	&UCA1CTL1
+#endif
+};
 #endif
-REG_8b PxIE[GPIO_PORT_SUPPORT_INT_COUNT] = { &P1IE, &P2IE };
-REG_8b PxIFG[GPIO_PORT_SUPPORT_INT_COUNT] = { &P1IFG, &P2IFG };
-REG_8b PxIES[GPIO_PORT_SUPPORT_INT_COUNT] = { &P1IES, &P2IES };
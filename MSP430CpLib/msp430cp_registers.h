@@ -1,9 +1,18 @@
+#pragma once
+
 #include <msp430.h>
 
 // Global definations
+/// <summary>16-bit register element (unsigned int on the device, unsigned short on host)</summary>
+#ifdef MSP430CP_HOST
+typedef unsigned short MSP430_RegisterWord;
+#else
+typedef unsigned int MSP430_RegisterWord;
+#endif
 #define REG_8b volatile unsigned char*
+#define REG_16b volatile MSP430_RegisterWord*
 
-// Register operations
+// Untyped register operations (kept for application code, the library uses MSP430_Register/MSP430_FieldRegister below)
 /// <summary>Write data to register</summary>
 /// <param name="REG">Register address pointer</param>
 /// <param name="DATA">Data to write</param>
@@ -15,7 +24,7 @@
 /// <param name="REG">Register address pointer</param>
 /// <param name="DATA">Data to write</param>
 /// <param name="MASK">Data mask</param>
-#define REG_WM(REG, DATA, MASK) (*(REG) = ((*REG) & (~(MASK))) | ((DATA) & (MASK)))
+#define REG_WM(REG, DATA, MASK) (*(REG) = (*(REG) & (~(MASK))) | ((DATA) & (MASK)))
 /// <summary>Read data from register with data mask</summary>
 /// <param name="REG">Register address pointer</param>
 /// <param name="MASK">Data mask</param>
@@ -40,3 +49,308 @@
 /// <param name="BIT">Bit in the register</param>
 #define REG_GBIT(REG, BIT) ((*(REG) & (1 << (BIT))) >> (BIT))
 
+// Typed register access
+/// <summary>
+/// Register handle (an 8-bit or 16-bit register, the size of a pointer)
+/// <para>Each operation is the cheapest instruction for it: Write() MOV, Set() BIS, Clear() BIC, Toggle() XOR, Test() BIT.
+/// Modify() becomes MOV/BIS/BIC when the value and the mask are known at compile time (a read-modify-write otherwise),
+/// Assign() branches to BIS or BIC instead of shifting a bit value into place.</para>
+/// <para>A handle built from a constant address (e.g. in a static inline function) folds into absolute addressing.</para>
+/// </summary>
+/// <typeparam name="T">Register element (unsigned char or MSP430_RegisterWord)</typeparam>
+template <typename T>
+class MSP430_Register
+{
+protected:
+	/// <summary>Register address</summary>
+	volatile T* address;
+
+public:
+	/// <summary>Register element</summary>
+	typedef T Type;
+	/// <summary>All bits of the register</summary>
+	static constexpr T Full = static_cast<T> (~0u);
+
+	// Constructor
+	/// <summary>Create a handle of a register address (nullptr for an absent register)</summary>
+	/// <param name="address">Register address</param>
+	constexpr MSP430_Register(volatile T* address = nullptr) : address(address)
+	{
+	}
+
+	// Location
+	/// <summary>Get the register address</summary>
+	constexpr volatile T* Address(void) const
+	{
+		return this->address;
+	}
+	/// <summary>Check the register is present (the handle has an address)</summary>
+	constexpr bool IsPresent(void) const
+	{
+		return this->address != nullptr;
+	}
+	/// <summary>Get a following register (offset in register elements, like pointer arithmetic)</summary>
+	/// <param name="offset">Register elements from this register</param>
+	constexpr MSP430_Register operator+(int offset) const
+	{
+		return MSP430_Register(this->address + offset);
+	}
+
+	// Whole register
+	/// <summary>Write the register (MOV)</summary>
+	/// <param name="value">Register value</param>
+	__attribute__((always_inline)) void Write(T value) const
+	{
+		*this->address = value;
+	}
+	/// <summary>Read the register (MOV)</summary>
+	__attribute__((always_inline)) T Read(void) const
+	{
+		return *this->address;
+	}
+
+	// Bits
+	/// <summary>Read the bits in a mask (AND)</summary>
+	/// <param name="mask">Bit mask</param>
+	__attribute__((always_inline)) T Read(T mask) const
+	{
+		return *this->address & mask;
+	}
+	/// <summary>Check if any bit in a mask is set (BIT)</summary>
+	/// <param name="mask">Bit mask</param>
+	__attribute__((always_inline)) bool Test(T mask) const
+	{
+		return (*this->address & mask) != 0;
+	}
+	/// <summary>Set the bits in a mask (BIS)</summary>
+	/// <param name="mask">Bit mask</param>
+	__attribute__((always_inline)) void Set(T mask) const
+	{
+		*this->address |= mask;
+	}
+	/// <summary>Clear the bits in a mask (BIC)</summary>
+	/// <param name="mask">Bit mask</param>
+	__attribute__((always_inline)) void Clear(T mask) const
+	{
+		*this->address &= static_cast<T> (~mask);
+	}
+	/// <summary>Toggle the bits in a mask (XOR)</summary>
+	/// <param name="mask">Bit mask</param>
+	__attribute__((always_inline)) void Toggle(T mask) const
+	{
+		*this->address ^= mask;
+	}
+	/// <summary>Set or clear all bits in a mask (BIS or BIC)</summary>
+	/// <param name="mask">Bit mask</param>
+	/// <param name="value">Set the bits (false: clear them)</param>
+	__attribute__((always_inline)) void Assign(T mask, bool value) const
+	{
+		if (value)
+		{
+			Set(mask);
+		}
+		else
+		{
+			Clear(mask);
+		}
+	}
+	/// <summary>
+	/// Write the bits in a mask, keep the others
+	/// <para>MOV for a full mask, BIS/BIC when the masked value is all ones/zeros (compile-time values), otherwise a read-modify-write.</para>
+	/// </summary>
+	/// <param name="value">Data to write</param>
+	/// <param name="mask">Bit mask</param>
+	__attribute__((always_inline)) void Modify(T value, T mask) const
+	{
+		T bits = static_cast<T> (value & mask);
+		if (__builtin_constant_p(mask) && mask == Full)
+		{
+			Write(value);
+		}
+		else if (__builtin_constant_p(bits) && __builtin_constant_p(mask) && bits == mask)
+		{
+			Set(mask);
+		}
+		else if (__builtin_constant_p(bits) && bits == 0)
+		{
+			Clear(mask);
+		}
+		else
+		{
+			*this->address = static_cast<T> ((*this->address & ~mask) | bits);
+		}
+	}
+};
+
+/// <summary>8-bit register handle</summary>
+typedef MSP430_Register<unsigned char> MSP430_Register8;
+/// <summary>16-bit register handle</summary>
+typedef MSP430_Register<MSP430_RegisterWord> MSP430_Register16;
+
+/// <summary>
+/// Value of some fields of a register (bits and the mask of the fields they belong to)
+/// <para>Values of the same register combine with |, values of different registers do not compile.</para>
+/// </summary>
+/// <typeparam name="Fields">Field set of the register</typeparam>
+template <typename Fields>
+struct MSP430_RegisterValue
+{
+	/// <summary>Field bits</summary>
+	typename Fields::Type bits;
+	/// <summary>Mask of the fields</summary>
+	typename Fields::Type mask;
+
+	/// <summary>Combine the values of other fields of the same register</summary>
+	/// <param name="other">Other field value</param>
+	constexpr MSP430_RegisterValue operator|(MSP430_RegisterValue other) const
+	{
+		return { static_cast<typename Fields::Type> (bits | other.bits), static_cast<typename Fields::Type> (mask | other.mask) };
+	}
+};
+
+/// <summary>
+/// Register field (width bits at a position, holding a value of type V)
+/// <para>Enumeration fields only take their enumeration, numeric fields check constant values with Of&lt;value&gt;().</para>
+/// </summary>
+/// <typeparam name="Fields">Field set of the register (provides Type, the register element)</typeparam>
+/// <typeparam name="position">Lowest bit</typeparam>
+/// <typeparam name="width">Number of bits</typeparam>
+/// <typeparam name="V">Value type (an enumeration, bool or an unsigned number)</typeparam>
+template <typename Fields, unsigned char position, unsigned char width, typename V = unsigned int>
+struct MSP430_RegisterField
+{
+	/// <summary>Mask of the field in the register</summary>
+	static constexpr typename Fields::Type Mask = static_cast<typename Fields::Type> (((1UL << width) - 1) << position);
+
+	/// <summary>Field value</summary>
+	/// <param name="value">Value</param>
+	static constexpr MSP430_RegisterValue<Fields> Of(V value)
+	{
+		return { static_cast<typename Fields::Type> ((static_cast<unsigned long> (value) << position) & Mask), Mask };
+	}
+	/// <summary>Field value checked at compile time (numeric fields)</summary>
+	/// <typeparam name="value">Value</typeparam>
+	template <unsigned long value>
+	static constexpr MSP430_RegisterValue<Fields> Of(void)
+	{
+		static_assert(value < (1UL << width), "The value does not fit into the field");
+		return { static_cast<typename Fields::Type> (value << position), Mask };
+	}
+	/// <summary>Field value in a register value</summary>
+	/// <param name="registerValue">Register value</param>
+	static constexpr V Get(typename Fields::Type registerValue)
+	{
+		return static_cast<V> ((registerValue & Mask) >> position);
+	}
+
+	/// <summary>All bits of the field set (flags)</summary>
+	static constexpr MSP430_RegisterValue<Fields> On = { Mask, Mask };
+	/// <summary>All bits of the field cleared</summary>
+	static constexpr MSP430_RegisterValue<Fields> Off = { 0, Mask };
+};
+
+/// <summary>
+/// Register handle with typed fields
+/// <para>Writes only take field values of this register (MSP430_RegisterField of Fields), so a field of another register,
+/// a mistyped enumeration or a constant out of range fails to compile. Modify() writes the given fields only, with the
+/// same instruction selection as MSP430_Register::Modify(): a single flag is one BIS/BIC.</para>
+/// </summary>
+/// <typeparam name="Fields">Field set of the register (provides Type and the MSP430_RegisterField definitions)</typeparam>
+template <typename Fields>
+class MSP430_FieldRegister : public MSP430_Register<typename Fields::Type>
+{
+private:
+	typedef typename Fields::Type T;
+	typedef MSP430_Register<T> Base;
+
+public:
+	// Constructor
+	/// <summary>Create a handle of a register address (nullptr for an absent register)</summary>
+	/// <param name="address">Register address</param>
+	constexpr MSP430_FieldRegister(volatile T* address = nullptr) : Base(address)
+	{
+	}
+
+	// Typed access (the untyped writes of MSP430_Register are hidden)
+	/// <summary>Write the register, the fields not given are zero (MOV)</summary>
+	/// <param name="value">Field values</param>
+	__attribute__((always_inline)) void Write(MSP430_RegisterValue<Fields> value) const
+	{
+		Base::Write(value.bits);
+	}
+	/// <summary>Write the given fields, keep the others (MOV, BIS, BIC or a read-modify-write)</summary>
+	/// <param name="value">Field values</param>
+	__attribute__((always_inline)) void Modify(MSP430_RegisterValue<Fields> value) const
+	{
+		Base::Modify(value.bits, value.mask);
+	}
+	/// <summary>Check if the given fields hold their values</summary>
+	/// <param name="value">Field values</param>
+	__attribute__((always_inline)) bool Test(MSP430_RegisterValue<Fields> value) const
+	{
+		return Base::Read(value.mask) == value.bits;
+	}
+	/// <summary>Write zero to the whole register (every field at value 0, MOV #0)</summary>
+	__attribute__((always_inline)) void Reset(void) const
+	{
+		Base::Write(0);
+	}
+	/// <summary>Read a field</summary>
+	/// <typeparam name="Field">Field of this register</typeparam>
+	template <typename Field>
+	__attribute__((always_inline)) auto Get(void) const
+	{
+		// A field of another register does not convert
+		constexpr MSP430_RegisterValue<Fields> field = Field::On;
+		(void)field;
+		return Field::Get(Base::Read());
+	}
+	/// <summary>Get a following register (offset in register elements, untyped)</summary>
+	/// <param name="offset">Register elements from this register</param>
+	constexpr Base operator+(int offset) const
+	{
+		return Base(this->address + offset);
+	}
+
+	void Set(T) const = delete;
+	void Clear(T) const = delete;
+	void Toggle(T) const = delete;
+	void Assign(T, bool) const = delete;
+	void Modify(T, T) const = delete;
+	void Write(T) const = delete;
+};
+
+// Memory ordering
+/// <summary>Compiler barrier: memory accesses are not reordered across it (e.g. fill a buffer entry, then publish its index)</summary>
+#define REG_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// Interrupt service routine
+#ifdef MSP430CP_HOST
+/// <summary>Define an interrupt service routine (a plain function on host build)</summary>
+/// <param name="VECTOR">Interrupt vector</param>
+/// <param name="NAME">Function name</param>
+#define REG_ISR(VECTOR, NAME) void NAME(void)
+#else
+/// <summary>Define an interrupt service routine</summary>
+/// <param name="VECTOR">Interrupt vector</param>
+/// <param name="NAME">Function name</param>
+#define REG_ISR(VECTOR, NAME) void __attribute__((interrupt(VECTOR))) NAME(void)
+#endif
+
+// Low-power wake-up
+// Handlers (MSP430_TIMER_INTERRUPT_HANDLER, ...) are plain functions called by the library interrupt routines, so they can't
+// change the SR stacked on interrupt entry: MSP430_WAKE() records the request, REG_ISR_EXIT() at the end of the routine takes it.
+/// <summary>A handler requested to leave the low-power mode when the current interrupt routine exits</summary>
+extern volatile bool MSP430_WakeRequest;
+/// <summary>Leave the low-power mode when the current interrupt routine exits (from a handler or any code it calls)</summary>
+#define MSP430_WAKE() (MSP430_WakeRequest = true)
+/// <summary>Take the wake-up request at the end of an interrupt routine (the interrupted code returns to active mode)</summary>
+#define REG_ISR_EXIT() \
+	do \
+	{ \
+		if (MSP430_WakeRequest) \
+		{ \
+			MSP430_WakeRequest = false; \
+			__bic_SR_register_on_exit(LPM4_bits); \
+		} \
+	} while (0)
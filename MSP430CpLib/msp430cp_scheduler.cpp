@@ -0,0 +1,149 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_scheduler.h"
+#include "msp430cp_timer.h"
+
+#ifdef SCHEDULER_TIMER
+// Timebase registers
+typedef MSP430_Timer_Registers<MSP430_Timer_Instance::SCHEDULER_TIMER> TimebaseRegisters;
+
+/// <summary>High word of the time (written by the overflow handler)</summary>
+static volatile unsigned int epoch = 0;
+/// <summary>The CPU sleeps with an alarm beyond the current 16-bit range (the overflow handler wakes it)</summary>
+static volatile bool waiting = false;
+
+/// <summary>Service the alarm (CCR0) interrupt: disarm it and request the wake-up (Called by the library handler, or by yours with SCHEDULER_USER_ISR)</summary>
+void MSP430_SchedulerTimebase::ServiceAlarm(void)
+{
+	TimebaseRegisters::TxCCTL(0).Reset();
+	MSP430_WAKE();
+}
+
+/// <summary>Service the overflow interrupt: extend the time, request the wake-up to reprogram a far alarm (Called by the library handler, or by yours with SCHEDULER_USER_ISR)</summary>
+void MSP430_SchedulerTimebase::ServiceOverflow(void)
+{
+	epoch = epoch + 1;
+	if (waiting)
+	{
+		MSP430_WAKE();
+	}
+}
+
+#ifndef SCHEDULER_USER_ISR
+/// <summary>Define the CCR0/overflow handlers of a timer given by a macro</summary>
+#define MSP430CP_SCHEDULER_ALARM_HANDLER(TIMER) MSP430_TIMER_INTERRUPT_HANDLER(TIMER, 0)
+#define MSP430CP_SCHEDULER_OVERFLOW_HANDLER(TIMER) MSP430_TIMER_OVERFLOW_HANDLER(TIMER)
+
+/// <summary>Alarm (CCR0) handler: disarm and return to active mode (the timer interrupt routine takes the wake-up on exit)</summary>
+MSP430CP_SCHEDULER_ALARM_HANDLER(SCHEDULER_TIMER)
+{
+	MSP430_SchedulerTimebase::ServiceAlarm();
+}
+
+/// <summary>Overflow handler: extend the time, wake the CPU to reprogram a far alarm</summary>
+MSP430CP_SCHEDULER_OVERFLOW_HANDLER(SCHEDULER_TIMER)
+{
+	MSP430_SchedulerTimebase::ServiceOverflow();
+}
+#endif
+
+/// <summary>Read the counter (ACLK is asynchronous to MCLK, read until two readings agree)</summary>
+static inline unsigned int ReadCounter(void)
+{
+	unsigned int count = TimebaseRegisters::TxR().Read();
+	unsigned int check;
+	while ((check = TimebaseRegisters::TxR().Read()) != count)
+	{
+		count = check;
+	}
+	return count;
+}
+
+/// <summary>Start the timebase from zero (ACLK, continuous mode, overflow interrupt enabled)</summary>
+void MSP430_SchedulerTimebase::Initialize(void)
+{
+	epoch = 0;
+	TimebaseRegisters::TxCCTL(0).Reset();
+	TimebaseRegisters::TxEX0().Write(0);
+	TimebaseRegisters::TxCTL().Write(MSP430_Timer_Control::ClockSource::Of(MSP430_Timer_ClockSource::ACLK) | MSP430_Timer_Control::Clear::On);
+	TimebaseRegisters::TxCTL().Write(MSP430_Timer_Control::ClockSource::Of(MSP430_Timer_ClockSource::ACLK) |
+		MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Continuous) | MSP430_Timer_Control::InterruptEnable::On);
+}
+
+/// <summary>Get the current time in ticks (32-bit, wraps after 36 hours at 32768 Hz)</summary>
+unsigned long MSP430_SchedulerTimebase::Now(void)
+{
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+
+	unsigned int high = epoch;
+	unsigned int low = ReadCounter();
+	// An overflow not served yet (interrupts disabled) belongs to the low counter value already read
+	if (TimebaseRegisters::TxCTL().Test(MSP430_Timer_Control::InterruptFlag::On) && low < 0x8000)
+	{
+		high++;
+	}
+
+	if (gie)
+	{
+		__enable_interrupt();
+	}
+	return (static_cast<unsigned long> (high) << 16) | low;
+}
+
+/// <summary>Program the one-shot alarm for a deadline (an alarm beyond the current 16-bit range is reached through the overflow)</summary>
+/// <param name="deadline">Deadline time (ticks)</param>
+/// <return>The alarm is armed (false if the deadline has already passed)</return>
+bool MSP430_SchedulerTimebase::SetAlarm(unsigned long deadline)
+{
+	unsigned long left = deadline - Now();
+	if (static_cast<long> (left) <= 0)
+	{
+		return false;
+	}
+	if (left > 0xFFFFUL)
+	{
+		// Far deadline: sleep until the overflow, then reprogram
+		TimebaseRegisters::TxCCTL(0).Reset();
+		return true;
+	}
+
+	TimebaseRegisters::TxCCR(0).Write(static_cast<MSP430_RegisterWord> (deadline));
+	TimebaseRegisters::TxCCTL(0).Write(MSP430_Timer_CaptureControl::InterruptEnable::On);
+
+	// The counter may have passed the compare value while it was written
+	if (static_cast<long> (deadline - Now()) <= 0)
+	{
+		TimebaseRegisters::TxCCTL(0).Reset();
+		return false;
+	}
+	return true;
+}
+
+/// <summary>Disarm the one-shot alarm</summary>
+void MSP430_SchedulerTimebase::ClearAlarm(void)
+{
+	TimebaseRegisters::TxCCTL(0).Reset();
+}
+
+/// <summary>
+/// Enter the low-power mode with interrupts enabled, return with interrupts disabled after an interrupt exited it
+/// <para>LPM3 unless a driver holds SMCLK (then LPM0, see MSP430_Clock::HoldSMCLK()).</para>
+/// </summary>
+/// <param name="alarm">An alarm is armed (the overflow interrupt wakes the CPU to reprogram it)</param>
+void MSP430_SchedulerTimebase::Sleep(bool alarm)
+{
+	waiting = alarm;
+	// A request left by code outside of an interrupt was already seen by the caller
+	MSP430_WakeRequest = false;
+
+	// GIE and the low-power bits are set by one instruction, so a wake-up can't be lost before the sleep
+	__bis_SR_register((MSP430_Clock::IsSMCLKHeld() ? LPM0_bits : LPM3_bits) | GIE);
+	__no_operation();
+	__disable_interrupt();
+	__no_operation();
+
+	waiting = false;
+}
+#endif
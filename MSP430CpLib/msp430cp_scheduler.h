@@ -0,0 +1,294 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+
+// Cooperative scheduler
+// Tasks are plain functions listed at compile time, a lower position means a higher priority.
+// A task runs once each time it is posted: by an interrupt handler (GPIO, event queue producer, ...) or by a deadline.
+// When nothing is runnable the CPU sleeps in LPM3 (LPM0 while a driver holds SMCLK, see MSP430_Clock::HoldSMCLK()),
+// and the timebase compare is programmed for the nearest deadline only (no periodic tick).
+//
+//     void Blink(void);
+//     void Button(void);
+//     typedef MSP430_Scheduler<Blink, Button> Scheduler;
+//
+//     void Blink(void)
+//     {
+//         leds.ReverseValue();
+//         Scheduler::PostAfter<Blink>(MSP430_SchedulerTimebase::TicksOf(250));
+//     }
+//
+//     MSP430_GPIO_INTERRUPT_HANDLER(P1, 1)
+//     {
+//         Scheduler::Post<Button>();
+//     }
+//
+//     Scheduler::Initialize();
+//     Scheduler::Post<Blink>();
+//     Scheduler::Run();
+//
+// Post()/PostAt() from an interrupt handler request the wake-up (MSP430_WAKE()), the library interrupt routine
+// (GPIO, timer, DMA, UART) leaves the low-power mode on exit; routines of your own end with REG_ISR_EXIT().
+//
+// The SMCLK drivers hold SMCLK while they run (PWM and UART from Initialize() to Deinitialize(), waveform and ADC12 timer
+// trigger from Start() to Stop(), parallel DMA writer from Write() to Finish()), so the loop sleeps in LPM0 meanwhile.
+// Peripherals of your own on SMCLK call MSP430_Clock::HoldSMCLK()/ReleaseSMCLK() around their use.
+//
+// The library owns the CCR0 and overflow handlers of SCHEDULER_TIMER (define SCHEDULER_USER_ISR in msp430cp_device.h
+// to keep your own and call ServiceAlarm()/ServiceOverflow() from them, they request the wake-up as needed).
+
+/// <summary>Task function (called from the scheduler loop with interrupts enabled)</summary>
+typedef void (*MSP430_Task)(void);
+
+/// <summary>Task Id (position in the task list)</summary>
+typedef unsigned char MSP430_TaskId;
+
+/// <summary>
+/// Scheduler timebase (all static)
+/// <para>SCHEDULER_TIMER counts ACLK in continuous mode, the overflow interrupt extends the counter to 32 bits.
+/// CCR0 is the one-shot alarm of the nearest deadline.</para>
+/// </summary>
+class MSP430_SchedulerTimebase
+{
+public:
+	// Conversion
+	/// <summary>Timebase ticks of a time in milliseconds (rounded up)</summary>
+	/// <param name="milliseconds">Time (ms)</param>
+	static constexpr unsigned long TicksOf(unsigned long milliseconds)
+	{
+		return static_cast<unsigned long> ((static_cast<unsigned long long> (MSP430_Clock::ACLKFrequency) * milliseconds + 999ULL) / 1000ULL);
+	}
+
+	// Timebase control
+	/// <summary>Start the timebase from zero (ACLK, continuous mode, overflow interrupt enabled)</summary>
+	static void Initialize(void);
+	/// <summary>Get the current time in ticks (32-bit, wraps after 36 hours at 32768 Hz)</summary>
+	static unsigned long Now(void);
+
+	// Idle (called with interrupts disabled)
+	/// <summary>Program the one-shot alarm for a deadline (an alarm beyond the current 16-bit range is reached through the overflow)</summary>
+	/// <param name="deadline">Deadline time (ticks)</param>
+	/// <return>The alarm is armed (false if the deadline has already passed)</return>
+	static bool SetAlarm(unsigned long deadline);
+	/// <summary>Disarm the one-shot alarm</summary>
+	static void ClearAlarm(void);
+	/// <summary>
+	/// Enter the low-power mode with interrupts enabled, return with interrupts disabled after an interrupt exited it
+	/// <para>LPM3 unless a driver holds SMCLK (then LPM0, see MSP430_Clock::HoldSMCLK()).</para>
+	/// </summary>
+	/// <param name="alarm">An alarm is armed (the overflow interrupt wakes the CPU to reprogram it)</param>
+	static void Sleep(bool alarm);
+
+	// Interrupt service
+	/// <summary>Service the alarm (CCR0) interrupt of SCHEDULER_TIMER and request the wake-up (Called by the library handler, or by yours with SCHEDULER_USER_ISR)</summary>
+	static void ServiceAlarm(void);
+	/// <summary>Service the overflow interrupt of SCHEDULER_TIMER, request the wake-up for a far alarm (Called by the library handler, or by yours with SCHEDULER_USER_ISR)</summary>
+	static void ServiceOverflow(void);
+};
+
+/// <summary>
+/// MSP430 cooperative scheduler (all static, one instance per task list)
+/// <para>Post() is interrupt-safe. PostAt()/PostAfter()/Cancel() are interrupt-safe as well, deadlines are checked by the scheduler loop.
+/// Post()/PostAt() request the wake-up, so the scheduler loop leaves the low-power mode when the interrupt routine exits.</para>
+/// </summary>
+/// <typeparam name="tasks">Task functions (up to 16, in priority order)</typeparam>
+template <MSP430_Task... tasks>
+class MSP430_Scheduler
+{
+	static_assert(sizeof...(tasks) > 0 && sizeof...(tasks) <= 16, "Scheduler supports 1 to 16 tasks");
+
+private:
+	/// <summary>Task table (flash-resident)</summary>
+	static constexpr MSP430_Task taskTable[sizeof...(tasks)] = { tasks... };
+
+	/// <summary>Runnable tasks (bit n for task n)</summary>
+	static volatile unsigned int pending;
+	/// <summary>Tasks waiting for a deadline (bit n for task n)</summary>
+	static volatile unsigned int armed;
+	/// <summary>Deadlines of the armed tasks (ticks)</summary>
+	static volatile unsigned long deadlines[sizeof...(tasks)];
+
+	/// <summary>Run a statement with interrupts disabled, then restore GIE</summary>
+	template <typename Body>
+	static inline void Atomic(Body body)
+	{
+		unsigned int gie = __get_SR_register() & GIE;
+		__disable_interrupt();
+		__no_operation();
+		body();
+		if (gie)
+		{
+			__enable_interrupt();
+		}
+	}
+
+	/// <summary>Move the passed deadlines to the runnable tasks, find the nearest one left (called with interrupts disabled)</summary>
+	/// <param name="now">Current time (ticks)</param>
+	/// <param name="nearest">Nearest deadline output (valid when armed is not zero)</param>
+	static void CollectDeadlines(unsigned long now, unsigned long& nearest)
+	{
+		unsigned long distance = 0xFFFFFFFFUL;
+		for (MSP430_TaskId id = 0; id < TaskCount; id++)
+		{
+			unsigned int mask = 1u << id;
+			if (armed & mask)
+			{
+				unsigned long left = deadlines[id] - now;
+				if (static_cast<long> (left) <= 0)
+				{
+					armed = armed & ~mask;
+					pending = pending | mask;
+				}
+				else if (left < distance)
+				{
+					distance = left;
+					nearest = deadlines[id];
+				}
+			}
+		}
+	}
+
+public:
+	/// <summary>Number of tasks</summary>
+	static constexpr MSP430_TaskId TaskCount = sizeof...(tasks);
+
+	/// <summary>Get the Id of a task function</summary>
+	/// <typeparam name="task">Task function (must be in the task list)</typeparam>
+	template <MSP430_Task task>
+	static constexpr MSP430_TaskId IdOf(void)
+	{
+		for (MSP430_TaskId id = 0; id < TaskCount; id++)
+		{
+			if (taskTable[id] == task)
+			{
+				return id;
+			}
+		}
+		return TaskCount;
+	}
+
+	// Scheduler initialize
+	/// <summary>Start the timebase and clear all posts and deadlines</summary>
+	static void Initialize(void)
+	{
+		pending = 0;
+		armed = 0;
+		MSP430_SchedulerTimebase::Initialize();
+	}
+
+	// Wake-up sources
+	/// <summary>Make a task runnable (from an interrupt handler or another task, the scheduler loop wakes up)</summary>
+	/// <param name="id">Task Id</param>
+	static void Post(MSP430_TaskId id)
+	{
+		Atomic([=] { pending = pending | (1u << id); });
+		MSP430_WAKE();
+	}
+	/// <summary>Make a task runnable (from an interrupt handler or another task)</summary>
+	/// <typeparam name="task">Task function</typeparam>
+	template <MSP430_Task task>
+	static void Post(void)
+	{
+		static_assert(IdOf<task>() < TaskCount, "Task is not in the task list");
+		Post(IdOf<task>());
+	}
+	/// <summary>Make a task runnable at a time (replaces its previous deadline)</summary>
+	/// <param name="id">Task Id</param>
+	/// <param name="time">Deadline time (ticks of MSP430_SchedulerTimebase::Now())</param>
+	static void PostAt(MSP430_TaskId id, unsigned long time)
+	{
+		Atomic([=] { deadlines[id] = time; armed = armed | (1u << id); });
+		// The scheduler loop reprograms the alarm, the deadline may be nearer than the armed one
+		MSP430_WAKE();
+	}
+	/// <summary>Make a task runnable after a delay (replaces its previous deadline)</summary>
+	/// <param name="id">Task Id</param>
+	/// <param name="ticks">Delay (ticks, see MSP430_SchedulerTimebase::TicksOf())</param>
+	static void PostAfter(MSP430_TaskId id, unsigned long ticks)
+	{
+		PostAt(id, MSP430_SchedulerTimebase::Now() + ticks);
+	}
+	/// <summary>Make a task runnable after a delay (replaces its previous deadline)</summary>
+	/// <typeparam name="task">Task function</typeparam>
+	/// <param name="ticks">Delay (ticks, see MSP430_SchedulerTimebase::TicksOf())</param>
+	template <MSP430_Task task>
+	static void PostAfter(unsigned long ticks)
+	{
+		static_assert(IdOf<task>() < TaskCount, "Task is not in the task list");
+		PostAfter(IdOf<task>(), ticks);
+	}
+	/// <summary>Remove the post and the deadline of a task</summary>
+	/// <param name="id">Task Id</param>
+	static void Cancel(MSP430_TaskId id)
+	{
+		Atomic([=] { pending = pending & ~(1u << id); armed = armed & ~(1u << id); });
+	}
+
+	// Scheduler loop
+	/// <summary>Run the runnable tasks by priority until none is left (the highest priority is rechecked after each task)</summary>
+	/// <return>Number of tasks run</return>
+	static unsigned int Dispatch(void)
+	{
+		unsigned int count = 0;
+		for (;;)
+		{
+			unsigned int runnable = pending;
+			if (runnable == 0)
+			{
+				return count;
+			}
+
+			MSP430_TaskId id = 0;
+			while (!(runnable & (1u << id)))
+			{
+				id++;
+			}
+			Atomic([=] { pending = pending & ~(1u << id); });
+			taskTable[id]();
+			count++;
+		}
+	}
+	/// <summary>Collect the passed deadlines, sleep until the next wake-up source when nothing is runnable</summary>
+	static void Idle(void)
+	{
+		__disable_interrupt();
+		__no_operation();
+
+		unsigned long nearest = 0;
+		CollectDeadlines(MSP430_SchedulerTimebase::Now(), nearest);
+		if (pending == 0)
+		{
+			if (armed == 0)
+			{
+				MSP430_SchedulerTimebase::ClearAlarm();
+				MSP430_SchedulerTimebase::Sleep(false);
+			}
+			else if (MSP430_SchedulerTimebase::SetAlarm(nearest))
+			{
+				MSP430_SchedulerTimebase::Sleep(true);
+			}
+		}
+
+		__enable_interrupt();
+	}
+	/// <summary>Run the scheduler loop (never returns)</summary>
+	static void Run(void)
+	{
+		__enable_interrupt();
+		for (;;)
+		{
+			Dispatch();
+			Idle();
+		}
+	}
+};
+
+template <MSP430_Task... tasks>
+volatile unsigned int MSP430_Scheduler<tasks...>::pending = 0;
+template <MSP430_Task... tasks>
+volatile unsigned int MSP430_Scheduler<tasks...>::armed = 0;
+template <MSP430_Task... tasks>
+volatile unsigned long MSP430_Scheduler<tasks...>::deadlines[sizeof...(tasks)];
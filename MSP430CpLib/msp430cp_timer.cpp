@@ -0,0 +1,395 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_timer.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_trace.h"
+
+// Timer registers
+extern REG_16b const TxCTL[TIMER_COUNT];
+extern const unsigned char TxCHANNEL_COUNT[TIMER_COUNT];
+
+/// <summary>Hardware link from program to registers</summary>
+void MSP430_Timer::HardLink(void)
+{
+	this->reg_TxCTL = TxCTL[static_cast<int> (this->instance)];
+}
+
+/// <summary>SMCLK clocks per period, before the input divider</summary>
+static inline unsigned long ClocksOnSMCLK(unsigned long rate)
+{
+	return (rate == 0) ? 0x80000UL : (MSP430_Clock::SMCLKFrequency / rate);
+}
+
+/// <summary>Smallest input divider that fits the SMCLK clocks of a period into 16 bits (the drivers clocked by SMCLK)</summary>
+/// <param name="rate">Periods per second (0 for the longest period)</param>
+MSP430_Timer_Divider MSP430_Timer::DividerOnSMCLK(unsigned long rate)
+{
+	unsigned long clocks = ClocksOnSMCLK(rate);
+	unsigned int divider = 0;
+	while (clocks > 0x10000UL && divider < 3)
+	{
+		clocks >>= 1;
+		divider++;
+	}
+	return static_cast<MSP430_Timer_Divider> (divider);
+}
+
+/// <summary>Timer clocks per period on SMCLK after DividerOnSMCLK() (2 to 65536)</summary>
+/// <param name="rate">Periods per second (0 for the longest period)</param>
+unsigned long MSP430_Timer::PeriodOnSMCLK(unsigned long rate)
+{
+	unsigned long period = ClocksOnSMCLK(rate) >> static_cast<unsigned int> (DividerOnSMCLK(rate));
+	if (period > 0x10000UL)
+	{
+		period = 0x10000UL;
+	}
+	if (period < 2)
+	{
+		period = 2;
+	}
+	return period;
+}
+
+/// <summary>
+/// Load a period on SMCLK: TxCCR0 = period - 1, SMCLK and DividerOnSMCLK() in TxCTL
+/// <para>NOTE: The other TxCTL fields (mode, interrupt enable) are kept.</para>
+/// </summary>
+/// <param name="control">Control register (TxCTL)</param>
+/// <param name="rate">Periods per second (0 for the longest period)</param>
+/// <return>Timer clocks per period (2 to 65536)</return>
+unsigned long MSP430_Timer::SetPeriodOnSMCLK(MSP430_FieldRegister<MSP430_Timer_Control> control, unsigned long rate)
+{
+	unsigned long period = PeriodOnSMCLK(rate);
+	(control + OffsetCCR).Write(static_cast<unsigned int> (period - 1));
+	control.Modify(MSP430_Timer_Control::ClockSource::Of(MSP430_Timer_ClockSource::SMCLK) | MSP430_Timer_Control::Divider::Of(DividerOnSMCLK(rate)));
+	return period;
+}
+
+/// <summary>Create a new timer object, set the instance only and let other parameters to default</summary>
+/// <param name="instance">Timer instance</param>
+MSP430_Timer::MSP430_Timer(MSP430_Timer_Instance instance)
+{
+	this->instance = instance;
+
+	// Link the hardware
+	HardLink();
+}
+
+/// <summary>Create a new timer object, set the instance, clock source, divider and mode</summary>
+/// <param name="instance">Timer instance</param>
+/// <param name="clockSource">Clock source</param>
+/// <param name="divider">Input divider</param>
+/// <param name="mode">Mode used by Start()</param>
+MSP430_Timer::MSP430_Timer(MSP430_Timer_Instance instance, MSP430_Timer_ClockSource clockSource, MSP430_Timer_Divider divider, MSP430_Timer_Mode mode) : MSP430_Timer::MSP430_Timer(instance)
+{
+	this->clockSource = clockSource;
+	this->divider = divider;
+	this->mode = mode;
+}
+
+/// <summary>Create a new timer object, set the instance, clock source, divider, divider expansion and mode</summary>
+/// <param name="instance">Timer instance</param>
+/// <param name="clockSource">Clock source</param>
+/// <param name="divider">Input divider</param>
+/// <param name="dividerEx">Input divider expansion</param>
+/// <param name="mode">Mode used by Start()</param>
+MSP430_Timer::MSP430_Timer(MSP430_Timer_Instance instance, MSP430_Timer_ClockSource clockSource, MSP430_Timer_Divider divider, MSP430_Timer_DividerEx dividerEx, MSP430_Timer_Mode mode) : MSP430_Timer::MSP430_Timer(instance, clockSource, divider, mode)
+{
+	this->dividerEx = dividerEx;
+}
+
+/// <summary>Delete this timer instance, stop the hardware timer and reset the registers</summary>
+MSP430_Timer::~MSP430_Timer()
+{
+	Deinitialize();
+}
+
+/// <summary>Initialize the hardware timer by this timer instance (clock and divider selected, counter cleared, timer halted)</summary>
+void MSP430_Timer::Initialize(void)
+{
+	// Select the clock and divider, clear the counter
+	this->reg_TxCTL.Write(MSP430_Timer_Control::ClockSource::Of(this->clockSource) | MSP430_Timer_Control::Divider::Of(this->divider) | MSP430_Timer_Control::Clear::On);
+
+	// Set divider expansion
+	(this->reg_TxCTL + OffsetEX0).Write(static_cast<unsigned int> (this->dividerEx));
+}
+
+/// <summary>
+/// Deinitialize the hardware timer and set all registers to default.
+/// <para>(Default: Halted, all channels in compare mode with interrupts disabled)</para>
+/// </summary>
+void MSP430_Timer::Deinitialize(void)
+{
+	this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+	for (MSP430_Timer_Channel channel = 0; channel < GetChannelCount(); channel++)
+	{
+		CaptureControl(channel).Reset();
+	}
+	(this->reg_TxCTL + OffsetEX0).Write(0);
+}
+
+/// <summary>Get the number of capture/compare channels of the timer</summary>
+MSP430_Timer_Channel MSP430_Timer::GetChannelCount(void)
+{
+	return TxCHANNEL_COUNT[static_cast<int> (this->instance)];
+}
+
+/// <summary>Start the timer in the configured mode</summary>
+void MSP430_Timer::Start(void)
+{
+	Start(this->mode);
+}
+
+/// <summary>Start the timer in a mode</summary>
+/// <param name="mode">Timer mode</param>
+void MSP430_Timer::Start(MSP430_Timer_Mode mode)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(mode));
+}
+
+/// <summary>Halt the timer (the counter value is kept)</summary>
+void MSP430_Timer::Stop(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Stop));
+}
+
+/// <summary>Clear the counter, the input divider and the count direction</summary>
+void MSP430_Timer::Clear(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Clear::On);
+}
+
+/// <summary>
+/// Get the counter value (TxR)
+/// <para>NOTE: When the timer clock is asynchronous to MCLK, read it while halted, or use a majority vote.</para>
+/// </summary>
+unsigned int MSP430_Timer::GetCounter(void)
+{
+	return (this->reg_TxCTL + OffsetR).Read();
+}
+
+/// <summary>Set the period of Up/UpDown mode (CCR0 = period - 1)</summary>
+/// <param name="period">Timer clocks per period (Up mode)</param>
+void MSP430_Timer::SetPeriod(unsigned int period)
+{
+	(this->reg_TxCTL + OffsetCCR).Write(period - 1);
+}
+
+/// <summary>Enable the overflow interrupt (TAIFG/TBIFG, when the counter returns to zero)</summary>
+void MSP430_Timer::EnableOverflowInterrupt(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::InterruptEnable::On);
+}
+
+/// <summary>Disable the overflow interrupt</summary>
+void MSP430_Timer::DisableOverflowInterrupt(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::InterruptEnable::Off);
+}
+
+/// <summary>Check if the overflow flag was setted</summary>
+bool MSP430_Timer::CheckOverflowFlag(void)
+{
+	return this->reg_TxCTL.Test(MSP430_Timer_Control::InterruptFlag::On);
+}
+
+/// <summary>Clear the overflow flag</summary>
+void MSP430_Timer::ClearOverflowFlag(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::InterruptFlag::Off);
+}
+
+/// <summary>Set a channel to compare mode with a compare value</summary>
+/// <param name="channel">Capture/compare channel</param>
+/// <param name="value">Compare value (TxCCRn)</param>
+void MSP430_Timer::SetCompare(MSP430_Timer_Channel channel, unsigned int value)
+{
+	CaptureControl(channel).Modify(MSP430_Timer_CaptureControl::Capture::Off);
+	(this->reg_TxCTL + OffsetCCR + channel).Write(value);
+}
+
+/// <summary>Set the output mode of a channel (TAx.y output pin, select the pin's primary function to drive it)</summary>
+/// <param name="channel">Capture/compare channel</param>
+/// <param name="mode">Output mode</param>
+void MSP430_Timer::SetOutputMode(MSP430_Timer_Channel channel, MSP430_Timer_OutputMode mode)
+{
+	CaptureControl(channel).Modify(MSP430_Timer_CaptureControl::OutputMode::Of(mode));
+}
+
+/// <summary>Set a channel to capture mode (synchronized to the timer clock)</summary>
+/// <param name="channel">Capture/compare channel</param>
+/// <param name="edge">Capture edge</param>
+/// <param name="input">Capture input</param>
+void MSP430_Timer::SetCapture(MSP430_Timer_Channel channel, MSP430_Timer_CaptureEdge edge, MSP430_Timer_CaptureInput input)
+{
+	// Keep the interrupt enable, select capture mode, edge and input
+	CaptureControl(channel).Modify(MSP430_Timer_CaptureControl::CaptureEdge::Of(edge) | MSP430_Timer_CaptureControl::CaptureInput::Of(input) |
+		MSP430_Timer_CaptureControl::Synchronize::On | MSP430_Timer_CaptureControl::Capture::On | MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output) |
+		MSP430_Timer_CaptureControl::Output::Off | MSP430_Timer_CaptureControl::Overflow::Off | MSP430_Timer_CaptureControl::InterruptFlag::Off);
+}
+
+/// <summary>Get the captured value (or the compare value in compare mode)</summary>
+/// <param name="channel">Capture/compare channel</param>
+unsigned int MSP430_Timer::GetCapture(MSP430_Timer_Channel channel)
+{
+	return (this->reg_TxCTL + OffsetCCR + channel).Read();
+}
+
+/// <summary>Check if a capture was overwritten before it was read, and clear the overflow</summary>
+/// <param name="channel">Capture/compare channel</param>
+bool MSP430_Timer::CheckCaptureOverflow(MSP430_Timer_Channel channel)
+{
+	MSP430_FieldRegister<MSP430_Timer_CaptureControl> cctl = CaptureControl(channel);
+	bool overflow = cctl.Test(MSP430_Timer_CaptureControl::Overflow::On);
+	cctl.Modify(MSP430_Timer_CaptureControl::Overflow::Off);
+	return overflow;
+}
+
+/// <summary>Enable the capture/compare interrupt of a channel</summary>
+/// <param name="channel">Capture/compare channel</param>
+void MSP430_Timer::EnableInterrupt(MSP430_Timer_Channel channel)
+{
+	CaptureControl(channel).Modify(MSP430_Timer_CaptureControl::InterruptEnable::On);
+}
+
+/// <summary>Disable the capture/compare interrupt of a channel</summary>
+/// <param name="channel">Capture/compare channel</param>
+void MSP430_Timer::DisableInterrupt(MSP430_Timer_Channel channel)
+{
+	CaptureControl(channel).Modify(MSP430_Timer_CaptureControl::InterruptEnable::Off);
+}
+
+/// <summary>Check if the capture/compare interrupt flag of a channel was setted</summary>
+/// <param name="channel">Capture/compare channel</param>
+bool MSP430_Timer::CheckInterruptFlag(MSP430_Timer_Channel channel)
+{
+	return CaptureControl(channel).Test(MSP430_Timer_CaptureControl::InterruptFlag::On);
+}
+
+/// <summary>Clear the capture/compare interrupt flag of a channel</summary>
+/// <param name="channel">Capture/compare channel</param>
+void MSP430_Timer::ClearInterruptFlag(MSP430_Timer_Channel channel)
+{
+	CaptureControl(channel).Modify(MSP430_Timer_CaptureControl::InterruptFlag::Off);
+}
+
+/// <summary>Default handler for the timer interrupts without a registered handler</summary>
+extern "C" void MSP430_Timer_DefaultInterruptHandler(void)
+{
+}
+
+// Weak handler entry points, aliased to the default handler until MSP430_TIMER_INTERRUPT_HANDLER/MSP430_TIMER_OVERFLOW_HANDLER defines them
+#define MSP430CP_TIMER_WEAK_HANDLER(TIMER, CHANNEL) \
+	extern "C" void MSP430_Timer_##TIMER##_##CHANNEL##_InterruptHandler(void) __attribute__((weak, alias("MSP430_Timer_DefaultInterruptHandler")));
+
+#if TIMER_TA0_CHANNEL_COUNT > 0
+MSP430CP_TIMER_WEAK_HANDLER(TA0, 0)
+MSP430CP_TIMER_WEAK_HANDLER(TA0, 1)
+MSP430CP_TIMER_WEAK_HANDLER(TA0, 2)
+MSP430CP_TIMER_WEAK_HANDLER(TA0, 3)
+MSP430CP_TIMER_WEAK_HANDLER(TA0, 4)
+MSP430CP_TIMER_WEAK_HANDLER(TA0, Overflow)
+#endif
+#if TIMER_TA1_CHANNEL_COUNT > 0
+MSP430CP_TIMER_WEAK_HANDLER(TA1, 0)
+MSP430CP_TIMER_WEAK_HANDLER(TA1, 1)
+MSP430CP_TIMER_WEAK_HANDLER(TA1, 2)
+MSP430CP_TIMER_WEAK_HANDLER(TA1, Overflow)
+#endif
+#if TIMER_TA2_CHANNEL_COUNT > 0
+MSP430CP_TIMER_WEAK_HANDLER(TA2, 0)
+MSP430CP_TIMER_WEAK_HANDLER(TA2, 1)
+MSP430CP_TIMER_WEAK_HANDLER(TA2, 2)
+MSP430CP_TIMER_WEAK_HANDLER(TA2, Overflow)
+#endif
+#if TIMER_TB0_CHANNEL_COUNT > 0
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 0)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 1)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 2)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 3)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 4)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 5)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, 6)
+MSP430CP_TIMER_WEAK_HANDLER(TB0, Overflow)
+#endif
+
+/// <summary>
+/// TxIV handler tables (flash-resident)
+/// <para>TxIV is 2 * n for channel n and 0x0E for the overflow, so TxIV shifted right by 1 is the index directly.
+/// Index 0 (never read from TxIV) holds the CCR0 handler.</para>
+/// </summary>
+#if TIMER_TA0_CHANNEL_COUNT > 0
+static const MSP430_Timer_InterruptHandler TA0Handlers[8] =
+{
+	MSP430_Timer_TA0_0_InterruptHandler, MSP430_Timer_TA0_1_InterruptHandler,
+	MSP430_Timer_TA0_2_InterruptHandler, MSP430_Timer_TA0_3_InterruptHandler,
+	MSP430_Timer_TA0_4_InterruptHandler, MSP430_Timer_DefaultInterruptHandler,
+	MSP430_Timer_DefaultInterruptHandler, MSP430_Timer_TA0_Overflow_InterruptHandler
+};
+#endif
+#if TIMER_TA1_CHANNEL_COUNT > 0
+static const MSP430_Timer_InterruptHandler TA1Handlers[8] =
+{
+	MSP430_Timer_TA1_0_InterruptHandler, MSP430_Timer_TA1_1_InterruptHandler,
+	MSP430_Timer_TA1_2_InterruptHandler, MSP430_Timer_DefaultInterruptHandler,
+	MSP430_Timer_DefaultInterruptHandler, MSP430_Timer_DefaultInterruptHandler,
+	MSP430_Timer_DefaultInterruptHandler, MSP430_Timer_TA1_Overflow_InterruptHandler
+};
+#endif
+#if TIMER_TA2_CHANNEL_COUNT > 0
+static const MSP430_Timer_InterruptHandler TA2Handlers[8] =
+{
+	MSP430_Timer_TA2_0_InterruptHandler, MSP430_Timer_TA2_1_InterruptHandler,
+	MSP430_Timer_TA2_2_InterruptHandler, MSP430_Timer_DefaultInterruptHandler,
+	MSP430_Timer_DefaultInterruptHandler, MSP430_Timer_DefaultInterruptHandler,
+	MSP430_Timer_DefaultInterruptHandler, MSP430_Timer_TA2_Overflow_InterruptHandler
+};
+#endif
+#if TIMER_TB0_CHANNEL_COUNT > 0
+static const MSP430_Timer_InterruptHandler TB0Handlers[8] =
+{
+	MSP430_Timer_TB0_0_InterruptHandler, MSP430_Timer_TB0_1_InterruptHandler,
+	MSP430_Timer_TB0_2_InterruptHandler, MSP430_Timer_TB0_3_InterruptHandler,
+	MSP430_Timer_TB0_4_InterruptHandler, MSP430_Timer_TB0_5_InterruptHandler,
+	MSP430_Timer_TB0_6_InterruptHandler, MSP430_Timer_TB0_Overflow_InterruptHandler
+};
+#endif
+
+#ifndef TIMER_USER_ISR
+/// <summary>Define the CCR0 and TxIV interrupt service routines of a timer</summary>
+#define MSP430CP_TIMER_ISR(TIMER, VECTOR0, VECTOR1) \
+	REG_ISR(VECTOR0, MSP430_Timer_##TIMER##_CCR0_ISR) \
+	{ \
+		MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::TIMER##_CCR0); \
+		/* CCR0 flag is cleared automatically when the interrupt is accepted */ \
+		TIMER##Handlers[0](); \
+		MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::TIMER##_CCR0); \
+		REG_ISR_EXIT(); \
+	} \
+	REG_ISR(VECTOR1, MSP430_Timer_##TIMER##_IV_ISR) \
+	{ \
+		MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::TIMER##_IV); \
+		/* Reading TxIV returns the highest priority pending source and clears its flag */ \
+		unsigned int iv; \
+		while ((iv = TIMER##IV) != 0) \
+		{ \
+			MSP430_TRACE(MSP430_Trace_Id::InterruptDispatch, iv >> 1); \
+			TIMER##Handlers[__even_in_range(iv, 0x0E) >> 1](); \
+		} \
+		MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::TIMER##_IV); \
+		REG_ISR_EXIT(); \
+	}
+
+#if TIMER_TA0_CHANNEL_COUNT > 0
+MSP430CP_TIMER_ISR(TA0, TIMER0_A0_VECTOR, TIMER0_A1_VECTOR)
+#endif
+#if TIMER_TA1_CHANNEL_COUNT > 0
+MSP430CP_TIMER_ISR(TA1, TIMER1_A0_VECTOR, TIMER1_A1_VECTOR)
+#endif
+#if TIMER_TA2_CHANNEL_COUNT > 0
+MSP430CP_TIMER_ISR(TA2, TIMER2_A0_VECTOR, TIMER2_A1_VECTOR)
+#endif
+#if TIMER_TB0_CHANNEL_COUNT > 0
+MSP430CP_TIMER_ISR(TB0, TIMER0_B0_VECTOR, TIMER0_B1_VECTOR)
+#endif
+#endif
@@ -1,4 +1,621 @@
+#pragma once
+
 #include <msp430.h>
+#include "msp430cp_device.h"
 #include "msp430cp_registers.h"
 
+// Timer location enumerations and definations
+/// <summary>
+/// Timer instance (Timer_A with 5/3/3 capture/compare channels, Timer_B with 7 capture/compare channels)
+/// <para>NOTE: The timer is usable or not, is depending on the device, see also the device's datasheet to get more information.</para>
+/// </summary>
+enum class MSP430_Timer_Instance
+{
+	TA0,
+	TA1,
+	TA2,
+	TB0
+};
+
+/// <summary>
+/// Timer capture/compare channel Id (CCR0 to CCR6)
+/// </summary>
+typedef unsigned char MSP430_Timer_Channel;
+
+// Timer configurations enumerations
+/// <summary>
+/// Timer Clock Source (Results in TASSEL/TBSSEL bits)
+/// </summary>
+enum class MSP430_Timer_ClockSource
+{
+	/// <summary>External clock TxCLK</summary>
+	External = 0b00,
+	ACLK = 0b01,
+	SMCLK = 0b10,
+	/// <summary>Inverted external clock TxCLK (INCLK on some devices)</summary>
+	InvertedExternal = 0b11
+};
+
+/// <summary>
+/// Timer Input Divider (Results in ID bits)
+/// </summary>
+enum class MSP430_Timer_Divider
+{
+	Div1 = 0b00,
+	Div2 = 0b01,
+	Div4 = 0b10,
+	Div8 = 0b11
+};
+
+/// <summary>
+/// Timer Input Divider Expansion (Results in TAIDEX/TBIDEX bits, applied after the input divider)
+/// </summary>
+enum class MSP430_Timer_DividerEx
+{
+	Div1 = 0,
+	Div2 = 1,
+	Div3 = 2,
+	Div4 = 3,
+	Div5 = 4,
+	Div6 = 5,
+	Div7 = 6,
+	Div8 = 7
+};
+
+/// <summary>
+/// Timer Mode Control (Results in MC bits)
+/// </summary>
+enum class MSP430_Timer_Mode
+{
+	/// <summary>Timer is halted</summary>
+	Stop = 0b00,
+	/// <summary>Timer counts up to CCR0, then restarts from zero</summary>
+	Up = 0b01,
+	/// <summary>Timer counts up to 0xFFFF, then restarts from zero</summary>
+	Continuous = 0b10,
+	/// <summary>Timer counts up to CCR0, then down to zero</summary>
+	UpDown = 0b11
+};
+
+/// <summary>
+/// Timer Capture Mode (Results in CM bits)
+/// </summary>
+enum class MSP430_Timer_CaptureEdge
+{
+	None = 0b00,
+	/// <summary>Capture on rising edge</summary>
+	Posedge = 0b01,
+	/// <summary>Capture on falling edge</summary>
+	Negedge = 0b10,
+	/// <summary>Capture on both edges</summary>
+	Both = 0b11
+};
+
+/// <summary>
+/// Timer Capture Input Select (Results in CCIS bits)
+/// <para>See also the device's datasheet for the signal connected to CCIxA/CCIxB of each channel.</para>
+/// </summary>
+enum class MSP430_Timer_CaptureInput
+{
+	CCIxA = 0b00,
+	CCIxB = 0b01,
+	GND = 0b10,
+	VCC = 0b11
+};
+
+/// <summary>
+/// Timer Output Mode (Results in OUTMOD bits)
+/// <para>NOTE: Modes 2, 3, 6 and 7 are not useful for CCR0 (EQUx = EQU0).</para>
+/// </summary>
+enum class MSP430_Timer_OutputMode
+{
+	/// <summary>Output is the OUT bit</summary>
+	Output = 0,
+	Set = 1,
+	ToggleReset = 2,
+	SetReset = 3,
+	Toggle = 4,
+	Reset = 5,
+	ToggleSet = 6,
+	ResetSet = 7
+};
+
+// Register fields
+/// <summary>
+/// Timer control register fields (TxCTL)
+/// </summary>
+struct MSP430_Timer_Control
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>Clock source (TASSEL/TBSSEL)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_Control, 8, 2, MSP430_Timer_ClockSource> ClockSource;
+	/// <summary>Input divider (ID)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_Control, 6, 2, MSP430_Timer_Divider> Divider;
+	/// <summary>Mode control (MC)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_Control, 4, 2, MSP430_Timer_Mode> Mode;
+	/// <summary>Counter, divider and direction clear (TACLR/TBCLR, reads as 0)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_Control, 2, 1, bool> Clear;
+	/// <summary>Overflow interrupt enable (TAIE/TBIE)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_Control, 1, 1, bool> InterruptEnable;
+	/// <summary>Overflow interrupt flag (TAIFG/TBIFG)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_Control, 0, 1, bool> InterruptFlag;
+};
+
+/// <summary>
+/// Timer capture/compare control register fields (TxCCTLn)
+/// </summary>
+struct MSP430_Timer_CaptureControl
+{
+	typedef MSP430_RegisterWord Type;
+	/// <summary>Capture edge (CM)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 14, 2, MSP430_Timer_CaptureEdge> CaptureEdge;
+	/// <summary>Capture input (CCIS)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 12, 2, MSP430_Timer_CaptureInput> CaptureInput;
+	/// <summary>Capture synchronized to the timer clock (SCS)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 11, 1, bool> Synchronize;
+	/// <summary>Compare latch load (CLLD, Timer_B only: 0 at once, 1 at counter zero, 2/3 at the period boundaries)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 9, 2> CompareLoad;
+	/// <summary>Capture mode (CAP, 0: compare mode)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 8, 1, bool> Capture;
+	/// <summary>Output mode (OUTMOD)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 5, 3, MSP430_Timer_OutputMode> OutputMode;
+	/// <summary>Capture/compare interrupt enable (CCIE)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 4, 1, bool> InterruptEnable;
+	/// <summary>Output level of output mode 0 (OUT)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 2, 1, bool> Output;
+	/// <summary>Capture overflow (COV)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 1, 1, bool> Overflow;
+	/// <summary>Capture/compare interrupt flag (CCIFG)</summary>
+	typedef MSP430_RegisterField<MSP430_Timer_CaptureControl, 0, 1, bool> InterruptFlag;
+};
+
+// Interrupt handlers
+/// <summary>Timer interrupt handler (called in interrupt context, the interrupt flag is already cleared)</summary>
+typedef void (*MSP430_Timer_InterruptHandler)(void);
+
+/// <summary>
+/// Define the capture/compare interrupt handler of a timer channel
+/// <para>TIMER is the timer name (TA0, TA1, TA2 or TB0), CHANNEL is the channel id. Follow the macro by the handler body.</para>
+/// <para>The handler is called by the library interrupt routine: use MSP430_WAKE() to return to active mode, not __bic_SR_register_on_exit().</para>
+/// </summary>
+#define MSP430_TIMER_INTERRUPT_HANDLER(TIMER, CHANNEL) extern "C" void MSP430_Timer_##TIMER##_##CHANNEL##_InterruptHandler(void)
+/// <summary>
+/// Define the overflow (TAIFG/TBIFG) interrupt handler of a timer
+/// <para>TIMER is the timer name (TA0, TA1, TA2 or TB0). Follow the macro by the handler body.</para>
+/// </summary>
+#define MSP430_TIMER_OVERFLOW_HANDLER(TIMER) extern "C" void MSP430_Timer_##TIMER##_Overflow_InterruptHandler(void)
+
+/// <summary>Default handler for the timer interrupts without a registered handler</summary>
+extern "C" void MSP430_Timer_DefaultInterruptHandler(void);
+
+// Handler entry points (weak, overridden by MSP430_TIMER_INTERRUPT_HANDLER/MSP430_TIMER_OVERFLOW_HANDLER)
+MSP430_TIMER_INTERRUPT_HANDLER(TA0, 0);
+MSP430_TIMER_INTERRUPT_HANDLER(TA0, 1);
+MSP430_TIMER_INTERRUPT_HANDLER(TA0, 2);
+MSP430_TIMER_INTERRUPT_HANDLER(TA0, 3);
+MSP430_TIMER_INTERRUPT_HANDLER(TA0, 4);
+MSP430_TIMER_OVERFLOW_HANDLER(TA0);
+MSP430_TIMER_INTERRUPT_HANDLER(TA1, 0);
+MSP430_TIMER_INTERRUPT_HANDLER(TA1, 1);
+MSP430_TIMER_INTERRUPT_HANDLER(TA1, 2);
+MSP430_TIMER_OVERFLOW_HANDLER(TA1);
+MSP430_TIMER_INTERRUPT_HANDLER(TA2, 0);
+MSP430_TIMER_INTERRUPT_HANDLER(TA2, 1);
+MSP430_TIMER_INTERRUPT_HANDLER(TA2, 2);
+MSP430_TIMER_OVERFLOW_HANDLER(TA2);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 0);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 1);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 2);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 3);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 4);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 5);
+MSP430_TIMER_INTERRUPT_HANDLER(TB0, 6);
+MSP430_TIMER_OVERFLOW_HANDLER(TB0);
+
+/// <summary>
+/// MSP430 Timer_A/Timer_B class
+/// <para>The timer registers are reached from the control register by the 5xx/6xx register layout
+/// (TxCTL, TxCCTL0-6, TxR, TxCCR0-6, TxEX0, TxIV).</para>
+/// <para>Interrupts are dispatched by the library's interrupt service routines: CCR0 by its own vector,
+/// the other channels and the overflow by TxIV. Define the handlers with MSP430_TIMER_INTERRUPT_HANDLER/MSP430_TIMER_OVERFLOW_HANDLER.</para>
+/// </summary>
+class MSP430_Timer
+{
+private:
+	// Register for hardware operation
+
+	/// <summary>Control register (TxCTL), the base of the other registers</summary>
+	MSP430_FieldRegister<MSP430_Timer_Control> reg_TxCTL;
+
+	// Corresponding timer location
+	/// <summary>Timer instance</summary>
+	MSP430_Timer_Instance instance;
+
+	// Corresponding timer configuration
+	/// <summary>Clock source</summary>
+	MSP430_Timer_ClockSource clockSource = MSP430_Timer_ClockSource::SMCLK;
+	/// <summary>Input divider</summary>
+	MSP430_Timer_Divider divider = MSP430_Timer_Divider::Div1;
+	/// <summary>Input divider expansion</summary>
+	MSP430_Timer_DividerEx dividerEx = MSP430_Timer_DividerEx::Div1;
+	/// <summary>Mode used by Start()</summary>
+	MSP430_Timer_Mode mode = MSP430_Timer_Mode::Continuous;
+
+	// Private low-level linking functions
+	/// <summary>Hardware link from program to registers</summary>
+	void HardLink(void);
+	/// <summary>Capture/compare control register of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	MSP430_FieldRegister<MSP430_Timer_CaptureControl> CaptureControl(MSP430_Timer_Channel channel) const
+	{
+		return CaptureControlOf(this->reg_TxCTL, channel);
+	}
+
+public:
+	// Register word offsets from TxCTL
+	/// <summary>TxCCTL0 offset (TxCCTLn = TxCTL + OffsetCCTL + n)</summary>
+	static constexpr int OffsetCCTL = 1;
+	/// <summary>TxR offset</summary>
+	static constexpr int OffsetR = 8;
+	/// <summary>TxCCR0 offset (TxCCRn = TxCTL + OffsetCCR + n)</summary>
+	static constexpr int OffsetCCR = 9;
+	/// <summary>TxEX0 offset</summary>
+	static constexpr int OffsetEX0 = 16;
+
+	/// <summary>Typed capture/compare control register of a channel (the other drivers reach TxCCTLn from a TxCTL table entry)</summary>
+	/// <param name="control">Control register (TxCTL)</param>
+	/// <param name="channel">Capture/compare channel</param>
+	static MSP430_FieldRegister<MSP430_Timer_CaptureControl> CaptureControlOf(MSP430_Register16 control, MSP430_Timer_Channel channel)
+	{
+		return (control + OffsetCCTL + channel).Address();
+	}
+	/// <summary>Smallest input divider that fits the SMCLK clocks of a period into 16 bits (the drivers clocked by SMCLK)</summary>
+	/// <param name="rate">Periods per second (0 for the longest period)</param>
+	static MSP430_Timer_Divider DividerOnSMCLK(unsigned long rate);
+	/// <summary>Timer clocks per period on SMCLK after DividerOnSMCLK() (2 to 65536)</summary>
+	/// <param name="rate">Periods per second (0 for the longest period)</param>
+	static unsigned long PeriodOnSMCLK(unsigned long rate);
+	/// <summary>
+	/// Load a period on SMCLK: TxCCR0 = period - 1, SMCLK and DividerOnSMCLK() in TxCTL
+	/// <para>NOTE: The other TxCTL fields (mode, interrupt enable) are kept.</para>
+	/// </summary>
+	/// <param name="control">Control register (TxCTL)</param>
+	/// <param name="rate">Periods per second (0 for the longest period)</param>
+	/// <return>Timer clocks per period (2 to 65536)</return>
+	static unsigned long SetPeriodOnSMCLK(MSP430_FieldRegister<MSP430_Timer_Control> control, unsigned long rate);
+
+	// Constructor
+	/// <summary>Create a new timer object, set the instance only and let other parameters to default</summary>
+	/// <param name="instance">Timer instance</param>
+	MSP430_Timer(MSP430_Timer_Instance instance);
+	/// <summary>Create a new timer object, set the instance, clock source, divider and mode</summary>
+	/// <param name="instance">Timer instance</param>
+	/// <param name="clockSource">Clock source</param>
+	/// <param name="divider">Input divider</param>
+	/// <param name="mode">Mode used by Start()</param>
+	MSP430_Timer(MSP430_Timer_Instance instance, MSP430_Timer_ClockSource clockSource, MSP430_Timer_Divider divider, MSP430_Timer_Mode mode);
+	/// <summary>Create a new timer object, set the instance, clock source, divider, divider expansion and mode</summary>
+	/// <param name="instance">Timer instance</param>
+	/// <param name="clockSource">Clock source</param>
+	/// <param name="divider">Input divider</param>
+	/// <param name="dividerEx">Input divider expansion</param>
+	/// <param name="mode">Mode used by Start()</param>
+	MSP430_Timer(MSP430_Timer_Instance instance, MSP430_Timer_ClockSource clockSource, MSP430_Timer_Divider divider, MSP430_Timer_DividerEx dividerEx, MSP430_Timer_Mode mode);
+	/// <summary>Delete this timer instance, stop the hardware timer and reset the registers</summary>
+	~MSP430_Timer();
+
+	// Timer initialize or re-configuration
+	/// <summary>Initialize the hardware timer by this timer instance (clock and divider selected, counter cleared, timer halted)</summary>
+	void Initialize(void);
+	/// <summary>
+	/// Deinitialize the hardware timer and set all registers to default.
+	/// <para>(Default: Halted, all channels in compare mode with interrupts disabled)</para>
+	/// </summary>
+	void Deinitialize(void);
+	/// <summary>Get the number of capture/compare channels of the timer</summary>
+	MSP430_Timer_Channel GetChannelCount(void);
+
+	// Counter control
+	/// <summary>Start the timer in the configured mode</summary>
+	void Start(void);
+	/// <summary>Start the timer in a mode</summary>
+	/// <param name="mode">Timer mode</param>
+	void Start(MSP430_Timer_Mode mode);
+	/// <summary>Halt the timer (the counter value is kept)</summary>
+	void Stop(void);
+	/// <summary>Clear the counter, the input divider and the count direction</summary>
+	void Clear(void);
+	/// <summary>
+	/// Get the counter value (TxR)
+	/// <para>NOTE: When the timer clock is asynchronous to MCLK, read it while halted, or use a majority vote.</para>
+	/// </summary>
+	unsigned int GetCounter(void);
+	/// <summary>Set the period of Up/UpDown mode (CCR0 = period - 1)</summary>
+	/// <param name="period">Timer clocks per period (Up mode)</param>
+	void SetPeriod(unsigned int period);
+
+	// Overflow interrupt
+	/// <summary>Enable the overflow interrupt (TAIFG/TBIFG, when the counter returns to zero)</summary>
+	void EnableOverflowInterrupt(void);
+	/// <summary>Disable the overflow interrupt</summary>
+	void DisableOverflowInterrupt(void);
+	/// <summary>Check if the overflow flag was setted</summary>
+	bool CheckOverflowFlag(void);
+	/// <summary>Clear the overflow flag</summary>
+	void ClearOverflowFlag(void);
+
+	// Compare channels
+	/// <summary>Set a channel to compare mode with a compare value</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	/// <param name="value">Compare value (TxCCRn)</param>
+	void SetCompare(MSP430_Timer_Channel channel, unsigned int value);
+	/// <summary>Set the output mode of a channel (TAx.y output pin, select the pin's primary function to drive it)</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	/// <param name="mode">Output mode</param>
+	void SetOutputMode(MSP430_Timer_Channel channel, MSP430_Timer_OutputMode mode);
+
+	// Capture channels
+	/// <summary>Set a channel to capture mode (synchronized to the timer clock)</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	/// <param name="edge">Capture edge</param>
+	/// <param name="input">Capture input</param>
+	void SetCapture(MSP430_Timer_Channel channel, MSP430_Timer_CaptureEdge edge, MSP430_Timer_CaptureInput input);
+	/// <summary>Get the captured value (or the compare value in compare mode)</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	unsigned int GetCapture(MSP430_Timer_Channel channel);
+	/// <summary>Check if a capture was overwritten before it was read, and clear the overflow</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	bool CheckCaptureOverflow(MSP430_Timer_Channel channel);
+
+	// Channel interrupts
+	/// <summary>Enable the capture/compare interrupt of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	void EnableInterrupt(MSP430_Timer_Channel channel);
+	/// <summary>Disable the capture/compare interrupt of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	void DisableInterrupt(MSP430_Timer_Channel channel);
+	/// <summary>Check if the capture/compare interrupt flag of a channel was setted</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	bool CheckInterruptFlag(MSP430_Timer_Channel channel);
+	/// <summary>Clear the capture/compare interrupt flag of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	void ClearInterruptFlag(MSP430_Timer_Channel channel);
+};
+
+// Compile-time timer register map
+/// <summary>
+/// Timer register map resolved at compile time
+/// <para>Each specialization returns handles of the timer registers built from constant addresses, so the compiler can use absolute addressing.</para>
+/// </summary>
+template <MSP430_Timer_Instance instance>
+struct MSP430_Timer_Registers;
+
+/// <summary>Define the compile-time register map of a timer</summary>
+#define MSP430CP_TIMER_REGISTERS(TIMER, CHANNELS) \
+	template <> \
+	struct MSP430_Timer_Registers<MSP430_Timer_Instance::TIMER> \
+	{ \
+		static constexpr MSP430_Timer_Channel ChannelCount = CHANNELS; \
+		static MSP430_FieldRegister<MSP430_Timer_Control> TxCTL(void) { return &TIMER##CTL; } \
+		static MSP430_Register16 TxR(void) { return &TIMER##R; } \
+		static MSP430_Register16 TxEX0(void) { return &TIMER##EX0; } \
+		static MSP430_Register16 TxIV(void) { return &TIMER##IV; } \
+		static MSP430_FieldRegister<MSP430_Timer_CaptureControl> TxCCTL(MSP430_Timer_Channel channel) { return &TIMER##CCTL0 + channel; } \
+		static MSP430_Register16 TxCCR(MSP430_Timer_Channel channel) { return &TIMER##CCR0 + channel; } \
+	};
+
+// Only the timers of the device get a map (using another one fails to compile)
+#if TIMER_TA0_CHANNEL_COUNT > 0
+MSP430CP_TIMER_REGISTERS(TA0, TIMER_TA0_CHANNEL_COUNT)
+#endif
+#if TIMER_TA1_CHANNEL_COUNT > 0
+MSP430CP_TIMER_REGISTERS(TA1, TIMER_TA1_CHANNEL_COUNT)
+#endif
+#if TIMER_TA2_CHANNEL_COUNT > 0
+MSP430CP_TIMER_REGISTERS(TA2, TIMER_TA2_CHANNEL_COUNT)
+#endif
+#if TIMER_TB0_CHANNEL_COUNT > 0
+MSP430CP_TIMER_REGISTERS(TB0, TIMER_TB0_CHANNEL_COUNT)
+#endif
+
+/// <summary>
+/// MSP430 Timer_A/Timer_B class resolved at compile time
+/// <para>The instance and the clock configuration are template parameters, so the instance holds no register pointers,
+/// and operations on a constant channel compile to single instructions on absolute register addresses.</para>
+/// <para>The methods are the same as MSP430_Timer.</para>
+/// </summary>
+/// <typeparam name="instance">Timer instance</typeparam>
+/// <typeparam name="clockSource">Clock source used by Initialize()</typeparam>
+/// <typeparam name="divider">Input divider used by Initialize()</typeparam>
+/// <typeparam name="dividerEx">Input divider expansion used by Initialize()</typeparam>
+/// <typeparam name="initMode">Mode used by Start()</typeparam>
+template <MSP430_Timer_Instance instance,
+	MSP430_Timer_ClockSource clockSource = MSP430_Timer_ClockSource::SMCLK,
+	MSP430_Timer_Divider divider = MSP430_Timer_Divider::Div1,
+	MSP430_Timer_DividerEx dividerEx = MSP430_Timer_DividerEx::Div1,
+	MSP430_Timer_Mode initMode = MSP430_Timer_Mode::Continuous>
+class MSP430_StaticTimer
+{
+private:
+	// Register for hardware operation
+	typedef MSP430_Timer_Registers<instance> Registers;
+
+public:
+	/// <summary>Timer instance</summary>
+	static constexpr MSP430_Timer_Instance Instance = instance;
+
+	// Constructor
+	/// <summary>Create a new compile-time timer object (No hardware operation)</summary>
+	MSP430_StaticTimer() = default;
+	/// <summary>Delete this timer instance, stop the hardware timer and reset the registers</summary>
+	~MSP430_StaticTimer()
+	{
+		Deinitialize();
+	}
+
+	// Timer initialize or re-configuration
+	/// <summary>Initialize the hardware timer by the template configuration (counter cleared, timer halted)</summary>
+	static void Initialize(void)
+	{
+		Registers::TxCTL().Write(MSP430_Timer_Control::ClockSource::Of(clockSource) | MSP430_Timer_Control::Divider::Of(divider) | MSP430_Timer_Control::Clear::On);
+		Registers::TxEX0().Write(static_cast<MSP430_RegisterWord> (dividerEx));
+	}
+	/// <summary>
+	/// Deinitialize the hardware timer and set all registers to default.
+	/// <para>(Default: Halted, all channels in compare mode with interrupts disabled)</para>
+	/// </summary>
+	static void Deinitialize(void)
+	{
+		Registers::TxCTL().Write(MSP430_Timer_Control::Clear::On);
+		for (MSP430_Timer_Channel channel = 0; channel < Registers::ChannelCount; channel++)
+		{
+			Registers::TxCCTL(channel).Reset();
+		}
+		Registers::TxEX0().Write(0);
+	}
+	/// <summary>Get the number of capture/compare channels of the timer</summary>
+	static constexpr MSP430_Timer_Channel GetChannelCount(void)
+	{
+		return Registers::ChannelCount;
+	}
+
+	// Counter control
+	/// <summary>Start the timer in the configured mode</summary>
+	static void Start(void)
+	{
+		Start(initMode);
+	}
+	/// <summary>Start the timer in a mode</summary>
+	/// <param name="mode">Timer mode</param>
+	static void Start(MSP430_Timer_Mode mode)
+	{
+		Registers::TxCTL().Modify(MSP430_Timer_Control::Mode::Of(mode));
+	}
+	/// <summary>Halt the timer (the counter value is kept)</summary>
+	static void Stop(void)
+	{
+		Registers::TxCTL().Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Stop));
+	}
+	/// <summary>Clear the counter, the input divider and the count direction</summary>
+	static void Clear(void)
+	{
+		Registers::TxCTL().Modify(MSP430_Timer_Control::Clear::On);
+	}
+	/// <summary>Get the counter value (TxR)</summary>
+	static unsigned int GetCounter(void)
+	{
+		return Registers::TxR().Read();
+	}
+	/// <summary>Set the period of Up/UpDown mode (CCR0 = period - 1)</summary>
+	/// <param name="period">Timer clocks per period (Up mode)</param>
+	static void SetPeriod(unsigned int period)
+	{
+		Registers::TxCCR(0).Write(period - 1);
+	}
+
+	// Overflow interrupt
+	/// <summary>Enable the overflow interrupt (TAIFG/TBIFG, when the counter returns to zero)</summary>
+	static void EnableOverflowInterrupt(void)
+	{
+		Registers::TxCTL().Modify(MSP430_Timer_Control::InterruptEnable::On);
+	}
+	/// <summary>Disable the overflow interrupt</summary>
+	static void DisableOverflowInterrupt(void)
+	{
+		Registers::TxCTL().Modify(MSP430_Timer_Control::InterruptEnable::Off);
+	}
+	/// <summary>Check if the overflow flag was setted</summary>
+	static bool CheckOverflowFlag(void)
+	{
+		return Registers::TxCTL().Test(MSP430_Timer_Control::InterruptFlag::On);
+	}
+	/// <summary>Clear the overflow flag</summary>
+	static void ClearOverflowFlag(void)
+	{
+		Registers::TxCTL().Modify(MSP430_Timer_Control::InterruptFlag::Off);
+	}
+
+	// Compare channels
+	/// <summary>Set a channel to compare mode with a compare value</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	/// <param name="value">Compare value (TxCCRn)</param>
+	static void SetCompare(MSP430_Timer_Channel channel, unsigned int value)
+	{
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::Capture::Off);
+		Registers::TxCCR(channel).Write(value);
+	}
+	/// <summary>Set the output mode of a channel (TAx.y output pin, select the pin's primary function to drive it)</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	/// <param name="mode">Output mode</param>
+	static void SetOutputMode(MSP430_Timer_Channel channel, MSP430_Timer_OutputMode mode)
+	{
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::OutputMode::Of(mode));
+	}
+
+	// Capture channels
+	/// <summary>Set a channel to capture mode (synchronized to the timer clock)</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	/// <param name="edge">Capture edge</param>
+	/// <param name="input">Capture input</param>
+	static void SetCapture(MSP430_Timer_Channel channel, MSP430_Timer_CaptureEdge edge, MSP430_Timer_CaptureInput input)
+	{
+		// Keep the interrupt enable, select capture mode, edge and input
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::CaptureEdge::Of(edge) | MSP430_Timer_CaptureControl::CaptureInput::Of(input) |
+			MSP430_Timer_CaptureControl::Synchronize::On | MSP430_Timer_CaptureControl::Capture::On | MSP430_Timer_CaptureControl::OutputMode::Of(MSP430_Timer_OutputMode::Output) |
+			MSP430_Timer_CaptureControl::Output::Off | MSP430_Timer_CaptureControl::Overflow::Off | MSP430_Timer_CaptureControl::InterruptFlag::Off);
+	}
+	/// <summary>Get the captured value (or the compare value in compare mode)</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	static unsigned int GetCapture(MSP430_Timer_Channel channel)
+	{
+		return Registers::TxCCR(channel).Read();
+	}
+	/// <summary>Check if a capture was overwritten before it was read, and clear the overflow</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	static bool CheckCaptureOverflow(MSP430_Timer_Channel channel)
+	{
+		bool overflow = Registers::TxCCTL(channel).Test(MSP430_Timer_CaptureControl::Overflow::On);
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::Overflow::Off);
+		return overflow;
+	}
+
+	// Channel interrupts
+	/// <summary>Enable the capture/compare interrupt of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	static void EnableInterrupt(MSP430_Timer_Channel channel)
+	{
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::InterruptEnable::On);
+	}
+	/// <summary>Disable the capture/compare interrupt of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	static void DisableInterrupt(MSP430_Timer_Channel channel)
+	{
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::InterruptEnable::Off);
+	}
+	/// <summary>Check if the capture/compare interrupt flag of a channel was setted</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	static bool CheckInterruptFlag(MSP430_Timer_Channel channel)
+	{
+		return Registers::TxCCTL(channel).Test(MSP430_Timer_CaptureControl::InterruptFlag::On);
+	}
+	/// <summary>Clear the capture/compare interrupt flag of a channel</summary>
+	/// <param name="channel">Capture/compare channel</param>
+	static void ClearInterruptFlag(MSP430_Timer_Channel channel)
+	{
+		Registers::TxCCTL(channel).Modify(MSP430_Timer_CaptureControl::InterruptFlag::Off);
+	}
+};
 
+#ifdef MSP430CP_HOST
+#ifndef TIMER_USER_ISR
+// Interrupt service routines (plain functions on host)
+void MSP430_Timer_TA0_CCR0_ISR(void);
+void MSP430_Timer_TA0_IV_ISR(void);
+void MSP430_Timer_TA1_CCR0_ISR(void);
+void MSP430_Timer_TA1_IV_ISR(void);
+void MSP430_Timer_TA2_CCR0_ISR(void);
+void MSP430_Timer_TA2_IV_ISR(void);
+void MSP430_Timer_TB0_CCR0_ISR(void);
+void MSP430_Timer_TB0_IV_ISR(void);
+#endif
+#endif
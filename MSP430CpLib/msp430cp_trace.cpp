@@ -0,0 +1,104 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_trace.h"
+
+#ifdef TRACE_ENABLE
+#include "msp430cp_clock.h"
+#include "msp430cp_uart.h"
+
+/// <summary>Trace ring (header initialized at startup, entries zero = None)</summary>
+MSP430_Trace_Buffer msp430cp_trace = {
+	MSP430_Trace::Magic, sizeof(MSP430_Trace_Entry), MSP430_Trace::Version, TRACE_CAPACITY, 0, TRACE_TIMESTAMP_FREQUENCY, {}
+};
+
+/// <summary>Events are recorded</summary>
+static volatile bool recording = true;
+
+/// <summary>Record an event (interrupt-safe, nothing while stopped)</summary>
+/// <param name="id">Event id</param>
+/// <param name="argument">Event argument</param>
+void MSP430_Trace::Record(MSP430_Trace_Id id, unsigned char argument)
+{
+	// The timestamp is taken inside the critical section, so the entries stay in time order
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	if (recording)
+	{
+		unsigned int head = msp430cp_trace.head;
+		MSP430_Trace_Entry& entry = msp430cp_trace.entries[head & (TRACE_CAPACITY - 1)];
+		entry.id = static_cast<uint8_t> (id);
+		entry.argument = argument;
+		entry.timestamp = TRACE_TIMESTAMP;
+		// 65536 is a multiple of the capacity: wrapping to the capacity keeps the index and the count of a full ring
+		head = head + 1;
+		msp430cp_trace.head = (head & 0xFFFF) ? head : TRACE_CAPACITY;
+	}
+	__bis_SR_register(gie);
+}
+
+/// <summary>Resume recording</summary>
+void MSP430_Trace::Start(void)
+{
+	recording = true;
+}
+
+/// <summary>Freeze the ring (events are dropped until Start())</summary>
+void MSP430_Trace::Stop(void)
+{
+	recording = false;
+}
+
+/// <summary>Check if events are recorded</summary>
+bool MSP430_Trace::IsRecording(void)
+{
+	return recording;
+}
+
+/// <summary>Empty the ring</summary>
+void MSP430_Trace::Clear(void)
+{
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+	for (unsigned int i = 0; i < TRACE_CAPACITY; i++)
+	{
+		msp430cp_trace.entries[i].id = static_cast<uint8_t> (MSP430_Trace_Id::None);
+	}
+	msp430cp_trace.head = 0;
+	__bis_SR_register(gie);
+}
+
+/// <summary>Get the number of entries in the ring (up to TRACE_CAPACITY)</summary>
+unsigned int MSP430_Trace::GetCount(void)
+{
+	unsigned int head = msp430cp_trace.head;
+	return (head < TRACE_CAPACITY) ? head : TRACE_CAPACITY;
+}
+
+/// <summary>
+/// Send the header and the ring as raw bytes (the msp430cp_trace layout), recording is paused meanwhile
+/// <para>NOTE: Blocks until all bytes are sent, the UART interrupt must be enabled.</para>
+/// </summary>
+/// <param name="uart">Initialized UART</param>
+void MSP430_Trace::Dump(MSP430_UART& uart)
+{
+	// The UART's own transmit events would overwrite the ring being sent
+	bool resume = recording;
+	recording = false;
+
+	const unsigned char* data = reinterpret_cast<const unsigned char*> (&msp430cp_trace);
+	unsigned int length = sizeof(msp430cp_trace);
+	while (length > 0)
+	{
+		unsigned int written = uart.Write(data, length);
+		data += written;
+		length -= written;
+	}
+	while (uart.IsBusy())
+	{
+	}
+
+	recording = resume;
+}
+#endif
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <stdint.h>
+#include <msp430.h>
+#include "msp430cp_device.h"
+
+// Hot-path trace buffer
+// GPIO output changes, interrupt entry/exit and driver events are recorded into a fixed RAM ring (msp430cp_trace)
+// as 4-byte entries: event id, 8-bit argument and the 16-bit TRACE_TIMESTAMP counter. The ring keeps the last
+// TRACE_CAPACITY entries; it can be read by the debugger (memory dump of msp430cp_trace) or sent over a UART with
+// Dump(), and Tools/trace_decode.py turns either into a timeline.
+//
+//     // msp430cp_device.h: #define TRACE_ENABLE (TA0 must count, e.g. continuous mode on SMCLK)
+//     MSP430_TRACE(MSP430_Trace::User(1), state);             // own events, ids 0x80-0xFF
+//     ...
+// #ifdef TRACE_ENABLE
+//     MSP430_Trace::Dump(log);                                 // header + ring, raw binary
+// #endif
+//
+//     python3 Tools/trace_decode.py capture.bin                 # or a memory dump of msp430cp_trace
+//
+// Without TRACE_ENABLE, MSP430_TRACE() expands to nothing (its arguments are not evaluated), so the drivers carry
+// no trace instructions and msp430cp_trace takes no RAM.
+
+/// <summary>
+/// Trace event id (Entry id, the meaning of the argument is given per id)
+/// <para>Keep in sync with EVENTS of Tools/trace_decode.py.</para>
+/// </summary>
+enum class MSP430_Trace_Id : unsigned char
+{
+	/// <summary>Never recorded (empty entry)</summary>
+	None = 0x00,
+	/// <summary>GPIO output written (Argument: MSP430_Trace::PinOf(), bit 7 = new value)</summary>
+	GPIOWrite = 0x01,
+	/// <summary>GPIO output toggled (Argument: MSP430_Trace::PinOf())</summary>
+	GPIOToggle = 0x02,
+	/// <summary>Interrupt service routine entered (Argument: MSP430_Trace_Source)</summary>
+	InterruptEnter = 0x10,
+	/// <summary>Interrupt service routine left (Argument: MSP430_Trace_Source)</summary>
+	InterruptExit = 0x11,
+	/// <summary>Interrupt vector dispatched to a handler (Argument: handler index, IV / 2)</summary>
+	InterruptDispatch = 0x12,
+	/// <summary>UART byte received (Argument: byte)</summary>
+	UARTReceive = 0x20,
+	/// <summary>UART byte loaded into the transmitter (Argument: byte)</summary>
+	UARTTransmit = 0x21,
+	/// <summary>UART receive error or RX ring overflow (Argument: UCAxSTAT, 0 on overflow)</summary>
+	UARTError = 0x22,
+	/// <summary>First application event id (User(0), up to 0xFF)</summary>
+	User = 0x80
+};
+
+/// <summary>
+/// Interrupt source (Argument of the interrupt events)
+/// </summary>
+enum class MSP430_Trace_Source : unsigned char
+{
+	Port1 = 1,
+	Port2 = 2,
+	TA0_CCR0 = 3,
+	TA0_IV = 4,
+	TA1_CCR0 = 5,
+	TA1_IV = 6,
+	TA2_CCR0 = 7,
+	TA2_IV = 8,
+	TB0_CCR0 = 9,
+	TB0_IV = 10,
+	DMA = 11,
+	UCA0 = 12,
+	UCA1 = 13
+};
+
+#ifdef TRACE_ENABLE
+static_assert(TRACE_CAPACITY >= 2 && (TRACE_CAPACITY & (TRACE_CAPACITY - 1)) == 0, "TRACE_CAPACITY must be a power of 2");
+
+/// <summary>
+/// Trace entry (4 bytes, little-endian, the same layout on the device and on host)
+/// </summary>
+struct MSP430_Trace_Entry
+{
+	/// <summary>Event id (MSP430_Trace_Id)</summary>
+	uint8_t id;
+	/// <summary>Event argument</summary>
+	uint8_t argument;
+	/// <summary>TRACE_TIMESTAMP counter when the event was recorded</summary>
+	uint16_t timestamp;
+};
+
+/// <summary>
+/// Trace ring with its header (12 bytes + entries, the layout read by Tools/trace_decode.py)
+/// </summary>
+struct MSP430_Trace_Buffer
+{
+	/// <summary>Buffer tag (MSP430_Trace::Magic, "TR")</summary>
+	uint16_t magic;
+	/// <summary>Bytes per entry (4)</summary>
+	uint8_t entrySize;
+	/// <summary>Layout version (MSP430_Trace::Version)</summary>
+	uint8_t version;
+	/// <summary>Entries in the ring (TRACE_CAPACITY)</summary>
+	uint16_t capacity;
+	/// <summary>Entries recorded since Clear() (wraps to capacity, so a full ring stays full), the next one goes to entries[head % capacity]</summary>
+	uint16_t head;
+	/// <summary>Counting frequency of the timestamps (Hz)</summary>
+	uint32_t frequency;
+	/// <summary>Ring entries</summary>
+	MSP430_Trace_Entry entries[TRACE_CAPACITY];
+};
+
+/// <summary>Trace ring (C name for the debugger: msp430cp_trace)</summary>
+extern "C" MSP430_Trace_Buffer msp430cp_trace;
+
+class MSP430_UART;
+
+/// <summary>
+/// MSP430 trace class (all static, TRACE_ENABLE only)
+/// <para>Recording starts at reset. Record() may be called from interrupts (a call and a short critical section per event).</para>
+/// </summary>
+class MSP430_Trace
+{
+public:
+	/// <summary>Buffer tag ("TR" in memory)</summary>
+	static constexpr uint16_t Magic = 0x5254;
+	/// <summary>Buffer layout version</summary>
+	static constexpr uint8_t Version = 1;
+
+	/// <summary>Application event id</summary>
+	/// <param name="number">Event number (0-127)</param>
+	static constexpr MSP430_Trace_Id User(unsigned char number)
+	{
+		return static_cast<MSP430_Trace_Id> (static_cast<unsigned char> (MSP430_Trace_Id::User) | (number & 0x7F));
+	}
+	/// <summary>GPIO event argument of a pin (value in bit 7, port index in bits 3-6, pin in bits 0-2)</summary>
+	/// <param name="port">Port index (0 = P1)</param>
+	/// <param name="pin">Pin number (0-7)</param>
+	/// <param name="value">New output value (GPIOWrite only)</param>
+	static constexpr unsigned char PinOf(unsigned int port, unsigned int pin, bool value = false)
+	{
+		return static_cast<unsigned char> ((value ? 0x80 : 0) | ((port & 0x0F) << 3) | (pin & 0x07));
+	}
+
+	/// <summary>Record an event (interrupt-safe, nothing while stopped)</summary>
+	/// <param name="id">Event id</param>
+	/// <param name="argument">Event argument</param>
+	static void Record(MSP430_Trace_Id id, unsigned char argument);
+	/// <summary>Resume recording</summary>
+	static void Start(void);
+	/// <summary>Freeze the ring (events are dropped until Start())</summary>
+	static void Stop(void);
+	/// <summary>Check if events are recorded</summary>
+	static bool IsRecording(void);
+	/// <summary>Empty the ring</summary>
+	static void Clear(void);
+	/// <summary>Get the number of entries in the ring (up to TRACE_CAPACITY)</summary>
+	static unsigned int GetCount(void);
+	/// <summary>
+	/// Send the header and the ring as raw bytes (the msp430cp_trace layout), recording is paused meanwhile
+	/// <para>NOTE: Blocks until all bytes are sent, the UART interrupt must be enabled.</para>
+	/// </summary>
+	/// <param name="uart">Initialized UART</param>
+	static void Dump(MSP430_UART& uart);
+};
+
+#define MSP430_TRACE(ID, ARGUMENT) MSP430_Trace::Record((ID), static_cast<unsigned char> (ARGUMENT))
+#else
+#define MSP430_TRACE(ID, ARGUMENT) ((void)0)
+#endif
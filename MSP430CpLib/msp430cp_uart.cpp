@@ -0,0 +1,394 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_uart.h"
+#include "msp430cp_trace.h"
+
+// UART registers
+extern REG_8b const UCAxCTL1[UART_COUNT];
+
+/// <summary>UART serviced by the interrupt routine of each USCI_A instance (the last initialized one)</summary>
+static MSP430_UART* volatile active[UART_COUNT];
+
+/// <summary>Hardware link from program to registers</summary>
+void MSP430_UART::HardLink(void)
+{
+	this->reg_UCAxCTL1 = UCAxCTL1[static_cast<int> (this->instance)];
+	this->reg_UCAxSTAT = this->reg_UCAxCTL1 + OffsetSTAT;
+	this->reg_UCAxRXBUF = this->reg_UCAxCTL1 + OffsetRXBUF;
+	this->reg_UCAxTXBUF = this->reg_UCAxCTL1 + OffsetTXBUF;
+	this->reg_UCAxIE = this->reg_UCAxCTL1 + OffsetIE;
+	this->reg_UCAxIFG = this->reg_UCAxCTL1 + OffsetIE + 1;
+	this->reg_UCAxIV = reinterpret_cast<REG_16b> ((this->reg_UCAxCTL1 + OffsetIV).Address());
+}
+
+/// <summary>Create a new UART object on a USCI_A instance with caller-supplied ring buffers (No hardware operation)</summary>
+/// <param name="instance">USCI_A instance</param>
+/// <param name="txPin">Transmit pin (UCAxTXD)</param>
+/// <param name="rxPin">Receive pin (UCAxRXD)</param>
+/// <param name="clockSource">Clock source</param>
+/// <param name="divisor">Baud rate divisor of the clock source</param>
+/// <param name="txBuffer">Transmit ring buffer</param>
+/// <param name="txCapacity">Transmit ring buffer size (power of 2)</param>
+/// <param name="rxBuffer">Receive ring buffer</param>
+/// <param name="rxCapacity">Receive ring buffer size (power of 2)</param>
+MSP430_UART::MSP430_UART(MSP430_UART_Instance instance, MSP430_GPIO& txPin, MSP430_GPIO& rxPin, MSP430_UART_ClockSource clockSource, MSP430_UART_Divisor divisor,
+	unsigned char* txBuffer, unsigned int txCapacity, unsigned char* rxBuffer, unsigned int rxCapacity) :
+	txPin(txPin), rxPin(rxPin)
+{
+	this->instance = instance;
+	this->clockSource = clockSource;
+	this->divisor = divisor;
+	this->txBuffer = txBuffer;
+	this->txMask = txCapacity - 1;
+	this->rxBuffer = rxBuffer;
+	this->rxMask = rxCapacity - 1;
+
+	// Link the hardware
+	HardLink();
+}
+
+/// <summary>Delete this UART instance, hold the USCI in reset and release the pins</summary>
+MSP430_UART::~MSP430_UART()
+{
+	Deinitialize();
+}
+
+/// <summary>Configure the USCI, select the pin functions, empty the buffers and enable the receive interrupt</summary>
+void MSP430_UART::Initialize(void)
+{
+	// The USCI is configured in reset, releasing the reset sets UCTXIFG
+	this->reg_UCAxCTL1.Write(UCSWRST);
+	(this->reg_UCAxCTL1 + 1).Write(0);
+	this->reg_UCAxCTL1.Write((static_cast<unsigned char> (this->clockSource) << 6) | UCSWRST);
+	(this->reg_UCAxCTL1 + OffsetBR0).Write(static_cast<unsigned char> (this->divisor.prescaler));
+	(this->reg_UCAxCTL1 + OffsetBR0 + 1).Write(static_cast<unsigned char> (this->divisor.prescaler >> 8));
+	(this->reg_UCAxCTL1 + OffsetMCTL).Write(this->divisor.modulation);
+
+	this->txPin.SetFunction(MSP430_GPIO_Function::Primary);
+	this->rxPin.SetFunction(MSP430_GPIO_Function::Primary);
+
+	if (this->dma != nullptr)
+	{
+		this->dma->Initialize();
+		this->dma->SetDestination(this->reg_UCAxTXBUF.Address());
+	}
+
+	this->txHead = this->txTail = 0;
+	this->rxHead = this->rxTail = 0;
+	active[static_cast<int> (this->instance)] = this;
+
+	// The USCI receives on SMCLK only while the low-power waits keep it running
+	if (this->clockSource == MSP430_UART_ClockSource::SMCLK)
+	{
+		this->smclk.Take();
+	}
+
+	this->reg_UCAxCTL1.Clear(UCSWRST);
+	this->reg_UCAxIE.Write(UCRXIE);
+}
+
+/// <summary>Hold the USCI in reset, disable its interrupts and give the pins back to GPIO</summary>
+void MSP430_UART::Deinitialize(void)
+{
+	this->reg_UCAxCTL1.Write(UCSWRST);
+	this->reg_UCAxIE.Write(0);
+	if (this->dma != nullptr)
+	{
+		this->dma->Disable();
+	}
+	if (active[static_cast<int> (this->instance)] == this)
+	{
+		active[static_cast<int> (this->instance)] = nullptr;
+	}
+
+	this->smclk.Release();
+
+	this->txPin.SetFunction(MSP430_GPIO_Function::Stardand);
+	this->rxPin.SetFunction(MSP430_GPIO_Function::Stardand);
+}
+
+/// <summary>
+/// Use a DMA channel for WriteDMA() (Call it before Initialize(), nullptr to stop using DMA)
+/// <para>The channel must be single transfer, byte unit, source increment, destination fixed, triggered by TransmitTrigger(instance).</para>
+/// </summary>
+/// <param name="dma">DMA channel</param>
+void MSP430_UART::SetTransmitDMA(MSP430_DMA* dma)
+{
+	this->dma = dma;
+}
+
+/// <summary>Queue a byte for transmission</summary>
+/// <param name="value">Byte</param>
+/// <return>The byte was queued (false if the TX buffer is full)</return>
+bool MSP430_UART::Write(unsigned char value)
+{
+	unsigned int index = this->txHead;
+	if (index - this->txTail > this->txMask)
+	{
+		return false;
+	}
+
+	this->txBuffer[index & this->txMask] = value;
+	REG_BARRIER();
+	this->txHead = index + 1;
+	Transmit();
+	return true;
+}
+
+/// <summary>Queue as many bytes as fit into the TX buffer (never blocks)</summary>
+/// <param name="data">Bytes</param>
+/// <param name="length">Number of bytes</param>
+/// <return>Number of bytes queued</return>
+unsigned int MSP430_UART::Write(const unsigned char* data, unsigned int length)
+{
+	unsigned int index = this->txHead;
+	unsigned int mask = this->txMask;
+	unsigned int count = mask + 1 - (index - this->txTail);
+	if (count > length)
+	{
+		count = length;
+	}
+
+	// Copied in up to two runs (before and after the end of the ring), published once
+	unsigned char* buffer = this->txBuffer;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		buffer[(index + i) & mask] = data[i];
+	}
+	REG_BARRIER();
+	this->txHead = index + count;
+	if (count > 0)
+	{
+		Transmit();
+	}
+	return count;
+}
+
+/// <summary>
+/// Send a block by DMA straight from the caller's buffer (the buffer must stay valid until IsBusy() is false)
+/// <para>Starts only when no DMA transfer is running and the TX buffer is empty. Bytes queued by Write() meanwhile
+/// wait for the next Write() or Transmit() after the DMA transfer.</para>
+/// </summary>
+/// <param name="data">Bytes</param>
+/// <param name="length">Number of bytes</param>
+/// <return>The transfer was started</return>
+bool MSP430_UART::WriteDMA(const unsigned char* data, unsigned int length)
+{
+	if (this->dma == nullptr || length == 0 || this->dma->IsEnabled() || this->txHead != this->txTail)
+	{
+		return false;
+	}
+
+	this->dma->SetSource(data);
+	this->dma->SetSize(length);
+	this->dma->ClearInterruptFlag();
+
+	unsigned int gie = __get_SR_register() & GIE;
+	__disable_interrupt();
+	__no_operation();
+
+	// The interrupt must not write UCAxTXBUF during the transfer
+	this->reg_UCAxIE.Clear(UCTXIE);
+	this->dma->Enable();
+
+	// The trigger is the rising edge of UCTXIFG: an idle transmitter (flag already set) gets one by software,
+	// a busy one raises it at the end of the current byte
+	if (this->reg_UCAxIFG.Test(UCTXIFG))
+	{
+		this->reg_UCAxIFG.Clear(UCTXIFG);
+		this->reg_UCAxIFG.Set(UCTXIFG);
+	}
+
+	__bis_SR_register(gie);
+	return true;
+}
+
+/// <summary>Start the interrupt transmission of the queued bytes (e.g. from the DMA channel's handler after WriteDMA())</summary>
+void MSP430_UART::Transmit(void)
+{
+	// UCTXIFG is set while UCAxTXBUF is empty, so enabling the interrupt starts the transmission;
+	// the interrupt disables itself when the buffer is empty
+	if (this->dma == nullptr || !this->dma->IsEnabled())
+	{
+		this->reg_UCAxIE.Set(UCTXIE);
+	}
+}
+
+/// <summary>Get the free space of the TX buffer</summary>
+unsigned int MSP430_UART::GetWritable(void) const
+{
+	return this->txMask + 1 - (this->txHead - this->txTail);
+}
+
+/// <summary>Check if bytes are queued, a DMA transfer is running or the USCI is shifting</summary>
+bool MSP430_UART::IsBusy(void) const
+{
+	return this->txHead != this->txTail || (this->dma != nullptr && this->dma->IsEnabled()) || this->reg_UCAxSTAT.Test(UCBUSY);
+}
+
+/// <summary>Take the oldest received byte</summary>
+/// <param name="value">Byte output</param>
+/// <return>A byte was taken (false if the RX buffer is empty)</return>
+bool MSP430_UART::Read(unsigned char& value)
+{
+	unsigned int index = this->rxTail;
+	if (index == this->rxHead)
+	{
+		return false;
+	}
+
+	REG_BARRIER();
+	value = this->rxBuffer[index & this->rxMask];
+	REG_BARRIER();
+	this->rxTail = index + 1;
+	return true;
+}
+
+/// <summary>Take up to max received bytes</summary>
+/// <param name="data">Bytes output</param>
+/// <param name="max">Size of the output</param>
+/// <return>Number of bytes taken</return>
+unsigned int MSP430_UART::Read(unsigned char* data, unsigned int max)
+{
+	unsigned int index = this->rxTail;
+	unsigned int mask = this->rxMask;
+	unsigned int count = this->rxHead - index;
+	if (count > max)
+	{
+		count = max;
+	}
+
+	REG_BARRIER();
+	const unsigned char* buffer = this->rxBuffer;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		data[i] = buffer[(index + i) & mask];
+	}
+	REG_BARRIER();
+	this->rxTail = index + count;
+	return count;
+}
+
+/// <summary>Get the number of received bytes</summary>
+unsigned int MSP430_UART::GetAvailable(void) const
+{
+	return this->rxHead - this->rxTail;
+}
+
+/// <summary>Get the oldest received bytes in place (up to the end of the ring, a second Peek() after Consume() returns the wrapped part)</summary>
+/// <param name="data">Pointer to the oldest received byte output</param>
+/// <return>Number of contiguous bytes at data</return>
+unsigned int MSP430_UART::Peek(const unsigned char*& data) const
+{
+	unsigned int index = this->rxTail;
+	unsigned int count = this->rxHead - index;
+	unsigned int offset = index & this->rxMask;
+	if (count > this->rxMask + 1 - offset)
+	{
+		count = this->rxMask + 1 - offset;
+	}
+
+	REG_BARRIER();
+	data = this->rxBuffer + offset;
+	return count;
+}
+
+/// <summary>Release received bytes returned by Peek()</summary>
+/// <param name="count">Number of bytes (at most the Peek() result)</param>
+void MSP430_UART::Consume(unsigned int count)
+{
+	REG_BARRIER();
+	this->rxTail = this->rxTail + count;
+}
+
+/// <summary>Get the number of received bytes lost because the RX buffer was full</summary>
+unsigned int MSP430_UART::GetOverflowCount(void) const
+{
+	return this->overflowCount;
+}
+
+/// <summary>Get the number of received bytes with an overrun, framing or parity error</summary>
+unsigned int MSP430_UART::GetErrorCount(void) const
+{
+	return this->errorCount;
+}
+
+/// <summary>Service one UCAxIV source (Called by the library interrupt routine, or by yours with UART_USER_ISR)</summary>
+void MSP430_UART::Service(void)
+{
+	// Reading UCAxIV returns the highest priority pending source (RX before TX) and clears its flag
+	switch (__even_in_range(this->reg_UCAxIV.Read(), USCI_UCTXIFG))
+	{
+	case USCI_UCRXIFG:
+	{
+		// The status is read before UCAxRXBUF, reading UCAxRXBUF clears the error flags
+		unsigned char status = this->reg_UCAxSTAT.Read();
+		unsigned char value = this->reg_UCAxRXBUF.Read();
+		MSP430_TRACE(MSP430_Trace_Id::UARTReceive, value);
+		if (status & (UCOE | UCFE | UCPE))
+		{
+			this->errorCount = this->errorCount + 1;
+			MSP430_TRACE(MSP430_Trace_Id::UARTError, status);
+		}
+
+		unsigned int index = this->rxHead;
+		if (index - this->rxTail > this->rxMask)
+		{
+			this->overflowCount = this->overflowCount + 1;
+			MSP430_TRACE(MSP430_Trace_Id::UARTError, 0);
+			break;
+		}
+		this->rxBuffer[index & this->rxMask] = value;
+		REG_BARRIER();
+		this->rxHead = index + 1;
+		break;
+	}
+	case USCI_UCTXIFG:
+	{
+		unsigned int index = this->txTail;
+		if (index == this->txHead)
+		{
+			this->reg_UCAxIE.Clear(UCTXIE);
+			break;
+		}
+		unsigned char value = this->txBuffer[index & this->txMask];
+		this->reg_UCAxTXBUF.Write(value);
+		MSP430_TRACE(MSP430_Trace_Id::UARTTransmit, value);
+		REG_BARRIER();
+		this->txTail = index + 1;
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+#ifndef UART_USER_ISR
+/// <summary>USCI_A0 interrupt service routine</summary>
+REG_ISR(USCI_A0_VECTOR, MSP430_UART_A0_ISR)
+{
+	MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::UCA0);
+	MSP430_UART* uart = active[0];
+	if (uart != nullptr)
+	{
+		uart->Service();
+	}
+	MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::UCA0);
+	REG_ISR_EXIT();
+}
+
+#if UART_COUNT > 1
+/// <summary>USCI_A1 interrupt service routine</summary>
+REG_ISR(USCI_A1_VECTOR, MSP430_UART_A1_ISR)
+{
+	MSP430_TRACE(MSP430_Trace_Id::InterruptEnter, MSP430_Trace_Source::UCA1);
+	MSP430_UART* uart = active[1];
+	if (uart != nullptr)
+	{
+		uart->Service();
+	}
+	MSP430_TRACE(MSP430_Trace_Id::InterruptExit, MSP430_Trace_Source::UCA1);
+	REG_ISR_EXIT();
+}
+#endif
+#endif
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_dma.h"
+
+// Buffered USCI_A UART
+// Transmit and receive go through single-producer/single-consumer ring buffers serviced by the USCI_Ax interrupt
+// (UCAxIV): the main loop only writes the TX head and the RX tail, the interrupt only the TX tail and the RX head,
+// so neither side disables interrupts. The baud divisor and modulation are computed at compile time from the
+// MSP430_Clock frequencies.
+//
+//     MSP430_GPIO txd(MSP430_GPIO_Port::P4, 4), rxd(MSP430_GPIO_Port::P4, 5);   // UCA1TXD/UCA1RXD
+//     MSP430_BufferedUART<MSP430_UART_Instance::UCA1, 921600, 256, 64> log(txd, rxd);
+//
+//     log.Initialize();
+//     __enable_interrupt();
+//     log.Write(reinterpret_cast<const unsigned char*> ("boot\r\n"), 6);
+//
+//     const unsigned char* data;
+//     unsigned int length = log.Peek(data);                    // received bytes in place, no copy
+//     Parse(data, length);
+//     log.Consume(length);
+//
+// Large blocks can be sent by DMA straight from the caller's buffer (UCAxTXIFG trigger, see SetTransmitDMA()).
+// The library owns the USCI_A0/USCI_A1 interrupt service routines (define UART_USER_ISR in msp430cp_device.h
+// to keep your own, and call Service() from them).
+
+// UART location enumerations and definations
+/// <summary>
+/// UART instance (USCI_A module)
+/// </summary>
+enum class MSP430_UART_Instance
+{
+	UCA0 = 0,
+	UCA1 = 1
+};
+
+// UART configurations enumerations
+/// <summary>
+/// UART Clock Source (Results in UCSSELx bits)
+/// </summary>
+enum class MSP430_UART_ClockSource
+{
+	ACLK = 0b01,
+	SMCLK = 0b10
+};
+
+/// <summary>
+/// UART baud rate divisor (UCAxBRW and UCAxMCTL values)
+/// </summary>
+struct MSP430_UART_Divisor
+{
+	/// <summary>Clock prescaler (UCBRx, 0 for an unreachable baud rate)</summary>
+	unsigned int prescaler;
+	/// <summary>Modulation control (UCBRFx, UCBRSx and UCOS16 bits)</summary>
+	unsigned char modulation;
+
+	/// <summary>
+	/// Compute the divisor of a baud rate (User's Guide: Setting a Baud Rate)
+	/// <para>N = clock / baud. N &gt;= 16: oversampling, UCBRx = INT(N / 16), UCBRFx = round(N - 16 * UCBRx).
+	/// Otherwise low-frequency mode, UCBRx = INT(N), UCBRSx = round(8 * (N - UCBRx)). N must be 3 or more.</para>
+	/// </summary>
+	/// <param name="clock">BRCLK frequency (Hz)</param>
+	/// <param name="baudRate">Baud rate</param>
+	static constexpr MSP430_UART_Divisor Of(unsigned long clock, unsigned long baudRate)
+	{
+		if (baudRate == 0 || clock / 3 < baudRate)
+		{
+			return { 0, 0 };
+		}
+		if (clock / 16 >= baudRate)
+		{
+			unsigned long prescaler = clock / (16 * baudRate);
+			unsigned long first = (2 * (clock - 16 * prescaler * baudRate) + baudRate) / (2 * baudRate);
+			if (first >= 16)
+			{
+				prescaler++;
+				first = 0;
+			}
+			if (prescaler > 0xFFFF)
+			{
+				return { 0, 0 };
+			}
+			return { static_cast<unsigned int> (prescaler), static_cast<unsigned char> ((first << 4) | UCOS16) };
+		}
+		unsigned long prescaler = clock / baudRate;
+		unsigned long second = (16 * (clock - prescaler * baudRate) + baudRate) / (2 * baudRate);
+		if (second >= 8)
+		{
+			prescaler++;
+			second = 0;
+		}
+		return { static_cast<unsigned int> (prescaler), static_cast<unsigned char> (second << 1) };
+	}
+
+	/// <summary>Check the baud rate is reachable</summary>
+	constexpr bool IsValid(void) const
+	{
+		return prescaler != 0;
+	}
+	/// <summary>Get the mean baud rate produced by this divisor</summary>
+	/// <param name="clock">BRCLK frequency (Hz)</param>
+	constexpr unsigned long GetBaudRate(unsigned long clock) const
+	{
+		return !IsValid() ? 0 : (modulation & UCOS16)
+			? clock / (16UL * prescaler + (modulation >> 4))
+			: 8 * clock / (8UL * prescaler + ((modulation >> 1) & 0x07));
+	}
+};
+
+/// <summary>
+/// MSP430 buffered UART class (8N1, LSB first)
+/// <para>The ring buffers are supplied by the caller (capacities are powers of 2), see MSP430_BufferedUART for the
+/// compile-time configured version. The counters of lost and bad bytes are never cleared (only the interrupt writes them).</para>
+/// <para>NOTE: One object per USCI_A instance is serviced by the library interrupt routine (the last initialized one).</para>
+/// </summary>
+class MSP430_UART
+{
+private:
+	// Register for hardware operation
+	MSP430_Register8 reg_UCAxCTL1;
+	MSP430_Register8 reg_UCAxSTAT;
+	MSP430_Register8 reg_UCAxRXBUF;
+	MSP430_Register8 reg_UCAxTXBUF;
+	MSP430_Register8 reg_UCAxIE;
+	MSP430_Register8 reg_UCAxIFG;
+	MSP430_Register16 reg_UCAxIV;
+
+	// Corresponding UART location and configuration
+	/// <summary>USCI_A instance</summary>
+	MSP430_UART_Instance instance;
+	/// <summary>Transmit pin (UCAxTXD)</summary>
+	MSP430_GPIO& txPin;
+	/// <summary>Receive pin (UCAxRXD)</summary>
+	MSP430_GPIO& rxPin;
+	/// <summary>Clock source</summary>
+	MSP430_UART_ClockSource clockSource;
+	/// <summary>Baud rate divisor</summary>
+	MSP430_UART_Divisor divisor;
+	/// <summary>Optional transmit DMA channel</summary>
+	MSP430_DMA* dma = nullptr;
+	/// <summary>SMCLK hold from Initialize() to Deinitialize() (SMCLK clock source)</summary>
+	MSP430_Clock_SMCLKHold smclk;
+
+	// Ring buffers
+	unsigned char* txBuffer;
+	unsigned char* rxBuffer;
+	/// <summary>TX capacity - 1</summary>
+	unsigned int txMask;
+	/// <summary>RX capacity - 1</summary>
+	unsigned int rxMask;
+	/// <summary>Free-running TX write index (written by the main loop only)</summary>
+	volatile unsigned int txHead = 0;
+	/// <summary>Free-running TX read index (written by the interrupt only)</summary>
+	volatile unsigned int txTail = 0;
+	/// <summary>Free-running RX write index (written by the interrupt only)</summary>
+	volatile unsigned int rxHead = 0;
+	/// <summary>Free-running RX read index (written by the main loop only)</summary>
+	volatile unsigned int rxTail = 0;
+	/// <summary>Received bytes lost because the RX buffer was full</summary>
+	volatile unsigned int overflowCount = 0;
+	/// <summary>Received bytes with an overrun, framing or parity error</summary>
+	volatile unsigned int errorCount = 0;
+
+	// Private low-level linking functions
+	/// <summary>Hardware link from program to registers</summary>
+	void HardLink(void);
+
+public:
+	// Register byte offsets from UCAxCTL1
+	/// <summary>UCAxBR0 offset (UCAxBR1 follows)</summary>
+	static constexpr int OffsetBR0 = 0x06;
+	/// <summary>UCAxMCTL offset</summary>
+	static constexpr int OffsetMCTL = 0x08;
+	/// <summary>UCAxSTAT offset</summary>
+	static constexpr int OffsetSTAT = 0x0A;
+	/// <summary>UCAxRXBUF offset</summary>
+	static constexpr int OffsetRXBUF = 0x0C;
+	/// <summary>UCAxTXBUF offset</summary>
+	static constexpr int OffsetTXBUF = 0x0E;
+	/// <summary>UCAxIE offset (UCAxIFG follows)</summary>
+	static constexpr int OffsetIE = 0x1C;
+	/// <summary>UCAxIV offset</summary>
+	static constexpr int OffsetIV = 0x1E;
+
+	/// <summary>Get the frequency of a clock source (MSP430_Clock::xxxFrequency)</summary>
+	/// <param name="clockSource">Clock source</param>
+	static constexpr unsigned long ClockOf(MSP430_UART_ClockSource clockSource)
+	{
+		return (clockSource == MSP430_UART_ClockSource::ACLK) ? MSP430_Clock::ACLKFrequency : MSP430_Clock::SMCLKFrequency;
+	}
+	/// <summary>Get the DMA trigger of an instance's transmit buffer (UCAxTXIFG)</summary>
+	/// <param name="instance">USCI_A instance</param>
+	static constexpr MSP430_DMA_Trigger TransmitTrigger(MSP430_UART_Instance instance)
+	{
+		return (instance == MSP430_UART_Instance::UCA0) ? MSP430_DMA_Trigger::UCA0_TX : MSP430_DMA_Trigger::UCA1_TX;
+	}
+
+	// Constructor
+	/// <summary>Create a new UART object on a USCI_A instance with caller-supplied ring buffers (No hardware operation)</summary>
+	/// <param name="instance">USCI_A instance</param>
+	/// <param name="txPin">Transmit pin (UCAxTXD)</param>
+	/// <param name="rxPin">Receive pin (UCAxRXD)</param>
+	/// <param name="clockSource">Clock source</param>
+	/// <param name="divisor">Baud rate divisor of the clock source</param>
+	/// <param name="txBuffer">Transmit ring buffer</param>
+	/// <param name="txCapacity">Transmit ring buffer size (power of 2)</param>
+	/// <param name="rxBuffer">Receive ring buffer</param>
+	/// <param name="rxCapacity">Receive ring buffer size (power of 2)</param>
+	MSP430_UART(MSP430_UART_Instance instance, MSP430_GPIO& txPin, MSP430_GPIO& rxPin, MSP430_UART_ClockSource clockSource, MSP430_UART_Divisor divisor,
+		unsigned char* txBuffer, unsigned int txCapacity, unsigned char* rxBuffer, unsigned int rxCapacity);
+	/// <summary>Delete this UART instance, hold the USCI in reset and release the pins</summary>
+	~MSP430_UART();
+
+	// UART initialize
+	/// <summary>Configure the USCI, select the pin functions, empty the buffers and enable the receive interrupt</summary>
+	void Initialize(void);
+	/// <summary>Hold the USCI in reset, disable its interrupts and give the pins back to GPIO</summary>
+	void Deinitialize(void);
+	/// <summary>
+	/// Use a DMA channel for WriteDMA() (Call it before Initialize(), nullptr to stop using DMA)
+	/// <para>The channel must be single transfer, byte unit, source increment, destination fixed, triggered by TransmitTrigger(instance).</para>
+	/// </summary>
+	/// <param name="dma">DMA channel</param>
+	void SetTransmitDMA(MSP430_DMA* dma);
+
+	// Transmit
+	/// <summary>Queue a byte for transmission</summary>
+	/// <param name="value">Byte</param>
+	/// <return>The byte was queued (false if the TX buffer is full)</return>
+	bool Write(unsigned char value);
+	/// <summary>Queue as many bytes as fit into the TX buffer (never blocks)</summary>
+	/// <param name="data">Bytes</param>
+	/// <param name="length">Number of bytes</param>
+	/// <return>Number of bytes queued</return>
+	unsigned int Write(const unsigned char* data, unsigned int length);
+	/// <summary>
+	/// Send a block by DMA straight from the caller's buffer (the buffer must stay valid until IsBusy() is false)
+	/// <para>Starts only when no DMA transfer is running and the TX buffer is empty. Bytes queued by Write() meanwhile
+	/// wait for the next Write() or Transmit() after the DMA transfer.</para>
+	/// </summary>
+	/// <param name="data">Bytes</param>
+	/// <param name="length">Number of bytes</param>
+	/// <return>The transfer was started</return>
+	bool WriteDMA(const unsigned char* data, unsigned int length);
+	/// <summary>Start the interrupt transmission of the queued bytes (e.g. from the DMA channel's handler after WriteDMA())</summary>
+	void Transmit(void);
+	/// <summary>Get the free space of the TX buffer</summary>
+	unsigned int GetWritable(void) const;
+	/// <summary>Check if bytes are queued, a DMA transfer is running or the USCI is shifting</summary>
+	bool IsBusy(void) const;
+
+	// Receive
+	/// <summary>Take the oldest received byte</summary>
+	/// <param name="value">Byte output</param>
+	/// <return>A byte was taken (false if the RX buffer is empty)</return>
+	bool Read(unsigned char& value);
+	/// <summary>Take up to max received bytes</summary>
+	/// <param name="data">Bytes output</param>
+	/// <param name="max">Size of the output</param>
+	/// <return>Number of bytes taken</return>
+	unsigned int Read(unsigned char* data, unsigned int max);
+	/// <summary>Get the number of received bytes</summary>
+	unsigned int GetAvailable(void) const;
+	/// <summary>Get the oldest received bytes in place (up to the end of the ring, a second Peek() after Consume() returns the wrapped part)</summary>
+	/// <param name="data">Pointer to the oldest received byte output</param>
+	/// <return>Number of contiguous bytes at data</return>
+	unsigned int Peek(const unsigned char*& data) const;
+	/// <summary>Release received bytes returned by Peek()</summary>
+	/// <param name="count">Number of bytes (at most the Peek() result)</param>
+	void Consume(unsigned int count);
+
+	// Status
+	/// <summary>Get the number of received bytes lost because the RX buffer was full</summary>
+	unsigned int GetOverflowCount(void) const;
+	/// <summary>Get the number of received bytes with an overrun, framing or parity error</summary>
+	unsigned int GetErrorCount(void) const;
+
+	// Interrupt service
+	/// <summary>Service one UCAxIV source (Called by the library interrupt routine, or by yours with UART_USER_ISR)</summary>
+	void Service(void);
+};
+
+/// <summary>
+/// MSP430 buffered UART class with compile-time baud rate and buffers
+/// <para>The divisor is computed from the clock source frequency at compile time, the baud rate must be within 2%.</para>
+/// </summary>
+/// <typeparam name="uartInstance">USCI_A instance</typeparam>
+/// <typeparam name="baudRate">Baud rate</typeparam>
+/// <typeparam name="txCapacity">Transmit ring buffer size (power of 2)</typeparam>
+/// <typeparam name="rxCapacity">Receive ring buffer size (power of 2)</typeparam>
+/// <typeparam name="uartClockSource">Clock source</typeparam>
+template <MSP430_UART_Instance uartInstance, unsigned long baudRate, unsigned int txCapacity, unsigned int rxCapacity,
+	MSP430_UART_ClockSource uartClockSource = MSP430_UART_ClockSource::SMCLK>
+class MSP430_BufferedUART : public MSP430_UART
+{
+	static_assert(txCapacity >= 2 && (txCapacity & (txCapacity - 1)) == 0, "TX capacity must be a power of 2");
+	static_assert(rxCapacity >= 2 && (rxCapacity & (rxCapacity - 1)) == 0, "RX capacity must be a power of 2");
+
+public:
+	/// <summary>Clock source frequency (Hz)</summary>
+	static constexpr unsigned long Clock = MSP430_UART::ClockOf(uartClockSource);
+	/// <summary>Baud rate divisor</summary>
+	static constexpr MSP430_UART_Divisor Divisor = MSP430_UART_Divisor::Of(Clock, baudRate);
+	static_assert(Divisor.IsValid(), "The baud rate needs a clock of 3 times the baud rate or more");
+	static_assert(Divisor.GetBaudRate(Clock) <= baudRate + baudRate / 50 && Divisor.GetBaudRate(Clock) + baudRate / 50 >= baudRate,
+		"The baud rate error is more than 2%, raise the clock frequency");
+
+private:
+	unsigned char txStorage[txCapacity];
+	unsigned char rxStorage[rxCapacity];
+
+public:
+	// Constructor
+	/// <summary>Create a new UART object (No hardware operation)</summary>
+	/// <param name="txPin">Transmit pin (UCAxTXD)</param>
+	/// <param name="rxPin">Receive pin (UCAxRXD)</param>
+	MSP430_BufferedUART(MSP430_GPIO& txPin, MSP430_GPIO& rxPin) :
+		MSP430_UART(uartInstance, txPin, rxPin, uartClockSource, Divisor, txStorage, txCapacity, rxStorage, rxCapacity)
+	{
+	}
+};
+
+#ifdef MSP430CP_HOST
+#ifndef UART_USER_ISR
+// Interrupt service routines (plain functions on host)
+void MSP430_UART_A0_ISR(void);
+void MSP430_UART_A1_ISR(void);
+#endif
+#endif
@@ -0,0 +1,140 @@
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_waveform.h"
+#include "msp430cp_clock.h"
+
+// GPIO registers
+extern REG_8b const PxOUT[GPIO_PORT_COUNT];
+// Timer registers
+extern REG_16b const TxCTL[TIMER_COUNT];
+
+/// <summary>DMA trigger of a timer's CCR0 (TA0_CCR0, TA1_CCR0, TA2_CCR0, TB0_CCR0 follow the timer instance order)</summary>
+static inline MSP430_DMA_Trigger TriggerOf(MSP430_Timer_Instance timer)
+{
+	return static_cast<MSP430_DMA_Trigger> (static_cast<int> (MSP430_DMA_Trigger::TA0_CCR0) + 2 * static_cast<int> (timer));
+}
+
+/// <summary>Create a new waveform object on a bank, a DMA channel and a timer</summary>
+/// <param name="bank">Output bank</param>
+/// <param name="channel">DMA channel</param>
+/// <param name="timer">Sample clock timer (its CCR0 triggers the DMA)</param>
+/// <param name="sampleRate">Frames per second</param>
+/// <param name="mode">Playing mode</param>
+MSP430_GPIO_Waveform::MSP430_GPIO_Waveform(MSP430_GPIO_Bank& bank, MSP430_DMA_Channel channel, MSP430_Timer_Instance timer, unsigned long sampleRate, MSP430_Waveform_Mode mode) :
+	dma(channel, TriggerOf(timer), (mode == MSP430_Waveform_Mode::Single) ? MSP430_DMA_Mode::Single : MSP430_DMA_Mode::RepeatSingle,
+		MSP430_DMA_Step::Increment, MSP430_DMA_Step::Fixed, MSP430_DMA_Unit::Byte)
+{
+	this->reg_TxCTL = TxCTL[static_cast<int> (timer)];
+	this->reg_PxOUT = PxOUT[static_cast<int> (bank.GetPort())];
+	this->accessMask = bank.GetAccessMask();
+	this->mode = mode;
+	this->sampleRate = sampleRate;
+}
+
+/// <summary>Delete this waveform instance, stop playing and release the DMA channel and the timer</summary>
+MSP430_GPIO_Waveform::~MSP430_GPIO_Waveform()
+{
+	Deinitialize();
+}
+
+/// <summary>Initialize the DMA channel (PxOUT destination) and the sample clock (halted)</summary>
+void MSP430_GPIO_Waveform::Initialize(void)
+{
+	this->dma.Initialize();
+	this->dma.SetDestination(this->reg_PxOUT.Address());
+
+	this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+	SetSampleRate(this->sampleRate);
+}
+
+/// <summary>Stop playing, reset the DMA channel and the timer</summary>
+void MSP430_GPIO_Waveform::Deinitialize(void)
+{
+	this->dma.Deinitialize();
+	this->reg_TxCTL.Write(MSP430_Timer_Control::Clear::On);
+	MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0).Reset();
+}
+
+/// <summary>Set the sample rate (takes effect at once)</summary>
+/// <param name="sampleRate">Frames per second</param>
+void MSP430_GPIO_Waveform::SetSampleRate(unsigned long sampleRate)
+{
+	this->sampleRate = sampleRate;
+
+	// SMCLK with the smallest input divider that fits the period into 16 bits
+	MSP430_Timer::SetPeriodOnSMCLK(this->reg_TxCTL, sampleRate);
+}
+
+/// <summary>
+/// Merge the current output level of the pins outside the access mask into frames
+/// <para>Call it before playing and after changing those pins. Not needed when the access mask is 0xFF.</para>
+/// </summary>
+/// <param name="frames">Frames</param>
+/// <param name="count">Number of frames</param>
+void MSP430_GPIO_Waveform::Prepare(unsigned char* frames, unsigned int count)
+{
+	unsigned char mask = this->accessMask;
+	unsigned char others = this->reg_PxOUT.Read() & ~mask;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		frames[i] = (frames[i] & mask) | others;
+	}
+}
+
+/// <summary>Start playing from the first frame</summary>
+/// <param name="frames">Frames (2 x length in ping-pong mode)</param>
+/// <param name="length">Frames per pass (per half in ping-pong mode)</param>
+void MSP430_GPIO_Waveform::Start(unsigned char* frames, unsigned int length)
+{
+	Stop();
+	this->frames = frames;
+	this->length = length;
+	this->half = 0;
+
+	// The first pass is loaded by Enable()
+	this->dma.SetSource(frames);
+	this->dma.SetSize(length);
+	this->dma.ClearInterruptFlag();
+	this->dma.Enable();
+
+	if (this->mode == MSP430_Waveform_Mode::PingPong)
+	{
+		// The second half is loaded when the first one is finished
+		this->dma.SetSource(frames + length);
+		this->dma.EnableInterrupt();
+	}
+
+	// Restart the sample clock without a pending trigger (SMCLK keeps running in the low-power waits)
+	this->smclk.Take();
+	MSP430_Timer::CaptureControlOf(this->reg_TxCTL, 0).Reset();
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Up) | MSP430_Timer_Control::Clear::On);
+}
+
+/// <summary>Stop playing (the outputs keep the last frame)</summary>
+void MSP430_GPIO_Waveform::Stop(void)
+{
+	this->reg_TxCTL.Modify(MSP430_Timer_Control::Mode::Of(MSP430_Timer_Mode::Stop));
+	this->dma.DisableInterrupt();
+	this->dma.Disable();
+	this->smclk.Release();
+}
+
+/// <summary>Check if the waveform is playing (false after a single pass is completed)</summary>
+bool MSP430_GPIO_Waveform::IsPlaying(void)
+{
+	return this->reg_TxCTL.Get<MSP430_Timer_Control::Mode>() != MSP430_Timer_Mode::Stop && this->dma.IsEnabled();
+}
+
+/// <summary>
+/// Hand over the finished half (Call it from the DMA channel's interrupt handler in ping-pong mode)
+/// <para>The other half is already playing, the returned one can be refilled until the next call.</para>
+/// </summary>
+/// <return>First frame of the finished half</return>
+unsigned char* MSP430_GPIO_Waveform::Advance(void)
+{
+	// The finished half is the one loaded after the half playing now
+	unsigned char* finished = this->frames + (this->half ? this->length : 0);
+	this->dma.SetSource(finished);
+	this->half = this->half ^ 1;
+	return finished;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <msp430.h>
+#include "msp430cp_device.h"
+#include "msp430cp_registers.h"
+#include "msp430cp_clock.h"
+#include "msp430cp_gpio.h"
+#include "msp430cp_timer.h"
+#include "msp430cp_dma.h"
+
+// GPIO waveform output
+// A DMA channel copies one byte of a frame buffer into the bank's PxOUT at each CCR0 match of a timer in Up mode,
+// so parallel patterns are played at a fixed sample rate without CPU.
+//
+//     unsigned char frames[64];                                   // 2 x 32 for ping-pong
+//     unsigned char* volatile refill;
+//     MSP430_GPIO_Waveform wave(bus, 0, MSP430_Timer_Instance::TB0, 100000, MSP430_Waveform_Mode::PingPong);
+//     wave.Initialize();
+//     wave.Prepare(frames, sizeof(frames));
+//     wave.Start(frames, 32);
+//
+//     MSP430_DMA_INTERRUPT_HANDLER(0)
+//     {
+//         refill = wave.Advance();                                // the Refill task fills these 32 frames before the next call
+//         Scheduler::Post<Refill>();
+//     }
+//
+// Post() requests the wake-up: the DMA interrupt routine leaves the low-power mode of the scheduler loop on exit.
+//
+// DMA writes the whole PxOUT byte. Pins outside the access mask get the level stored in the frames:
+// Prepare() merges their current output level into the frames, they must not be changed by the program while playing.
+
+/// <summary>
+/// Waveform playing mode
+/// </summary>
+enum class MSP430_Waveform_Mode
+{
+	/// <summary>Play the frames once, the outputs keep the last frame</summary>
+	Single,
+	/// <summary>Play the frames over and over</summary>
+	Repeat,
+	/// <summary>Play two halves alternately, the DMA interrupt hands over the finished half to be refilled</summary>
+	PingPong
+};
+
+/// <summary>
+/// MSP430 GPIO bank waveform output class
+/// <para>Uses one DMA channel and one timer (Up mode on SMCLK, CCR0 as the DMA trigger). The bank must be initialized as output.</para>
+/// </summary>
+class MSP430_GPIO_Waveform
+{
+private:
+	// Hardware for waveform operation
+	/// <summary>DMA channel (frames to PxOUT)</summary>
+	MSP430_DMA dma;
+	/// <summary>Timer control register (TxCTL) of the sample clock</summary>
+	MSP430_FieldRegister<MSP430_Timer_Control> reg_TxCTL;
+	/// <summary>Output register (PxOUT) of the bank</summary>
+	MSP430_Register8 reg_PxOUT;
+
+	// Corresponding waveform configuration
+	/// <summary>Access mask of the bank</summary>
+	unsigned char accessMask;
+	/// <summary>Playing mode</summary>
+	MSP430_Waveform_Mode mode;
+	/// <summary>Sample rate (Hz)</summary>
+	unsigned long sampleRate;
+
+	// Playing state
+	/// <summary>First frame of the buffer</summary>
+	unsigned char* frames = nullptr;
+	/// <summary>Frames per pass (per half in ping-pong mode)</summary>
+	unsigned int length = 0;
+	/// <summary>Half being played (ping-pong mode, 0 or 1)</summary>
+	volatile unsigned char half = 0;
+	/// <summary>SMCLK hold from Start() to Stop()</summary>
+	MSP430_Clock_SMCLKHold smclk;
+
+public:
+	// Constructor
+	/// <summary>Create a new waveform object on a bank, a DMA channel and a timer</summary>
+	/// <param name="bank">Output bank</param>
+	/// <param name="channel">DMA channel</param>
+	/// <param name="timer">Sample clock timer (its CCR0 triggers the DMA)</param>
+	/// <param name="sampleRate">Frames per second</param>
+	/// <param name="mode">Playing mode</param>
+	MSP430_GPIO_Waveform(MSP430_GPIO_Bank& bank, MSP430_DMA_Channel channel, MSP430_Timer_Instance timer, unsigned long sampleRate, MSP430_Waveform_Mode mode);
+	/// <summary>Delete this waveform instance, stop playing and release the DMA channel and the timer</summary>
+	~MSP430_GPIO_Waveform();
+
+	// Waveform initialize or re-configuration
+	/// <summary>Initialize the DMA channel (PxOUT destination) and the sample clock (halted)</summary>
+	void Initialize(void);
+	/// <summary>Stop playing, reset the DMA channel and the timer</summary>
+	void Deinitialize(void);
+	/// <summary>Set the sample rate (takes effect at once)</summary>
+	/// <param name="sampleRate">Frames per second</param>
+	void SetSampleRate(unsigned long sampleRate);
+
+	// Frames
+	/// <summary>
+	/// Merge the current output level of the pins outside the access mask into frames
+	/// <para>Call it before playing and after changing those pins. Not needed when the access mask is 0xFF.</para>
+	/// </summary>
+	/// <param name="frames">Frames</param>
+	/// <param name="count">Number of frames</param>
+	void Prepare(unsigned char* frames, unsigned int count);
+
+	// Playing control
+	/// <summary>Start playing from the first frame</summary>
+	/// <param name="frames">Frames (2 x length in ping-pong mode)</param>
+	/// <param name="length">Frames per pass (per half in ping-pong mode)</param>
+	void Start(unsigned char* frames, unsigned int length);
+	/// <summary>Stop playing (the outputs keep the last frame)</summary>
+	void Stop(void);
+	/// <summary>Check if the waveform is playing (false after a single pass is completed)</summary>
+	bool IsPlaying(void);
+	/// <summary>
+	/// Hand over the finished half (Call it from the DMA channel's interrupt handler in ping-pong mode)
+	/// <para>The other half is already playing, the returned one can be refilled until the next call.</para>
+	/// </summary>
+	/// <return>First frame of the finished half</return>
+	unsigned char* Advance(void);
+};